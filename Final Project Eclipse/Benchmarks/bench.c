@@ -0,0 +1,137 @@
+/******************************************************************************
+*  File name:		bench.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "bench.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+extern uint8 __heap_start; /* end of .bss, nothing but the stack goes above it */
+
+static volatile uint16 g_benchOverflows = 0;
+static uint8 *g_benchStackTop;
+static uint16 g_benchStackUsed = 0;
+static char g_benchText[12];
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void BENCH_sendString(const char *string);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void BENCH_init(void)
+{
+	UBRRH = 0;
+	UBRRL = (uint8)((F_CPU / (16UL * BENCH_BAUD_RATE)) - 1);
+	UCSRB = (1<<TXEN);
+	UCSRC = (1<<URSEL) | (1<<UCSZ1) | (1<<UCSZ0); /* 8 bits, no parity, 1 stop bit */
+	sei();
+}
+
+void BENCH_start(void)
+{
+	uint8 sreg = SREG;
+
+	/* nothing may push while the free part of the stack is painted */
+	cli();
+	g_benchStackTop = (uint8 *)SP;
+	for(uint8 *byte = &__heap_start ; byte <= g_benchStackTop ; byte++)
+	{
+		*byte = BENCH_STACK_PAINT;
+	}
+	SREG = sreg;
+
+	TCCR1A = 0;
+	TCCR1B = 0;
+	TCNT1 = 0;
+	g_benchOverflows = 0;
+	TIFR = (1<<TOV1);
+	TIMSK |= (1<<TOIE1);
+	TCCR1B = (1<<CS10); /* no prescaler, one count every cycle */
+}
+
+uint32 BENCH_stop(void)
+{
+	uint32 cycles;
+	uint8 *byte = &__heap_start;
+
+	TCCR1B = 0;
+	cycles = ((uint32)g_benchOverflows<<16) | TCNT1;
+	if(TIFR & (1<<TOV1))
+		cycles += 0x10000UL; /* overflow that happened while stopping */
+	TIMSK &= ~(1<<TOIE1);
+
+	while( (byte <= g_benchStackTop) && (*byte == BENCH_STACK_PAINT) )
+	{
+		byte++;
+	}
+	g_benchStackUsed = (uint16)(g_benchStackTop + 1 - byte);
+	return cycles;
+}
+
+uint16 BENCH_getStackUsed(void)
+{
+	return g_benchStackUsed;
+}
+
+void BENCH_report(const char *name,uint32 value)
+{
+	BENCH_sendString(name);
+	ultoa(value, g_benchText, 10);
+	BENCH_sendString(g_benchText);
+	BENCH_sendString("\r\n");
+}
+
+void BENCH_end(boolean pass)
+{
+	BENCH_sendString(pass ? "result=PASS\r\n" : "result=FAIL\r\n");
+	while((UCSRA & (1<<TXC)) == 0){} /* the last byte is out of the shift register */
+
+	/* sleeping with the interrupts disabled ends the simulation */
+	cli();
+	sleep_mode();
+	while(1){}
+}
+
+/*******************************************************************************
+* Function Name:		BENCH_sendString
+* Description:			Function to send a string over the UART by polling
+* Parameters (in):    	String
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BENCH_sendString(const char *string)
+{
+	for( ; *string != '\0' ; string++)
+	{
+		while((UCSRA & (1<<UDRE)) == 0){}
+		UCSRA = (1<<TXC); /* cleared by writing one, set again by the last byte */
+		UDR = *string;
+	}
+}
+
+/*******************************************************************************
+*                      		INTERRUPT SERVICE ROUTINE	           	           *
+*******************************************************************************/
+
+ISR(TIMER1_OVF_vect)
+{
+	g_benchOverflows++;
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+*  File name:		bench.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*
+ * Common part of the benchmarks : the CPU cycles of a path are counted with TIMER1
+ * at F_CPU and the stack below the caller is painted before the path runs so the
+ * deepest byte it used can be found after it. The results are sent over the UART
+ * (9600 baud) as "name=value" lines, which is what simavr prints and what the
+ * Makefile collects in results.txt. The UART is driven here so a benchmark of
+ * MCU1 or MCU2 code doesn't depend on the driver of either project.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "../Final_Project_MCU2/LIB/std_types.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define BENCH_BAUD_RATE			9600UL
+#define BENCH_STACK_PAINT		0xC5		/* unlikely to be pushed, a byte that isn't it was used */
+#define BENCH_CYCLES_PER_US		(F_CPU / 1000000UL)
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		BENCH_init
+* Description:			Function to set up the UART of the report and enable the interrupts
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BENCH_init(void);
+
+/*******************************************************************************
+* Function Name:		BENCH_start
+* Description:			Function to paint the free stack and start counting the CPU cycles
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BENCH_start(void);
+
+/*******************************************************************************
+* Function Name:		BENCH_stop
+* Description:			Function to stop counting and find how deep the stack went since BENCH_start
+* Parameters (in):    	None
+* Parameters (out):   	Number of cycles since BENCH_start
+* Return value:      	uint32
+********************************************************************************/
+
+uint32 BENCH_stop(void);
+
+/*******************************************************************************
+* Function Name:		BENCH_getStackUsed
+* Description:			Function to get the stack used by the path of the last BENCH_stop,
+* 						interrupts that came meanwhile included
+* Parameters (in):    	None
+* Parameters (out):   	Bytes below the stack pointer of BENCH_start
+* Return value:      	uint16
+********************************************************************************/
+
+uint16 BENCH_getStackUsed(void);
+
+/*******************************************************************************
+* Function Name:		BENCH_report
+* Description:			Function to send one "name=value" line over the UART
+* Parameters (in):    	Name with its '=' and value
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BENCH_report(const char *name,uint32 value);
+
+/*******************************************************************************
+* Function Name:		BENCH_end
+* Description:			Function to send the result line and end the simulation, on a board
+* 						the MCU just sleeps
+* Parameters (in):    	TRUE if every path was within its budget
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BENCH_end(boolean pass) __attribute__((noreturn));
+
+#endif /* BENCH_H_ */
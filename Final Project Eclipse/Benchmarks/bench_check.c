@@ -0,0 +1,197 @@
+/******************************************************************************
+*  File name:		bench_check.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Time of a whole APP_checkPassword on MCU2, from the password of MCU1 to the
+ * answer, for the right main password and for a wrong one with the longest PIN.
+ * The link is wrapped (-Wl,--wrap=UART_receiveByte,--wrap=UART_sendByte) so the
+ * bytes of MCU1 are there at once and the answers are only counted, the EEPROM is
+ * the RAM one with the time of its page reads and writes added. The buzzer shares
+ * TIMER1 with the cycle counter so it is replaced by stubs that only count.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "bench.h"
+#include "eeprom_ram.h"
+#include "../Final_Project_MCU2/APP/app.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define BENCH_BUDGET_US			50000UL		/* MCU1 shows nothing while it waits for the answer */
+#define BENCH_PIN_SIZE			PASSWORD_MAX_SIZE
+#define BENCH_LINK_SIZE			(1 + PASSWORD_MAX_SIZE)
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static uint8 g_benchLink[BENCH_LINK_SIZE];	/* length then digits, as MCU1 sends them */
+static uint8 g_benchLinkHead;
+static uint8 g_benchAnswers;
+static uint8 g_benchBeeps;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+uint8 __wrap_UART_receiveByte(void);
+void __wrap_UART_sendByte(const uint8 data);
+static uint32 BENCH_check(uint8 firstDigit,uint16 *stack);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(void)
+{
+	uint8 pin[BENCH_PIN_SIZE];
+	uint8 record[JOURNAL_DATA_SIZE] = {0};
+	uint16 matchedStack;
+	uint16 wrongStack;
+	uint32 matchedUs;
+	uint32 wrongUs;
+
+	BENCH_init();
+	EEPROM_RAM_erase();
+	JOURNAL_init();
+	CREDENTIAL_init();
+	LOCKOUT_init();
+	AUDIT_init();
+
+	/* main password 123456789012 */
+	for(uint8 i = 0 ; i < BENCH_PIN_SIZE ; i++)
+	{
+		pin[i] = (1 + i) % 10;
+	}
+	CREDENTIAL_hash(pin, BENCH_PIN_SIZE, (Credential_SecretType *)record);
+	JOURNAL_write(JOURNAL_KEY_PASSWORD, record);
+
+	matchedUs = BENCH_check(1, &matchedStack);
+	wrongUs = BENCH_check(9, &wrongStack);
+
+	BENCH_report("check_matched_stack=", matchedStack);
+	BENCH_report("check_matched_us=", matchedUs);
+	BENCH_report("check_wrong_stack=", wrongStack);
+	BENCH_report("check_wrong_us=", wrongUs);
+	BENCH_report("answers=", g_benchAnswers);
+	BENCH_report("beeps=", g_benchBeeps);
+	BENCH_report("budget_us=", BENCH_BUDGET_US);
+	BENCH_end( (matchedUs <= BENCH_BUDGET_US) && (wrongUs <= BENCH_BUDGET_US) );
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		BENCH_check
+* Description:			Function to time one APP_checkPassword for a PIN starting with a digit,
+* 						the others follow it as in the main password
+* Parameters (in):    	First digit and pointer to the stack used
+* Parameters (out):   	Time of the check with the EEPROM transfers in us
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 BENCH_check(uint8 firstDigit,uint16 *stack)
+{
+	uint32 cycles;
+	uint16 reads;
+	uint16 writes;
+
+	g_benchLink[0] = BENCH_PIN_SIZE;
+	for(uint8 i = 0 ; i < BENCH_PIN_SIZE ; i++)
+	{
+		g_benchLink[1 + i] = (firstDigit + i) % 10;
+	}
+	g_benchLinkHead = 0;
+
+	g_eepromRamReads = 0;
+	g_eepromRamWrites = 0;
+	BENCH_start();
+	APP_checkPassword();
+	cycles = BENCH_stop();
+	*stack = BENCH_getStackUsed();
+	reads = g_eepromRamReads;
+	writes = g_eepromRamWrites;
+
+	BENCH_report((firstDigit == 1) ? "check_matched_cycles=" : "check_wrong_cycles=", cycles);
+	BENCH_report((firstDigit == 1) ? "check_matched_page_reads=" : "check_wrong_page_reads=", reads);
+	BENCH_report((firstDigit == 1) ? "check_matched_page_writes=" : "check_wrong_page_writes=", writes);
+	return (cycles / BENCH_CYCLES_PER_US) + (reads * EEPROM_RAM_PAGE_READ_US) + (writes * EEPROM_RAM_PAGE_WRITE_US);
+}
+
+/*******************************************************************************
+* Function Name:		__wrap_UART_receiveByte
+* Description:			Function to get the next byte MCU1 sends, 0 once it sent them all
+* Parameters (in):    	None
+* Parameters (out):   	Byte
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 __wrap_UART_receiveByte(void)
+{
+	return (g_benchLinkHead < BENCH_LINK_SIZE) ? g_benchLink[g_benchLinkHead++] : 0;
+}
+
+/*******************************************************************************
+* Function Name:		__wrap_UART_sendByte
+* Description:			Function to count a byte sent to MCU1
+* Parameters (in):    	Byte
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void __wrap_UART_sendByte(const uint8 data)
+{
+	(void)data;
+	g_benchAnswers++;
+}
+
+/*******************************************************************************
+* Function Name:		BUZZER_play
+* Description:			Stub of the buzzer, a pattern is only counted
+* Parameters (in):    	Pattern
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BUZZER_play(Buzzer_PatternType pattern)
+{
+	(void)pattern;
+	g_benchBeeps++;
+}
+
+/*******************************************************************************
+* Function Name:		BUZZER_repeat
+* Description:			Stub of the buzzer, a pattern is only counted
+* Parameters (in):    	Pattern and ticks
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BUZZER_repeat(Buzzer_PatternType pattern,uint16 ticks)
+{
+	(void)pattern;
+	(void)ticks;
+	g_benchBeeps++;
+}
+
+/*******************************************************************************
+* Function Name:		BUZZER_tick
+* Description:			Stub of the buzzer, nothing is playing
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BUZZER_tick(void)
+{
+}
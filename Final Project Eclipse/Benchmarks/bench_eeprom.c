@@ -0,0 +1,118 @@
+/******************************************************************************
+*  File name:		bench_eeprom.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Time of EEPROM_readByte and of a page read with EEPROM_readBlock on MCU2, with
+ * the real TWI driver at the bus rate of MCU2. simavr has no 24Cxx on the bus so
+ * the status of the driver is wrapped (-Wl,--wrap=TWI_getStatus) : the NACKs of
+ * the missing chip are taken as its ACKs and every transfer goes to the end at
+ * the speed of the bus. Timeouts and bus errors still fail the benchmark.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "bench.h"
+#include "../Final_Project_MCU2/HAL/EXT_EEPORM/eeprom.h"
+#include "../Final_Project_MCU2/MCAL/TWI/twi.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define BENCH_READ_BYTE_BUDGET_US	10500UL		/* the driver waits 10 ms before every byte */
+#define BENCH_READ_PAGE_BUDGET_US	1500UL
+#define BENCH_ADDRESS				0x7F0		/* last page, every block bit is in the SLA */
+
+/* status of a transfer where the slave didn't answer */
+#define BENCH_MT_SLA_W_NACK			0x20
+#define BENCH_MT_DATA_NACK			0x30
+#define BENCH_MR_SLA_R_NACK			0x48
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+TWI_ConfigType TWI_Configuration = {1,400}; /* same as MCU2 */
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+uint8 __real_TWI_getStatus(void);
+uint8 __wrap_TWI_getStatus(void);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(void)
+{
+	uint8 page[EEPROM_PAGE_SIZE];
+	uint8 status;
+	uint32 byteCycles;
+	uint16 byteStack;
+	uint32 pageCycles;
+	uint16 pageStack;
+	boolean pass = TRUE;
+
+	BENCH_init();
+	TWI_init(&TWI_Configuration);
+
+	BENCH_start();
+	status = EEPROM_readByte(BENCH_ADDRESS, page);
+	byteCycles = BENCH_stop();
+	byteStack = BENCH_getStackUsed();
+	pass = pass && (status == SUCCESS);
+
+	BENCH_start();
+	status = EEPROM_readBlock(BENCH_ADDRESS, page, EEPROM_PAGE_SIZE);
+	pageCycles = BENCH_stop();
+	pageStack = BENCH_getStackUsed();
+	pass = pass && (status == SUCCESS);
+
+	BENCH_report("read_byte_cycles=", byteCycles);
+	BENCH_report("read_byte_stack=", byteStack);
+	BENCH_report("read_byte_us=", byteCycles / BENCH_CYCLES_PER_US);
+	BENCH_report("read_page_cycles=", pageCycles);
+	BENCH_report("read_page_stack=", pageStack);
+	BENCH_report("read_page_us=", pageCycles / BENCH_CYCLES_PER_US);
+	BENCH_report("read_byte_budget_us=", BENCH_READ_BYTE_BUDGET_US);
+	BENCH_report("read_page_budget_us=", BENCH_READ_PAGE_BUDGET_US);
+	pass = pass && ((byteCycles / BENCH_CYCLES_PER_US) <= BENCH_READ_BYTE_BUDGET_US)
+			&& ((pageCycles / BENCH_CYCLES_PER_US) <= BENCH_READ_PAGE_BUDGET_US);
+	BENCH_end(pass);
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		__wrap_TWI_getStatus
+* Description:			Function to get the status of the bus as if a 24Cxx answered
+* Parameters (in):    	None
+* Parameters (out):   	Status of the last operation
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 __wrap_TWI_getStatus(void)
+{
+	uint8 status = __real_TWI_getStatus();
+
+	switch(status)
+	{
+	case BENCH_MT_SLA_W_NACK:
+		return TWI_MT_SLA_W_ACK;
+	case BENCH_MT_DATA_NACK:
+		return TWI_MT_DATA_ACK;
+	case BENCH_MR_SLA_R_NACK:
+		return TWI_MT_SLA_R_ACK;
+	default:
+		return status;
+	}
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+*  File name:		bench_keypad.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Time of KEYPAD_getPressedKey on MCU1 for every button of the keypad, the last
+ * row and column take the longest as every row before them is scanned first.
+ * Nothing is wired to the pins in simavr so the keypad reads its columns with
+ * BENCH_readColumn (-D'KEYPAD_READ_COL(col)=BENCH_readColumn(col)') : the real read
+ * is done then the column of the held button reads pressed while its row is
+ * driven, every other one released. The call costs a few cycles more than the
+ * read of the pin on the lock.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "bench.h"
+#include "../Final_Project_MCU1/HAL/KEYPAD/keypad.h"
+#include "../Final_Project_MCU1/MCAL/GPIO/gpio.h"
+#include "../Final_Project_MCU1/LIB/common_macros.h"
+#include <avr/io.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define BENCH_BUDGET_US			500UL		/* a scan must stay far below the key repeat delay */
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static uint8 g_benchKeyRow;
+static uint8 g_benchKeyCol;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+uint8 BENCH_readColumn(uint8 col);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(void)
+{
+	uint32 cycles;
+	uint32 maxCycles = 0;
+	uint16 maxStack = 0;
+	uint32 worstUs;
+
+	BENCH_init();
+	KEYPAD_init();
+
+	for(g_benchKeyRow = 0 ; g_benchKeyRow < KEYPAD_NUM_ROWS ; g_benchKeyRow++)
+	{
+		for(g_benchKeyCol = 0 ; g_benchKeyCol < KEYPAD_NUM_COLS ; g_benchKeyCol++)
+		{
+			BENCH_start();
+			KEYPAD_getPressedKey();
+			cycles = BENCH_stop();
+			if(cycles > maxCycles)
+				maxCycles = cycles;
+			if(BENCH_getStackUsed() > maxStack)
+				maxStack = BENCH_getStackUsed();
+		}
+	}
+
+	worstUs = maxCycles / BENCH_CYCLES_PER_US;
+	BENCH_report("get_key_cycles=", maxCycles);
+	BENCH_report("get_key_stack=", maxStack);
+	BENCH_report("get_key_us=", worstUs);
+	BENCH_report("budget_us=", BENCH_BUDGET_US);
+	BENCH_end(worstUs <= BENCH_BUDGET_US);
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		BENCH_readColumn
+* Description:			Function to read a column as if the button of the benchmark was held
+* Parameters (in):    	Column of the keypad
+* Parameters (out):   	Level of the pin
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 BENCH_readColumn(uint8 col)
+{
+	(void)GET_BIT(KEYPAD_COL_PIN_REG, (KEYPAD_COL_PIN_ID + col)); /* same time as a read of the real pin */
+
+	if( (col == g_benchKeyCol) && BIT_IS_SET(KEYPAD_ROW_DDR_REG, (KEYPAD_ROW_PIN_ID + g_benchKeyRow)) )
+	{
+		return KEYPAD_BUTTON_PRESSED;
+	}
+	return KEYPAD_BUTTON_RELEASED;
+}
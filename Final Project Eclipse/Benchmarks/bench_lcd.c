@@ -0,0 +1,58 @@
+/******************************************************************************
+*  File name:		bench_lcd.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Time of LCD_displayCharacter on MCU1, for a whole screen of characters. The
+ * driver waits a fixed time for every edge instead of reading the busy flag so
+ * nearly all of it is _delay_ms, the budget catches a change of these waits.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "bench.h"
+#include "../Final_Project_MCU1/HAL/LCD/lcd.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define BENCH_BUDGET_US			4500UL		/* 4 waits of 1 ms, each with its count worked out in float at -O0, and the GPIO writes */
+#define BENCH_NUM_CHARACTERS	32			/* the two lines of the display */
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(void)
+{
+	uint32 cycles;
+	uint32 maxCycles = 0;
+	uint16 maxStack = 0;
+	uint32 worstUs;
+
+	BENCH_init();
+	LCD_init();
+
+	for(uint8 i = 0 ; i < BENCH_NUM_CHARACTERS ; i++)
+	{
+		BENCH_start();
+		LCD_displayCharacter('0' + (i % 10));
+		cycles = BENCH_stop();
+		if(cycles > maxCycles)
+			maxCycles = cycles;
+		if(BENCH_getStackUsed() > maxStack)
+			maxStack = BENCH_getStackUsed();
+	}
+
+	worstUs = maxCycles / BENCH_CYCLES_PER_US;
+	BENCH_report("display_character_cycles=", maxCycles);
+	BENCH_report("display_character_stack=", maxStack);
+	BENCH_report("display_character_us=", worstUs);
+	BENCH_report("budget_us=", BENCH_BUDGET_US);
+	BENCH_end(worstUs <= BENCH_BUDGET_US);
+}
@@ -0,0 +1,112 @@
+/******************************************************************************
+*  File name:		bench_verify.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Worst case time of a password check on MCU2 at 8 MHz : the main password is
+ * checked first then the users table with a full table so the probe chains are as
+ * long as they can be. The time of the EEPROM page reads is added to the CPU cycles
+ * for the slowest bus rate and the run fails if any check goes over the budget.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "bench.h"
+#include "eeprom_ram.h"
+#include "../Final_Project_MCU2/HAL/EXT_EEPORM/credential.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define BENCH_BUDGET_US			20000UL		/* a password check must never take longer */
+#define BENCH_PIN_SIZE			CREDENTIAL_MAX_PIN_SIZE	/* the longest PIN takes the longest to hash */
+#define BENCH_NUM_PINS			300			/* more than the table can hold so it ends full */
+#define BENCH_ROLE				0x02		/* ROLE_USER of the application */
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void BENCH_getPin(uint16 number,uint8 *pin);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(void)
+{
+	Credential_SecretType mainPassword;
+	uint8 pin[BENCH_PIN_SIZE];
+	uint8 slot;
+	uint8 role;
+	uint32 cycles;
+	uint32 maxCycles = 0;
+	uint16 maxReads = 0;
+	uint16 maxStack = 0;
+	uint32 worstUs;
+
+	BENCH_init();
+
+	EEPROM_RAM_erase();
+	CREDENTIAL_init();
+	BENCH_getPin(BENCH_NUM_PINS, pin);
+	CREDENTIAL_hash(pin, BENCH_PIN_SIZE, &mainPassword);
+	for(uint16 i = 0 ; i < BENCH_NUM_PINS ; i++)
+	{
+		BENCH_getPin(i, pin);
+		CREDENTIAL_add(pin, BENCH_PIN_SIZE, BENCH_ROLE, CREDENTIAL_USES_UNLIMITED, &slot);
+	}
+
+	/* the users found in the table and the unknown PINs, the main password never matches */
+	for(uint16 i = 0 ; i < BENCH_NUM_PINS ; i++)
+	{
+		BENCH_getPin(i, pin);
+		g_eepromRamReads = 0;
+		BENCH_start();
+		if(CREDENTIAL_match(pin, BENCH_PIN_SIZE, &mainPassword) == FALSE)
+		{
+			CREDENTIAL_verify(pin, BENCH_PIN_SIZE, &slot, &role);
+		}
+		cycles = BENCH_stop();
+		if(cycles > maxCycles)
+			maxCycles = cycles;
+		if(g_eepromRamReads > maxReads)
+			maxReads = g_eepromRamReads;
+		if(BENCH_getStackUsed() > maxStack)
+			maxStack = BENCH_getStackUsed();
+	}
+
+	worstUs = (maxCycles / BENCH_CYCLES_PER_US) + (maxReads * EEPROM_RAM_PAGE_READ_US);
+	BENCH_report("verify_cycles=", maxCycles);
+	BENCH_report("verify_page_reads=", maxReads);
+	BENCH_report("verify_stack=", maxStack);
+	BENCH_report("verify_us=", worstUs);
+	BENCH_report("budget_us=", BENCH_BUDGET_US);
+	BENCH_end(worstUs <= BENCH_BUDGET_US);
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		BENCH_getPin
+* Description:			Function to get the digits of a test PIN from its number
+* Parameters (in):    	Number of the PIN and array of BENCH_PIN_SIZE bytes
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BENCH_getPin(uint16 number,uint8 *pin)
+{
+	for(uint8 i = 0 ; i < BENCH_PIN_SIZE ; i++)
+	{
+		pin[i] = number % 10;
+		number /= 10;
+	}
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+*  File name:		eeprom_ram.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * RAM copy of a window of the external EEPROM for the benchmarks, it replaces the
+ * TWI driver so only the CPU time is measured. The number of bus transfers is counted and the bus
+ * time is added by the benchmark itself.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "eeprom_ram.h"
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+uint8 g_eepromRam[EEPROM_RAM_SIZE];
+uint16 g_eepromRamReads = 0;
+uint16 g_eepromRamWrites = 0;
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void EEPROM_RAM_erase(void)
+{
+	for(uint16 i = 0 ; i < EEPROM_RAM_SIZE ; i++)
+	{
+		g_eepromRam[i] = 0xFF;
+	}
+	g_eepromRamReads = 0;
+	g_eepromRamWrites = 0;
+}
+
+uint8 EEPROM_readBlock(uint16 address,uint8 *data,uint16 length)
+{
+	if((address + length) > EEPROM_SIZE)
+		return ERROR;
+
+	for(uint16 i = 0 ; i < length ; i++)
+	{
+		uint16 cell = address + i;
+		/* outside the window the chip reads as blank */
+		data[i] = ( (cell >= EEPROM_RAM_START) && (cell < (EEPROM_RAM_START + EEPROM_RAM_SIZE)) ) ?
+				g_eepromRam[cell - EEPROM_RAM_START] : 0xFF;
+	}
+	g_eepromRamReads++;
+	return SUCCESS;
+}
+
+uint8 EEPROM_readByte(uint16 address,uint8 *value)
+{
+	return EEPROM_readBlock(address, value, 1);
+}
+
+uint8 EEPROM_writeByte(uint16 address,uint8 byte)
+{
+	return EEPROM_writePage(address, &byte, 1);
+}
+
+uint8 EEPROM_writePage(uint16 address,const uint8 *data,uint8 length)
+{
+	if( (length == 0) || ((address % EEPROM_PAGE_SIZE) + length > EEPROM_PAGE_SIZE)
+			|| (address < EEPROM_RAM_START) || ((address + length) > (EEPROM_RAM_START + EEPROM_RAM_SIZE)) )
+		return ERROR;
+
+	for(uint8 i = 0 ; i < length ; i++)
+	{
+		g_eepromRam[address - EEPROM_RAM_START + i] = data[i];
+	}
+	g_eepromRamWrites++;
+	return SUCCESS;
+}
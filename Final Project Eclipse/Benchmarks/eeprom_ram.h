@@ -0,0 +1,69 @@
+/******************************************************************************
+*  File name:		eeprom_ram.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef EEPROM_RAM_H_
+#define EEPROM_RAM_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "../Final_Project_MCU2/HAL/EXT_EEPORM/eeprom.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * The chip is as big as the whole SRAM so only a window of it is kept in RAM,
+ * every benchmark sets the window over the region it uses. The rest reads as a
+ * blank chip and can't be written.
+ */
+#ifndef EEPROM_RAM_START
+#define EEPROM_RAM_START	0x400
+#endif
+
+#ifndef EEPROM_RAM_SIZE
+#define EEPROM_RAM_SIZE		0x400
+#endif
+
+#if ((EEPROM_RAM_START % EEPROM_PAGE_SIZE) != 0) || ((EEPROM_RAM_START + EEPROM_RAM_SIZE) > EEPROM_SIZE)
+
+#error "The RAM window must start at a page boundary and be inside the EEPROM"
+
+#endif
+
+/* bus time of the transfers at the slowest bus rate, the real driver waits for it so it adds to the CPU time */
+#define EEPROM_RAM_BIT_RATE			100000UL
+/* START, SLA+W, word address, repeated START, SLA+R, one page and STOP */
+#define EEPROM_RAM_PAGE_READ_BITS	((3UL + EEPROM_PAGE_SIZE) * 9 + 3)
+#define EEPROM_RAM_PAGE_READ_US		((EEPROM_RAM_PAGE_READ_BITS * 1000000UL) / EEPROM_RAM_BIT_RATE)
+/* the chip doesn't answer during its internal write cycle */
+#define EEPROM_RAM_PAGE_WRITE_US	5000UL
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+extern uint8 g_eepromRam[EEPROM_RAM_SIZE];
+extern uint16 g_eepromRamReads;
+extern uint16 g_eepromRamWrites;
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		EEPROM_RAM_erase
+* Description:			Function to fill the RAM EEPROM with 0xFF and clear the counters
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void EEPROM_RAM_erase(void);
+
+#endif /* EEPROM_RAM_H_ */
@@ -12,14 +12,14 @@
 /*******************************************************************************
 *                           Global Variables                                  *
 *******************************************************************************/
-uint8 Password[PASSWORD_SIZE]; /* Variable to store the password first time and send it to MCU2 */
-uint8 Password2[PASSWORD_SIZE]; /* Variable to store the password and send it to MCU2 to get checked */
+uint8 Password[PASSWORD_MAX_SIZE]; /* Variable to store the password first time and send it to MCU2 */
+uint8 Password2[PASSWORD_MAX_SIZE]; /* Variable to store the password and send it to MCU2 to get checked */
+uint8 PasswordLength; /* Number of digits in Password[] */
+uint8 Password2Length; /* Number of digits in Password2[] */
 uint8 PasswordMatchFlag; /* Flag to indicate if the two passwords match or not */
-uint8 Lives = ALLOWED_TRIES; /* Number of tries u get to try to insert the right password */
-uint8 g_ticks = 0; /* Variable to store number of seconds we get from the timer */
-uint8 g_exitMotorFlag = 0; /* Flag to exit APP_dooPorcessing Function */
-uint8 g_MotorUnlocking = 0; /* To decide to unlock or lock the door in the ISR*/
-uint8 g_exitAlarmFlag = 0; /* Flag to exit ERROR state in case 3 password wrong in row */
+uint8 UserRole; /* Role of the last user who entered a right password (ROLE_ADMIN or ROLE_USER) */
+uint16 LockoutSeconds = 0; /* Remaining lockout time sent by MCU2, no password can be checked until it ends */
+volatile uint8 g_secondFlag = 0; /* Flag set by the timer every second of the lockout countdown, volatile as it is polled */
 
 Timer1_ConfigType TIMER1_Configuration = {0,TIMER1_OCR1A,TIMER1_FCPU_1024,COMPARE};
 
@@ -27,6 +27,106 @@ Timer1_ConfigType TIMER1_Configuration = {0,TIMER1_OCR1A,TIMER1_FCPU_1024,COMPAR
 *                      		Functions Definitions	             	           *
 *******************************************************************************/
 
+/*******************************************************************************
+* Function Name:		APP_enterPassword
+* Description:			Function to get a password of PASSWORD_MIN_SIZE to PASSWORD_MAX_SIZE digits
+* 						from the keypad, the password ends with the Enter key
+* Parameters (in):    	Array of PASSWORD_MAX_SIZE to store the password in
+* Parameters (out):   	Number of digits
+* Return value:      	uint8
+********************************************************************************/
+uint8 APP_enterPassword(uint8 *password)
+{
+	uint8 length = 0;
+	uint8 key;
+	do
+	{
+		key = KEYPAD_getPressedKey();
+		if(key <= 9 && key >= 0 && length < PASSWORD_MAX_SIZE) /* other keys and extra digits are not counted */
+		{
+			password[length] = key;
+			length++;
+			LCD_displayCharacter('*');
+		}
+		_delay_ms(KEYPAD_BUTTON_DELAY); /* wait for a certain delay before getting another input */
+	}while( (key != ENTER_KEY) || (length < PASSWORD_MIN_SIZE) ); /* wait tell the user press Enter key after enough digits */
+	return length;
+}
+
+/*******************************************************************************
+* Function Name:		APP_sendPassword
+* Description:			Function to send a password to MCU2, its length then its digits
+* Parameters (in):    	The password and its length, TRUE to wait for MC_Ready after every byte
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_sendPassword(const uint8 *password,uint8 length,boolean acknowledge)
+{
+	UART_sendByte(length);
+	if(acknowledge)
+	{
+		while(UART_receiveByte() != MC_Ready);
+	}
+	for(uint8 k = 0 ; k < length ; k++)
+	{
+		UART_sendByte(password[k]);
+		if(acknowledge)
+		{
+			while(UART_receiveByte() != MC_Ready);
+		}
+	}
+}
+
+/*******************************************************************************
+* Function Name:		APP_isSamePassword
+* Description:			Function to check if the user entered the same password in Password[] and Password2[]
+* Parameters (in):    	None
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+boolean APP_isSamePassword()
+{
+	if(PasswordLength != Password2Length)
+	{
+		return FALSE;
+	}
+	for(uint8 j = 0 ; j < PasswordLength ; j++)
+	{
+		if(Password[j] != Password2[j])
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		APP_enterNumber
+* Description:			Function to get a number of up to NUMBER_MAX_DIGITS digits from the keypad
+* 						and display it, the number ends with the Enter key
+* Parameters (in):    	None
+* Parameters (out):   	The number
+* Return value:      	uint16
+********************************************************************************/
+uint16 APP_enterNumber()
+{
+	uint16 number = 0;
+	uint8 digits = 0;
+	uint8 key;
+	do
+	{
+		key = KEYPAD_getPressedKey();
+		if(key <= 9 && key >= 0 && digits < NUMBER_MAX_DIGITS)
+		{
+			number = (number * 10) + key;
+			digits++;
+			LCD_displayCharacter('0' + key);
+		}
+		_delay_ms(KEYPAD_BUTTON_DELAY);
+	}while( (key != ENTER_KEY) || (digits == 0) );
+	return number;
+}
+
 /*******************************************************************************
 * Function Name:		APP_setPassword
 * Description:			Function to set the password in case no one set it before
@@ -36,6 +136,8 @@ Timer1_ConfigType TIMER1_Configuration = {0,TIMER1_OCR1A,TIMER1_FCPU_1024,COMPAR
 ********************************************************************************/
 void APP_setPassword()
 {
+	uint8 reply;
+	uint8 failures = 0;
 	LCD_clearScreen();
 	LCD_displayString("Set New Password");
 	_delay_ms(1000);
@@ -43,63 +145,45 @@ void APP_setPassword()
 	UART_sendByte(MSG_UpdatePassword); /* Inform MCU2 that it will receive new password to set it in the eeprom */
 	do
 	{
-		PasswordMatchFlag = TRUE ;
 		LCD_displayStringRowColumn(0, 0, "Plz Enter Pass");
 		LCD_moveCursor(1, 0);
-		for(uint8 i = 0 ; i < PASSWORD_SIZE ; i++) /* get the password from the user and save it into Password[] array */
-		{
-			uint8 key = KEYPAD_getPressedKey();
-			if(key <= 9 && key >= 0)
-			{
-				Password[i] = key;
-				LCD_displayCharacter('*');
-			}
-			else /* in case the user pressed a key that is not allowed */
-			{
-				i--; /* don't count this key and go back again */
-			}
-			_delay_ms(KEYPAD_BUTTON_DELAY); /* wait for a certain delay before getting another input */
-		}
-		while(KEYPAD_getPressedKey() != ENTER_KEY){} /* wait tell the user press Enter key on the keypad */
+		PasswordLength = APP_enterPassword(Password); /* get the password from the user and save it into Password[] array */
 
 
 		LCD_clearScreen();
-		LCD_displayStringRowColumn(0,0,"Plz Re-Enter the");
-		LCD_displayStringRowColumn(1, 0, "Same Pass: ");
-		for(uint8 i = 0 ; i < PASSWORD_SIZE ; i++) /* get the password again from the user and save it into Password2[] array */
-		{
-			uint8 key = KEYPAD_getPressedKey();
-			if(key <= 9 && key >= 0)
-			{
-				Password2[i] = key;
-				LCD_displayCharacter('*');
-			}
-			else
-			{
-				i--;
-			}
-			_delay_ms(KEYPAD_BUTTON_DELAY);
-		}
-		while(KEYPAD_getPressedKey() != ENTER_KEY){}
+		LCD_displayStringRowColumn(0,0,"Re-Enter Pass");
+		LCD_moveCursor(1, 0);
+		Password2Length = APP_enterPassword(Password2); /* get the password again from the user and save it into Password2[] array */
 
 
-		for(uint8 j = 0 ; j < PASSWORD_SIZE	; j++) /* Compare between the two passwords to see if they match or not */
-		{
-			if(Password[j] != Password2[j])
-			{
-				PasswordMatchFlag = 0;
-				break;
-			}
-		}
+		PasswordMatchFlag = APP_isSamePassword(); /* Compare between the two passwords to see if they match or not */
 		LCD_clearScreen();
 		if(PasswordMatchFlag == TRUE) /* if they match then change the password */
 		{
-			LCD_displayStringRowColumn(0, 4, "Matched");
-			LCD_displayStringRowColumn(1, 0, "Password Updated");
-			for(uint8 k = 0 ; k < PASSWORD_SIZE ; k++)
+			/* as MCU2 already on MSG_UpdatePassword state and it is waiting for the new password to be sent */
+			APP_sendPassword(Password, PasswordLength, FALSE);
+			reply = UART_receiveByte();
+			if(reply == MSG_Committed) /* MCU2 saved the new password and verified it */
 			{
-				UART_sendByte(Password[k]); /* as MCU2 already on MSG_UpdatePassword state and it is waiting for the new password to be sent */
-				_delay_ms(50);
+				LCD_displayStringRowColumn(0, 4, "Matched");
+				LCD_displayStringRowColumn(1, 0, "Password Updated");
+			}
+			else if(reply == MSG_Refused) /* MCU2 wants the admin password first, it went back to its commands */
+			{
+				LCD_displayStringRowColumn(0, 2, "Not Allowed");
+				_delay_ms(1000);
+				LCD_clearScreen();
+				return;
+			}
+			else /* the old password is still the active one, MCU2 is waiting for the password again */
+			{
+				PasswordMatchFlag = FALSE;
+				LCD_displayStringRowColumn(0, 0, "Saving Failed");
+				if(++failures == PASSWORD_COMMIT_TRIES) /* MCU2 went back to its commands, ask it again */
+				{
+					failures = 0;
+					UART_sendByte(MSG_UpdatePassword);
+				}
 			}
 		}
 		else /* if they are not display UnMatched on the LCD */
@@ -114,65 +198,114 @@ void APP_setPassword()
 
 /*******************************************************************************
 * Function Name:		APP_comparePassWithEEPROM
-* Description:			Function to get input password from user and compare it with the one saved in EEPORM
+* Description:			Function to get input password from user and compare it with the one saved in EEPORM,
+* 						MCU2 counts the wrong passwords and locks the checks after too many of them
 * Parameters (in):    	None
-* Parameters (out):   	MSG_Matched or MSG_UnMatched
+* Parameters (out):   	MSG_Matched, MSG_UnMatched if this password started a lockout or MSG_LockedOut
+* 						if a lockout was already running, LockoutSeconds holds its remaining time
 * Return value:      	uint8
 ********************************************************************************/
 uint8 APP_comparePassWithEEPROM()
 {
-	Lives = ALLOWED_TRIES; /* Number of Tries Allowed */
-	do
+	uint8 reply;
+	UART_sendByte(MSG_LockoutStatus); /* no need to ask for the password if MCU2 won't check it */
+	LockoutSeconds = APP_receiveLockout();
+	if(LockoutSeconds != 0)
+	{
+		return MSG_LockedOut;
+	}
+	while(1) /* until the password is right or MCU2 locks the checks */
 	{
 		PasswordMatchFlag = TRUE;
 		LCD_clearScreen();
-		LCD_displayStringRowColumn(0, 0, "Plz Enter old");
-		LCD_displayStringRowColumn(1, 0, "Password: ");
-		for(uint8 i = 0 ; i < PASSWORD_SIZE ; i++) /* Getting the password from the user */
-		{
-			uint8 key = KEYPAD_getPressedKey();
-			if(key <= 9 && key >= 0)
-			{
-				Password2[i] = key;
-				LCD_displayCharacter('*');
-			}
-			else /* in case the user pressed a key that is not allowed */
-			{
-				i--; /* don't count this key and go back again */
-			}
-			_delay_ms(KEYPAD_BUTTON_DELAY); /* wait for certain time before pressing another button */
-		}
-		while(KEYPAD_getPressedKey() != ENTER_KEY){} /* wait the user to hit enter "ON/C" */
+		LCD_displayStringRowColumn(0, 0, "Plz Enter Pass:");
+		LCD_moveCursor(1, 0);
+		Password2Length = APP_enterPassword(Password2); /* Getting the password from the user */
 
 		UART_sendByte(MSG_checkPassword);  /* Telling MCU2 that MCU1 want to check if the password match the one in the EEPROM */
-
-		for(uint8 j = 0 ; j < PASSWORD_SIZE	; j++) /* send the claimed password */
-		{
-			UART_sendByte(Password2[j]);
-			while(UART_receiveByte() != MC_Ready);
-		}
+		APP_sendPassword(Password2, Password2Length, TRUE); /* send the claimed password */
 		LCD_clearScreen();
-		if(UART_receiveByte() == MSG_Matched) /* in case they are match print Matched on LCD and return MSG_Matched */
+		reply = UART_receiveByte();
+		if(reply == MSG_Matched) /* in case they are match print Matched on LCD and return MSG_Matched */
 		{
+			UserRole = UART_receiveByte(); /* MCU2 tells us if it is an admin or a normal user */
 			LCD_displayStringRowColumn(0, 4, "Matched");
 			_delay_ms(1000);
 			return MSG_Matched; /* to exit the whole function */
 		}
-		else /* in case they are not matched, decrease number of tries and try again if tries > 0 */
+		else if(reply == MSG_LockedOut) /* too many wrong passwords, MCU2 started a lockout */
+		{
+			LockoutSeconds = APP_receiveLockout();
+			return MSG_UnMatched;
+		}
+		else /* in case they are not matched, MCU2 tells how many tries are left before the lockout */
 		{
-			Lives--; /* decrease number of tries by 1 if the user missed */
 			LCD_displayStringRowColumn(0, 3, "UnMatched");
 			LCD_displayStringRowColumn(1, 0, "Tries left = ");
-			LCD_intgerToString(Lives);
+			LCD_intgerToString(UART_receiveByte());
 			_delay_ms(1000);
 		}
-	}while((Lives > 0)); /* wait until the user uses all number of tries available */
-	return MSG_UnMatched; /* in case the user used all his tries and didn't get the password right at any one of them */
+	}
+}
+
+/*******************************************************************************
+* Function Name:		APP_receiveLockout
+* Description:			Function to receive the remaining lockout time from MCU2
+* Parameters (in):    	None
+* Parameters (out):   	Number of seconds
+* Return value:      	uint16
+********************************************************************************/
+uint16 APP_receiveLockout()
+{
+	uint16 seconds = UART_receiveByte(); /* little endian */
+	seconds |= (uint16)UART_receiveByte() << 8;
+	return seconds;
+}
+
+/*******************************************************************************
+* Function Name:		APP_displayTime
+* Description:			Function to display a number of seconds as mm:ss at the cursor
+* Parameters (in):    	Number of seconds
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_displayTime(uint16 seconds)
+{
+	uint16 minutes = seconds / 60;
+	seconds %= 60;
+	LCD_displayCharacter('0' + (minutes / 10) % 10);
+	LCD_displayCharacter('0' + (minutes % 10));
+	LCD_displayCharacter(':');
+	LCD_displayCharacter('0' + (seconds / 10));
+	LCD_displayCharacter('0' + (seconds % 10));
+}
+
+/*******************************************************************************
+* Function Name:		APP_lockedOut
+* Description:			Function to show the countdown of the lockout on the second row until it ends
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_lockedOut()
+{
+	g_secondFlag = 0;
+	TIMER1_init(&TIMER1_Configuration); /* one interrupt every second */
+	TIMER1_COMP_setCallBack(TIMER1_ALARM_ISR);
+	while(LockoutSeconds != 0)
+	{
+		LCD_displayStringRowColumn(1, 3, "Wait ");
+		APP_displayTime(LockoutSeconds);
+		while(g_secondFlag == 0){} /* wait for the next second */
+		g_secondFlag = 0;
+		LockoutSeconds--;
+	}
+	TIMER1_deInit(); /* stop the timer */
 }
 
 /*******************************************************************************
 * Function Name:		APP_alarm
-* Description:			Function to turn on alarm and enter ERROR state for 60 seconds
+* Description:			Function to turn on alarm and enter ERROR state until the lockout ends
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
@@ -182,11 +315,7 @@ void APP_alarm()
 	LCD_clearScreen();
 	LCD_displayStringRowColumn(0, 3, "ERROR !!!");
 	UART_sendByte(MSG_TurnOnAlarm); /* Telling MCU2 to turn on the buzzer */
-	g_ticks = 0;
-	g_exitAlarmFlag = 0;
-	TIMER1_init(&TIMER1_Configuration); /* setting the time to display ERROR message on LCD for 60 seconds */
-	TIMER1_COMP_setCallBack(TIMER1_ALARM_ISR);
-	while(g_exitAlarmFlag == 0){} /* wait until the timer count the required time and handle different cases then exit */
+	APP_lockedOut(); /* the ERROR message stays on LCD for the whole lockout */
 }
 
 /*******************************************************************************
@@ -201,13 +330,26 @@ void APP_changePassword()
 	uint8 PasswordsCompare = APP_comparePassWithEEPROM() ;
 	if(PasswordsCompare == MSG_Matched)
 	{
-		APP_setPassword(); /* set the new password */
+		if(UserRole == ROLE_ADMIN)
+		{
+			APP_setPassword(); /* set the new password */
+		}
+		else /* normal users can only open the door */
+		{
+			LCD_clearScreen();
+			LCD_displayStringRowColumn(0, 2, "Not Allowed");
+			_delay_ms(1000);
+		}
 	}
 	if(PasswordsCompare == MSG_UnMatched) /* if the user used didn't get the password right in all of his tries */
 	{
 		APP_alarm(); /* Turn on the alarm */
 	}
-
+	if(PasswordsCompare == MSG_LockedOut) /* a lockout is still running, even after a reset */
+	{
+		LCD_displayStringRowColumn(0, 2, "Locked Out");
+		APP_lockedOut();
+	}
 }
 
 /*******************************************************************************
@@ -222,94 +364,259 @@ void APP_door()
 	uint8 PasswordsCompare = APP_comparePassWithEEPROM() ;
 	if(PasswordsCompare == MSG_Matched)
 	{
-		UART_sendByte(MSG_Motor);
-		g_ticks = 0;
-		TIMER1_COMP_setCallBack(TIMER1_MOTOR_15SEC_ISR); /* unlock the door takes 15 seconds */
-		TIMER1_init(&TIMER1_Configuration);
 		LCD_displayStringRowColumn(0, 3, "Unlocking");
 		LCD_displayStringRowColumn(1, 3, "The Door");
-		g_exitMotorFlag = 0;
-		while(g_exitMotorFlag == 0){} /* wait until the timer count the required time and handle different cases then exit */
+		/* a bolt left open by a power loss answers right away, the LCD is written before so
+		 * the answer can't overrun the UART */
+		UART_sendByte(MSG_Motor);
+		APP_waitDoor(); /* MCU2 stops the motor as soon as the bolt gets there */
+		LCD_clearScreen();
+		LCD_displayStringRowColumn(0, 0, "Door Is Locked");
+		_delay_ms(DOOR_OPEN_TIME);
+		LCD_clearScreen();
+		LCD_displayStringRowColumn(0, 3, "Locking");
+		LCD_displayStringRowColumn(1, 3, "The Door");
+		/* MCU2 waits for the LCD to be written before it turns the motor on */
+		UART_sendByte(MC_Ready);
+		APP_waitDoor();
 	}
 	if(PasswordsCompare == MSG_UnMatched) /* if the user used didn't get the password right in all of his tries */
 	{
 		APP_alarm(); /* Turn on the alarm */
 	}
+	if(PasswordsCompare == MSG_LockedOut) /* a lockout is still running, even after a reset */
+	{
+		LCD_displayStringRowColumn(0, 2, "Locked Out");
+		APP_lockedOut();
+	}
 }
 
 /*******************************************************************************
-*                      		INTERRUPT SERVICE ROUTINE	           	           *
-*******************************************************************************/
+* Function Name:		APP_waitDoor
+* Description:			Function to wait for the end of a move of the door and show if it jammed
+* Parameters (in):    	None
+* Parameters (out):   	DOOR_EndStop, DOOR_Stalled or DOOR_TimedOut
+* Return value:      	uint8
+********************************************************************************/
+uint8 APP_waitDoor()
+{
+	uint8 result;
+	while(UART_receiveByte() != MSG_DoorMoved){}
+	result = UART_receiveByte();
+	UART_receiveByte(); /* travel time in ms, only MCU2 needs it */
+	UART_receiveByte();
+	if(result == DOOR_Stalled)
+	{
+		LCD_clearScreen();
+		LCD_displayStringRowColumn(0, 2, "Door Jammed");
+		_delay_ms(1000);
+	}
+	return result;
+}
+
+/*******************************************************************************
+* Function Name:		APP_manageUsers
+* Description:			Function to check the admin password then add or remove a user
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_manageUsers()
+{
+	uint8 PasswordsCompare = APP_comparePassWithEEPROM() ;
+	if(PasswordsCompare == MSG_UnMatched) /* if the user used didn't get the password right in all of his tries */
+	{
+		APP_alarm(); /* Turn on the alarm */
+		return;
+	}
+	if(PasswordsCompare == MSG_LockedOut) /* a lockout is still running, even after a reset */
+	{
+		LCD_displayStringRowColumn(0, 2, "Locked Out");
+		APP_lockedOut();
+		return;
+	}
+	LCD_clearScreen();
+	if(UserRole != ROLE_ADMIN) /* normal users can only open the door */
+	{
+		LCD_displayStringRowColumn(0, 2, "Not Allowed");
+		_delay_ms(1000);
+		return;
+	}
+	LCD_displayStringRowColumn(0, 0, "+ : Add User");
+	LCD_displayStringRowColumn(1, 0, "- : Remove User");
+	uint8 key;
+	do{
+		key = KEYPAD_getPressedKey();
+	}while(key != '-' && key != '+'); /* wait until we get '+' or '-' */
+	_delay_ms(KEYPAD_BUTTON_DELAY);
+
+	if(key == '+')
+	{
+		APP_addUser();
+	}
+	else
+	{
+		APP_revokeUser();
+	}
+}
 
 /*******************************************************************************
-* Function Name:		TIMER1_MOTOR_15SEC_ISR
-* Description:			ISR function for the timer in case we want to count 15 seconds and lock or unlock the door
+* Function Name:		APP_addUser
+* Description:			Function to get the password, role and number of uses of a new user and send it to MCU2
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
-void TIMER1_MOTOR_15SEC_ISR(void)
+void APP_addUser()
 {
-	g_ticks++;
-	if(g_ticks == 15) /* wait until number of seconds = 15 */
+	uint8 role;
+	uint16 uses;
+	uint8 reply;
+
+	LCD_clearScreen();
+	LCD_displayStringRowColumn(0, 0, "New User Pass");
+	LCD_moveCursor(1, 0);
+	PasswordLength = APP_enterPassword(Password);
+	LCD_clearScreen();
+	LCD_displayStringRowColumn(0, 0, "Re-Enter Pass");
+	LCD_moveCursor(1, 0);
+	Password2Length = APP_enterPassword(Password2);
+	if(APP_isSamePassword() == FALSE) /* Compare between the two passwords to see if they match or not */
 	{
-		g_ticks = 0; /* clear the number of seconds so we can use it in other functions*/
 		LCD_clearScreen();
-		if(g_MotorUnlocking == 0) /* in case it is the first time to come here then we want to unlock the door */
+		LCD_displayStringRowColumn(0, 0, "UnMatched");
+		_delay_ms(1000);
+		return;
+	}
+
+	LCD_clearScreen();
+	LCD_displayStringRowColumn(0, 0, "1 : User");
+	LCD_displayStringRowColumn(1, 0, "2 : Admin");
+	do{
+		role = KEYPAD_getPressedKey();
+	}while(role != 1 && role != 2);
+	_delay_ms(KEYPAD_BUTTON_DELAY);
+	role = (role == 2) ? ROLE_ADMIN : ROLE_USER;
+
+	LCD_clearScreen();
+	LCD_displayStringRowColumn(0, 0, "Uses (0=Always)");
+	LCD_moveCursor(1, 0);
+	uses = APP_enterNumber();
+	if(uses > 254)
+	{
+		uses = 254; /* 255 means unlimited in MCU2 */
+	}
+
+	UART_sendByte(MSG_AddUser); /* Inform MCU2 that it will receive a new user */
+	UART_sendByte(role);
+	UART_sendByte((uint8)uses);
+	APP_sendPassword(Password, PasswordLength, FALSE);
+
+	LCD_clearScreen();
+	reply = UART_receiveByte();
+	if(reply == MSG_Committed)
+	{
+		LCD_displayStringRowColumn(0, 3, "User Added");
+		LCD_displayStringRowColumn(1, 3, "Slot = ");
+		LCD_intgerToString(UART_receiveByte()); /* the slot is needed to remove the user later */
+	}
+	else
+	{
+		reply = UART_receiveByte(); /* the reason */
+		if(reply == ERR_PasswordTaken)
 		{
-			LCD_displayStringRowColumn(0, 0, "Door Is Locked");
-			/* Waiting MC1 to be Ready as LCD is slow at writing and Turning Motor On or OFF is fast so there will
-			 * a delay that we can solve by waiting LCD to write then turn the motor on or off */
-			UART_sendByte(MC_Ready);
-			g_MotorUnlocking++; /* go to the other branch next time */
-			TIMER1_COMP_setCallBack(TIMER1_MOTOR_3SEC_ISR); /* to wait another 3 seconds then lock the door again */
+			LCD_displayStringRowColumn(0, 0, "Pass Not Allowed");
+			LCD_displayStringRowColumn(1, 0, "Choose Another");
 		}
-		else if(g_MotorUnlocking == 1) /* in case it is the second time to come here then we handled every case for the door and we want to exit*/
+		else if(reply == ERR_UsersFull)
 		{
-			g_MotorUnlocking = 0;
-			g_exitMotorFlag = 1; /* to exit the function */
-			TIMER1_deInit(); /* stop the timer */
+			LCD_displayStringRowColumn(0, 0, "No Free Slots");
+		}
+		else
+		{
+			LCD_displayStringRowColumn(0, 0, "Saving Failed");
 		}
 	}
+	_delay_ms(1000);
 }
 
 /*******************************************************************************
-* Function Name:		TIMER1_MOTOR_3SEC_ISR
-* Description:			ISR function for the timer in case we want to count 3 seconds then lock the door
+* Function Name:		APP_revokeUser
+* Description:			Function to get the slot of a user and ask MCU2 to remove it
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
-void TIMER1_MOTOR_3SEC_ISR(void)
+void APP_revokeUser()
 {
-	g_ticks++;
-	if(g_ticks == 3) /* wait until number of seconds = 3 */
+	uint16 slot;
+
+	LCD_clearScreen();
+	LCD_displayStringRowColumn(0, 0, "User Slot: ");
+	slot = APP_enterNumber();
+	if(slot > 255)
 	{
-		g_ticks = 0; /* clear the number of seconds */
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0, 3, "Locking");
-		LCD_displayStringRowColumn(1, 3, "The Door");
-		/* Waiting MC1 to be Ready as LCD is slow at writing and Turning Motor On or OFF is fast so there will
-		 * a delay that we can solve by waiting LCD to write then turn the motor on or off */
-		UART_sendByte(MC_Ready);
-		TIMER1_COMP_setCallBack(TIMER1_MOTOR_15SEC_ISR); /* so we can count another 15 seconds then stop the motor */
+		slot = 255; /* not a valid slot, MCU2 will refuse it */
+	}
+
+	UART_sendByte(MSG_RevokeUser); /* Inform MCU2 that it will receive the slot of the user to remove */
+	UART_sendByte((uint8)slot);
+
+	LCD_clearScreen();
+	if(UART_receiveByte() == MSG_Committed)
+	{
+		LCD_displayStringRowColumn(0, 2, "User Removed");
 	}
+	else
+	{
+		LCD_displayStringRowColumn(0, 2, "No Such User");
+	}
+	_delay_ms(1000);
+}
+
+/*******************************************************************************
+* Function Name:		APP_debugScreen
+* Description:			Function to show the deepest the stack of each MCU went and the RAM it has,
+* 						until a key is pressed
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_debugScreen()
+{
+	uint16 used;
+	uint16 size;
+
+	UART_sendByte(MSG_ReadStack);
+	used = UART_receiveByte(); /* little endian */
+	used |= (uint16)UART_receiveByte() << 8;
+	size = UART_receiveByte();
+	size |= (uint16)UART_receiveByte() << 8;
+
+	LCD_displayStringRowColumn(0, 0, "Stack1 ");
+	LCD_intgerToString(STACK_getUsed());
+	LCD_displayCharacter('/');
+	LCD_intgerToString(STACK_getSize());
+	LCD_displayStringRowColumn(1, 0, "Stack2 ");
+	LCD_intgerToString(used);
+	LCD_displayCharacter('/');
+	LCD_intgerToString(size);
+	KEYPAD_getPressedKey();
+	_delay_ms(KEYPAD_BUTTON_DELAY);
 }
 
+/*******************************************************************************
+*                      		INTERRUPT SERVICE ROUTINE	           	           *
+*******************************************************************************/
+
 /*******************************************************************************
 * Function Name:		TIMER1_ALARM_ISR
-* Description:			ISR function for the timer in case we want to count 60 seconds then turn off the alarm
+* Description:			ISR function for the timer to count the seconds of the lockout
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
 void TIMER1_ALARM_ISR()
 {
-	g_ticks++;
-	if(g_ticks == 60) /* wait until number of seconds = 60 */
-	{
-		g_ticks = 0;
-		g_exitAlarmFlag = 1; /* exit ERROR state */
-		TIMER1_deInit(); /* stop the timer */
-	}
+	g_secondFlag = 1; /* APP_lockedOut counts the seconds and stops the timer */
 }
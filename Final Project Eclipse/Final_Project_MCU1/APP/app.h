@@ -14,6 +14,8 @@
 #include "../HAL/LCD/lcd.h"
 #include "../MCAL/UART/uart.h"
 #include "../MCAL/TIMER/timer1.h"
+#include "../LIB/stack.h"
+#include "../../SHARED/shared_config.h"
 #include "util/delay.h"
 #include "avr/interrupt.h"
 
@@ -22,38 +24,36 @@
 *******************************************************************************/
 #define TIMER1_OCR1A				8000 	/* as we need TCNT1 to be 8000 so we can get interrupt every 1 sec */
 #define KEYPAD_BUTTON_DELAY			500 	/* the amount of delay the keypad need to get another input from the user */
-#define PASSWORD_SIZE				5 		/* password array size */
 #define Password_Address			0x350 	/* Password Location in the EEPROM */
 #define	Password_Is_Set_Address		0x320 	/* Password flag Location in the EEPROM */
-#define PasswordSET					0xC2 	/* To indicate whether the password is set or not */
-#define ALLOWED_TRIES				3 		/* allow only 3 tries to enter the password right */
 #define ENTER_KEY					13		/* 13 is the "ON/C" button on the keypad */
-
-/*******************************************************************************
-*                        		UATR MESSAGES                                  *
-*******************************************************************************/
-#define MC_Ready					0xFC /* Message to indicate if the MCU is ready or not */
-#define MSG_UpdatePassword			0x99 /* Message From MCU1 to MCU2 to inform it that it will send new password and replace the one you have with it */
-#define MSG_TurnOnAlarm				0x88 /* Message From MCU1 to MCU2 to inform it the user entered the password wrong for 3 times, turn on the alarm */
-#define MSG_checkPassword			0x77 /* Message From MCU1 to MCU2 to inform it that it will send password from keypad to get checked */
-#define MSG_Motor					0x20 /* Message From MCU1 to MCU2 to inform it the user entered the password right, open the door */
-#define MSG_Matched					0xF0 /* Message From MCU2 to MCU1 to inform it if the passwords match or not */
-#define MSG_UnMatched				0x0F /* Message From MCU2 to MCU1 to inform it if the passwords match or not */
+#define NUMBER_MAX_DIGITS			3 		/* max number of digits the user can enter for a slot or number of uses */
+#define DOOR_OPEN_TIME				3000	/* ms the door stays unlocked before it is locked again */
 
 /*******************************************************************************
 *                      		Functions Prototypes	             	           *
 *******************************************************************************/
+uint8 APP_enterPassword(uint8 *password);
+void APP_sendPassword(const uint8 *password,uint8 length,boolean acknowledge);
+boolean APP_isSamePassword();
+uint16 APP_enterNumber();
 void APP_setPassword();
 void APP_changePassword();
 uint8 APP_comparePassWithEEPROM();
+uint16 APP_receiveLockout();
+void APP_displayTime(uint16 seconds);
+void APP_lockedOut();
 void APP_alarm();
 void APP_door();
+uint8 APP_waitDoor();
+void APP_manageUsers();
+void APP_addUser();
+void APP_revokeUser();
+void APP_debugScreen();
 
 /*******************************************************************************
 *                      		INTERRUPT SERVICE ROUTINE	           	           *
 *******************************************************************************/
-void TIMER1_MOTOR_3SEC_ISR();
-void TIMER1_MOTOR_15SEC_ISR();
 void TIMER1_ALARM_ISR();
 
 #endif /* APP_APP_H_ */
@@ -9,7 +9,21 @@
 *******************************************************************************/
 
 #include "keypad.h"
+#include "../../LIB/common_macros.h"
 #include "../../MCAL/GPIO/gpio.h"
+#include "avr/io.h" /* To use the IO Ports Registers */
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* level of a column, a benchmark reads it with a function of its own with
+ * -D'KEYPAD_READ_COL(col)=function(col)' to hold a button without anything wired */
+#ifdef KEYPAD_READ_COL
+uint8 KEYPAD_READ_COL(uint8 col);
+#else
+#define KEYPAD_READ_COL(col)		GET_BIT(KEYPAD_COL_PIN_REG, (KEYPAD_COL_PIN_ID+(col)))
+#endif
 
 /*******************************************************************************
 *                      Functions Prototypes(Private)                          *
@@ -33,26 +47,10 @@ static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number);
 *******************************************************************************/
 void KEYPAD_init()
 {
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+1, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+2, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+3, PIN_INPUT);
-
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+1, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+2, PIN_INPUT);
-	GPIO_setupPinDirection(PORTC_ID, PIN0_ID, PIN_INPUT);
-#if(KEYPAD_NUM_COLS == 4)
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+3, PIN_INPUT);
-#endif
-
-	GPIO_writePin(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID, LOGIC_HIGH);
-	GPIO_writePin(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+1, LOGIC_HIGH);
-	GPIO_writePin(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+2, LOGIC_HIGH);
-	GPIO_writePin(PORTC_ID, PIN0_ID, LOGIC_HIGH);
-#if(KEYPAD_NUM_COLS == 4)
-	GPIO_writePin(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+3, LOGIC_HIGH);
-#endif
+	/* the rows stay inputs without their pull-up until the scan drives one of them */
+	GPIO_INPUT(KEYPAD_ROW);
+	GPIO_INPUT(KEYPAD_COL);
+	GPIO_HIGH(KEYPAD_COL);
 }
 
 uint8 KEYPAD_getPressedKey()
@@ -62,29 +60,33 @@ uint8 KEYPAD_getPressedKey()
 	{
 		for(row = 0 ; row < KEYPAD_NUM_ROWS ; row++)
 		{
-			GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+row, PIN_OUTPUT);
-			GPIO_writePin(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+row, KEYPAD_BUTTON_PRESSED);
+			SET_BIT(KEYPAD_ROW_DDR_REG, (KEYPAD_ROW_PIN_ID+row));
+#if (KEYPAD_BUTTON_PRESSED == LOGIC_HIGH)
+			SET_BIT(KEYPAD_ROW_PORT_REG, (KEYPAD_ROW_PIN_ID+row));
+#else
+			CLEAR_BIT(KEYPAD_ROW_PORT_REG, (KEYPAD_ROW_PIN_ID+row));
+#endif
 
 			for(col = 0 ; col < KEYPAD_NUM_COLS ; col++)
 			{
-				if(GPIO_readPin(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+col) == KEYPAD_BUTTON_PRESSED)
+				if(KEYPAD_READ_COL(col) == KEYPAD_BUTTON_PRESSED)
 				{
 					#if (STANDARD_KEYPAD == FALSE)
 						#if (KEYPAD_NUM_COLS == 3)
-							GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID,KEYPAD_FIRST_ROW_PIN_ID+row,PIN_INPUT);
+							CLEAR_BIT(KEYPAD_ROW_DDR_REG, (KEYPAD_ROW_PIN_ID+row));
 							return KEYPAD_4x3_adjustKeyNumber( (row*KEYPAD_NUM_COLS)+col+1 );
 						#elif (KEYPAD_NUM_COLS == 4)
-							GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID,KEYPAD_FIRST_ROW_PIN_ID+row,PIN_INPUT);
+							CLEAR_BIT(KEYPAD_ROW_DDR_REG, (KEYPAD_ROW_PIN_ID+row));
 							return KEYPAD_4x4_adjustKeyNumber( (row*KEYPAD_NUM_COLS)+col+1 );
 						#endif
 					#elif (STANDARD_KEYPAD == TRUE)
-						GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID,KEYPAD_FIRST_ROW_PIN_ID+row,PIN_INPUT);
+						CLEAR_BIT(KEYPAD_ROW_DDR_REG, (KEYPAD_ROW_PIN_ID+row));
 						return ((row*KEYPAD_NUM_COLS)+col+1);
 					#endif /* ---> STANDARD_KEYPAD */
 				}
 			}
 
-			GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+row, PIN_INPUT);
+			CLEAR_BIT(KEYPAD_ROW_DDR_REG, (KEYPAD_ROW_PIN_ID+row));
 		}
 	}
 }
@@ -12,6 +12,7 @@
 *******************************************************************************/
 
 #include "../../LIB/std_types.h"
+#include "../../../SHARED/board_mcu1.h" /* KEYPAD_ROW and KEYPAD_COL */
 
 /*******************************************************************************
 *                        		Definitions                                    *
@@ -19,14 +20,14 @@
 
 #define STANDARD_KEYPAD				FALSE
 
-#define KEYPAD_NUM_COLS				4
-#define	KEYPAD_NUM_ROWS				4
+#define KEYPAD_NUM_COLS				KEYPAD_COL_NUM_PINS
+#define	KEYPAD_NUM_ROWS				KEYPAD_ROW_NUM_PINS
 
-#define	KEYPAD_ROW_PORT_ID			PORTB_ID
-#define	KEYPAD_FIRST_ROW_PIN_ID		PIN0_ID
+#if (KEYPAD_NUM_ROWS != 4) || ((KEYPAD_NUM_COLS != 3) && (KEYPAD_NUM_COLS != 4))
 
-#define	KEYPAD_COL_PORT_ID			PORTB_ID
-#define	KEYPAD_FIRST_COL_PIN_ID		PIN4_ID
+#error "The keypad should have 4 rows and 3 or 4 columns in board.cfg"
+
+#endif
 
 #define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
 #define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
@@ -11,26 +11,33 @@
 #include "lcd.h"
 #include "../../LIB/common_macros.h"
 #include "../../MCAL/GPIO/gpio.h"
+#include "avr/io.h" /* To use the IO Ports Registers */
 #include "util/delay.h"
+#include "stdlib.h" /* itoa */
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* the data pins get the low bits of value, the other pins of their port keep theirs */
+#define LCD_WRITE_DATA(value)	(LCD_DATA_PORT_REG = (LCD_DATA_PORT_REG & (uint8)~LCD_DATA_MASK) | \
+									((uint8)((value) << LCD_DATA_PIN_ID) & LCD_DATA_MASK))
 
 void LCD_init(void)
 {
-	GPIO_setupPinDirection(LCD_RS_PORT_ID, LCD_RS_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_E_PORT_ID, LCD_E_PIN_ID, PIN_OUTPUT);
+	GPIO_OUTPUT(LCD_RS);
+	GPIO_OUTPUT(LCD_E);
 
 	_delay_ms(20);
 
 #if(LCD_DATA_BITS_MODE == 8)
 
-	GPIO_setupPortDirection(LCD_DATA_PORT_ID, PORT_OUTPUT);
+	GPIO_OUTPUT(LCD_DATA);
 	LCD_sendCommand(LCD_TWO_LINES_EIGHT_BITS_MODE);
 
 #elif(LCD_DATA_BITS_MODE == 4)
 
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, PIN_OUTPUT);
+	GPIO_OUTPUT(LCD_DATA);
 
 	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1);
 	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2);
@@ -45,38 +52,32 @@ void LCD_init(void)
 
 void LCD_sendCommand(uint8 command)
 {
-	GPIO_writePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID	, LOGIC_LOW); /* Rs = 0 */
+	GPIO_LOW(LCD_RS); /* Rs = 0 */
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable = 1 */
+	GPIO_HIGH(LCD_E); /* Enable = 1 */
 	_delay_ms(1);
 
 #if(LCD_DATA_BITS_MODE == 8)
 
-	GPIO_writePort(LCD_DATA_PORT_ID, command); /* write command */
+	LCD_WRITE_DATA(command); /* write command */
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Enable = 1 */
+	GPIO_LOW(LCD_E); /* Enable = 1 */
 	_delay_ms(1);
 
 #elif(LCD_DATA_BITS_MODE == 4)
 
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(command,4));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(command,5));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(command,6));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(command,7));
+	LCD_WRITE_DATA(command >> 4);
 
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_LOW(LCD_E);
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	GPIO_HIGH(LCD_E);
 	_delay_ms(1);
 
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(command,0));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(command,1));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(command,2));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(command,3));
+	LCD_WRITE_DATA(command & 0x0F);
 
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_LOW(LCD_E);
 	_delay_ms(1);
 
 #endif
@@ -84,38 +85,32 @@ void LCD_sendCommand(uint8 command)
 
 void LCD_displayCharacter(uint8 data)
 {
-	GPIO_writePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID	, LOGIC_HIGH); /* Rs = 0 */
+	GPIO_HIGH(LCD_RS); /* Rs = 0 */
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable = 1 */
+	GPIO_HIGH(LCD_E); /* Enable = 1 */
 	_delay_ms(1);
 
 #if(LCD_DATA_BITS_MODE == 8)
 
-	GPIO_writePort(LCD_DATA_PORT_ID, data); /* write command */
+	LCD_WRITE_DATA(data); /* write command */
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Enable = 1 */
+	GPIO_LOW(LCD_E); /* Enable = 1 */
 	_delay_ms(1);
 
 #elif(LCD_DATA_BITS_MODE == 4)
 
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(data,4));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(data,5));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(data,6));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(data,7));
+	LCD_WRITE_DATA(data >> 4);
 
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_LOW(LCD_E);
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	GPIO_HIGH(LCD_E);
 	_delay_ms(1);
 
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(data,0));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(data,1));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(data,2));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(data,3));
+	LCD_WRITE_DATA(data & 0x0F);
 
 	_delay_ms(1);
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_LOW(LCD_E);
 	_delay_ms(1);
 
 #endif
@@ -12,13 +12,15 @@
 *******************************************************************************/
 
 #include "../../LIB/std_types.h"
+#include "../../../SHARED/board_mcu1.h" /* LCD_RS, LCD_E and LCD_DATA */
 
 
 /*******************************************************************************
 *                        		Definitions                                    *
 *******************************************************************************/
 
-#define LCD_DATA_BITS_MODE	8
+/* 8 or 4 pins next to each other on one port, DB0 to DB7 or DB4 to DB7 */
+#define LCD_DATA_BITS_MODE	LCD_DATA_NUM_PINS
 
 #if((LCD_DATA_BITS_MODE != 4) && (LCD_DATA_BITS_MODE != 8))
 
@@ -26,23 +28,6 @@
 
 #endif
 
-#define LCD_RS_PORT_ID				PORTD_ID
-#define LCD_RS_PIN_ID				PIN6_ID
-
-#define LCD_E_PORT_ID				PORTD_ID
-#define LCD_E_PIN_ID				PIN7_ID
-
-#define LCD_DATA_PORT_ID			PORTA_ID
-
-#if (LCD_DATA_BITS_MODE == 4)
-
-#define LCD_DB4_PIN_ID                 PIN4_ID
-#define LCD_DB5_PIN_ID                 PIN5_ID
-#define LCD_DB6_PIN_ID                 PIN6_ID
-#define LCD_DB7_PIN_ID                 PIN7_ID
-
-#endif
-
 /* LCD Commands */
 #define LCD_CLEAR_COMMAND                    0x01
 #define LCD_GO_TO_HOME                       0x02
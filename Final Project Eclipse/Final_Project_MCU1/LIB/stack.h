@@ -0,0 +1,69 @@
+/******************************************************************************
+*  File name:		stack.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef LIB_STACK_H_
+#define LIB_STACK_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * High-water mark of the stack. STACK_init paints the free RAM between the end
+ * of .bss and the stack pointer at the start of main, the painted bytes the
+ * stack never reached are still there when it is checked. The worst case of
+ * every entry point is found at build time by the Release build (stack_usage.awk),
+ * this is what a lock really used in the field. The host build has no AVR stack
+ * and sets STACK_PAINT_ENABLED to FALSE, the functions then return 0.
+ */
+#ifndef STACK_PAINT_ENABLED
+#define STACK_PAINT_ENABLED			TRUE
+#endif
+#define STACK_PAINT					0xC5	/* unlikely to be pushed, a byte that isn't it was used */
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		STACK_init
+* Description:			Function to paint the free stack, first thing in main before the interrupts
+* 						are enabled
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void STACK_init(void);
+
+/*******************************************************************************
+* Function Name:		STACK_getUsed
+* Description:			Function to get the deepest the stack went since STACK_init, main's own
+* 						frame and what was pushed before it included
+* Parameters (in):    	None
+* Parameters (out):   	Bytes from the end of the RAM
+* Return value:      	uint16
+********************************************************************************/
+
+uint16 STACK_getUsed(void);
+
+/*******************************************************************************
+* Function Name:		STACK_getSize
+* Description:			Function to get the RAM left for the stack after .data and .bss
+* Parameters (in):    	None
+* Parameters (out):   	Bytes
+* Return value:      	uint16
+********************************************************************************/
+
+uint16 STACK_getSize(void);
+
+#endif /* LIB_STACK_H_ */
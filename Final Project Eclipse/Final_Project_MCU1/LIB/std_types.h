@@ -27,8 +27,9 @@ typedef unsigned char         uint8;          /*           0 .. 255
 typedef signed char           sint8;          /*        -128 .. +127             */
 typedef unsigned short        uint16;         /*           0 .. 65535            */
 typedef signed short          sint16;         /*      -32768 .. +32767           */
-typedef unsigned long         uint32;         /*           0 .. 4294967295       */
-typedef signed long           sint32;         /* -2147483648 .. +2147483647      */
+/* long on the AVR, int on the host build where long is 64 bits */
+typedef __UINT32_TYPE__       uint32;         /*           0 .. 4294967295       */
+typedef __INT32_TYPE__        sint32;         /* -2147483648 .. +2147483647      */
 typedef unsigned long long    uint64;         /*       0 .. 18446744073709551615  */
 typedef signed long long      sint64;         /* -9223372036854775808 .. 9223372036854775807 */
 typedef float                 float32;
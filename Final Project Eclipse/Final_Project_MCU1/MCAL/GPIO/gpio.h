@@ -33,6 +33,18 @@
 #define PIN6_ID                6
 #define PIN7_ID                7
 
+/*
+ * Direct access to every pin of a name of the board_mcuX.h of SHARED, made from board.cfg.
+ * Its registers and its mask are constants so a pin is one sbi, cbi, sbis or sbic with the
+ * optimization on, there is no lookup of the port. The file using them includes avr/io.h.
+ */
+#define GPIO_OUTPUT(name)				(name##_DDR_REG |= name##_MASK)
+#define GPIO_INPUT(name)				(name##_DDR_REG &= (uint8)~name##_MASK)
+#define GPIO_HIGH(name)					(name##_PORT_REG |= name##_MASK)
+#define GPIO_LOW(name)					(name##_PORT_REG &= (uint8)~name##_MASK)
+#define GPIO_WRITE(name,value)			(((value) == LOGIC_HIGH) ? GPIO_HIGH(name) : GPIO_LOW(name))
+#define GPIO_READ(name)					((name##_PIN_REG & name##_MASK) ? LOGIC_HIGH : LOGIC_LOW)
+
 /*******************************************************************************
  *                               Types Declaration                             *
  *******************************************************************************/
@@ -14,8 +14,8 @@
 /*******************************************************************************
 *                           Global Variables                                  *
 *******************************************************************************/
-static volatile void (*g_callBackPtr1)(void) = NULL_PTR; /* to store the address of the function */
-static volatile void (*g_callBackPtr2)(void) = NULL_PTR; /* to store the address of the function */
+static void (*volatile g_callBackPtr1)(void) = NULL_PTR; /* to store the address of the function */
+static void (*volatile g_callBackPtr2)(void) = NULL_PTR; /* to store the address of the function */
 
 /*******************************************************************************
 *                      Functions Definitions                                   *
@@ -18,7 +18,7 @@
 *******************************************************************************/
 
 static uint8 g_endStringChar; /* to store the special char to end sting at */
-static volatile void (*g_callBackPtr)(void) = NULL_PTR; /* to store the address of the function */
+static void (*volatile g_callBackPtr)(void) = NULL_PTR; /* to store the address of the function */
 
 /*******************************************************************************
 *                       Interrupt Service Routines                            *
@@ -67,14 +67,12 @@ void UART_init(const UART_ConfigType * Configptr)
 	UCSRB = (1<<RXEN) | (1<<TXEN) ;	/* Transmission and receive enable */
 	UCSRB = (UCSRB & CLEAR_RECEIVE_METHOD_MASK ) | ( (Configptr->RECEVIE_METHOD<<7) ) ; /* To configure the UART with interrupt or polling */
 
-	SET_BIT(UCSRC,URSEL); /* so we can write in UCSRC register */
-	UCSRC = (UCSRC & CLEAR_CHAR_SIZE_MASK ) | ( (Configptr->CHAR_SIZE)<<1) ; /* setting the number of bits in UART frame */
-	UCSRC = (UCSRC & CLEAR_STOP_BITS_MASK) | ( (Configptr->STOP_BIT)<<3) ; /* set the number of stop bits */
-	UCSRC = (UCSRC & CLEAR_PARITY_MASK ) | ( (Configptr->PARITY)<<4) ; /* setting the PARITY */
+	/* UCSRC shares its address with UBRRH and a single read gives UBRRH, so it is written in one go with URSEL set.
+	 * A read-modify-write would copy UBRRH into it and leave a 5-bit frame */
+	UCSRC = (1<<URSEL) | ( (Configptr->PARITY)<<UPM0 ) | ( (Configptr->STOP_BIT)<<USBS ) | ( (Configptr->CHAR_SIZE)<<UCSZ0 ) ;
 
-	CLEAR_BIT(UBRRH,URSEL); /* to access UBRRH not UCSRC */
 	ubrr_value = (uint16)(((F_CPU / (Configptr->BAUD_RATE * 8UL))) - 1);
-	UBRRH = ubrr_value>>8;
+	UBRRH = (ubrr_value>>8) & 0x0F; /* URSEL cleared to write UBRRH not UCSRC */
 	UBRRL = ubrr_value;
 
 	g_endStringChar = Configptr->END_SRTING;
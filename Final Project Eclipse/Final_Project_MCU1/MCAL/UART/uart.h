@@ -17,9 +17,6 @@
 *                        		Definitions                                    *
 *******************************************************************************/
 
-#define CLEAR_PARITY_MASK				0xCF
-#define CLEAR_STOP_BITS_MASK			0xF7
-#define CLEAR_CHAR_SIZE_MASK			0xF9
 #define CLEAR_RECEIVE_METHOD_MASK		0x7F
 
 /*******************************************************************************
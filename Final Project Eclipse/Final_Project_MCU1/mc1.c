@@ -21,6 +21,7 @@ UART_ConfigType UART_Configuration = {9600,'#',UART_1_STOP_BIT,UART_8_BITS,UART_
 int main(void)
 {
 	/* Initialize different modules */
+	STACK_init(); /* before anything else uses the stack */
 	KEYPAD_init();
 	LCD_init();
 	UART_init(&UART_Configuration);
@@ -40,11 +41,11 @@ int main(void)
 	{
 		LCD_clearScreen();
 		LCD_displayStringRowColumn(0, 0, "+ : Open Door");
-		LCD_displayStringRowColumn(1, 0, "- : Change Pass");
-		uint8 menuKey; /* variable to decide  to open the door or change the password from the menu */
+		LCD_displayStringRowColumn(1, 0, "-:Pass  *:Users");
+		uint8 menuKey; /* variable to decide  to open the door, change the password or manage users from the menu */
 		do{
 			menuKey = KEYPAD_getPressedKey();
-		}while(menuKey != '-' && menuKey != '+'); /* wait until we get '+' or '-' */
+		}while(menuKey != '-' && menuKey != '+' && menuKey != '*' && menuKey != '='); /* wait until we get '+' or '-' or '*', '=' isn't shown */
 		LCD_clearScreen();
 
 		switch(menuKey)
@@ -56,6 +57,14 @@ int main(void)
 		case '-':
 			APP_changePassword(); /* Change password function */
 			break;
+
+		case '*':
+			APP_manageUsers(); /* Add or remove users function */
+			break;
+
+		case '=':
+			APP_debugScreen(); /* Stack high-water marks of both MCUs */
+			break;
 		}
 	}
 }
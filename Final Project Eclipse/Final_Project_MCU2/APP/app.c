@@ -14,12 +14,11 @@
 *******************************************************************************/
 uint8 UART_String[20];
 uint8 PasswordState;
-uint8 Password[PASSWORD_SIZE];
-uint8 g_ticks = 0;
-uint8 g_exitMotorFlag = 0;
-uint8 g_MotorUnlocking = 0;
-uint8 g_exitAlarmFlag = 0;
-Timer1_ConfigType TIMER1_Configuration = {0,TIMER1_OCR1A,TIMER1_FCPU_1024,COMPARE};
+Credential_SecretType PasswordSecret; /* salted hash of the main password, the password itself is never saved */
+uint8 g_adminSession = FALSE; /* set when the last checked password belongs to an admin, allows one admin operation */
+uint8 g_timer2Ticks = 0;
+uint16 g_busErrors = 0; /* TWI problems already logged */
+DcMotor_MotionConfigType DOOR_Motion = {DcMotor_S_CURVE,DOOR_HOLD_SPEED,DOOR_RAMP_TICKS,DOOR_HOLD_TICKS,DOOR_SENSING,DOOR_STALL_CURRENT};
 
 /*******************************************************************************
 *                      		Functions Definitions	             	           *
@@ -34,25 +33,85 @@ Timer1_ConfigType TIMER1_Configuration = {0,TIMER1_OCR1A,TIMER1_FCPU_1024,COMPAR
 ********************************************************************************/
 void APP_isPasswordSet()
 {
+	/* The password used to be saved in fixed cells, move it to the journal the first time we boot with the journal */
+	if(JOURNAL_hasRecord(JOURNAL_KEY_PASSWORD) == FALSE)
+	{
+		EEPROM_readByte(Password_Is_Set_Address, &PasswordState);
+		if(PasswordState == PasswordSET)
+		{
+			uint8 oldPassword[LEGACY_PASSWORD_SIZE];
+			uint8 record[JOURNAL_DATA_SIZE] = {0};
+			for(uint8 i = 0 ; i < LEGACY_PASSWORD_SIZE ; i++ )
+			{
+				EEPROM_readByte(Password_Address+i, (oldPassword+i) );
+			}
+			CREDENTIAL_hash(oldPassword, LEGACY_PASSWORD_SIZE, (Credential_SecretType *)record);
+			if(JOURNAL_write(JOURNAL_KEY_PASSWORD, record) == SUCCESS)
+			{
+				/* don't leave the plain password in the old cells */
+				for(uint8 i = 0 ; i < LEGACY_PASSWORD_SIZE ; i++ )
+				{
+					EEPROM_writeByte(Password_Address+i, 0x00);
+				}
+				EEPROM_writeByte(Password_Is_Set_Address, 0xFF);
+			}
+		}
+	}
 	/* To check if password is set in the EEPROM or not */
-	EEPROM_readByte(Password_Is_Set_Address, &PasswordState);
+	PasswordState = (JOURNAL_hasRecord(JOURNAL_KEY_PASSWORD) == TRUE) ? PasswordSET : PasswordNotSET;
 	/* send the password state to MCU1 to handle the different cases */
 	UART_sendByte(PasswordState);
 }
 
+/*******************************************************************************
+* Function Name:		APP_receivePassword
+* Description:			Function to receive a password from MCU1, its length then its digits
+* Parameters (in):    	Array of PASSWORD_MAX_SIZE to store the password in, TRUE to answer every byte with MC_Ready
+* Parameters (out):   	Length of the password or 0 if its length is not allowed
+* Return value:      	uint8
+********************************************************************************/
+uint8 APP_receivePassword(uint8 *password,boolean acknowledge)
+{
+	uint8 length = UART_receiveByte();
+	if(acknowledge)
+	{
+		UART_sendByte(MC_Ready);
+	}
+	for(uint8 k = 0 ; k < length ; k++)
+	{
+		uint8 digit = UART_receiveByte();
+		if(k < PASSWORD_MAX_SIZE) /* extra digits are still received to stay in sync with MCU1 */
+		{
+			password[k] = digit;
+		}
+		if(acknowledge)
+		{
+			UART_sendByte(MC_Ready);
+		}
+	}
+	return ( (length >= PASSWORD_MIN_SIZE) && (length <= PASSWORD_MAX_SIZE) ) ? length : 0;
+}
+
 /*******************************************************************************
 * Function Name:		APP_readPassword
-* Description:			Function to read the password saved in EEPROM into Password[] variable
+* Description:			Function to read the hash of the password saved in EEPROM into PasswordSecret variable
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
 void APP_readPassword()
 {
-	for(uint8 i = 0 ; i < PASSWORD_SIZE ; i++ )
+	uint8 record[JOURNAL_DATA_SIZE];
+	TRACE_ENTER(READ_PASSWORD);
+	if(JOURNAL_read(JOURNAL_KEY_PASSWORD, record) == SUCCESS) /* one page read instead of reading the password byte by byte */
 	{
-		EEPROM_readByte(Password_Address+i, (Password+i) );
+		PasswordSecret = *(Credential_SecretType *)record;
 	}
+	else
+	{
+		PasswordSecret.length = 0; /* no password of length 0 can be entered so nothing matches */
+	}
+	TRACE_EXIT(READ_PASSWORD);
 }
 
 /*******************************************************************************
@@ -64,12 +123,35 @@ void APP_readPassword()
 ********************************************************************************/
 void APP_updatePassword()
 {
-	for(uint8 k = 0 ; k < PASSWORD_SIZE ; k++)
+	uint8 newPassword[PASSWORD_MAX_SIZE];
+	uint8 length;
+	uint8 record[JOURNAL_DATA_SIZE] = {0};
+	uint8 commit = ERROR;
+	if( (JOURNAL_hasRecord(JOURNAL_KEY_PASSWORD) == TRUE) && (g_adminSession == FALSE) )
 	{
-		Password[k] = UART_receiveByte(); /* Getting the new password from MCU1 */
-		EEPROM_writeByte(Password_Address+k, Password[k]); /* Write it in the EEPROM */
+		/* only the first password can be set without an admin password check, MCU1 doesn't send it again */
+		APP_receivePassword(newPassword, FALSE);
+		UART_sendByte(MSG_Refused);
+		AUDIT_log(AUDIT_EVENT_PASSWORD_CHANGE, AUDIT_NO_SLOT, ERROR);
+		return;
+	}
+	/* MCU1 asks the user for the password again in case of failure, up to PASSWORD_COMMIT_TRIES passwords
+	 * so a bad length or a broken EEPROM can't keep MCU2 away from its commands */
+	for(uint8 tries = 0 ; (tries < PASSWORD_COMMIT_TRIES) && (commit == ERROR) ; tries++)
+	{
+		length = APP_receivePassword(newPassword, FALSE); /* Getting the new password from MCU1 */
+		if(length != 0)
+		{
+			CREDENTIAL_hash(newPassword, length, (Credential_SecretType *)record); /* only the salted hash is saved */
+			/* Append the new password to the journal, it replaces the old one only after it is verified
+			 * so a power failure in the middle of the write keeps the old password active */
+			commit = JOURNAL_write(JOURNAL_KEY_PASSWORD, record);
+		}
+		UART_sendByte( (commit == SUCCESS) ? MSG_Committed : MSG_CommitFailed );
+		BUZZER_play( (commit == SUCCESS) ? BUZZER_ACCEPT : BUZZER_REJECT );
+		AUDIT_log(AUDIT_EVENT_PASSWORD_CHANGE, AUDIT_NO_SLOT, commit);
 	}
-	EEPROM_writeByte(Password_Is_Set_Address, PasswordSET); /* Update password state to be set*/
+	g_adminSession = FALSE;
 }
 
 /*******************************************************************************
@@ -81,132 +163,508 @@ void APP_updatePassword()
 ********************************************************************************/
 void APP_checkPassword()
 {
-	uint8 checkPassword[PASSWORD_SIZE]; /* Variable to save the password from the keypad in MCU1 */
-	APP_readPassword(); /* Update the Password variable to be = to the password in the EEPROM */
-	for(uint8 k = 0 ; k < PASSWORD_SIZE ; k++) /* Receiving the password from MCU1 */
+	uint8 checkPassword[PASSWORD_MAX_SIZE]; /* Variable to save the password from the keypad in MCU1 */
+	uint8 length;
+	uint8 matched = FALSE;
+	uint8 role = ROLE_ADMIN;
+	uint8 slot = AUDIT_NO_SLOT; /* stays so if it is the main password */
+	uint16 remaining;
+	TRACE_ENTER(CHECK_PASSWORD);
+	APP_readPassword(); /* Update the PasswordSecret variable to be = to the hash in the EEPROM */
+	length = APP_receivePassword(checkPassword, TRUE); /* Receiving the password from MCU1 */
+	remaining = LOCKOUT_getRemaining();
+	if(remaining == 0) /* no password is checked during a lockout */
 	{
-		checkPassword[k] = UART_receiveByte();
-		UART_sendByte(MC_Ready);
+		LOCKOUT_recordAttempt(); /* saved as a wrong password until it matches */
+		if(length != 0)
+		{
+			TRACE_ENTER(MATCH);
+			matched = CREDENTIAL_match(checkPassword, length, &PasswordSecret); /* check if it is the main password */
+			TRACE_EXIT(MATCH);
+			if(matched == FALSE) /* check if it is the password of one of the users, at most one EEPROM page read */
+			{
+				TRACE_ENTER(VERIFY);
+				matched = (CREDENTIAL_verify(checkPassword, length, &slot, &role) == CREDENTIAL_OK);
+				TRACE_EXIT(VERIFY);
+			}
+		}
+		if(matched == FALSE)
+		{
+			remaining = LOCKOUT_getRemaining();
+		}
+	}
+	g_adminSession = matched && (role == ROLE_ADMIN);
+	if(matched)
+	{
+		UART_sendByte(MSG_Matched);
+		UART_sendByte(role); /* so MCU1 knows which options the user is allowed to use */
+		/* the wrong password saved before the check is cleared once MCU1 has its answer so the record
+		 * doesn't delay it, a reset before that only costs one try */
+		LOCKOUT_recordSuccess();
+		BUZZER_play(BUZZER_ACCEPT);
+		/* only staged, MCU1 sends MSG_Motor right away and the door shouldn't wait for the EEPROM */
+		AUDIT_log(AUDIT_EVENT_UNLOCK, slot, role);
+		TRACE_EXIT(CHECK_PASSWORD);
+		return;
+	}
+	else if(remaining != 0)
+	{
+		UART_sendByte(MSG_LockedOut);
+		APP_sendLockout(); /* so MCU1 can show the countdown */
+		BUZZER_play(BUZZER_REJECT);
+		AUDIT_log(AUDIT_EVENT_LOCKED_OUT, AUDIT_NO_SLOT, (remaining > (255 * 60)) ? 255 : (uint8)((remaining + 59) / 60));
+	}
+	else
+	{
+		UART_sendByte(MSG_UnMatched);
+		UART_sendByte(LOCKOUT_getTriesLeft());
+		BUZZER_play(BUZZER_REJECT);
+		AUDIT_log(AUDIT_EVENT_WRONG_PASSWORD, AUDIT_NO_SLOT, LOCKOUT_getTriesLeft());
+	}
+	TRACE_EXIT(CHECK_PASSWORD);
+	AUDIT_flush(); /* MCU1 already has its answer */
+}
+
+/*******************************************************************************
+* Function Name:		APP_sendLockout
+* Description:			Function to send the remaining lockout time to MCU1
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_sendLockout()
+{
+	uint16 remaining = LOCKOUT_getRemaining();
+	UART_sendByte((uint8)remaining); /* seconds, little endian */
+	UART_sendByte((uint8)(remaining>>8));
+}
+
+/*******************************************************************************
+* Function Name:		APP_addUser
+* Description:			Function to get a new user from MCU1 and add it to the credentials table
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_addUser()
+{
+	uint8 newPassword[PASSWORD_MAX_SIZE];
+	uint8 role = UART_receiveByte();
+	uint8 uses = UART_receiveByte();
+	uint8 length = APP_receivePassword(newPassword, FALSE); /* Receiving the password of the new user from MCU1 */
+	uint8 slot = AUDIT_NO_SLOT;
+	Credential_StatusType status;
+
+	if( (g_adminSession == FALSE) || (length == 0) || ((role != ROLE_ADMIN) && (role != ROLE_USER)) )
+	{
+		status = CREDENTIAL_EEPROM_ERROR; /* refuse it without touching the table */
+	}
+	else
+	{
+		status = CREDENTIAL_add(newPassword, length, role, (uses == 0) ? CREDENTIAL_USES_UNLIMITED : uses, &slot);
+	}
+	g_adminSession = FALSE;
+	AUDIT_log(AUDIT_EVENT_USER_ADDED, slot, status);
+	BUZZER_play( (status == CREDENTIAL_OK) ? BUZZER_ACCEPT : BUZZER_REJECT );
+
+	if(status == CREDENTIAL_OK)
+	{
+		UART_sendByte(MSG_Committed);
+		UART_sendByte(slot); /* MCU1 shows the slot so it can be used to revoke the user later */
+	}
+	else
+	{
+		UART_sendByte(MSG_CommitFailed);
+		if(status == CREDENTIAL_TAKEN)
+			UART_sendByte(ERR_PasswordTaken);
+		else if(status == CREDENTIAL_FULL)
+			UART_sendByte(ERR_UsersFull);
+		else
+			UART_sendByte(ERR_SavingFailed);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		APP_revokeUser
+* Description:			Function to get a slot from MCU1 and remove the user saved in it
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_revokeUser()
+{
+	uint8 slot = UART_receiveByte();
+	Credential_StatusType status = CREDENTIAL_NOT_FOUND;
+	if(g_adminSession == TRUE)
+	{
+		status = CREDENTIAL_revoke(slot);
 	}
-	for(uint8 j = 0 ; j < PASSWORD_SIZE ; j++) /* check if they are matched or not */
+	g_adminSession = FALSE;
+	UART_sendByte( (status == CREDENTIAL_OK) ? MSG_Committed : MSG_CommitFailed );
+	AUDIT_log(AUDIT_EVENT_USER_REVOKED, slot, status);
+	BUZZER_play( (status == CREDENTIAL_OK) ? BUZZER_ACCEPT : BUZZER_REJECT );
+}
+
+/*******************************************************************************
+* Function Name:		APP_sendAudit
+* Description:			Function to stream the whole audit log out, see MSG_ReadAudit
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_sendAudit()
+{
+	Audit_RecordType record;
+	Audit_RecordType previous;
+	uint8 broken = 0;
+	boolean first = TRUE;
+
+	AUDIT_flush(); /* so the staged events are sent too */
+	UART_sendByte(AUDIT_NUM_RECORDS);
+	for(uint8 age = 0 ; age < AUDIT_NUM_RECORDS ; age++)
 	{
-		if(Password[j] != checkPassword[j])
+		if(AUDIT_readRecord(age, &record) == ERROR)
 		{
-			UART_sendByte(MSG_UnMatched);
-			return;
+			for(uint8 i = 0 ; i < AUDIT_RECORD_SIZE ; i++)
+			{
+				((uint8 *)&record)[i] = 0xFF; /* sent as an erased record, the next link shows the gap */
+			}
+		}
+		for(uint8 i = 0 ; i < AUDIT_RECORD_SIZE ; i++)
+		{
+			UART_sendByte(((uint8 *)&record)[i]);
+		}
+		if(record.event != AUDIT_EVENT_ERASED)
+		{
+			/* the link of the oldest record can't be checked as the record before it was overwritten */
+			if( (first == FALSE) && (AUDIT_isLinked(&previous, &record) == FALSE) )
+			{
+				broken++;
+			}
+			previous = record;
+			first = FALSE;
 		}
 	}
-	UART_sendByte(MSG_Matched);
+	UART_sendByte(broken);
+	UART_sendByte(AUDIT_getDropped());
 }
 
 /*******************************************************************************
-* Function Name:		APP_alarm
-* Description:			Function to turn on alarm and enter ERROR state for 60 seconds
+* Function Name:		APP_sendTrace
+* Description:			Function to send the trace ring out and empty it, see MSG_ReadTrace
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
-void APP_alarm()
+void APP_sendTrace()
 {
-	g_ticks = 0;
-	g_exitAlarmFlag = 0;
-	/* initialize the timer module with the desired ISR */
-	TIMER1_COMP_setCallBack(TIMER1_ALARM_ISR);
-	TIMER1_init(&TIMER1_Configuration);
-	BUZZER_on(); /* Turn on the alarm */
-	while(g_exitAlarmFlag == 0){} /* wait until the timer counts 60 seconds */
-	BUZZER_off(); /* Turn off the alarm */
+	Trace_EventType event;
+	uint8 count = TRACE_pause(); /* nothing is overwritten while the events are sent */
+
+	UART_sendByte(count);
+	UART_sendByte(TRACE_getDropped());
+	for(uint8 age = 0 ; age < count ; age++)
+	{
+		TRACE_readEvent(age, &event);
+		for(uint8 i = 0 ; i < TRACE_EVENT_SIZE ; i++)
+		{
+			UART_sendByte(((uint8 *)&event)[i]);
+		}
+	}
+	TRACE_restart();
 }
 
 /*******************************************************************************
-* Function Name:		APP_door
-* Description:			Function to control locking and unlocking the door
+* Function Name:		APP_sendStats
+* Description:			Function to send the statistics of the interrupts and the CPU load, see MSG_ReadStats
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
-void APP_door()
+void APP_sendStats()
 {
-	g_ticks = 0;
-	/* initialize the timer module with the desired ISR */
-	TIMER1_COMP_setCallBack(TIMER1_MOTOR_15SEC_ISR);
-	TIMER1_init(&TIMER1_Configuration);
-	DcMotor_Rotate(	DcMotor_CW, 100); /* opening the door */
-	g_exitMotorFlag = 0;
-	while(g_exitMotorFlag == 0){}
+	Trace_IsrStatsType stats;
+	uint16 average;
+	uint16 latency = TRACE_getWorstLatency();
+
+	UART_sendByte(TRACE_NUM_VECTORS);
+	for(uint8 vector = 0 ; vector < TRACE_NUM_VECTORS ; vector++)
+	{
+		TRACE_readIsrStats(vector, &stats);
+		average = (stats.samples != 0) ? (uint16)(stats.sum / stats.samples) : 0;
+		for(uint8 i = 0 ; i < 4 ; i++)
+		{
+			UART_sendByte((uint8)(stats.count >> (8 * i))); /* little endian */
+		}
+		UART_sendByte((uint8)average);
+		UART_sendByte((uint8)(average>>8));
+		UART_sendByte((uint8)stats.max);
+		UART_sendByte((uint8)(stats.max>>8));
+	}
+	UART_sendByte((uint8)latency);
+	UART_sendByte((uint8)(latency>>8));
+	UART_sendByte(TRACE_getLoad());
+	UART_sendByte(TRACE_getMaxLoad());
 }
 
 /*******************************************************************************
-*                      		INTERRUPT SERVICE ROUTINE	           	           *
-*******************************************************************************/
+* Function Name:		APP_sendStack
+* Description:			Function to send the deepest the stack went and the RAM it has, see MSG_ReadStack
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_sendStack()
+{
+	uint16 used = STACK_getUsed();
+	uint16 size = STACK_getSize();
+	UART_sendByte((uint8)used); /* little endian */
+	UART_sendByte((uint8)(used>>8));
+	UART_sendByte((uint8)size);
+	UART_sendByte((uint8)(size>>8));
+}
 
 /*******************************************************************************
-* Function Name:		TIMER1_MOTOR_15SEC_ISR
-* Description:			ISR function for the timer in case we want to count 15 seconds and lock or unlock the door
+* Function Name:		APP_sendCapture
+* Description:			Function to stop the capture of the link and send it, see MSG_ReadCapture
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
-void TIMER1_MOTOR_15SEC_ISR(void)
+void APP_sendCapture()
 {
-	g_ticks++;
-	if(g_ticks == 15)
+	Capture_EventType event;
+	uint16 count = CAPTURE_stop(); /* the answer isn't captured */
+
+	UART_sendByte((uint8)count); /* little endian */
+	UART_sendByte((uint8)(count>>8));
+	UART_sendByte(CAPTURE_getDropped());
+	for(uint16 index = 0 ; index < count ; index++)
 	{
-		g_ticks = 0;
-		if(g_MotorUnlocking == 0) /* wait until number of seconds = 15 */
+		CAPTURE_readEvent(index, &event);
+		for(uint8 i = 0 ; i < CAPTURE_EVENT_SIZE ; i++)
 		{
-			/* Waiting MC1 to be Ready as LCD is slow at writing and Turning Motor On or OFF is fast so there will
-			 * a delay that we can solve by waiting LCD to write then turn the motor on or off */
-			UART_receiveByte();
-			DcMotor_Rotate(	DcMotor_STOP, 100); /* the door now is unlocked */
-			g_MotorUnlocking++;
-			TIMER1_COMP_setCallBack(TIMER1_MOTOR_3SEC_ISR); /* to wait another 3 seconds then lock it again */
+			UART_sendByte(((uint8 *)&event)[i]);
 		}
-		else if(g_MotorUnlocking == 1) /* in case it is the second time to come here then we handled every case for the door and we want to exit*/
+	}
+}
+
+/*******************************************************************************
+* Function Name:		APP_maintenance
+* Description:			Function to run the maintenance mode if it is allowed, the EEPROM is scanned
+* 						again after it so a restored image is used right away
+* Parameters (in):    	Normal configuration of the link
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_maintenance(const UART_ConfigType *linkConfig)
+{
+	uint8 allowed = g_adminSession || (JOURNAL_hasRecord(JOURNAL_KEY_PASSWORD) == FALSE); /* an empty lock can be provisioned */
+	g_adminSession = FALSE;
+	if(allowed == FALSE)
+	{
+		UART_sendByte(MSG_CommitFailed);
+		AUDIT_log(AUDIT_EVENT_MAINTENANCE, AUDIT_NO_SLOT, 0);
+		return;
+	}
+
+	AUDIT_flush(); /* so a backup holds every event */
+	UART_sendByte(MC_Ready);
+	UART_waitTransmitComplete(); /* the answer must leave at the normal baud rate */
+	if(MAINTENANCE_run(linkConfig) == TRUE)
+	{
+		if( (JOURNAL_init() == SUCCESS) && (CREDENTIAL_init() == SUCCESS) )
 		{
-			g_MotorUnlocking = 0;
-			g_exitMotorFlag = 1; /* to exit the function */
-			DcMotor_Rotate(	DcMotor_STOP, 100); /* Stop the motor */
-			TIMER1_deInit(); /* stop the timer */
+			APP_checkKeys(); /* a backup of another lock can't be checked with the keys of this one */
 		}
+		LOCKOUT_init();
+		AUDIT_init();
+		AUDIT_log(AUDIT_EVENT_MAINTENANCE, AUDIT_NO_SLOT, 2);
+	}
+	else
+	{
+		AUDIT_log(AUDIT_EVENT_MAINTENANCE, AUDIT_NO_SLOT, 1);
 	}
 }
 
 /*******************************************************************************
-* Function Name:		TIMER1_MOTOR_3SEC_ISR
-* Description:			ISR function for the timer in case we want to count 3 seconds then lock the door
+* Function Name:		APP_checkBus
+* Description:			Function to log the TWI problems that happened since the last call, the EEPROM
+* 						functions only return ERROR so this is where a failing bus shows up
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
-void TIMER1_MOTOR_3SEC_ISR(void)
+void APP_checkBus()
 {
-	g_ticks++;
-	if(g_ticks == 3) /* wait until number of seconds = 3 */
+	TWI_ErrorCountersType counters;
+	uint16 total;
+	TWI_getErrorCounters(&counters);
+	total = counters.timeouts + counters.bus_errors + counters.arbitration_lost;
+	if(total != g_busErrors)
 	{
-		g_ticks = 0;
-		/* Waiting MC1 to be Ready as LCD is slow at writing and Turning Motor On or OFF is fast so there will
-		 * a delay that we can solve by waiting LCD to write then turn the motor on or off */
-		UART_receiveByte();
-		DcMotor_Rotate(	DcMotor_CCW, 100); /* Lock the door again */
-		TIMER1_COMP_setCallBack(TIMER1_MOTOR_15SEC_ISR); /* to count 15 seconds then stop the motor */
+		uint16 count = total - g_busErrors;
+		AUDIT_log(AUDIT_EVENT_BUS_ERROR, AUDIT_NO_SLOT, (count > 0xFF) ? 0xFF : (uint8)count);
+		g_busErrors = total;
 	}
 }
 
 /*******************************************************************************
-* Function Name:		TIMER1_ALARM_ISR
-* Description:			ISR function for the timer in case we want to count 60 seconds then turn off the alarm
+* Function Name:		APP_checkKeys
+* Description:			Function to erase the password and the users if they were saved with other device
+* 						keys, they could never match again and the lock could only be opened by taking its
+* 						24C16 out. It happens when the internal EEPROM lost the keys (a chip erase without
+* 						the EESAVE fuse) or when a backup of another lock was restored. The lock is then
+* 						provisioned again like a new one. JOURNAL_init and CREDENTIAL_init must have
+* 						succeeded first, a record that couldn't be read is never taken as missing.
 * Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+uint8 APP_checkKeys()
+{
+	uint8 check[JOURNAL_DATA_SIZE] = {0};
+	uint8 saved[JOURNAL_DATA_SIZE];
+	uint8 status = SUCCESS;
+
+	CREDENTIAL_getKeysCheck(check);
+	if(JOURNAL_hasRecord(JOURNAL_KEY_KEYS_CHECK) == TRUE)
+	{
+		uint8 difference = 0;
+		if(JOURNAL_read(JOURNAL_KEY_KEYS_CHECK, saved) == ERROR)
+			return ERROR;
+
+		for(uint8 i = 0 ; i < JOURNAL_DATA_SIZE ; i++)
+		{
+			difference |= saved[i] ^ check[i];
+		}
+		if(difference == 0)
+			return SUCCESS;
+	}
+	/* the check is written last, a power cut before it only means the records are erased again at the next boot */
+	status &= JOURNAL_erase(JOURNAL_KEY_PASSWORD);
+	status &= CREDENTIAL_clear();
+	if(status == SUCCESS)
+	{
+		status = JOURNAL_write(JOURNAL_KEY_KEYS_CHECK, check);
+	}
+	return status;
+}
+
+/*******************************************************************************
+* Function Name:		APP_alarm
+* Description:			Function to turn on the siren for ALARM_SECONDS, it plays from the tick so the link is
+* 						still served meanwhile
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_alarm()
+{
+	AUDIT_log(AUDIT_EVENT_ALARM, AUDIT_NO_SLOT, 0);
+	BUZZER_repeat(BUZZER_SIREN, ALARM_SECONDS * APP_TICKS_PER_SECOND); /* Turn on the alarm */
+}
+
+/*******************************************************************************
+* Function Name:		APP_door
+* Description:			Function to control locking and unlocking the door
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_door()
+{
+	APP_moveDoor(DcMotor_CW); /* opening the door */
+	/* MCU1 keeps the door open for a few seconds then sends MC_Ready, waiting for it also lets the LCD
+	 * show the locking screen before the motor starts */
+	UART_receiveByte();
+	APP_moveDoor(DcMotor_CCW); /* Lock the door again */
+}
+
+/*******************************************************************************
+* Function Name:		APP_moveDoor
+* Description:			Function to move the door until it reaches its end-stop, stalls or the max
+* 						time passes, then tell MCU1 how the move ended and how long it took
+* Parameters (in):    	Direction of the move
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void APP_moveDoor(DcMotor_State direction)
+{
+	uint16 ticks;
+	uint16 travelTime;
+	uint8 door;
+	DcMotor_ResultType result;
+
+	BUZZER_play(BUZZER_CLICK); /* the bolt is about to move */
+	DcMotor_Move(direction, &DOOR_Motion); /* soft start and soft stop, runs from the tick */
+	TRACE_IDLE_ENTER(); /* the door is moved by the tick */
+	while(DcMotor_IsMoving()){}
+	TRACE_IDLE_EXIT();
+	result = DcMotor_GetResult(&ticks);
+	travelTime = ticks * APP_TICK_MS;
+
+	if(result == DcMotor_END_STOP)
+		door = DOOR_EndStop;
+	else if(result == DcMotor_STALLED)
+		door = DOOR_Stalled;
+	else
+		door = DOOR_TimedOut;
+
+	UART_sendByte(MSG_DoorMoved);
+	UART_sendByte(door);
+	UART_sendByte((uint8)travelTime); /* ms, little endian */
+	UART_sendByte((uint8)(travelTime>>8));
+
+	/* without end-stops every move ends by a stall or the max time */
+	if( (door != DOOR_EndStop) && (DOOR_SENSING & DCMOTOR_SENSE_END_STOP) )
+	{
+		AUDIT_log((direction == DcMotor_CW) ? AUDIT_EVENT_UNLOCK_FAULT : AUDIT_EVENT_LOCK_FAULT, AUDIT_NO_SLOT, door);
+		BUZZER_play(BUZZER_REJECT);
+	}
+}
+
+/*******************************************************************************
+*                      		INTERRUPT SERVICE ROUTINE	           	           *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		TIMER2_TICK_ISR
+* Description:			ISR function for the 8 ms tick, runs the motor ramps and sensors, the buzzer and counts the seconds of the lockout and the audit log
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void TIMER2_TICK_ISR()
+{
+	TRACE_ENTER_ISR(TICK);
+	CAPTURE_tick(); /* first, the time of the capture counts from the compare match */
+	DcMotor_Tick(); /* the speed ramps and the sensors of the door move */
+	BUZZER_tick(); /* the beep codes and the siren */
+	g_timer2Ticks++;
+	if(g_timer2Ticks == APP_TICKS_PER_SECOND)
+	{
+		g_timer2Ticks = 0;
+		LOCKOUT_tick();
+		AUDIT_tick();
+	}
+	TRACE_EXIT_ISR(TICK);
+}
+
+/*******************************************************************************
+* Function Name:		APP_endAdminSession
+* Description:			Function to end the admin session after any command that doesn't use it, so a door
+* 						opening or a read between the check and the admin operation needs a new check
+* Parameters (in):    	The command that was just handled
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
-void TIMER1_ALARM_ISR()
+void APP_endAdminSession(uint8 command)
 {
-	g_ticks++;
-	if(g_ticks == 60)  /* wait until number of seconds = 60 */
+	/* MSG_checkPassword starts the session, the admin operations end it themselves */
+	if( (command != MSG_checkPassword) && (command != MSG_UpdatePassword) && (command != MSG_AddUser) &&
+		(command != MSG_RevokeUser) && (command != MSG_Maintenance) )
 	{
-		g_ticks = 0;
-		g_exitAlarmFlag = 1; /* exit ERROR state and turn off the buzzer */
-		TIMER1_deInit(); /* stop the timer */
+		g_adminSession = FALSE;
 	}
 }
@@ -12,47 +12,109 @@
 *******************************************************************************/
 #include "../MCAL/UART/uart.h"
 #include "../MCAL/TWI/twi.h"
-#include "../MCAL/TIMER1/timer1.h"
+#include "../MCAL/TIMER2/timer2.h"
 #include "../HAL/BUZZER/buzzer.h"
 #include "../HAL/EXT_EEPORM/eeprom.h"
+#include "../HAL/EXT_EEPORM/journal.h"
+#include "../HAL/EXT_EEPORM/credential.h"
+#include "lockout.h"
+#include "audit.h"
+#include "maintenance.h"
 #include "../HAL/MOTOR/motor.h"
+#include "../LIB/trace.h"
+#include "../LIB/stack.h"
+#include "../LIB/capture.h"
+#include "../../SHARED/shared_config.h"
 #include "avr/interrupt.h"
 
 /*******************************************************************************
 *                        		Definitions                                    *
 *******************************************************************************/
-#define TIMER1_OCR1A				8000 	/* as we need TCNT1 to be 8000 so we can get interrupt every 1 sec */
-#define PASSWORD_SIZE				5 		/* password array size */
-#define Password_Address			0x350 	/* Password Location in the EEPROM */
-#define	Password_Is_Set_Address		0x320	 /* Password flag Location in the EEPROM */
-#define PasswordSET					0xC2 	/* To indicate whether the password is set or not */
+#define TIMER2_OCR2					249 	/* F_CPU/256/250 = 125 interrupts per second for the lockout and the log time */
+#define APP_TICKS_PER_SECOND		125
+#define APP_TICK_MS					(1000 / APP_TICKS_PER_SECOND)
+#define ALARM_SECONDS				60
+#define DOOR_MOVE_SECONDS			15		/* max travel time, a move stops on its end-stop or a stall well before */
+#define DOOR_HOLD_SPEED				204		/* 80% of DCMOTOR_MAX_SPEED, the ramps give the extra torque to get the bolt going */
+#define DOOR_RAMP_TICKS				APP_TICKS_PER_SECOND	/* 1 second soft start and soft stop */
+#define DOOR_HOLD_TICKS				((DOOR_MOVE_SECONDS * APP_TICKS_PER_SECOND) - (2 * DOOR_RAMP_TICKS))
+/*
+ * The door lock board has the end-stops and the current sense of board.cfg, a move ends as soon
+ * as the bolt gets there. A board without them sets -DDOOR_SENSING=0 in the build, its moves then
+ * last DOOR_MOVE_SECONDS, or keeps the one it has : an unconnected ADC input could read a stall
+ * in the middle of a move.
+ */
+#ifndef DOOR_SENSING
+#define DOOR_SENSING				(DCMOTOR_SENSE_END_STOP|DCMOTOR_SENSE_CURRENT)
+#endif
+#define DOOR_STALL_CURRENT			102		/* 1 A through the 0.5 ohm sense resistor with AVCC = 5 V */
+#define LEGACY_PASSWORD_SIZE		5 		/* the old password always had 5 digits */
+#define Password_Address			0x350 	/* Old Password Location in the EEPROM, moved to the journal then wiped */
+#define	Password_Is_Set_Address		0x320	 /* Old Password flag Location in the EEPROM, moved to the journal then wiped */
+
+#if (BUZZER_TICKS_PER_SECOND != APP_TICKS_PER_SECOND)
+
+#error "The buzzer patterns run from the application tick"
+
+#endif
+
+#if (TRACE_USES_TIMER1 == TRUE) && (BUZZER_USE_TONE == TRUE)
+
+#error "The tones of the buzzer and the trace both need timer 1, set TRACE_ENABLED and TRACE_STATS_ENABLED to FALSE"
+
+#endif
+
+#if (PASSWORD_MAX_SIZE > CREDENTIAL_MAX_PIN_SIZE)
+
+#error "The max password size doesn't fit in the credential records"
+
+#endif
 
 /*******************************************************************************
-*                        		UATR MESSAGES                                  *
+*                        		JOURNAL KEYS                                   *
 *******************************************************************************/
-#define MC_Ready					0xFC /* Message to indicate if the MCU is ready or not */
-#define MSG_UpdatePassword			0x99 /* Message From MCU1 to MCU2 to inform it that it will send new password and replace the one you have with it */
-#define MSG_TurnOnAlarm				0x88 /* Message From MCU1 to MCU2 to inform it the user entered the password wrong for 3 times, turn on the alarm */
-#define MSG_checkPassword			0x77 /* Message From MCU1 to MCU2 to inform it that it will send password from keypad to get checked */
-#define MSG_Motor					0x20 /* Message From MCU1 to MCU2 to inform it the user entered the password right, open the door */
-#define MSG_Matched					0xF0 /* Message From MCU2 to MCU1 to inform it if the passwords match or not */
-#define MSG_UnMatched				0x0F /* Message From MCU2 to MCU1 to inform it if the passwords match or not */
+#define JOURNAL_KEY_PASSWORD		0 		/* Journal record that holds the salted hash of the password */
+#define JOURNAL_KEY_KEYS_CHECK		1 		/* Journal record that holds the check value of the device keys the password and the users were saved with */
+
+#if (CREDENTIAL_SECRET_SIZE > JOURNAL_DATA_SIZE)
+
+#error "The hash of the password doesn't fit in a journal record"
+
+#endif
+
+#if (CREDENTIAL_KEYS_CHECK_SIZE > JOURNAL_DATA_SIZE)
+
+#error "The check value of the device keys doesn't fit in a journal record"
+
+#endif
 
 /*******************************************************************************
 *                      		Functions Prototypes	             	           *
 *******************************************************************************/
 void APP_isPasswordSet();
+uint8 APP_receivePassword(uint8 *password,boolean acknowledge);
 void APP_updatePassword();
 void APP_checkPassword();
+void APP_sendLockout();
+void APP_sendAudit();
+void APP_sendTrace();
+void APP_sendStats();
+void APP_sendStack();
+void APP_sendCapture();
+void APP_maintenance(const UART_ConfigType *linkConfig);
+void APP_checkBus();
+uint8 APP_checkKeys();
 void APP_readPassword();
 void APP_alarm();
+void APP_endAdminSession(uint8 command);
 void APP_door();
+void APP_moveDoor(DcMotor_State direction);
+void APP_addUser();
+void APP_revokeUser();
 
 /*******************************************************************************
 *                      		INTERRUPT SERVICE ROUTINE	           	           *
 *******************************************************************************/
-void TIMER1_MOTOR_3SEC_ISR();
-void TIMER1_MOTOR_15SEC_ISR();
-void TIMER1_ALARM_ISR();
+void TIMER2_TICK_ISR();
 
 #endif /* APP_APP_H_ */
@@ -0,0 +1,329 @@
+/******************************************************************************
+*  File name:		audit.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "audit.h"
+#include "../HAL/EXT_EEPORM/credential.h"
+#include "../LIB/crc16.h"
+#include "../MCAL/INT_EEPROM/int_eeprom.h"
+#include "../LIB/trace.h"
+#include "util/atomic.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+#define AUDIT_RECORD_ADDRESS(index)		(AUDIT_START_ADDRESS + ((uint16)(index) * AUDIT_RECORD_SIZE))
+#define AUDIT_RECORDS_PER_PAGE			(EEPROM_PAGE_SIZE / AUDIT_RECORD_SIZE)
+#define AUDIT_LINK_SIZE					2
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+static uint8 g_auditKey[HALFSIPHASH_KEY_SIZE]; /* device key from the internal EEPROM */
+static const uint8 g_auditFirstLink[AUDIT_LINK_SIZE] = {0x00,0x00}; /* previous link of the first record ever */
+
+static Audit_RecordType g_auditStaging[AUDIT_STAGING_RECORDS]; /* oldest staged event first */
+static uint8 g_auditStaged = 0;
+static uint8 g_auditNext = 0; /* index of the record after the newest staged event */
+static uint8 g_auditLink[AUDIT_LINK_SIZE] = {0x00,0x00}; /* link of the newest staged event */
+static uint8 g_auditDropped = 0;
+static boolean g_auditReady = FALSE; /* the end of the chain is known, so nothing is overwritten by mistake */
+static volatile uint32 g_auditTime = 0;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+static uint8 AUDIT_loadKey(void);
+static void AUDIT_computeLink(const uint8 *previousLink,const Audit_RecordType *record,uint8 *link);
+static boolean AUDIT_follows(const uint8 *previousLink,const Audit_RecordType *record);
+static uint32 AUDIT_getTime(const Audit_RecordType *record);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+uint8 AUDIT_init(void)
+{
+	Audit_RecordType records[AUDIT_RECORDS_PER_PAGE];
+	Audit_RecordType previous;
+	Audit_RecordType first;
+	uint8 linked[(AUDIT_NUM_RECORDS + 7) / 8] = {0}; /* bit set if the record is chained to the record before it */
+	uint8 newest = AUDIT_NUM_RECORDS;
+	uint32 newestTime = 0;
+
+	g_auditReady = FALSE;
+	g_auditStaged = 0;
+	previous.event = AUDIT_EVENT_ERASED;
+
+	if(AUDIT_loadKey() == ERROR)
+		return ERROR;
+
+	/* read the whole log once, one page at a time, and check every link */
+	for(uint8 index = 0 ; index < AUDIT_NUM_RECORDS ; index += AUDIT_RECORDS_PER_PAGE)
+	{
+		if(EEPROM_readBlock(AUDIT_RECORD_ADDRESS(index), (uint8 *)records, EEPROM_PAGE_SIZE) == ERROR)
+			return ERROR; /* nothing is written until the end of the chain is found */
+
+		for(uint8 i = 0 ; i < AUDIT_RECORDS_PER_PAGE ; i++)
+		{
+			uint8 current = index + i;
+			if(current == 0)
+			{
+				first = records[i];
+				if(AUDIT_follows(g_auditFirstLink, &records[i]) == TRUE)
+				{
+					linked[0] |= 1;
+				}
+			}
+			if(records[i].event != AUDIT_EVENT_ERASED)
+			{
+				if( (previous.event != AUDIT_EVENT_ERASED) && (AUDIT_follows(previous.link, &records[i]) == TRUE) )
+				{
+					linked[current / 8] |= (1 << (current % 8));
+				}
+				if( (newest == AUDIT_NUM_RECORDS) || (AUDIT_getTime(&records[i]) >= newestTime) )
+				{
+					newest = current; /* only used if the chain has no clear end */
+					newestTime = AUDIT_getTime(&records[i]);
+				}
+			}
+			previous = records[i];
+		}
+	}
+	/* the first record follows the last one once the log wrapped around */
+	if( (previous.event != AUDIT_EVENT_ERASED) && (first.event != AUDIT_EVENT_ERASED)
+			&& (AUDIT_follows(previous.link, &first) == TRUE) )
+	{
+		linked[0] |= 1;
+	}
+
+	/* the newest record is chained to the one before it but the record after it isn't chained to it.
+	 * There is more than one such record only if the log was edited, keep the latest one */
+	boolean found = FALSE;
+	for(uint8 current = 0 ; current < AUDIT_NUM_RECORDS ; current++)
+	{
+		uint8 next = (current + 1) % AUDIT_NUM_RECORDS;
+		if( (linked[current / 8] & (1 << (current % 8))) && !(linked[next / 8] & (1 << (next % 8))) )
+		{
+			if(EEPROM_readBlock(AUDIT_RECORD_ADDRESS(current), (uint8 *)&records[0], AUDIT_RECORD_SIZE) == ERROR)
+				return ERROR;
+
+			if( (found == FALSE) || (AUDIT_getTime(&records[0]) >= newestTime) )
+			{
+				newest = current;
+				newestTime = AUDIT_getTime(&records[0]);
+				found = TRUE;
+			}
+		}
+	}
+
+	if(newest == AUDIT_NUM_RECORDS) /* empty log */
+	{
+		g_auditNext = 0;
+		g_auditLink[0] = g_auditFirstLink[0];
+		g_auditLink[1] = g_auditFirstLink[1];
+		newestTime = 0;
+	}
+	else
+	{
+		if(EEPROM_readBlock(AUDIT_RECORD_ADDRESS(newest), (uint8 *)&records[0], AUDIT_RECORD_SIZE) == ERROR)
+			return ERROR;
+
+		g_auditNext = (newest + 1) % AUDIT_NUM_RECORDS;
+		g_auditLink[0] = records[0].link[0];
+		g_auditLink[1] = records[0].link[1];
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_auditTime = newestTime; /* the time of the log goes on from its newest record */
+	}
+	g_auditReady = TRUE;
+	return SUCCESS;
+}
+
+void AUDIT_log(Audit_EventType event,uint8 slot,uint8 result)
+{
+	Audit_RecordType *record;
+	uint32 time;
+
+	if(g_auditStaged == AUDIT_STAGING_RECORDS)
+	{
+		AUDIT_flush(); /* only happens after many events without a flush */
+		if(g_auditStaged == AUDIT_STAGING_RECORDS)
+		{
+			if(g_auditDropped < 0xFF)
+			{
+				g_auditDropped++;
+			}
+			return;
+		}
+	}
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		time = g_auditTime;
+	}
+	record = &g_auditStaging[g_auditStaged];
+	record->time[0] = (uint8)time;
+	record->time[1] = (uint8)(time>>8);
+	record->time[2] = (uint8)(time>>16);
+	record->event = event;
+	record->slot = slot;
+	record->result = result;
+	AUDIT_computeLink(g_auditLink, record, record->link);
+
+	g_auditLink[0] = record->link[0];
+	g_auditLink[1] = record->link[1];
+	g_auditNext = (g_auditNext + 1) % AUDIT_NUM_RECORDS;
+	g_auditStaged++;
+}
+
+uint8 AUDIT_flush(void)
+{
+	uint8 status = SUCCESS;
+
+	if(g_auditReady == FALSE)
+		return ERROR;
+
+	TRACE_ENTER(AUDIT_FLUSH);
+	while(g_auditStaged != 0)
+	{
+		uint8 index = (g_auditNext + AUDIT_NUM_RECORDS - g_auditStaged) % AUDIT_NUM_RECORDS; /* oldest staged event */
+		uint8 count = AUDIT_RECORDS_PER_PAGE - (index % AUDIT_RECORDS_PER_PAGE); /* records left in its page */
+		if(count > g_auditStaged)
+		{
+			count = g_auditStaged;
+		}
+
+		status = EEPROM_writePage(AUDIT_RECORD_ADDRESS(index), (const uint8 *)g_auditStaging, count * AUDIT_RECORD_SIZE);
+		if(status == ERROR)
+			break;
+
+		g_auditStaged -= count;
+		for(uint8 i = 0 ; i < g_auditStaged ; i++)
+		{
+			g_auditStaging[i] = g_auditStaging[i + count];
+		}
+	}
+	TRACE_EXIT(AUDIT_FLUSH);
+	return status;
+}
+
+uint8 AUDIT_readRecord(uint8 age,Audit_RecordType *record)
+{
+	if(age >= AUDIT_NUM_RECORDS)
+		return ERROR;
+
+	/* the record after the newest one is the oldest one */
+	return EEPROM_readBlock(AUDIT_RECORD_ADDRESS((g_auditNext + age) % AUDIT_NUM_RECORDS), (uint8 *)record, AUDIT_RECORD_SIZE);
+}
+
+boolean AUDIT_isLinked(const Audit_RecordType *previous,const Audit_RecordType *record)
+{
+	return AUDIT_follows(previous->link, record);
+}
+
+uint8 AUDIT_getDropped(void)
+{
+	return g_auditDropped;
+}
+
+void AUDIT_tick(void)
+{
+	if(g_auditTime < AUDIT_MAX_TIME) /* stops instead of wrapping so the time never goes back */
+	{
+		g_auditTime++;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		AUDIT_loadKey
+* Description:			Function to read the key of the links from the internal EEPROM, on the
+* 						first boot it is drawn from the entropy pool of the credentials, so
+* 						CREDENTIAL_init must run first. A new key breaks the whole chain.
+* Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR if the key can't be written
+* Return value:      	uint8
+********************************************************************************/
+static uint8 AUDIT_loadKey(void)
+{
+	Audit_KeyType block;
+	uint16 crc;
+
+	if(INT_EEPROM_readBlock(AUDIT_KEY_ADDRESS, (uint8 *)&block, sizeof(block)) == ERROR)
+		return ERROR;
+
+	crc = CRC16_update(CRC16_INITIAL_VALUE, block.key, HALFSIPHASH_KEY_SIZE);
+	if( (block.crc[0] != (uint8)crc) || (block.crc[1] != (uint8)(crc>>8)) )
+	{
+		CREDENTIAL_random(block.key);
+		crc = CRC16_update(CRC16_INITIAL_VALUE, block.key, HALFSIPHASH_KEY_SIZE);
+		block.crc[0] = (uint8)crc;
+		block.crc[1] = (uint8)(crc>>8);
+		if(INT_EEPROM_writeBlock(AUDIT_KEY_ADDRESS, (const uint8 *)&block, sizeof(block)) == ERROR)
+			return ERROR;
+	}
+
+	for(uint8 i = 0 ; i < HALFSIPHASH_KEY_SIZE ; i++)
+	{
+		g_auditKey[i] = block.key[i];
+	}
+	return SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name:		AUDIT_computeLink
+* Description:			Function to calculate the link of a record from the link of the previous record.
+* Parameters (in):    	Link of the previous record, the record, array of AUDIT_LINK_SIZE to store the link in
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+static void AUDIT_computeLink(const uint8 *previousLink,const Audit_RecordType *record,uint8 *link)
+{
+	uint8 message[AUDIT_RECORD_SIZE]; /* the previous link then the record without its link */
+	uint8 hash[HALFSIPHASH_OUTPUT_SIZE];
+
+	message[0] = previousLink[0];
+	message[1] = previousLink[1];
+	for(uint8 i = 0 ; i < (AUDIT_RECORD_SIZE - AUDIT_LINK_SIZE) ; i++)
+	{
+		message[AUDIT_LINK_SIZE + i] = ((const uint8 *)record)[i];
+	}
+	HALFSIPHASH_compute(g_auditKey, message, sizeof(message), hash);
+	link[0] = hash[0];
+	link[1] = hash[1];
+}
+
+/*******************************************************************************
+* Function Name:		AUDIT_follows
+* Description:			Function to check the link of a record against the link of the previous one
+* Parameters (in):    	Link of the previous record, the record
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+static boolean AUDIT_follows(const uint8 *previousLink,const Audit_RecordType *record)
+{
+	uint8 link[AUDIT_LINK_SIZE];
+
+	if(record->event == AUDIT_EVENT_ERASED)
+		return FALSE;
+
+	AUDIT_computeLink(previousLink, record, link);
+	return (link[0] == record->link[0]) && (link[1] == record->link[1]);
+}
+
+/*******************************************************************************
+* Function Name:		AUDIT_getTime
+* Description:			Function to get the time of a record
+* Parameters (in):    	Pointer to the record
+* Parameters (out):   	Seconds of power on time
+* Return value:      	uint32
+********************************************************************************/
+static uint32 AUDIT_getTime(const Audit_RecordType *record)
+{
+	return (uint32)record->time[0] | ((uint32)record->time[1]<<8) | ((uint32)record->time[2]<<16);
+}
@@ -0,0 +1,192 @@
+/******************************************************************************
+*  File name:		audit.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef APP_AUDIT_H_
+#define APP_AUDIT_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "../HAL/EXT_EEPORM/eeprom.h"
+#include "../LIB/halfsiphash.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * Append only log of the unlocks, wrong passwords, alarms and changes of the
+ * passwords. Every event is one 8 bytes record in a circular region, the oldest
+ * records are overwritten when it is full.
+ *
+ * Every record ends with a 16-bit link : a keyed HalfSipHash of the link of the
+ * previous record and the bytes of this one. Editing, removing or reordering records
+ * breaks the chain, the breaks are counted when the log is streamed out. The newest
+ * record is the end of the chain so no sequence number is needed.
+ *
+ * The key is drawn from the entropy pool of the credentials on the first boot and kept
+ * in the internal EEPROM, only MCU2 can compute or check a link. The links catch a bad
+ * page or bit and an edit made off the lock, a made up record passes with a chance of
+ * 1 in 65536 and every try costs putting the 24C16 back. They don't catch an erased log,
+ * records cut off at its end (a shorter chain is still a chain) nor an older image of
+ * the log of the same lock put back, and a forger who can try records on the lock
+ * itself gets one through in about 65536 tries.
+ *
+ * The events are kept in a RAM staging buffer and written a page at a time by
+ * AUDIT_flush, which is only called when no reply is awaited on the door path.
+ * Staged events are lost if the power drops before they are flushed.
+ */
+#define AUDIT_START_ADDRESS			0x180	/* first address of the log (page aligned), the old password cells start at 0x320 */
+#define AUDIT_NUM_RECORDS			48		/* number of records in the log */
+#define AUDIT_RECORD_SIZE			8
+#define AUDIT_STAGING_RECORDS		4		/* events kept in RAM between two flushes */
+#define AUDIT_MAX_TIME				0xFFFFFFUL	/* 24-bit time in seconds, about 194 days of power on time */
+#define AUDIT_NO_SLOT				0xFF	/* the event isn't related to a user slot */
+#define AUDIT_KEY_ADDRESS			0x020	/* of the key of the links in the internal EEPROM, after the credential keys */
+
+#if ((AUDIT_START_ADDRESS % EEPROM_PAGE_SIZE) != 0) || ((EEPROM_PAGE_SIZE % AUDIT_RECORD_SIZE) != 0)
+
+#error "An audit record must never cross a page boundary"
+
+#endif
+
+#if (AUDIT_NUM_RECORDS > 0xFF) || ((AUDIT_NUM_RECORDS % (EEPROM_PAGE_SIZE / AUDIT_RECORD_SIZE)) != 0)
+
+#error "The audit log is read in full pages and its size must fit in 8 bits"
+
+#endif
+
+#if ((AUDIT_START_ADDRESS + (AUDIT_NUM_RECORDS * AUDIT_RECORD_SIZE)) > 0x320)
+
+#error "The audit log overlaps the old password cells"
+
+#endif
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Audit_EventType
+* Type: Enumeration
+* Description: Data type to represent the events of the log, the meaning of the slot
+* 			   and result fields of every event is given next to it
+********************************************************************************/
+typedef enum
+{
+	AUDIT_EVENT_BOOT,				/* no slot, result = ERROR if a region of the EEPROM couldn't be read */
+	AUDIT_EVENT_UNLOCK,				/* slot of the user or AUDIT_NO_SLOT for the main password, result = role */
+	AUDIT_EVENT_WRONG_PASSWORD,		/* no slot, result = tries left before the lockout */
+	AUDIT_EVENT_LOCKED_OUT,			/* no slot, result = minutes left (255 at most), the password wasn't checked */
+	AUDIT_EVENT_ALARM,				/* no slot, result = 0 */
+	AUDIT_EVENT_PASSWORD_CHANGE,	/* no slot, result = SUCCESS or ERROR */
+	AUDIT_EVENT_USER_ADDED,			/* new slot, result = Credential_StatusType */
+	AUDIT_EVENT_USER_REVOKED,		/* slot, result = Credential_StatusType */
+	AUDIT_EVENT_MAINTENANCE,		/* no slot, result = 0 refused, 1 the EEPROM was only read, 2 it was written */
+	AUDIT_EVENT_BUS_ERROR,			/* no slot, result = new TWI timeouts and errors (255 at most) */
+	AUDIT_EVENT_UNLOCK_FAULT,		/* no slot, result = DOOR_Stalled or DOOR_TimedOut, the bolt didn't reach its open end-stop */
+	AUDIT_EVENT_LOCK_FAULT,			/* no slot, result = DOOR_Stalled or DOOR_TimedOut, the bolt didn't reach its closed end-stop */
+	AUDIT_EVENT_ERASED = 0xFF		/* erased record, never logged */
+}Audit_EventType;
+
+/*******************************************************************************
+* Name: Audit_KeyType
+* Type: Structure
+* Description: Data type to represent the key of the links exactly as it is stored in
+* 			   the internal EEPROM, an erased or broken block gives a new key
+********************************************************************************/
+typedef struct
+{
+	uint8 key[HALFSIPHASH_KEY_SIZE];
+	uint8 crc[2]; /* CRC-16/CCITT of the key, little endian */
+}Audit_KeyType;
+
+/*******************************************************************************
+* Name: Audit_RecordType
+* Type: Structure
+* Description: Data type to represent one record of the log as it is stored
+********************************************************************************/
+typedef struct
+{
+	uint8 time[3]; /* seconds of power on time since the log was started, little endian */
+	uint8 event;
+	uint8 slot;
+	uint8 result;
+	uint8 link[2]; /* truncated HalfSipHash of the previous link and the bytes above */
+}Audit_RecordType;
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		AUDIT_init
+* Description:			Function to find the end of the chain and continue the time from it.
+* Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+uint8 AUDIT_init(void);
+
+/*******************************************************************************
+* Function Name:		AUDIT_log
+* Description:			Function to add an event to the staging buffer, no EEPROM access unless
+* 						the buffer is full.
+* Parameters (in):    	Event, slot and result
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void AUDIT_log(Audit_EventType event,uint8 slot,uint8 result);
+
+/*******************************************************************************
+* Function Name:		AUDIT_flush
+* Description:			Function to write the staged events, one page write for every page they fall in.
+* Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR, the events that were not written stay staged
+* Return value:      	uint8
+********************************************************************************/
+uint8 AUDIT_flush(void);
+
+/*******************************************************************************
+* Function Name:		AUDIT_readRecord
+* Description:			Function to read a record of the log by its age, 0 is the oldest
+* 						record and AUDIT_NUM_RECORDS - 1 the newest one. Staged events are
+* 						not read so the log should be flushed first.
+* Parameters (in):    	Age of the record, pointer to store the record in
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+uint8 AUDIT_readRecord(uint8 age,Audit_RecordType *record);
+
+/*******************************************************************************
+* Function Name:		AUDIT_isLinked
+* Description:			Function to check that a record is chained to the record before it.
+* Parameters (in):    	The previous record and the record
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+boolean AUDIT_isLinked(const Audit_RecordType *previous,const Audit_RecordType *record);
+
+/*******************************************************************************
+* Function Name:		AUDIT_getDropped
+* Description:			Function to get the number of events lost as the staging buffer
+* 						was full and couldn't be written since the last reset.
+* Parameters (in):    	None
+* Parameters (out):   	Number of events (saturates at 255)
+* Return value:      	uint8
+********************************************************************************/
+uint8 AUDIT_getDropped(void);
+
+/*******************************************************************************
+* Function Name:		AUDIT_tick
+* Description:			Function to count the time of the records, called every second from the timer interrupt
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void AUDIT_tick(void);
+
+#endif /* APP_AUDIT_H_ */
@@ -0,0 +1,209 @@
+/******************************************************************************
+*  File name:		lockout.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "lockout.h"
+#include "../LIB/crc16.h"
+#include "util/atomic.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+#define LOCKOUT_RECORD_ADDRESS(index)	(LOCKOUT_START_ADDRESS + ((uint16)(index) * LOCKOUT_RECORD_SIZE))
+#define LOCKOUT_RECORDS_PER_PAGE		(EEPROM_PAGE_SIZE / LOCKOUT_RECORD_SIZE)
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+static uint8 g_lockoutFailures = 0; /* wrong passwords in a row */
+static uint8 g_lockoutHead = LOCKOUT_NUM_RECORDS - 1; /* index of the newest record */
+static uint8 g_lockoutSequence = 0xFF; /* sequence number of the newest record */
+static volatile uint16 g_lockoutRemaining = 0; /* seconds left, counted down by the timer */
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+static uint16 LOCKOUT_crc(const Lockout_RecordType *record);
+static uint16 LOCKOUT_getDuration(uint8 failures);
+static void LOCKOUT_save(void);
+static void LOCKOUT_start(void);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+uint8 LOCKOUT_init(void)
+{
+	Lockout_RecordType records[LOCKOUT_RECORDS_PER_PAGE];
+	boolean found = FALSE;
+
+	g_lockoutFailures = 0;
+	g_lockoutHead = LOCKOUT_NUM_RECORDS - 1; /* so the first record goes to the start of the log */
+	g_lockoutSequence = 0xFF;
+
+	/* read the whole log once, one page at a time. It holds the last LOCKOUT_NUM_RECORDS sequence
+	 * numbers so the newest record is found by their differences even after the 8-bit number wraps */
+	for(uint8 index = 0 ; index < LOCKOUT_NUM_RECORDS ; index += LOCKOUT_RECORDS_PER_PAGE)
+	{
+		if(EEPROM_readBlock(LOCKOUT_RECORD_ADDRESS(index), (uint8 *)records, EEPROM_PAGE_SIZE) == ERROR)
+		{
+			g_lockoutFailures = LOCKOUT_FREE_TRIES; /* can't know the failures, lock it to be safe */
+			LOCKOUT_start();
+			return ERROR;
+		}
+		for(uint8 i = 0 ; i < LOCKOUT_RECORDS_PER_PAGE ; i++)
+		{
+			uint16 crc = LOCKOUT_crc(&records[i]);
+			if( (records[i].crc[0] != (uint8)crc) || (records[i].crc[1] != (uint8)(crc>>8)) )
+				continue; /* erased or torn record */
+
+			if( (found == FALSE) || ((sint8)(records[i].sequence - g_lockoutSequence) > 0) )
+			{
+				g_lockoutHead = index + i;
+				g_lockoutSequence = records[i].sequence;
+				g_lockoutFailures = records[i].failures;
+				found = TRUE;
+			}
+		}
+	}
+	LOCKOUT_start();
+	return SUCCESS;
+}
+
+uint16 LOCKOUT_getRemaining(void)
+{
+	uint16 remaining;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		remaining = g_lockoutRemaining;
+	}
+	return remaining;
+}
+
+uint8 LOCKOUT_getTriesLeft(void)
+{
+	if(LOCKOUT_getRemaining() != 0)
+		return 0; /* no password is checked until the lockout ends */
+
+	/* after a lockout one more wrong password starts the next one */
+	return (g_lockoutFailures < LOCKOUT_FREE_TRIES) ? (LOCKOUT_FREE_TRIES - g_lockoutFailures) : 1;
+}
+
+void LOCKOUT_recordAttempt(void)
+{
+	if(g_lockoutFailures < 0xFF) /* a record only when the count changes */
+	{
+		g_lockoutFailures++;
+		LOCKOUT_save();
+	}
+	LOCKOUT_start();
+}
+
+void LOCKOUT_recordSuccess(void)
+{
+	if(g_lockoutFailures != 0)
+	{
+		g_lockoutFailures = 0;
+		LOCKOUT_save();
+	}
+	LOCKOUT_start();
+}
+
+void LOCKOUT_tick(void)
+{
+	if(g_lockoutRemaining != 0)
+	{
+		g_lockoutRemaining--;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_crc
+* Description:			Function to calculate the CRC-16/CCITT of a record without its CRC field.
+* Parameters (in):    	Pointer to the record
+* Parameters (out):   	The CRC
+* Return value:      	uint16
+********************************************************************************/
+static uint16 LOCKOUT_crc(const Lockout_RecordType *record)
+{
+	return CRC16_update(CRC16_INITIAL_VALUE, (const uint8 *)record, LOCKOUT_RECORD_SIZE - 2);
+}
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_getDuration
+* Description:			Function to get the lockout time after a number of wrong passwords
+* Parameters (in):    	Number of wrong passwords in a row
+* Parameters (out):   	Number of seconds
+* Return value:      	uint16
+********************************************************************************/
+static uint16 LOCKOUT_getDuration(uint8 failures)
+{
+	uint8 shift;
+
+	if(failures < LOCKOUT_FREE_TRIES)
+		return 0;
+
+	shift = failures - LOCKOUT_FREE_TRIES;
+	if(shift > LOCKOUT_MAX_SHIFT)
+	{
+		shift = LOCKOUT_MAX_SHIFT;
+	}
+	return (uint16)LOCKOUT_BASE_SECONDS << shift;
+}
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_save
+* Description:			Function to append the number of failures to the log, one record
+* 						write, the previous record stays valid if the write is torn.
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+static void LOCKOUT_save(void)
+{
+	Lockout_RecordType record;
+	Lockout_RecordType readBack;
+	uint16 crc;
+
+	record.failures = g_lockoutFailures;
+	for(uint8 tries = 0 ; tries < LOCKOUT_WRITE_TRIES ; tries++)
+	{
+		g_lockoutHead = (g_lockoutHead + 1) % LOCKOUT_NUM_RECORDS;
+		g_lockoutSequence++;
+		record.sequence = g_lockoutSequence;
+		crc = LOCKOUT_crc(&record);
+		record.crc[0] = (uint8)crc;
+		record.crc[1] = (uint8)(crc>>8);
+
+		if(EEPROM_writePage(LOCKOUT_RECORD_ADDRESS(g_lockoutHead), (const uint8 *)&record, LOCKOUT_RECORD_SIZE) == ERROR)
+			continue;
+
+		if(EEPROM_readBlock(LOCKOUT_RECORD_ADDRESS(g_lockoutHead), (uint8 *)&readBack, LOCKOUT_RECORD_SIZE) == ERROR)
+			continue;
+
+		if( (readBack.sequence == record.sequence) && (readBack.failures == record.failures)
+				&& (readBack.crc[0] == record.crc[0]) && (readBack.crc[1] == record.crc[1]) )
+			return;
+	}
+	/* the RAM state is still used until the next reset */
+}
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_start
+* Description:			Function to set the remaining time to the lockout of the current failures
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+static void LOCKOUT_start(void)
+{
+	uint16 duration = LOCKOUT_getDuration(g_lockoutFailures);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_lockoutRemaining = duration;
+	}
+}
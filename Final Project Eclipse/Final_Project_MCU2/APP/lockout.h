@@ -0,0 +1,134 @@
+/******************************************************************************
+*  File name:		lockout.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef APP_LOCKOUT_H_
+#define APP_LOCKOUT_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "../HAL/EXT_EEPORM/eeprom.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * Brute force protection : after LOCKOUT_FREE_TRIES wrong passwords in a row every
+ * password check is refused for LOCKOUT_BASE_SECONDS, and every wrong password after
+ * that doubles the time up to LOCKOUT_MAX_SHIFT doublings. A right password clears it.
+ *
+ * Every attempt is saved as a failure before the password is checked and cleared
+ * only if it matches, so cutting the power in the middle of a check doesn't save a try.
+ *
+ * Every change of the number of failures is saved as one 4 bytes record in a circular
+ * log so a reset doesn't give the attacker new tries. There is no clock while the power
+ * is off so after a reset the lockout of the saved number of failures starts again in full.
+ */
+#define LOCKOUT_FREE_TRIES			3		/* wrong passwords allowed before the first lockout */
+#define LOCKOUT_BASE_SECONDS		60		/* first lockout, the alarm of MCU1 lasts as long */
+#define LOCKOUT_MAX_SHIFT			6		/* the lockout stops doubling at 64 minutes */
+
+#define LOCKOUT_START_ADDRESS		0x100	/* first address of the log (page aligned) */
+#define LOCKOUT_NUM_RECORDS			32		/* number of records in the log */
+#define LOCKOUT_RECORD_SIZE			4
+#define LOCKOUT_WRITE_TRIES			2		/* number of records to try before giving up on a write */
+
+#if ((LOCKOUT_START_ADDRESS % EEPROM_PAGE_SIZE) != 0) || ((EEPROM_PAGE_SIZE % LOCKOUT_RECORD_SIZE) != 0)
+
+#error "A lockout record must never cross a page boundary"
+
+#endif
+
+#if (LOCKOUT_NUM_RECORDS > 32) || ((LOCKOUT_NUM_RECORDS % (EEPROM_PAGE_SIZE / LOCKOUT_RECORD_SIZE)) != 0)
+
+#error "The log is read in full pages and must have at most 32 records (less than half the 8-bit sequence numbers)"
+
+#endif
+
+#if ((LOCKOUT_BASE_SECONDS << LOCKOUT_MAX_SHIFT) > 0xFFFF)
+
+#error "The longest lockout doesn't fit in 16 bits"
+
+#endif
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Lockout_RecordType
+* Type: Structure
+* Description: Data type to represent one record of the lockout log as it is stored
+********************************************************************************/
+typedef struct
+{
+	uint8 sequence; /* one more than the previous record, wraps around */
+	uint8 failures; /* wrong passwords in a row */
+	uint8 crc[2]; /* CRC-16/CCITT of the bytes above, little endian */
+}Lockout_RecordType;
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_init
+* Description:			Function to find the newest record of the log and restart its lockout
+* Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+uint8 LOCKOUT_init(void);
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_getRemaining
+* Description:			Function to get the remaining time of the lockout
+* Parameters (in):    	None
+* Parameters (out):   	Number of seconds, 0 if password checks are allowed
+* Return value:      	uint16
+********************************************************************************/
+uint16 LOCKOUT_getRemaining(void);
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_getTriesLeft
+* Description:			Function to get the number of wrong passwords left before the next lockout,
+* 						0 while a lockout is running
+* Parameters (in):    	None
+* Parameters (out):   	Number of tries
+* Return value:      	uint8
+********************************************************************************/
+uint8 LOCKOUT_getTriesLeft(void);
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_recordAttempt
+* Description:			Function to count a password check as a wrong password and save it
+* 						before the check, the lockout starts if needed
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void LOCKOUT_recordAttempt(void);
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_recordSuccess
+* Description:			Function to clear the failures after a right password
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void LOCKOUT_recordSuccess(void);
+
+/*******************************************************************************
+* Function Name:		LOCKOUT_tick
+* Description:			Function to count the lockout time, called every second from the timer interrupt
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void LOCKOUT_tick(void);
+
+#endif /* APP_LOCKOUT_H_ */
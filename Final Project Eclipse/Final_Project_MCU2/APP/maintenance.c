@@ -0,0 +1,234 @@
+/******************************************************************************
+*  File name:		maintenance.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "maintenance.h"
+#include "../LIB/crc16.h"
+#include "util/delay.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+#define MAINTENANCE_HEADER_SIZE			4	/* command or status, address and length */
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+static const UART_ConfigType g_maintenanceLink = {MAINTENANCE_BAUD_RATE,'#',UART_1_STOP_BIT,UART_8_BITS,UART_DISABLED_PARTIY,POLLING};
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+static uint8 MAINTENANCE_receive(uint8 *byte,uint16 timeout);
+static void MAINTENANCE_drain(void);
+static boolean MAINTENANCE_isValidChunk(uint16 address,uint8 length);
+static uint8 MAINTENANCE_writeChunk(uint16 address,const uint8 *data,uint8 length);
+static void MAINTENANCE_sendFrame(uint8 status,uint16 address,uint8 length,const uint8 *data);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+boolean MAINTENANCE_run(const UART_ConfigType *linkConfig)
+{
+	uint8 header[MAINTENANCE_HEADER_SIZE];
+	uint8 data[MAINTENANCE_CHUNK_SIZE];
+	uint8 crc[2];
+	boolean written = FALSE;
+	boolean answered = FALSE;
+	boolean exit = FALSE;
+
+	UART_init(&g_maintenanceLink);
+	while(exit == FALSE)
+	{
+		uint8 received;
+		uint8 status = MAINTENANCE_NAK;
+		uint8 answerLength = 0;
+
+		if(MAINTENANCE_receive(&header[0], MAINTENANCE_IDLE_TIMEOUT) == ERROR)
+			break; /* the host is gone */
+
+		received = SUCCESS;
+		for(uint8 i = 1 ; (i < MAINTENANCE_HEADER_SIZE) && (received == SUCCESS) ; i++)
+		{
+			received = MAINTENANCE_receive(&header[i], MAINTENANCE_BYTE_TIMEOUT);
+		}
+
+		uint8 command = header[0];
+		uint16 address = (uint16)header[1] | ((uint16)header[2]<<8);
+		uint8 length = header[3];
+		uint8 dataLength = (command == MAINTENANCE_CMD_WRITE) ? length : 0;
+
+		if( (received == SUCCESS) && (dataLength <= MAINTENANCE_CHUNK_SIZE) )
+		{
+			for(uint8 i = 0 ; (i < dataLength) && (received == SUCCESS) ; i++)
+			{
+				received = MAINTENANCE_receive(&data[i], MAINTENANCE_BYTE_TIMEOUT);
+			}
+			for(uint8 i = 0 ; (i < 2) && (received == SUCCESS) ; i++)
+			{
+				received = MAINTENANCE_receive(&crc[i], MAINTENANCE_BYTE_TIMEOUT);
+			}
+		}
+		else
+		{
+			received = ERROR;
+		}
+
+		if(received == SUCCESS)
+		{
+			uint16 expected = CRC16_update(CRC16_INITIAL_VALUE, header, MAINTENANCE_HEADER_SIZE);
+			expected = CRC16_update(expected, data, dataLength);
+			if( (crc[0] != (uint8)expected) || (crc[1] != (uint8)(expected>>8)) )
+			{
+				received = ERROR;
+			}
+		}
+
+		if(received == ERROR)
+		{
+			MAINTENANCE_drain(); /* skip the rest of the broken frame so it isn't taken as a new one */
+		}
+		else if(command == MAINTENANCE_CMD_EXIT)
+		{
+			status = MAINTENANCE_ACK;
+			exit = TRUE;
+		}
+		else if( ((command == MAINTENANCE_CMD_READ) || (command == MAINTENANCE_CMD_WRITE))
+				&& (MAINTENANCE_isValidChunk(address, length) == TRUE) )
+		{
+			if(command == MAINTENANCE_CMD_READ)
+			{
+				/* one sequential read, the chip moves to the next page by itself */
+				status = (EEPROM_readBlock(address, data, length) == SUCCESS) ? MAINTENANCE_ACK : MAINTENANCE_EEPROM_FAILED;
+				answerLength = (status == MAINTENANCE_ACK) ? length : 0;
+			}
+			else
+			{
+				written = TRUE; /* even a failed write may have changed some pages */
+				status = (MAINTENANCE_writeChunk(address, data, length) == SUCCESS) ? MAINTENANCE_ACK : MAINTENANCE_EEPROM_FAILED;
+			}
+		}
+
+		MAINTENANCE_sendFrame(status, address, answerLength, data);
+		answered = TRUE;
+	}
+
+	if(answered == TRUE)
+	{
+		UART_waitTransmitComplete(); /* the last answer must leave at the maintenance baud rate */
+	}
+	UART_init(linkConfig);
+	return written;
+}
+
+/*******************************************************************************
+* Function Name:		MAINTENANCE_receive
+* Description:			Function to wait for a byte from the link for a limited time
+* Parameters (in):    	Pointer to store the byte in, time to wait in ms
+* Parameters (out):   	SUCCESS or ERROR if nothing came in time
+* Return value:      	uint8
+********************************************************************************/
+static uint8 MAINTENANCE_receive(uint8 *byte,uint16 timeout)
+{
+	for(uint16 ms = 0 ; ms < timeout ; ms++)
+	{
+		for(uint8 i = 0 ; i < 100 ; i++)
+		{
+			if(UART_isByteReceived() == TRUE)
+			{
+				*byte = UART_receiveByte();
+				return SUCCESS;
+			}
+			_delay_us(10);
+		}
+	}
+	return ERROR;
+}
+
+/*******************************************************************************
+* Function Name:		MAINTENANCE_drain
+* Description:			Function to drop the bytes received until the link is quiet for MAINTENANCE_BYTE_TIMEOUT
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+static void MAINTENANCE_drain(void)
+{
+	uint8 byte;
+	while(MAINTENANCE_receive(&byte, MAINTENANCE_BYTE_TIMEOUT) == SUCCESS){}
+}
+
+/*******************************************************************************
+* Function Name:		MAINTENANCE_isValidChunk
+* Description:			Function to check that a chunk is a number of full pages inside the chip
+* Parameters (in):    	First address and length of the chunk
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+static boolean MAINTENANCE_isValidChunk(uint16 address,uint8 length)
+{
+	return (length != 0) && (length <= MAINTENANCE_CHUNK_SIZE) && ((length % EEPROM_PAGE_SIZE) == 0)
+			&& ((address % EEPROM_PAGE_SIZE) == 0) && (((uint32)address + length) <= EEPROM_SIZE);
+}
+
+/*******************************************************************************
+* Function Name:		MAINTENANCE_writeChunk
+* Description:			Function to write a chunk one page at a time and read every page back
+* Parameters (in):    	First address, the data and its length
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+static uint8 MAINTENANCE_writeChunk(uint16 address,const uint8 *data,uint8 length)
+{
+	uint8 readBack[EEPROM_PAGE_SIZE];
+
+	for(uint8 offset = 0 ; offset < length ; offset += EEPROM_PAGE_SIZE)
+	{
+		if(EEPROM_writePage(address + offset, data + offset, EEPROM_PAGE_SIZE) == ERROR)
+			return ERROR;
+	}
+
+	/* the chip is polled until its last write cycle ends, then every page is compared */
+	for(uint8 offset = 0 ; offset < length ; offset += EEPROM_PAGE_SIZE)
+	{
+		if(EEPROM_readBlock(address + offset, readBack, EEPROM_PAGE_SIZE) == ERROR)
+			return ERROR;
+
+		for(uint8 i = 0 ; i < EEPROM_PAGE_SIZE ; i++)
+		{
+			if(readBack[i] != data[offset + i])
+				return ERROR;
+		}
+	}
+	return SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name:		MAINTENANCE_sendFrame
+* Description:			Function to send an answer frame with its CRC
+* Parameters (in):    	Status, address and length of the chunk, the data if the length isn't 0
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+static void MAINTENANCE_sendFrame(uint8 status,uint16 address,uint8 length,const uint8 *data)
+{
+	uint8 header[MAINTENANCE_HEADER_SIZE] = {status, (uint8)address, (uint8)(address>>8), length};
+	uint16 crc = CRC16_update(CRC16_INITIAL_VALUE, header, MAINTENANCE_HEADER_SIZE);
+	crc = CRC16_update(crc, data, length);
+
+	for(uint8 i = 0 ; i < MAINTENANCE_HEADER_SIZE ; i++)
+	{
+		UART_sendByte(header[i]);
+	}
+	for(uint8 i = 0 ; i < length ; i++)
+	{
+		UART_sendByte(data[i]);
+	}
+	UART_sendByte((uint8)crc);
+	UART_sendByte((uint8)(crc>>8));
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+*  File name:		maintenance.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef APP_MAINTENANCE_H_
+#define APP_MAINTENANCE_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "../MCAL/UART/uart.h"
+#include "../HAL/EXT_EEPORM/eeprom.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * Maintenance mode : the whole external EEPROM is read or written over the link
+ * so a lock can be backed up, restored or provisioned without pulling the chip.
+ *
+ * After MSG_Maintenance is accepted both sides switch to MAINTENANCE_BAUD_RATE and
+ * the host sends one frame at a time, waiting for the answer before the next one :
+ *
+ *     command, address (2 bytes), length, data (WRITE only), CRC (2 bytes)
+ *
+ * and MCU2 answers with
+ *
+ *     status, address (2 bytes), length, data (READ only), CRC (2 bytes)
+ *
+ * Addresses and CRCs are little endian, the CRC is the CRC-16/CCITT of all the bytes
+ * of the frame before it. A chunk starts at a page boundary and is a number of full
+ * pages up to MAINTENANCE_CHUNK_SIZE, so it is one sequential read or a few page writes.
+ * Every written chunk is read back before it is acknowledged.
+ *
+ * A full 2 KB image is 32 chunks of 64 bytes : about 0.1 s to read and 0.8 s to
+ * write at 250000 baud, most of it in the write cycles of the chip.
+ *
+ * The device keys stay in the internal EEPROM and are never sent, so a backup only
+ * restores on the lock that made it. Restored on another lock, its password and users
+ * are erased when the maintenance mode ends (see APP_checkKeys), the lock must be reset
+ * and set up again like a new one, and the links of its audit log show up as broken.
+ */
+#define MAINTENANCE_BAUD_RATE			250000	/* exact at 8 MHz with the double speed mode */
+#define MAINTENANCE_CHUNK_SIZE			64		/* max data bytes in a frame, a multiple of the page size */
+#define MAINTENANCE_BYTE_TIMEOUT		50		/* ms between two bytes of the same frame */
+#define MAINTENANCE_IDLE_TIMEOUT		10000	/* ms without any frame before going back to the normal link */
+
+#define MAINTENANCE_CMD_READ			0x52	/* 'R' */
+#define MAINTENANCE_CMD_WRITE			0x57	/* 'W' */
+#define MAINTENANCE_CMD_EXIT			0x58	/* 'X' */
+
+#define MAINTENANCE_ACK					0x06	/* done */
+#define MAINTENANCE_NAK					0x15	/* bad CRC, command, alignment or length, nothing was done */
+#define MAINTENANCE_EEPROM_FAILED		0x1E	/* the chip didn't answer or the read back didn't match */
+
+#if ((MAINTENANCE_CHUNK_SIZE % EEPROM_PAGE_SIZE) != 0) || (MAINTENANCE_CHUNK_SIZE > 0xFF)
+
+#error "A maintenance chunk must be a number of full pages and its length must fit in 8 bits"
+
+#endif
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		MAINTENANCE_run
+* Description:			Function to switch the link to the maintenance baud rate and answer frames
+* 						until the host exits or stays idle for MAINTENANCE_IDLE_TIMEOUT, the link
+* 						is then switched back to its normal configuration.
+* Parameters (in):    	Normal configuration of the link
+* Parameters (out):   	TRUE if any byte of the EEPROM was written
+* Return value:      	boolean
+********************************************************************************/
+boolean MAINTENANCE_run(const UART_ConfigType *linkConfig);
+
+#endif /* APP_MAINTENANCE_H_ */
@@ -4,13 +4,19 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../HAL/EXT_EEPORM/eeprom.c 
+../HAL/EXT_EEPORM/credential.c \
+../HAL/EXT_EEPORM/eeprom.c \
+../HAL/EXT_EEPORM/journal.c 
 
 OBJS += \
-./HAL/EXT_EEPORM/eeprom.o 
+./HAL/EXT_EEPORM/credential.o \
+./HAL/EXT_EEPORM/eeprom.o \
+./HAL/EXT_EEPORM/journal.o 
 
 C_DEPS += \
-./HAL/EXT_EEPORM/eeprom.d 
+./HAL/EXT_EEPORM/credential.d \
+./HAL/EXT_EEPORM/eeprom.d \
+./HAL/EXT_EEPORM/journal.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
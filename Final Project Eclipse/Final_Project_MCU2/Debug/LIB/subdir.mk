@@ -0,0 +1,36 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../LIB/capture.c \
+../LIB/crc16.c \
+../LIB/halfsiphash.c \
+../LIB/stack.c \
+../LIB/trace.c 
+
+OBJS += \
+./LIB/capture.o \
+./LIB/crc16.o \
+./LIB/halfsiphash.o \
+./LIB/stack.o \
+./LIB/trace.o 
+
+C_DEPS += \
+./LIB/capture.d \
+./LIB/crc16.d \
+./LIB/halfsiphash.d \
+./LIB/stack.d \
+./LIB/trace.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+LIB/%.o: ../LIB/%.c LIB/subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
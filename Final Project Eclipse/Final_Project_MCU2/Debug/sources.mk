@@ -23,9 +23,13 @@ APP \
 HAL/BUZZER \
 HAL/EXT_EEPORM \
 HAL/MOTOR \
+LIB \
+MCAL/ADC \
 MCAL/GPIO \
+MCAL/INT_EEPROM \
 MCAL/PWM0 \
 MCAL/TIMER1 \
+MCAL/TIMER2 \
 MCAL/TWI \
 MCAL/UART \
 . \
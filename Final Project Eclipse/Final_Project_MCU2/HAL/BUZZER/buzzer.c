@@ -10,18 +10,183 @@
 
 #include "buzzer.h"
 #include "../../MCAL/GPIO/gpio.h"
+#include "../../MCAL/TIMER1/timer1.h"
+#include "avr/io.h" /* To use the IO Ports Registers */
+#include "util/atomic.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define BUZZER_MS(ms)		((uint8)(((uint32)(ms) * BUZZER_TICKS_PER_SECOND) / 1000))
+#define BUZZER_SILENCE		0
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+typedef struct
+{
+	uint16 frequency; /* Hz or BUZZER_SILENCE */
+	uint8 ticks; /* 0 ends the pattern */
+}Buzzer_StepType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static const Buzzer_StepType g_buzzerClick[] = {{4000,BUZZER_MS(16)},{0,0}};
+static const Buzzer_StepType g_buzzerAccept[] = {{2000,BUZZER_MS(80)},{BUZZER_SILENCE,BUZZER_MS(40)},{3000,BUZZER_MS(120)},{0,0}};
+static const Buzzer_StepType g_buzzerReject[] = {{400,BUZZER_MS(120)},{BUZZER_SILENCE,BUZZER_MS(64)},{400,BUZZER_MS(120)},
+		{BUZZER_SILENCE,BUZZER_MS(64)},{400,BUZZER_MS(120)},{0,0}};
+static const Buzzer_StepType g_buzzerSiren[] = {{1200,BUZZER_MS(248)},{800,BUZZER_MS(248)},{0,0}};
+static const Buzzer_StepType * const g_buzzerPatterns[] = {g_buzzerClick,g_buzzerAccept,g_buzzerReject,g_buzzerSiren};
+
+static const Buzzer_StepType * volatile g_buzzerSteps = NULL_PTR; /* NULL_PTR if no pattern is playing */
+static Buzzer_PatternType g_buzzerPattern;
+static uint8 g_buzzerStep = 0;
+static uint8 g_buzzerTicks = 0; /* ticks left in the current step */
+static uint16 g_buzzerRepeatTicks = 0; /* ticks left before a repeated pattern stops, 0 to play it once */
+static uint16 g_buzzerFrequency = BUZZER_SILENCE; /* current output */
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void BUZZER_start(Buzzer_PatternType pattern,uint16 ticks);
+static void BUZZER_output(uint16 frequency);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
 
 void BUZZER_init(void)
 {
-	GPIO_setupPinDirection(BUZZER_PORT_ID, BUZZER_PIN_ID, PIN_OUTPUT);
+#if (BUZZER_USE_TONE == TRUE)
+	TIMER1_stopTone();
+#else
+	GPIO_OUTPUT(BUZZER);
+	GPIO_LOW(BUZZER);
+#endif
+	g_buzzerFrequency = BUZZER_SILENCE;
 }
 
 void BUZZER_on(void)
 {
-	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_HIGH);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_buzzerSteps = NULL_PTR;
+		BUZZER_output(BUZZER_ON_FREQUENCY);
+	}
 }
 
 void BUZZER_off(void)
 {
-	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_buzzerSteps = NULL_PTR;
+		BUZZER_output(BUZZER_SILENCE);
+	}
+}
+
+void BUZZER_play(Buzzer_PatternType pattern)
+{
+	BUZZER_start(pattern, 0);
+}
+
+void BUZZER_repeat(Buzzer_PatternType pattern,uint16 ticks)
+{
+	if(ticks != 0)
+	{
+		BUZZER_start(pattern, ticks);
+	}
+}
+
+boolean BUZZER_isPlaying(void)
+{
+	return (g_buzzerSteps != NULL_PTR);
+}
+
+void BUZZER_tick(void)
+{
+	const Buzzer_StepType *steps = g_buzzerSteps;
+	if(steps == NULL_PTR)
+		return;
+
+	if(g_buzzerRepeatTicks != 0)
+	{
+		g_buzzerRepeatTicks--;
+		if(g_buzzerRepeatTicks == 0)
+		{
+			g_buzzerSteps = NULL_PTR;
+			BUZZER_output(BUZZER_SILENCE);
+			return;
+		}
+	}
+
+	g_buzzerTicks--;
+	if(g_buzzerTicks == 0)
+	{
+		g_buzzerStep++;
+		if(steps[g_buzzerStep].ticks == 0) /* end of the pattern */
+		{
+			if(g_buzzerRepeatTicks == 0)
+			{
+				g_buzzerSteps = NULL_PTR;
+				BUZZER_output(BUZZER_SILENCE);
+				return;
+			}
+			g_buzzerStep = 0;
+		}
+		g_buzzerTicks = steps[g_buzzerStep].ticks;
+		BUZZER_output(steps[g_buzzerStep].frequency);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		BUZZER_start
+* Description:			Function to start a pattern unless a more important one is playing
+* Parameters (in):    	The pattern, ticks to repeat it for or 0 to play it once
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BUZZER_start(Buzzer_PatternType pattern,uint16 ticks)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if( (g_buzzerSteps == NULL_PTR) || (pattern >= g_buzzerPattern) )
+		{
+			g_buzzerPattern = pattern;
+			g_buzzerSteps = g_buzzerPatterns[pattern];
+			g_buzzerStep = 0;
+			g_buzzerTicks = g_buzzerSteps[0].ticks;
+			g_buzzerRepeatTicks = ticks;
+			BUZZER_output(g_buzzerSteps[0].frequency);
+		}
+	}
+}
+
+/*******************************************************************************
+* Function Name:		BUZZER_output
+* Description:			Function to drive the buzzer if its frequency changed
+* Parameters (in):    	Frequency in Hz or BUZZER_SILENCE
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BUZZER_output(uint16 frequency)
+{
+	if(frequency == g_buzzerFrequency)
+		return;
+
+#if (BUZZER_USE_TONE == TRUE)
+	if(frequency == BUZZER_SILENCE)
+		TIMER1_stopTone();
+	else
+		TIMER1_startTone(frequency);
+#else
+	GPIO_WRITE(BUZZER, (frequency == BUZZER_SILENCE) ? LOGIC_LOW : LOGIC_HIGH);
+#endif
+	g_buzzerFrequency = frequency;
 }
@@ -12,14 +12,37 @@
 *******************************************************************************/
 
 #include "../../LIB/std_types.h"
+#include "../../../SHARED/board_mcu2.h" /* BUZZER */
 
 
 /*******************************************************************************
 *                        		Definitions                                    *
 *******************************************************************************/
 
-#define BUZZER_PORT_ID					PORTB_ID
-#define	BUZZER_PIN_ID					PIN0_ID
+/* FALSE : active buzzer on BUZZER of board.cfg, the tones of the patterns are only on and off.
+ * TRUE : passive buzzer on OC1A (PD5) driven with the frequency of every step by timer 1 */
+#define BUZZER_USE_TONE					FALSE
+#define BUZZER_ON_FREQUENCY				2000	/* Hz of BUZZER_on */
+#define BUZZER_TICKS_PER_SECOND			125		/* rate of the BUZZER_tick calls */
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Buzzer_PatternType
+* Type: Enumeration
+* Description: Data type to represent the beep codes, a pattern can only be cut by one
+* 			   that comes after it in this list
+********************************************************************************/
+
+typedef enum
+{
+	BUZZER_CLICK, /* one short tick */
+	BUZZER_ACCEPT, /* two rising beeps */
+	BUZZER_REJECT, /* three low beeps */
+	BUZZER_SIREN /* two alternating tones, repeated */
+}Buzzer_PatternType;
 
 /*******************************************************************************
 *                      Functions Prototypes                                   *
@@ -37,7 +60,7 @@ void BUZZER_init(void);
 
 /*******************************************************************************
 * Function Name:		BUZZER_on
-* Description:			Function to turn the buzzer on
+* Description:			Function to turn the buzzer on until BUZZER_off, it cancels the pattern
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
@@ -47,7 +70,7 @@ void BUZZER_on(void);
 
 /*******************************************************************************
 * Function Name:		BUZZER_off
-* Description:			Function to turn the buzzer off
+* Description:			Function to turn the buzzer off, it cancels the pattern
 * Parameters (in):    	None
 * Parameters (out):   	None
 * Return value:      	void
@@ -55,4 +78,46 @@ void BUZZER_on(void);
 
 void BUZZER_off(void);
 
+/*******************************************************************************
+* Function Name:		BUZZER_play
+* Description:			Function to play a pattern once, it returns right away and the pattern
+* 						runs from BUZZER_tick
+* Parameters (in):    	The pattern
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BUZZER_play(Buzzer_PatternType pattern);
+
+/*******************************************************************************
+* Function Name:		BUZZER_repeat
+* Description:			Function to play a pattern again and again for some time without waiting
+* Parameters (in):    	The pattern and the number of ticks to play it for
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BUZZER_repeat(Buzzer_PatternType pattern,uint16 ticks);
+
+/*******************************************************************************
+* Function Name:		BUZZER_isPlaying
+* Description:			Function to check if a pattern is still playing
+* Parameters (in):    	None
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+boolean BUZZER_isPlaying(void);
+
+/*******************************************************************************
+* Function Name:		BUZZER_tick
+* Description:			Function to move the pattern forward, called BUZZER_TICKS_PER_SECOND times
+* 						per second from a timer interrupt
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void BUZZER_tick(void);
+
 #endif /* HAL_BUZZER_BUZZER_H_ */
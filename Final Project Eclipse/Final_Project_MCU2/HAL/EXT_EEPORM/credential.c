@@ -0,0 +1,479 @@
+/******************************************************************************
+*  File name:		credential.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "credential.h"
+#include "../../LIB/crc16.h"
+#include "../../LIB/halfsiphash.h"
+#include "../../MCAL/INT_EEPROM/int_eeprom.h"
+#include "../../MCAL/ADC/adc.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define CREDENTIAL_SLOT_ADDRESS(slot)	(CREDENTIAL_START_ADDRESS + ((uint16)(slot) * CREDENTIAL_RECORD_SIZE))
+#define CREDENTIAL_NEXT_SLOT(slot)		(((slot) + 1) & (CREDENTIAL_NUM_SLOTS - 1))
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static uint8 g_credentialTags[CREDENTIAL_NUM_SLOTS]; /* RAM index : tag of every slot */
+
+/* device keys from the internal EEPROM, the hash key protects the stored PINs and the index key spreads them over the table */
+static uint8 g_credentialHashKey[HALFSIPHASH_KEY_SIZE];
+static uint8 g_credentialIndexKey[HALFSIPHASH_KEY_SIZE];
+
+/* not cleared at reset, starts with whatever the SRAM holds and every new salt is mixed back in it */
+static uint8 g_credentialEntropy[HALFSIPHASH_OUTPUT_SIZE] __attribute__((section(".noinit")));
+static uint16 g_credentialSaltCount = 0;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint8 CREDENTIAL_loadKeys(void);
+static uint16 CREDENTIAL_digest(const uint8 *pin,uint8 length);
+static uint8 CREDENTIAL_getTag(uint16 digest);
+static void CREDENTIAL_stir(uint16 value);
+static void CREDENTIAL_computeHash(const uint8 *pin,uint8 length,const uint8 *salt,uint8 *hash);
+static uint16 CREDENTIAL_crc(const Credential_RecordType *record);
+static boolean CREDENTIAL_isValid(const Credential_RecordType *record);
+static uint8 CREDENTIAL_readRecord(uint8 slot,Credential_RecordType *record);
+static uint8 CREDENTIAL_writeRecord(uint8 slot,Credential_RecordType *record);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+uint8 CREDENTIAL_init(void)
+{
+	Credential_RecordType record;
+	uint16 tableCrc = CRC16_INITIAL_VALUE;
+
+	if(CREDENTIAL_loadKeys() == ERROR)
+		return ERROR;
+
+	for(uint8 slot = 0 ; slot < CREDENTIAL_NUM_SLOTS ; slot++)
+	{
+		if(EEPROM_readBlock(CREDENTIAL_SLOT_ADDRESS(slot), (uint8 *)&record, CREDENTIAL_RECORD_SIZE) == ERROR)
+			return ERROR;
+
+		tableCrc = CRC16_update(tableCrc, (const uint8 *)&record, CREDENTIAL_RECORD_SIZE);
+
+		if( (record.tag == CREDENTIAL_TAG_EMPTY) || (record.tag == CREDENTIAL_TAG_REVOKED) )
+		{
+			g_credentialTags[slot] = record.tag;
+		}
+		else if(CREDENTIAL_isValid(&record) == TRUE)
+		{
+			g_credentialTags[slot] = record.tag;
+		}
+		else
+		{
+			/* corrupted page, it can't be matched but it doesn't break the probe chains */
+			g_credentialTags[slot] = CREDENTIAL_TAG_REVOKED;
+		}
+	}
+	/* the salts of the stored credentials change the table, so the salts of this boot differ from the last one */
+	CREDENTIAL_stir(tableCrc);
+	return SUCCESS;
+}
+
+void CREDENTIAL_seed(void)
+{
+	static const ADC_ConfigType noiseConfig = {ADC_AVCC,ADC_FCPU_2}; /* far above 200 KHz so the low bits are mostly noise */
+	uint16 folded = 0;
+
+	ADC_init(&noiseConfig);
+	for(uint16 sample = 1 ; sample <= CREDENTIAL_NOISE_SAMPLES ; sample++)
+	{
+		/* the noisy low bits of every sample land on a different bit of the folded value */
+		folded = (uint16)((folded << 1) | (folded >> 15)) ^ ADC_readChannel(ADC_CHANNEL_BANDGAP);
+		if((sample % CREDENTIAL_NOISE_FOLD) == 0)
+		{
+			CREDENTIAL_stir(folded);
+		}
+	}
+}
+
+uint8 CREDENTIAL_clear(void)
+{
+	uint8 erased[CREDENTIAL_RECORD_SIZE];
+	uint8 status = SUCCESS;
+
+	for(uint8 i = 0 ; i < CREDENTIAL_RECORD_SIZE ; i++)
+	{
+		erased[i] = CREDENTIAL_TAG_EMPTY;
+	}
+	/* erased rather than revoked so the probe chains of the new users are short again */
+	for(uint8 slot = 0 ; slot < CREDENTIAL_NUM_SLOTS ; slot++)
+	{
+		if(g_credentialTags[slot] == CREDENTIAL_TAG_EMPTY)
+			continue;
+
+		if(EEPROM_writePage(CREDENTIAL_SLOT_ADDRESS(slot), erased, CREDENTIAL_RECORD_SIZE) == ERROR)
+			status = ERROR;
+		else
+			g_credentialTags[slot] = CREDENTIAL_TAG_EMPTY;
+	}
+	return status;
+}
+
+void CREDENTIAL_getKeysCheck(uint8 *check)
+{
+	/* a MAC of one key under the other, it tells the keys apart without giving any of them */
+	HALFSIPHASH_compute(g_credentialHashKey, g_credentialIndexKey, HALFSIPHASH_KEY_SIZE, check);
+}
+
+Credential_StatusType CREDENTIAL_add(const uint8 *pin,uint8 length,uint8 role,uint8 uses,uint8 *slot)
+{
+	Credential_RecordType record;
+	uint16 digest = CREDENTIAL_digest(pin, length);
+	uint8 tag = CREDENTIAL_getTag(digest);
+	uint8 current = (uint8)(digest & (CREDENTIAL_NUM_SLOTS - 1)); /* home slot */
+	uint8 freeSlot = CREDENTIAL_NO_SLOT;
+
+	if( (length == 0) || (length > CREDENTIAL_MAX_PIN_SIZE) || (uses == 0) )
+		return CREDENTIAL_NOT_FOUND;
+
+	/* walk the whole chain until an empty slot, the same PIN can appear only once in it */
+	for(uint8 i = 0 ; i < CREDENTIAL_NUM_SLOTS ; i++)
+	{
+		if(g_credentialTags[current] == tag)
+		{
+			/* the same tag, only the hash tells the same PIN from another one */
+			if(CREDENTIAL_readRecord(current, &record) == ERROR)
+				return CREDENTIAL_EEPROM_ERROR;
+
+			if(CREDENTIAL_match(pin, length, &record.secret) == TRUE)
+				return CREDENTIAL_TAKEN;
+		}
+
+		if( (g_credentialTags[current] == CREDENTIAL_TAG_EMPTY) || (g_credentialTags[current] == CREDENTIAL_TAG_REVOKED) )
+		{
+			if(freeSlot == CREDENTIAL_NO_SLOT)
+				freeSlot = current; /* first free slot on the chain */
+
+			if(g_credentialTags[current] == CREDENTIAL_TAG_EMPTY)
+				break;
+		}
+		current = CREDENTIAL_NEXT_SLOT(current);
+	}
+
+	if(freeSlot == CREDENTIAL_NO_SLOT)
+		return CREDENTIAL_FULL;
+
+	record.tag = tag;
+	record.role = role;
+	record.uses = uses;
+	record.reserved = 0;
+	CREDENTIAL_hash(pin, length, &record.secret);
+	if(CREDENTIAL_writeRecord(freeSlot, &record) == ERROR)
+		return CREDENTIAL_EEPROM_ERROR;
+
+	g_credentialTags[freeSlot] = tag;
+	*slot = freeSlot;
+	return CREDENTIAL_OK;
+}
+
+Credential_StatusType CREDENTIAL_verify(const uint8 *pin,uint8 length,uint8 *slot,uint8 *role)
+{
+	Credential_RecordType record;
+	uint16 digest = CREDENTIAL_digest(pin, length);
+	uint8 tag = CREDENTIAL_getTag(digest);
+	uint8 current = (uint8)(digest & (CREDENTIAL_NUM_SLOTS - 1)); /* home slot */
+
+	for(uint8 i = 0 ; i < CREDENTIAL_NUM_SLOTS ; i++)
+	{
+		if(g_credentialTags[current] == CREDENTIAL_TAG_EMPTY)
+			return CREDENTIAL_NOT_FOUND;
+
+		if(g_credentialTags[current] == tag)
+		{
+			/* almost always the only candidate on the chain and the only page read */
+			if(CREDENTIAL_readRecord(current, &record) == ERROR)
+				return CREDENTIAL_EEPROM_ERROR;
+
+			if(CREDENTIAL_match(pin, length, &record.secret) == FALSE)
+			{
+				current = CREDENTIAL_NEXT_SLOT(current); /* another PIN with the same tag */
+				continue;
+			}
+
+			*slot = current;
+			*role = record.role;
+			if(record.uses == 1)
+			{
+				return CREDENTIAL_revoke(current); /* last use */
+			}
+			else if(record.uses != CREDENTIAL_USES_UNLIMITED)
+			{
+				record.uses--;
+				if(CREDENTIAL_writeRecord(current, &record) == ERROR)
+					return CREDENTIAL_EEPROM_ERROR;
+			}
+			return CREDENTIAL_OK;
+		}
+		current = CREDENTIAL_NEXT_SLOT(current);
+	}
+	return CREDENTIAL_NOT_FOUND;
+}
+
+Credential_StatusType CREDENTIAL_revoke(uint8 slot)
+{
+	uint8 tag = CREDENTIAL_TAG_REVOKED;
+
+	if( (slot >= CREDENTIAL_NUM_SLOTS) || (g_credentialTags[slot] == CREDENTIAL_TAG_EMPTY)
+			|| (g_credentialTags[slot] == CREDENTIAL_TAG_REVOKED) )
+		return CREDENTIAL_NOT_FOUND;
+
+	/* only the tag byte is written, a revoked slot keeps the chains going */
+	if(EEPROM_writePage(CREDENTIAL_SLOT_ADDRESS(slot), &tag, 1) == ERROR)
+		return CREDENTIAL_EEPROM_ERROR;
+
+	g_credentialTags[slot] = CREDENTIAL_TAG_REVOKED;
+	return CREDENTIAL_OK;
+}
+
+void CREDENTIAL_hash(const uint8 *pin,uint8 length,Credential_SecretType *secret)
+{
+	uint8 random[HALFSIPHASH_OUTPUT_SIZE];
+
+	CREDENTIAL_random(random); /* a new salt */
+	for(uint8 i = 0 ; i < CREDENTIAL_SALT_SIZE ; i++)
+	{
+		secret->salt[i] = random[i];
+	}
+	secret->length = length;
+	CREDENTIAL_computeHash(pin, length, secret->salt, secret->hash);
+}
+
+void CREDENTIAL_random(uint8 *data)
+{
+	/* the counter keeps the bytes different even if the pool repeats */
+	CREDENTIAL_stir(g_credentialSaltCount);
+	g_credentialSaltCount++;
+	for(uint8 i = 0 ; i < HALFSIPHASH_OUTPUT_SIZE ; i++)
+	{
+		data[i] = g_credentialEntropy[i];
+	}
+}
+
+boolean CREDENTIAL_match(const uint8 *pin,uint8 length,const Credential_SecretType *secret)
+{
+	uint8 hash[CREDENTIAL_HASH_SIZE];
+	uint8 difference = secret->length ^ length;
+
+	CREDENTIAL_computeHash(pin, length, secret->salt, hash);
+	/* no early exit, every byte is compared whatever the result */
+	for(uint8 i = 0 ; i < CREDENTIAL_HASH_SIZE ; i++)
+	{
+		difference |= hash[i] ^ secret->hash[i];
+	}
+	return (difference == 0);
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_loadKeys
+* Description:			Function to read the device keys from the internal EEPROM. On the first
+* 						boot the block is erased, the keys are drawn from the entropy pool that
+* 						holds the power-up content of the SRAM and the noise of CREDENTIAL_seed,
+* 						then written. A broken block gives new keys too, the stored PINs can't be
+* 						checked anymore then, see CREDENTIAL_getKeysCheck.
+* Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR if the keys can't be written
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 CREDENTIAL_loadKeys(void)
+{
+	Credential_KeysType keys;
+	uint16 crc;
+
+	if(INT_EEPROM_readBlock(CREDENTIAL_KEYS_ADDRESS, (uint8 *)&keys, sizeof(keys)) == ERROR)
+		return ERROR;
+
+	crc = CRC16_update(CRC16_INITIAL_VALUE, (const uint8 *)&keys, sizeof(keys) - 2);
+	if( (keys.crc[0] != (uint8)crc) || (keys.crc[1] != (uint8)(crc>>8)) )
+	{
+		/* the pool is stirred with the all zero keys of the .bss until the new ones are in */
+		CREDENTIAL_random(keys.hashKey);
+		CREDENTIAL_random(keys.indexKey);
+		crc = CRC16_update(CRC16_INITIAL_VALUE, (const uint8 *)&keys, sizeof(keys) - 2);
+		keys.crc[0] = (uint8)crc;
+		keys.crc[1] = (uint8)(crc>>8);
+		if(INT_EEPROM_writeBlock(CREDENTIAL_KEYS_ADDRESS, (const uint8 *)&keys, sizeof(keys)) == ERROR)
+			return ERROR;
+	}
+
+	for(uint8 i = 0 ; i < HALFSIPHASH_KEY_SIZE ; i++)
+	{
+		g_credentialHashKey[i] = keys.hashKey[i];
+		g_credentialIndexKey[i] = keys.indexKey[i];
+	}
+	return SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_digest
+* Description:			Function to calculate the 16-bit digest of a PIN, the low bits
+* 						give the home slot and the high byte gives the tag.
+* Parameters (in):    	The PIN and its length
+* Parameters (out):   	The digest
+* Return value:      	uint16
+********************************************************************************/
+
+static uint16 CREDENTIAL_digest(const uint8 *pin,uint8 length)
+{
+	uint8 hash[HALFSIPHASH_OUTPUT_SIZE];
+
+	HALFSIPHASH_compute(g_credentialIndexKey, pin, length, hash);
+	return (uint16)hash[0] | ((uint16)hash[1]<<8);
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_getTag
+* Description:			Function to get the RAM index tag of a digest, it never equals
+* 						CREDENTIAL_TAG_EMPTY or CREDENTIAL_TAG_REVOKED.
+* Parameters (in):    	The digest
+* Parameters (out):   	The tag
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 CREDENTIAL_getTag(uint16 digest)
+{
+	return (uint8)(1 + ((digest>>8) % 254));
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_stir
+* Description:			Function to mix a value into the entropy pool used for the salts.
+* Parameters (in):    	The value
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void CREDENTIAL_stir(uint16 value)
+{
+	uint8 message[HALFSIPHASH_OUTPUT_SIZE + 2];
+
+	for(uint8 i = 0 ; i < HALFSIPHASH_OUTPUT_SIZE ; i++)
+	{
+		message[i] = g_credentialEntropy[i];
+	}
+	message[HALFSIPHASH_OUTPUT_SIZE] = (uint8)value;
+	message[HALFSIPHASH_OUTPUT_SIZE + 1] = (uint8)(value>>8);
+	HALFSIPHASH_compute(g_credentialHashKey, message, sizeof(message), g_credentialEntropy);
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_computeHash
+* Description:			Function to calculate the truncated hash of the salt followed by the PIN.
+* Parameters (in):    	The PIN and its length, the salt and array of CREDENTIAL_HASH_SIZE bytes.
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void CREDENTIAL_computeHash(const uint8 *pin,uint8 length,const uint8 *salt,uint8 *hash)
+{
+	uint8 message[CREDENTIAL_SALT_SIZE + CREDENTIAL_MAX_PIN_SIZE];
+	uint8 digest[HALFSIPHASH_OUTPUT_SIZE];
+
+	if(length > CREDENTIAL_MAX_PIN_SIZE)
+		length = CREDENTIAL_MAX_PIN_SIZE; /* never matches as the saved length is checked too */
+
+	for(uint8 i = 0 ; i < CREDENTIAL_SALT_SIZE ; i++)
+	{
+		message[i] = salt[i];
+	}
+	for(uint8 i = 0 ; i < length ; i++)
+	{
+		message[CREDENTIAL_SALT_SIZE + i] = pin[i];
+	}
+	HALFSIPHASH_compute(g_credentialHashKey, message, CREDENTIAL_SALT_SIZE + length, digest);
+	for(uint8 i = 0 ; i < CREDENTIAL_HASH_SIZE ; i++)
+	{
+		hash[i] = digest[i];
+	}
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_crc
+* Description:			Function to calculate the CRC-16/CCITT of a record without its CRC field.
+* Parameters (in):    	Pointer to the record
+* Parameters (out):   	The CRC
+* Return value:      	uint16
+********************************************************************************/
+
+static uint16 CREDENTIAL_crc(const Credential_RecordType *record)
+{
+	return CRC16_update(CRC16_INITIAL_VALUE, (const uint8 *)record, CREDENTIAL_RECORD_SIZE - 2);
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_isValid
+* Description:			Function to check the CRC of a record
+* Parameters (in):    	Pointer to the record
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean CREDENTIAL_isValid(const Credential_RecordType *record)
+{
+	uint16 crc = CREDENTIAL_crc(record);
+	return (record->crc[0] == (uint8)crc) && (record->crc[1] == (uint8)(crc>>8));
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_readRecord
+* Description:			Function to read the record of a slot and check its CRC.
+* Parameters (in):    	Required slot and pointer to store the record in.
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 CREDENTIAL_readRecord(uint8 slot,Credential_RecordType *record)
+{
+	if(EEPROM_readBlock(CREDENTIAL_SLOT_ADDRESS(slot), (uint8 *)record, CREDENTIAL_RECORD_SIZE) == ERROR)
+		return ERROR;
+
+	return (CREDENTIAL_isValid(record) == TRUE) ? SUCCESS : ERROR;
+}
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_writeRecord
+* Description:			Function to write the record of a slot with one page write and verify it.
+* Parameters (in):    	Required slot and the record, its CRC is filled here.
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 CREDENTIAL_writeRecord(uint8 slot,Credential_RecordType *record)
+{
+	Credential_RecordType readBack;
+	uint16 crc = CREDENTIAL_crc(record);
+
+	record->crc[0] = (uint8)crc;
+	record->crc[1] = (uint8)(crc>>8);
+
+	if(EEPROM_writePage(CREDENTIAL_SLOT_ADDRESS(slot), (const uint8 *)record, CREDENTIAL_RECORD_SIZE) == ERROR)
+		return ERROR;
+
+	if(CREDENTIAL_readRecord(slot, &readBack) == ERROR)
+		return ERROR;
+
+	for(uint8 i = 0 ; i < CREDENTIAL_RECORD_SIZE ; i++)
+	{
+		if(((const uint8 *)&readBack)[i] != ((const uint8 *)record)[i])
+			return ERROR;
+	}
+	return SUCCESS;
+}
@@ -0,0 +1,248 @@
+/******************************************************************************
+*  File name:		credential.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef HAL_EXT_EEPORM_CREDENTIAL_H_
+#define HAL_EXT_EEPORM_CREDENTIAL_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "eeprom.h"
+#include "../../LIB/halfsiphash.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * The credential table is an open addressing hash table in the EEPROM with one
+ * credential per page. The home slot of a PIN and its tag come from a 16-bit digest
+ * of the PIN, only the tags are kept in RAM. A lookup only reads the pages of its tag
+ * along the probe chain, one page whatever the number of credentials unless another
+ * PIN has the same tag on the chain (about chain length / 254 of the PINs), then one
+ * more page for each of them. A PIN is only refused as taken if its hash matches.
+ *
+ * The PINs are never stored, a page only holds a salted HalfSipHash of the PIN keyed
+ * with a device key. The RAM index uses a second key without a salt so a PIN can be
+ * located before its page is read. Both keys are drawn from the entropy pool of the
+ * salts on the first boot and kept in the internal EEPROM of MCU2, never in the 24C16:
+ * a 24C16 taken out of the lock gives hashes that can't be checked without them, and
+ * its table only works again in the lock that wrote it.
+ *
+ * The pool starts with the power-up content of the SRAM, which is often biased and
+ * may repeat on the same chip, so CREDENTIAL_seed mixes in the noise of the ADC on the
+ * internal band-gap reference first. The keys hold at most the 64 bits of the pool.
+ */
+#define CREDENTIAL_START_ADDRESS	0x400	/* first address of the table (page aligned) */
+#define CREDENTIAL_NUM_SLOTS		64		/* number of credentials, must be a power of 2 */
+#define CREDENTIAL_RECORD_SIZE		EEPROM_PAGE_SIZE	/* one credential per page */
+#define CREDENTIAL_MAX_PIN_SIZE		12
+#define CREDENTIAL_SALT_SIZE		2		/* random per credential, the same PIN never gives the same hash twice */
+#define CREDENTIAL_HASH_SIZE		7		/* truncated 64-bit HalfSipHash-2-4 */
+#define CREDENTIAL_SECRET_SIZE		(1 + CREDENTIAL_SALT_SIZE + CREDENTIAL_HASH_SIZE)	/* PIN length, salt and hash */
+
+#define CREDENTIAL_TAG_EMPTY		0xFF	/* erased page, ends any probe chain */
+#define CREDENTIAL_TAG_REVOKED		0x00	/* revoked credential, the slot can be used again */
+#define CREDENTIAL_USES_UNLIMITED	0xFF	/* the credential never expires */
+#define CREDENTIAL_NO_SLOT			0xFF
+
+#define CREDENTIAL_KEYS_ADDRESS		0x000	/* of the device keys in the internal EEPROM */
+#define CREDENTIAL_KEYS_CHECK_SIZE	HALFSIPHASH_OUTPUT_SIZE
+#define CREDENTIAL_NOISE_SAMPLES	256		/* ADC samples mixed in the entropy pool at every boot, 7 ms */
+#define CREDENTIAL_NOISE_FOLD		32		/* samples folded together for each stir of the pool */
+
+#if ((CREDENTIAL_NUM_SLOTS & (CREDENTIAL_NUM_SLOTS - 1)) != 0)
+
+#error "Number of credential slots should be a power of 2"
+
+#endif
+
+#if ((CREDENTIAL_SECRET_SIZE + 6) != CREDENTIAL_RECORD_SIZE)
+
+#error "The secret doesn't fit in the credential record"
+
+#endif
+
+#if ((CREDENTIAL_START_ADDRESS + (CREDENTIAL_NUM_SLOTS * CREDENTIAL_RECORD_SIZE)) > EEPROM_SIZE)
+
+#error "The credential table exceeds the EEPROM size"
+
+#endif
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Credential_StatusType
+* Type: Enumeration
+* Description: Data type to represent the result of the credential operations
+********************************************************************************/
+
+typedef enum
+{
+	CREDENTIAL_OK,
+	CREDENTIAL_NOT_FOUND,
+	CREDENTIAL_TAKEN,		/* the PIN is already in the table */
+	CREDENTIAL_FULL,
+	CREDENTIAL_EEPROM_ERROR
+}Credential_StatusType;
+
+/*******************************************************************************
+* Name: Credential_SecretType
+* Type: Structure
+* Description: Data type to represent a hashed PIN, also used for the main password
+********************************************************************************/
+
+typedef struct
+{
+	uint8 length; /* number of digits of the PIN */
+	uint8 salt[CREDENTIAL_SALT_SIZE];
+	uint8 hash[CREDENTIAL_HASH_SIZE];
+}Credential_SecretType;
+
+/*******************************************************************************
+* Name: Credential_RecordType
+* Type: Structure
+* Description: Data type to represent one credential exactly as it is stored in one page
+********************************************************************************/
+
+typedef struct
+{
+	uint8 tag;
+	uint8 role;
+	uint8 uses; /* remaining number of uses, CREDENTIAL_USES_UNLIMITED if it never expires */
+	Credential_SecretType secret;
+	uint8 reserved; /* always 0 */
+	uint8 crc[2]; /* CRC-16/CCITT of all the bytes above, little endian */
+}Credential_RecordType;
+
+/*******************************************************************************
+* Name: Credential_KeysType
+* Type: Structure
+* Description: Data type to represent the device keys exactly as they are stored in the
+* 			   internal EEPROM, an erased or broken block gives new keys
+********************************************************************************/
+
+typedef struct
+{
+	uint8 hashKey[HALFSIPHASH_KEY_SIZE];
+	uint8 indexKey[HALFSIPHASH_KEY_SIZE];
+	uint8 crc[2]; /* CRC-16/CCITT of the keys, little endian */
+}Credential_KeysType;
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_init
+* Description:			Function to load the device keys, they are made on the first boot,
+* 						then to read the table once and build the RAM index of tags.
+* Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 CREDENTIAL_init(void);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_seed
+* Description:			Function to mix the noise of the ADC in the entropy pool, it must be called
+* 						before CREDENTIAL_init and before the ADC is set up for anything else.
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void CREDENTIAL_seed(void);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_clear
+* Description:			Function to erase every credential of the table.
+* Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 CREDENTIAL_clear(void);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_getKeysCheck
+* Description:			Function to get the check value of the device keys, saved next to the records
+* 						hashed with the keys it tells if they were saved with other keys.
+* Parameters (in):    	Array of CREDENTIAL_KEYS_CHECK_SIZE bytes.
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void CREDENTIAL_getKeysCheck(uint8 *check);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_add
+* Description:			Function to add a new credential to the table.
+* Parameters (in):    	The PIN and its length, role and number of uses, pointer to store the slot in.
+* Parameters (out):   	Status of the operation
+* Return value:      	Credential_StatusType
+********************************************************************************/
+
+Credential_StatusType CREDENTIAL_add(const uint8 *pin,uint8 length,uint8 role,uint8 uses,uint8 *slot);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_verify
+* Description:			Function to look for a PIN in the table and consume one of its uses,
+* 						a credential is revoked after its last use.
+* Parameters (in):    	The PIN and its length, pointers to store the slot and the role in.
+* Parameters (out):   	CREDENTIAL_OK or CREDENTIAL_NOT_FOUND or CREDENTIAL_EEPROM_ERROR
+* Return value:      	Credential_StatusType
+********************************************************************************/
+
+Credential_StatusType CREDENTIAL_verify(const uint8 *pin,uint8 length,uint8 *slot,uint8 *role);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_revoke
+* Description:			Function to remove the credential saved in a slot.
+* Parameters (in):    	Required slot
+* Parameters (out):   	CREDENTIAL_OK or CREDENTIAL_NOT_FOUND or CREDENTIAL_EEPROM_ERROR
+* Return value:      	Credential_StatusType
+********************************************************************************/
+
+Credential_StatusType CREDENTIAL_revoke(uint8 slot);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_hash
+* Description:			Function to hash a PIN with a new salt.
+* Parameters (in):    	The PIN and its length, pointer to store the secret in.
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void CREDENTIAL_hash(const uint8 *pin,uint8 length,Credential_SecretType *secret);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_random
+* Description:			Function to draw bytes from the entropy pool of the salts, the pool
+* 						is stirred first so two draws never give the same bytes.
+* Parameters (in):    	Array of HALFSIPHASH_OUTPUT_SIZE bytes.
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void CREDENTIAL_random(uint8 *data);
+
+/*******************************************************************************
+* Function Name:		CREDENTIAL_match
+* Description:			Function to check a PIN against a secret, the hashes are compared
+* 						in constant time so the time taken doesn't tell how close the PIN is.
+* Parameters (in):    	The PIN and its length, the saved secret.
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+boolean CREDENTIAL_match(const uint8 *pin,uint8 length,const Credential_SecretType *secret);
+
+#endif /* HAL_EXT_EEPORM_CREDENTIAL_H_ */
@@ -12,6 +12,13 @@
 #include "../../MCAL/TWI/twi.h"
 #include "util/delay.h"
 
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint8 EEPROM_selectAddress(uint16 address);
+static uint8 EEPROM_abort(void);
+
 /*******************************************************************************
 *                      Functions Definitions                                   *
 *******************************************************************************/
@@ -21,19 +28,19 @@ uint8 EEPROM_writeByte(uint16 address,uint8 byte)
 	_delay_ms(10);
 	TWI_start();
 	if(TWI_getStatus() != TWI_START)
-		return ERROR;
+		return EEPROM_abort();
 
 	TWI_writeByte( (uint8)(((address&0x0700)>>7) | (0xA0)) );
 	if(TWI_getStatus() != TWI_MT_SLA_W_ACK)
-		return ERROR;
+		return EEPROM_abort();
 
 	TWI_writeByte((uint8)address);
 	if(TWI_getStatus() != TWI_MT_DATA_ACK)
-		return ERROR;
+		return EEPROM_abort();
 
 	TWI_writeByte(byte);
 	if(TWI_getStatus() != TWI_MT_DATA_ACK)
-		return ERROR;
+		return EEPROM_abort();
 
 	TWI_stop();
 
@@ -45,28 +52,126 @@ uint8 EEPROM_readByte(uint16 address,uint8 *value)
 	_delay_ms(10);
 	TWI_start();
 	if(TWI_getStatus() != TWI_START)
-		return ERROR;
+		return EEPROM_abort();
 
 	TWI_writeByte( (uint8)((address&0x0700)>>7 | (0xA0)) );
 	if(TWI_getStatus() != TWI_MT_SLA_W_ACK)
-		return ERROR;
+		return EEPROM_abort();
 
 	TWI_writeByte((uint8)address);
 	if(TWI_getStatus() != TWI_MT_DATA_ACK)
-		return ERROR;
+		return EEPROM_abort();
 
 	TWI_start();
 	if(TWI_getStatus() != TWI_REP_START)
-		return ERROR;
+		return EEPROM_abort();
 
     TWI_writeByte((uint8)((0xA0) | ((address & 0x0700)>>7) | 1));
     if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
-        return ERROR;
+        return EEPROM_abort();
 
     *value = TWI_readByteWithNACK();
     if (TWI_getStatus() != TWI_MR_DATA_NACK)
-        return ERROR;
+        return EEPROM_abort();
 
     TWI_stop();
 	return SUCCESS;
 }
+
+uint8 EEPROM_writePage(uint16 address,const uint8 *data,uint8 length)
+{
+	/* the chip wraps around inside the page so the data must fit in the page */
+	if( (length == 0) || (((address % EEPROM_PAGE_SIZE) + length) > EEPROM_PAGE_SIZE) )
+		return ERROR;
+
+	if(EEPROM_selectAddress(address) == ERROR)
+		return ERROR; /* already released */
+
+	for(uint8 i = 0 ; i < length ; i++)
+	{
+		TWI_writeByte(data[i]);
+		if(TWI_getStatus() != TWI_MT_DATA_ACK)
+			return EEPROM_abort();
+	}
+
+	TWI_stop(); /* the chip starts its internal write cycle now */
+	return SUCCESS;
+}
+
+uint8 EEPROM_readBlock(uint16 address,uint8 *data,uint16 length)
+{
+	if(length == 0)
+		return SUCCESS;
+
+	if(EEPROM_selectAddress(address) == ERROR)
+		return ERROR; /* already released */
+
+	TWI_start();
+	if(TWI_getStatus() != TWI_REP_START)
+		return EEPROM_abort();
+
+	TWI_writeByte((uint8)(EEPROM_DEVICE_ADDRESS | ((address & 0x0700)>>7) | 1));
+	if(TWI_getStatus() != TWI_MT_SLA_R_ACK)
+		return EEPROM_abort();
+
+	/* the address counter increments after every byte so the whole block is one transfer */
+	for(uint16 i = 0 ; i < (length - 1) ; i++)
+	{
+		data[i] = TWI_readByteWithACK();
+		if(TWI_getStatus() != TWI_MR_DATA_ACK)
+			return EEPROM_abort();
+	}
+
+	data[length - 1] = TWI_readByteWithNACK();
+	if(TWI_getStatus() != TWI_MR_DATA_NACK)
+		return EEPROM_abort();
+
+	TWI_stop();
+	return SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name:		EEPROM_selectAddress
+* Description:			Function to address the chip and set its internal address counter,
+* 						the chip doesn't ACK while it is busy in a write cycle so keep
+* 						polling it instead of waiting a fixed delay.
+* Parameters (in):    	Required address
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 EEPROM_selectAddress(uint16 address)
+{
+	for(uint8 tries = 0 ; tries < EEPROM_ACK_POLL_TRIES ; tries++)
+	{
+		TWI_start();
+		if(TWI_getStatus() != TWI_START)
+			return EEPROM_abort();
+
+		TWI_writeByte((uint8)(EEPROM_DEVICE_ADDRESS | ((address & 0x0700)>>7)));
+		if(TWI_getStatus() == TWI_MT_SLA_W_ACK)
+		{
+			TWI_writeByte((uint8)address);
+			if(TWI_getStatus() != TWI_MT_DATA_ACK)
+				return EEPROM_abort();
+			return SUCCESS;
+		}
+		TWI_stop(); /* NACK : the chip is still busy, release the bus and try again */
+	}
+	return ERROR;
+}
+
+/*******************************************************************************
+* Function Name:		EEPROM_abort
+* Description:			Function to end a failed transfer so the bus is free for the next one,
+* 						the TWI driver already recovered the bus if it timed out.
+* Parameters (in):    	None
+* Parameters (out):   	ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 EEPROM_abort(void)
+{
+	TWI_stop();
+	return ERROR;
+}
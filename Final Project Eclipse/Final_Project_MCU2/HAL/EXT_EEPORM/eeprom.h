@@ -20,6 +20,11 @@
 #define ERROR 0
 #define SUCCESS 1
 
+#define EEPROM_SIZE				2048	/* 24C16 capacity in bytes */
+#define EEPROM_PAGE_SIZE		16		/* 24C16 page write buffer size in bytes */
+#define EEPROM_DEVICE_ADDRESS	0xA0	/* 24Cxx device type identifier */
+#define EEPROM_ACK_POLL_TRIES	200		/* max number of address attempts while the chip is busy writing (~12ms at 400Kbps) */
+
 /*******************************************************************************
 *                      Functions Prototypes                                   *
 *******************************************************************************/
@@ -44,4 +49,25 @@ uint8 EEPROM_writeByte(uint16 address,uint8 byte);
 
 uint8 EEPROM_readByte(uint16 address,uint8 *value);
 
+/*******************************************************************************
+* Function Name:		EEPROM_writePage
+* Description:			Function to write up to one page in a single write cycle,
+* 						the data must not cross a page boundary.
+* Parameters (in):    	Start address, the data and its length.
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 EEPROM_writePage(uint16 address,const uint8 *data,uint8 length);
+
+/*******************************************************************************
+* Function Name:		EEPROM_readBlock
+* Description:			Function to read consecutive bytes with one sequential read.
+* Parameters (in):    	Start address, buffer to store the data in and its length.
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 EEPROM_readBlock(uint16 address,uint8 *data,uint16 length);
+
 #endif /* HAL_EXT_EEPORM_EEPROM_H_ */
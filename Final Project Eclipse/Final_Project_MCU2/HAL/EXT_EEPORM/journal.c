@@ -0,0 +1,291 @@
+/******************************************************************************
+*  File name:		journal.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "journal.h"
+#include "../../LIB/crc16.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define JOURNAL_PAGE_ADDRESS(page)	(JOURNAL_START_ADDRESS + ((uint16)(page) * EEPROM_PAGE_SIZE))
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static uint8 g_journalIndex[JOURNAL_MAX_KEYS]; /* page of the newest record of every key */
+static uint32 g_journalSequence = 0; /* sequence number of the newest record in the region */
+static uint8 g_journalHead = JOURNAL_NUM_PAGES - 1; /* page of the newest record in the region */
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint16 JOURNAL_crc(const Journal_RecordType *record);
+static uint32 JOURNAL_getSequence(const Journal_RecordType *record);
+static boolean JOURNAL_isValid(const Journal_RecordType *record);
+static uint8 JOURNAL_nextFreePage(void);
+static uint8 JOURNAL_invalidatePage(uint8 page);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+uint8 JOURNAL_init(void)
+{
+	Journal_RecordType record;
+	uint32 keySequence[JOURNAL_MAX_KEYS]; /* sequence of the newest record found so far for every key */
+
+	g_journalSequence = 0;
+	g_journalHead = JOURNAL_NUM_PAGES - 1; /* so the first record goes to the first page */
+	for(uint8 key = 0 ; key < JOURNAL_MAX_KEYS ; key++)
+	{
+		g_journalIndex[key] = JOURNAL_NO_RECORD;
+	}
+
+	/* one pass over the whole region, keep the newest record of every key */
+	for(uint8 page = 0 ; page < JOURNAL_NUM_PAGES ; page++)
+	{
+		if(EEPROM_readBlock(JOURNAL_PAGE_ADDRESS(page), (uint8 *)&record, JOURNAL_RECORD_SIZE) == ERROR)
+			return ERROR;
+
+		if(JOURNAL_isValid(&record) == FALSE)
+			continue; /* erased or corrupted page */
+
+		uint32 sequence = JOURNAL_getSequence(&record);
+		if( (g_journalIndex[record.key] == JOURNAL_NO_RECORD) || (sequence > keySequence[record.key]) )
+		{
+			g_journalIndex[record.key] = page;
+			keySequence[record.key] = sequence;
+		}
+		if(sequence > g_journalSequence)
+		{
+			g_journalSequence = sequence;
+			g_journalHead = page;
+		}
+	}
+	return SUCCESS;
+}
+
+boolean JOURNAL_hasRecord(uint8 key)
+{
+	return (key < JOURNAL_MAX_KEYS) && (g_journalIndex[key] != JOURNAL_NO_RECORD);
+}
+
+uint8 JOURNAL_read(uint8 key,uint8 *data)
+{
+	Journal_RecordType record;
+
+	if(JOURNAL_hasRecord(key) == FALSE)
+		return ERROR;
+
+	if(EEPROM_readBlock(JOURNAL_PAGE_ADDRESS(g_journalIndex[key]), (uint8 *)&record, JOURNAL_RECORD_SIZE) == ERROR)
+		return ERROR;
+
+	if( (JOURNAL_isValid(&record) == FALSE) || (record.key != key) )
+		return ERROR;
+
+	for(uint8 i = 0 ; i < JOURNAL_DATA_SIZE ; i++)
+	{
+		data[i] = record.data[i];
+	}
+	return SUCCESS;
+}
+
+uint8 JOURNAL_write(uint8 key,const uint8 *data)
+{
+	Journal_RecordType record;
+	uint32 sequence = g_journalSequence + 1;
+	uint8 page;
+
+	if( (key >= JOURNAL_MAX_KEYS) || (sequence > JOURNAL_MAX_SEQUENCE) )
+		return ERROR;
+
+	record.key = key;
+	for(uint8 i = 0 ; i < JOURNAL_DATA_SIZE ; i++)
+	{
+		record.data[i] = data[i];
+	}
+
+	for(uint8 tries = 0 ; tries < JOURNAL_WRITE_TRIES ; tries++)
+	{
+		Journal_RecordType readBack;
+		uint16 crc;
+
+		page = JOURNAL_nextFreePage();
+
+		record.sequence[0] = (uint8)sequence;
+		record.sequence[1] = (uint8)(sequence>>8);
+		record.sequence[2] = (uint8)(sequence>>16);
+		crc = JOURNAL_crc(&record);
+		record.crc[0] = (uint8)crc;
+		record.crc[1] = (uint8)(crc>>8);
+
+		/* whatever happens to this page it is never used as the newest record of the key before it is verified */
+		g_journalSequence = sequence;
+		g_journalHead = page;
+		sequence++;
+
+		boolean verified = (EEPROM_writePage(JOURNAL_PAGE_ADDRESS(page), (const uint8 *)&record, JOURNAL_RECORD_SIZE) == SUCCESS) &&
+						   (EEPROM_readBlock(JOURNAL_PAGE_ADDRESS(page), (uint8 *)&readBack, JOURNAL_RECORD_SIZE) == SUCCESS);
+		for(uint8 i = 0 ; (i < JOURNAL_RECORD_SIZE) && (verified == TRUE) ; i++)
+		{
+			if(((uint8 *)&readBack)[i] != ((uint8 *)&record)[i])
+			{
+				verified = FALSE;
+			}
+		}
+
+		if(verified == TRUE)
+		{
+			/* commit : the new page is now the active version and the old one becomes a free page */
+			g_journalIndex[key] = page;
+			return SUCCESS;
+		}
+
+		/* the page may still hold a complete record with the highest sequence (a failed read-back or a
+		 * transfer cut after the chip latched the bytes), the next scan would take it as the newest version
+		 * after the caller was told the write failed */
+		JOURNAL_invalidatePage(page);
+
+		if(sequence > JOURNAL_MAX_SEQUENCE)
+			break;
+	}
+	return ERROR; /* the old version of the key is still the active one */
+}
+
+uint8 JOURNAL_erase(uint8 key)
+{
+	Journal_RecordType record;
+	uint8 status = SUCCESS;
+
+	if(key >= JOURNAL_MAX_KEYS)
+		return ERROR;
+
+	/* every version of the key, an older one would be taken as the newest once the newest is gone */
+	for(uint8 page = 0 ; page < JOURNAL_NUM_PAGES ; page++)
+	{
+		if(EEPROM_readBlock(JOURNAL_PAGE_ADDRESS(page), (uint8 *)&record, JOURNAL_RECORD_SIZE) == ERROR)
+		{
+			status = ERROR;
+			continue;
+		}
+
+		if( (JOURNAL_isValid(&record) == TRUE) && (record.key == key) && (JOURNAL_invalidatePage(page) == ERROR) )
+			status = ERROR;
+	}
+
+	if(status == SUCCESS)
+		g_journalIndex[key] = JOURNAL_NO_RECORD;
+	return status;
+}
+
+/*******************************************************************************
+* Function Name:		JOURNAL_crc
+* Description:			Function to calculate the CRC-16/CCITT of a record without its CRC field.
+* Parameters (in):    	Pointer to the record
+* Parameters (out):   	The CRC
+* Return value:      	uint16
+********************************************************************************/
+
+static uint16 JOURNAL_crc(const Journal_RecordType *record)
+{
+	return CRC16_update(CRC16_INITIAL_VALUE, (const uint8 *)record, JOURNAL_RECORD_SIZE - 2);
+}
+
+/*******************************************************************************
+* Function Name:		JOURNAL_getSequence
+* Description:			Function to get the sequence number of a record
+* Parameters (in):    	Pointer to the record
+* Parameters (out):   	The sequence number
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 JOURNAL_getSequence(const Journal_RecordType *record)
+{
+	return (uint32)record->sequence[0] | ((uint32)record->sequence[1]<<8) | ((uint32)record->sequence[2]<<16);
+}
+
+/*******************************************************************************
+* Function Name:		JOURNAL_isValid
+* Description:			Function to check that a page holds a complete record
+* Parameters (in):    	Pointer to the record
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean JOURNAL_isValid(const Journal_RecordType *record)
+{
+	if(record->key >= JOURNAL_MAX_KEYS) /* 0xFF for an erased page */
+		return FALSE;
+
+	if( (JOURNAL_getSequence(record) == 0) || (JOURNAL_getSequence(record) > JOURNAL_MAX_SEQUENCE) )
+		return FALSE;
+
+	uint16 crc = JOURNAL_crc(record);
+	return (record->crc[0] == (uint8)crc) && (record->crc[1] == (uint8)(crc>>8));
+}
+
+/*******************************************************************************
+* Function Name:		JOURNAL_nextFreePage
+* Description:			Function to get the first page after the head that doesn't hold
+* 						the newest record of any key, so the writes rotate over the region
+* 						and the current version of every key is never overwritten.
+* Parameters (in):    	None
+* Parameters (out):   	Page number
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 JOURNAL_nextFreePage(void)
+{
+	uint8 page = g_journalHead;
+	boolean used;
+	do
+	{
+		page = (page + 1) % JOURNAL_NUM_PAGES;
+		used = FALSE;
+		for(uint8 key = 0 ; key < JOURNAL_MAX_KEYS ; key++)
+		{
+			if(g_journalIndex[key] == page)
+			{
+				used = TRUE;
+				break;
+			}
+		}
+	}while(used == TRUE); /* always ends as there are more pages than keys */
+	return page;
+}
+
+/*******************************************************************************
+* Function Name:		JOURNAL_invalidatePage
+* Description:			Function to overwrite the key of a page with the erased value so the page is
+* 						never taken as a record, the CRC alone can't be trusted after a failed read-back.
+* Parameters (in):    	Page number
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 JOURNAL_invalidatePage(uint8 page)
+{
+	const uint8 erased = JOURNAL_ERASED_KEY;
+	uint8 readBack;
+
+	for(uint8 tries = 0 ; tries < JOURNAL_WRITE_TRIES ; tries++)
+	{
+		if( (EEPROM_writePage(JOURNAL_PAGE_ADDRESS(page), &erased, 1) == SUCCESS) &&
+			(EEPROM_readBlock(JOURNAL_PAGE_ADDRESS(page), &readBack, 1) == SUCCESS) &&
+			(readBack == erased) )
+		{
+			return SUCCESS;
+		}
+	}
+	return ERROR;
+}
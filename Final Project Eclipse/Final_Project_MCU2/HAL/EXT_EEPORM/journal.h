@@ -0,0 +1,136 @@
+/******************************************************************************
+*  File name:		journal.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef HAL_EXT_EEPORM_JOURNAL_H_
+#define HAL_EXT_EEPORM_JOURNAL_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "eeprom.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * The journal is an append only record store, every update is written as a new
+ * record in the next free page of the region so the writes are spread over all
+ * the pages instead of hitting the same cells every time.
+ *
+ * The newest record of a key is never overwritten, a new version goes to a free
+ * page and only becomes the active one after it is read back and verified. If the
+ * power drops in the middle of the page write the CRC of the new page is wrong and
+ * the previous version is still the newest valid record at the next boot.
+ */
+#define JOURNAL_START_ADDRESS		0x000	/* first address of the journal region (page aligned) */
+#define JOURNAL_NUM_PAGES			16		/* number of pages used by the journal */
+#define JOURNAL_MAX_KEYS			8		/* number of different records the journal can hold */
+
+#define JOURNAL_RECORD_SIZE			EEPROM_PAGE_SIZE	/* one record per page so an update is one page write */
+#define JOURNAL_SEQUENCE_SIZE		3		/* 24-bit sequence number, never wraps in the chip lifetime */
+#define JOURNAL_DATA_SIZE			(JOURNAL_RECORD_SIZE - JOURNAL_SEQUENCE_SIZE - 3)	/* minus the key and the CRC */
+#define JOURNAL_MAX_SEQUENCE		0xFFFFFEUL	/* 0xFFFFFF is an erased page */
+#define JOURNAL_NO_RECORD			0xFF	/* the key has no record yet */
+#define JOURNAL_WRITE_TRIES			3		/* number of pages to try before giving up on a write */
+#define JOURNAL_ERASED_KEY			0xFF	/* key of an erased or invalidated page */
+
+#if ((JOURNAL_START_ADDRESS % EEPROM_PAGE_SIZE) != 0)
+
+#error "The journal region must start at a page boundary"
+
+#endif
+
+#if (JOURNAL_NUM_PAGES <= JOURNAL_MAX_KEYS)
+
+#error "The journal needs more pages than keys so there is always a free page to append in"
+
+#endif
+
+#if ((JOURNAL_START_ADDRESS + (JOURNAL_NUM_PAGES * EEPROM_PAGE_SIZE)) > EEPROM_SIZE)
+
+#error "The journal region exceeds the EEPROM size"
+
+#endif
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Journal_RecordType
+* Type: Structure
+* Description: Data type to represent one record exactly as it is stored in one page
+********************************************************************************/
+
+typedef struct
+{
+	uint8 key;
+	uint8 sequence[JOURNAL_SEQUENCE_SIZE]; /* little endian */
+	uint8 data[JOURNAL_DATA_SIZE];
+	uint8 crc[2]; /* CRC-16/CCITT of all the bytes above, little endian */
+}Journal_RecordType;
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		JOURNAL_init
+* Description:			Function to scan the journal region once and build the index
+* 						of the newest record of every key.
+* Parameters (in):    	None
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 JOURNAL_init(void);
+
+/*******************************************************************************
+* Function Name:		JOURNAL_hasRecord
+* Description:			Function to check if a key was written before.
+* Parameters (in):    	Required key
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+boolean JOURNAL_hasRecord(uint8 key);
+
+/*******************************************************************************
+* Function Name:		JOURNAL_read
+* Description:			Function to read the newest record of a key.
+* Parameters (in):    	Required key and buffer of JOURNAL_DATA_SIZE bytes to store the data in.
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 JOURNAL_read(uint8 key,uint8 *data);
+
+/*******************************************************************************
+* Function Name:		JOURNAL_write
+* Description:			Function to append a new version of a key with one page write,
+* 						the new version replaces the old one only after it is verified.
+* Parameters (in):    	Required key and JOURNAL_DATA_SIZE bytes of data.
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 JOURNAL_write(uint8 key,const uint8 *data);
+
+/*******************************************************************************
+* Function Name:		JOURNAL_erase
+* Description:			Function to remove every version of a key, JOURNAL_hasRecord returns
+* 						FALSE for it afterwards. After an ERROR some versions may be left, the
+* 						key must be erased again.
+* Parameters (in):    	Required key
+* Parameters (out):   	SUCCESS or ERROR
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 JOURNAL_erase(uint8 key);
+
+#endif /* HAL_EXT_EEPORM_JOURNAL_H_ */
@@ -11,28 +11,269 @@
 #include "motor.h"
 #include "../../MCAL/GPIO/gpio.h"
 #include "../../LIB/common_macros.h"
-#include "../../MCAL/PWM0/pwm0.h"
+#include "../../MCAL/ADC/adc.h"
+#include "avr/io.h" /* To use the IO Ports Registers */
+#include "util/atomic.h"
 
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+typedef enum
+{
+	DcMotor_IDLE,
+	DcMotor_RAMP_UP,
+	DcMotor_HOLD,
+	DcMotor_RAMP_DOWN
+}DcMotor_PhaseType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static volatile DcMotor_PhaseType g_motorPhase = DcMotor_IDLE;
+static const DcMotor_MotionConfigType *g_motorMotion = NULL_PTR;
+static uint16 g_motorTicks = 0; /* ticks since the start of the current phase */
+static uint8 g_motorSpeed = 0;
+static DcMotor_State g_motorDirection = DcMotor_STOP;
+static volatile uint16 g_motorTravel = 0; /* ticks since the start of the move */
+static volatile DcMotor_ResultType g_motorResult = DcMotor_DONE;
+static uint8 g_motorStallSamples = 0; /* current samples in a row above the stall current */
+static const Pwm0_ConfigType g_motorPwm = {DCMOTOR_PWM_PRESCALER,0};
+static const ADC_ConfigType g_motorCurrentSense = {ADC_AVCC,ADC_FCPU_64}; /* 125 KHz, a sample takes 104 us */
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint8 DcMotor_RampSpeed(uint16 ticks);
+static void DcMotor_SetSpeed(uint8 speed);
+static DcMotor_ResultType DcMotor_CheckSensors(void);
+static void DcMotor_Finish(DcMotor_ResultType result);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
 
 void DcMotor_Init(void)
 {
 	/* setting the direction of the motor pins */
-	GPIO_setupPinDirection(DCMOTOR_PORT_ID, DCMOTOR_PIN_IN1, PIN_OUTPUT); /* Input1 */
-	GPIO_setupPinDirection(DCMOTOR_PORT_ID, DCMOTOR_PIN_IN2, PIN_OUTPUT); /* Inupt2 */
+	GPIO_OUTPUT(DCMOTOR_IN1); /* Input1 */
+	GPIO_OUTPUT(DCMOTOR_IN2); /* Inupt2 */
 
 	/* Stop the motor */
-	GPIO_writePin(DCMOTOR_PORT_ID, DCMOTOR_PIN_IN1, LOGIC_LOW);
-	GPIO_writePin(DCMOTOR_PORT_ID, DCMOTOR_PIN_IN2, LOGIC_LOW);
+	GPIO_LOW(DCMOTOR_IN1);
+	GPIO_LOW(DCMOTOR_IN2);
+	PWM_Timer0_Init(&g_motorPwm); /* only the duty cycle changes from now on */
+	g_motorSpeed = 0;
+
+	/* the end-stops short their pin to ground */
+	GPIO_INPUT(DCMOTOR_OPENED);
+	GPIO_INPUT(DCMOTOR_CLOSED);
+	GPIO_HIGH(DCMOTOR_OPENED); /* pull-up */
+	GPIO_HIGH(DCMOTOR_CLOSED);
+
+	GPIO_INPUT(DCMOTOR_CURRENT);
+	ADC_init(&g_motorCurrentSense);
 }
 
 void DcMotor_Rotate(DcMotor_State state,uint8 speed)
 {
 	/* clearing the motor so we can change it state */
-	GPIO_writePin(DCMOTOR_PORT_ID, DCMOTOR_PIN_IN1, LOGIC_LOW);
-	GPIO_writePin(DCMOTOR_PORT_ID, DCMOTOR_PIN_IN2, LOGIC_LOW);
+	GPIO_LOW(DCMOTOR_IN1);
+	GPIO_LOW(DCMOTOR_IN2);
+
+	GPIO_WRITE(DCMOTOR_IN1, GET_BIT(state,0));
+	GPIO_WRITE(DCMOTOR_IN2, GET_BIT(state,1));
+
+	PWM_Timer0_SetDuty(speed);
+	g_motorSpeed = speed;
+}
+
+void DcMotor_Move(DcMotor_State state,const DcMotor_MotionConfigType *config)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		DcMotor_Rotate(state, 0); /* the ramp starts from standstill */
+		g_motorMotion = config;
+		g_motorTicks = 0;
+		g_motorTravel = 0;
+		g_motorStallSamples = 0;
+		g_motorDirection = state;
+		g_motorResult = (state == DcMotor_STOP) ? DcMotor_DONE : DcMotor_MOVING;
+		g_motorPhase = (state == DcMotor_STOP) ? DcMotor_IDLE : DcMotor_RAMP_UP;
+		if(config->sensing & DCMOTOR_SENSE_CURRENT)
+		{
+			ADC_startConversion(DCMOTOR_CURRENT_CHANNEL); /* one sample per tick from now on */
+		}
+	}
+}
 
-	GPIO_writePin(DCMOTOR_PORT_ID, DCMOTOR_PIN_IN1, GET_BIT(state,0));
-	GPIO_writePin(DCMOTOR_PORT_ID, DCMOTOR_PIN_IN2, GET_BIT(state,1));
+void DcMotor_Stop(void)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if(g_motorPhase != DcMotor_IDLE)
+		{
+			g_motorResult = DcMotor_STOPPED;
+		}
+		g_motorPhase = DcMotor_IDLE;
+		DcMotor_Rotate(DcMotor_STOP, 0);
+	}
+}
 
-	PWM_Timer0_Start(speed);
+boolean DcMotor_IsMoving(void)
+{
+	return (g_motorPhase != DcMotor_IDLE);
+}
+
+DcMotor_ResultType DcMotor_GetResult(uint16 *ticks)
+{
+	DcMotor_ResultType result;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		*ticks = g_motorTravel;
+		result = g_motorResult;
+	}
+	return result;
+}
+
+void DcMotor_Tick(void)
+{
+	if(g_motorPhase == DcMotor_IDLE)
+		return;
+
+	g_motorTicks++;
+	g_motorTravel++;
+	DcMotor_ResultType result = DcMotor_CheckSensors();
+	if(result != DcMotor_MOVING)
+	{
+		DcMotor_Finish(result); /* right away, the bolt is already against something */
+		return;
+	}
+
+	switch(g_motorPhase)
+	{
+	case DcMotor_RAMP_UP:
+		DcMotor_SetSpeed(DcMotor_RampSpeed(g_motorTicks));
+		if(g_motorTicks >= g_motorMotion->ramp_ticks)
+		{
+			g_motorPhase = DcMotor_HOLD;
+			g_motorTicks = 0;
+		}
+		break;
+	case DcMotor_HOLD:
+		if(g_motorTicks >= g_motorMotion->hold_ticks)
+		{
+			g_motorPhase = DcMotor_RAMP_DOWN;
+			g_motorTicks = 0;
+		}
+		break;
+	case DcMotor_RAMP_DOWN:
+		if(g_motorTicks >= g_motorMotion->ramp_ticks)
+		{
+			/* a sensing move should have reached its end-stop or stalled against it before */
+			DcMotor_Finish( (g_motorMotion->sensing != 0) ? DcMotor_TIMED_OUT : DcMotor_DONE );
+		}
+		else
+		{
+			DcMotor_SetSpeed(DcMotor_RampSpeed(g_motorMotion->ramp_ticks - g_motorTicks));
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		DcMotor_RampSpeed
+* Description:			Function to get the speed of the ramp after some ticks from standstill
+* Parameters (in):    	Ticks since the start of the ramp, at most ramp_ticks
+* Parameters (out):   	Speed from 0 to DCMOTOR_MAX_SPEED
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 DcMotor_RampSpeed(uint16 ticks)
+{
+	uint32 position; /* 0 to 256 along the ramp */
+
+	if(ticks >= g_motorMotion->ramp_ticks)
+		return g_motorMotion->hold_speed;
+
+	position = ((uint32)ticks << 8) / g_motorMotion->ramp_ticks;
+	if(g_motorMotion->profile == DcMotor_S_CURVE)
+	{
+		/* smoothstep 3x^2 - 2x^3 in 8-bit fixed point */
+		position = (position * position * ((3UL << 8) - (2 * position))) >> 16;
+	}
+	return (uint8)((g_motorMotion->hold_speed * position) >> 8);
+}
+
+/*******************************************************************************
+* Function Name:		DcMotor_SetSpeed
+* Description:			Function to change the speed of the running motor if it changed
+* Parameters (in):    	Speed from 0 to DCMOTOR_MAX_SPEED
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DcMotor_SetSpeed(uint8 speed)
+{
+	if(speed != g_motorSpeed)
+	{
+		PWM_Timer0_SetDuty(speed);
+		g_motorSpeed = speed;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		DcMotor_CheckSensors
+* Description:			Function to check the end-stop and the current of the running move, a new
+* 						current sample is started every tick so it is ready by the next one
+* Parameters (in):    	None
+* Parameters (out):   	DcMotor_MOVING if the move goes on or the reason to end it
+* Return value:      	DcMotor_ResultType
+********************************************************************************/
+
+static DcMotor_ResultType DcMotor_CheckSensors(void)
+{
+	if(g_motorMotion->sensing & DCMOTOR_SENSE_END_STOP)
+	{
+		uint8 level = (g_motorDirection == DcMotor_CW) ? GPIO_READ(DCMOTOR_OPENED) : GPIO_READ(DCMOTOR_CLOSED);
+		if(level == LOGIC_LOW)
+			return DcMotor_END_STOP;
+	}
+
+	if( (g_motorMotion->sensing & DCMOTOR_SENSE_CURRENT) && (ADC_isConversionComplete() == TRUE) )
+	{
+		uint16 current = ADC_getResult();
+		ADC_startConversion(DCMOTOR_CURRENT_CHANNEL);
+		/* the current of a starting motor looks like a stall so it is ignored for a while */
+		if( (g_motorTravel > DCMOTOR_INRUSH_TICKS) && (current >= g_motorMotion->stall_current) )
+		{
+			g_motorStallSamples++;
+			if(g_motorStallSamples >= DCMOTOR_STALL_SAMPLES)
+				return DcMotor_STALLED;
+		}
+		else
+		{
+			g_motorStallSamples = 0;
+		}
+	}
+	return DcMotor_MOVING;
+}
+
+/*******************************************************************************
+* Function Name:		DcMotor_Finish
+* Description:			Function to stop the motor at the end of a move and save how it ended
+* Parameters (in):    	How the move ended
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DcMotor_Finish(DcMotor_ResultType result)
+{
+	g_motorPhase = DcMotor_IDLE;
+	DcMotor_Rotate(DcMotor_STOP, 0);
+	g_motorResult = result;
 }
@@ -12,15 +12,21 @@
 *******************************************************************************/
 
 #include "../../LIB/std_types.h"
+#include "../../MCAL/PWM0/pwm0.h"
+#include "../../../SHARED/board_mcu2.h" /* DCMOTOR_IN1, DCMOTOR_IN2, DCMOTOR_CURRENT, DCMOTOR_OPENED and DCMOTOR_CLOSED */
 
 /*******************************************************************************
 *                        		Definitions                                    *
 *******************************************************************************/
 
-#define DCMOTOR_PORT_ID			PORTA_ID
-#define	DCMOTOR_PIN_IN1			PIN0_ID
-#define	DCMOTOR_PIN_IN2			PIN1_ID
-#define	DCMOTOR_PIN_E			PIN2_ID
+/* the enable of the H-bridge is OC0 of PWM0, the end-stops are active low with their pull-up */
+#define DCMOTOR_PWM_PRESCALER	PWM0_FCPU_8	/* 3.9 KHz at 8 MHz */
+#define DCMOTOR_MAX_SPEED		PWM0_MAX_DUTY	/* speeds are duty cycles of the enable pin */
+
+#define DCMOTOR_SENSE_END_STOP	0x01	/* the move ends when the end-stop of its direction trips */
+#define DCMOTOR_SENSE_CURRENT	0x02	/* the move ends when the current shows the motor stalled */
+#define DCMOTOR_INRUSH_TICKS	25		/* ticks of the current ignored at the start of a move */
+#define DCMOTOR_STALL_SAMPLES	4		/* samples in a row above the stall current to end a move */
 
 /*******************************************************************************
 *                         Types Declaration                                   *
@@ -39,6 +45,50 @@ typedef enum
 	DcMotor_CCW
 }DcMotor_State;
 
+/*******************************************************************************
+* Name: DcMotor_ProfileType
+* Type: Enumeration
+* Description: Data type to represent the shape of the speed ramps of a move
+********************************************************************************/
+
+typedef enum
+{
+	DcMotor_TRAPEZOIDAL, /* constant acceleration */
+	DcMotor_S_CURVE /* the acceleration starts and ends at 0, no jerk at the ends of the ramps */
+}DcMotor_ProfileType;
+
+/*******************************************************************************
+* Name: DcMotor_ResultType
+* Type: Enumeration
+* Description: Data type to represent how the last move ended
+********************************************************************************/
+
+typedef enum
+{
+	DcMotor_MOVING,
+	DcMotor_DONE, /* a move without sensing ran to its end */
+	DcMotor_END_STOP, /* the end-stop of the direction tripped */
+	DcMotor_STALLED, /* the current stayed above the stall current */
+	DcMotor_TIMED_OUT, /* a sensing move ran to its end without reaching its end-stop */
+	DcMotor_STOPPED /* cancelled by DcMotor_Stop */
+}DcMotor_ResultType;
+
+/*******************************************************************************
+* Name: DcMotor_MotionConfigType
+* Type: Structure
+* Description: Data type to describe a move : ramp up to the hold speed, hold it, ramp down to 0
+********************************************************************************/
+
+typedef struct
+{
+	DcMotor_ProfileType profile;
+	uint8 hold_speed; /* 0 to DCMOTOR_MAX_SPEED */
+	uint16 ramp_ticks; /* ticks to go from 0 to the hold speed and back, sets the acceleration */
+	uint16 hold_ticks; /* ticks at the hold speed, at most if the move has sensing */
+	uint8 sensing; /* DCMOTOR_SENSE_xxx flags, 0 for a timed move */
+	uint16 stall_current; /* ADC value of the current sense when the motor is stalled */
+}DcMotor_MotionConfigType;
+
 /*******************************************************************************
 *                      Functions Prototypes                                   *
 *******************************************************************************/
@@ -56,11 +106,63 @@ void DcMotor_Init(void);
 /*******************************************************************************
 * Function Name:		DcMotor_Rotate
 * Description:			Function to control the motor direction and its speed
-* Parameters (in):    	Required direction and speed
+* Parameters (in):    	Required direction and speed from 0 to DCMOTOR_MAX_SPEED
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
 
 void DcMotor_Rotate(DcMotor_State state,uint8 speed);
 
+/*******************************************************************************
+* Function Name:		DcMotor_Move
+* Description:			Function to start a move, it runs by itself from DcMotor_Tick and
+* 						the motor stops at its end or as soon as one of its sensors trips.
+* Parameters (in):    	Required direction and the description of the move
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void DcMotor_Move(DcMotor_State state,const DcMotor_MotionConfigType *config);
+
+/*******************************************************************************
+* Function Name:		DcMotor_Stop
+* Description:			Function to stop the motor right away and cancel the current move
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void DcMotor_Stop(void);
+
+/*******************************************************************************
+* Function Name:		DcMotor_IsMoving
+* Description:			Function to check if a move is still running
+* Parameters (in):    	None
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+boolean DcMotor_IsMoving(void);
+
+/*******************************************************************************
+* Function Name:		DcMotor_GetResult
+* Description:			Function to know how the last move ended and how long it took
+* Parameters (in):    	Pointer to store the ticks from the start of the move to the stop of the motor
+* Parameters (out):   	DcMotor_MOVING while the move runs or how it ended
+* Return value:      	DcMotor_ResultType
+********************************************************************************/
+
+DcMotor_ResultType DcMotor_GetResult(uint16 *ticks);
+
+/*******************************************************************************
+* Function Name:		DcMotor_Tick
+* Description:			Function to update the speed of the current move and check its sensors, called
+* 						from a timer interrupt
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void DcMotor_Tick(void);
+
 #endif /* MOTOR_H_ */
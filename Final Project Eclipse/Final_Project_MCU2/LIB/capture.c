@@ -0,0 +1,183 @@
+/******************************************************************************
+*  File name:		capture.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "capture.h"
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+#if (CAPTURE_ENABLED == TRUE)
+
+static Capture_EventType g_captureBuffer[CAPTURE_BUFFER_SIZE];
+static uint16 g_captureCount = 0;
+static uint8 g_captureDropped = 0;
+static boolean g_captureRecording = FALSE;
+static volatile uint32 g_captureTicks = 0;
+static uint32 g_captureLastTicks = 0; /* time of the newest event */
+static uint8 g_captureLastCount = 0;
+
+#endif
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+#if (CAPTURE_ENABLED == TRUE)
+
+static void CAPTURE_add(uint8 info,uint8 data,uint16 delta);
+
+#endif
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void CAPTURE_init(void)
+{
+#if (CAPTURE_ENABLED == TRUE)
+	g_captureCount = 0;
+	g_captureDropped = 0;
+	g_captureTicks = 0;
+	g_captureLastTicks = 0;
+	g_captureLastCount = 0;
+	g_captureRecording = TRUE;
+#endif
+}
+
+void CAPTURE_tick(void)
+{
+#if (CAPTURE_ENABLED == TRUE)
+	g_captureTicks++;
+#endif
+}
+
+uint8 CAPTURE_receive(void)
+{
+#if (CAPTURE_ENABLED == TRUE)
+	uint8 flags = UCSRA & CAPTURE_RX_FLAGS; /* they belong to the byte in UDR, read them first */
+	uint8 data = UDR;
+	CAPTURE_record(flags, data);
+	return data;
+#else
+	return UDR;
+#endif
+}
+
+void CAPTURE_record(uint8 info,uint8 data)
+{
+#if (CAPTURE_ENABLED == TRUE)
+	uint8 sreg = SREG;
+	uint8 count;
+	uint32 ticks;
+	uint32 elapsed;
+	uint32 delta;
+
+	cli();
+	count = TCNT2;
+	ticks = g_captureTicks;
+	/* the compare match isn't counted yet while the interrupts are disabled */
+	if( (TIFR & (1<<OCF2)) && (count < (OCR2 >> 1)) )
+	{
+		ticks++;
+	}
+	if(g_captureRecording == FALSE)
+	{
+		SREG = sreg;
+		return;
+	}
+
+	elapsed = ticks - g_captureLastTicks;
+	if(elapsed > CAPTURE_DELTA_TICKS)
+	{
+		uint32 gap = elapsed - CAPTURE_DELTA_TICKS;
+		if(gap > CAPTURE_MAX_GAP)
+			gap = CAPTURE_MAX_GAP;
+		if(g_captureCount + 2 > CAPTURE_BUFFER_SIZE)
+		{
+			/* no room for the silence and the event, every later event needs a silence too */
+			if(g_captureDropped < 0xFF)
+				g_captureDropped++;
+			SREG = sreg;
+			return;
+		}
+		CAPTURE_add(CAPTURE_GAP, (uint8)gap, (uint16)(gap >> 8));
+		elapsed -= gap;
+	}
+	delta = (elapsed * ((uint32)OCR2 + 1)) + count - g_captureLastCount;
+	if(delta > 0xFFFF)
+		delta = 0xFFFF; /* only after a silence that was cut */
+	CAPTURE_add(info, data, (uint16)delta);
+	g_captureLastTicks = ticks;
+	g_captureLastCount = count;
+	SREG = sreg;
+#else
+	(void)info;
+	(void)data;
+#endif
+}
+
+uint16 CAPTURE_stop(void)
+{
+#if (CAPTURE_ENABLED == TRUE)
+	g_captureRecording = FALSE;
+	return g_captureCount;
+#else
+	return 0;
+#endif
+}
+
+uint8 CAPTURE_getDropped(void)
+{
+#if (CAPTURE_ENABLED == TRUE)
+	return g_captureDropped;
+#else
+	return 0;
+#endif
+}
+
+void CAPTURE_readEvent(uint16 index,Capture_EventType *event)
+{
+#if (CAPTURE_ENABLED == TRUE)
+	*event = g_captureBuffer[index];
+#else
+	(void)index;
+	(void)event;
+#endif
+}
+
+#if (CAPTURE_ENABLED == TRUE)
+
+/*******************************************************************************
+* Function Name:		CAPTURE_add
+* Description:			Function to put an event in the buffer, or count it as lost if it is full
+* Parameters (in):    	Info, data and delta of the event
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void CAPTURE_add(uint8 info,uint8 data,uint16 delta)
+{
+	Capture_EventType *event;
+
+	if(g_captureCount == CAPTURE_BUFFER_SIZE)
+	{
+		if(g_captureDropped < 0xFF)
+			g_captureDropped++;
+		return;
+	}
+	event = &g_captureBuffer[g_captureCount];
+	event->info = info;
+	event->data = data;
+	event->delta = delta;
+	g_captureCount++;
+}
+
+#endif
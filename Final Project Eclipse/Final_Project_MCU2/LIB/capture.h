@@ -0,0 +1,161 @@
+/******************************************************************************
+*  File name:		capture.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef LIB_CAPTURE_H_
+#define LIB_CAPTURE_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "std_types.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * Capture of the link for the replay of a field problem on the host. Every byte
+ * read from and written to UDR is saved with the time since timer 2 started and,
+ * for a received byte, its FE and DOR flags. The capture starts at the reset and
+ * stops when its buffer is full or on MSG_ReadCapture, which sends it : replay of
+ * the host build runs MCU2 from the reset with the same EEPROM image and gives it
+ * every byte when the field firmware read it, then checks it sends the same bytes.
+ *
+ * The time is counted in steps of timer 2 (32 us with the 8 ms tick), the ticks
+ * are counted by CAPTURE_tick from the tick ISR. An event has the time since the
+ * previous one, a silence longer than 255 ticks adds a CAPTURE_GAP event first.
+ *
+ * Without CAPTURE_ENABLED the probes are empty and nothing is added to the image,
+ * set it from the build (-DCAPTURE_ENABLED=TRUE) to capture.
+ */
+#ifndef CAPTURE_ENABLED
+#define CAPTURE_ENABLED				FALSE
+#endif
+#ifndef CAPTURE_BUFFER_SIZE
+#define CAPTURE_BUFFER_SIZE			128		/* events, 4 bytes each */
+#endif
+#define CAPTURE_EVENT_SIZE			4		/* bytes of an event on the link */
+#define CAPTURE_TX					0x80	/* set in the info of a byte MCU2 sent */
+#define CAPTURE_GAP					0x40	/* info of a silence, its data and delta are 24 bits of ticks */
+#define CAPTURE_RX_FLAGS			((1<<FE) | (1<<DOR))	/* UCSRA flags kept with a received byte */
+#define CAPTURE_DELTA_TICKS			255		/* longest time in the delta of an event, in ticks */
+#define CAPTURE_MAX_GAP				0xFFFFFFUL	/* ticks, 37 hours with the 8 ms tick, a longer silence is cut */
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Capture_EventType
+* Type: Structure
+* Description: Data type to represent a byte of the link or a silence, sent in this
+* 			   order on the link
+********************************************************************************/
+
+typedef struct
+{
+	uint8 info;		/* CAPTURE_TX or the CAPTURE_RX_FLAGS of UCSRA, or CAPTURE_GAP */
+	uint8 data;		/* the byte, or bits 0 to 7 of the ticks of a silence */
+	uint16 delta;	/* steps of timer 2 since the previous event, bits 8 to 23 of the ticks of a silence */
+}Capture_EventType;
+
+/*******************************************************************************
+*                      		Probes				             	           *
+*******************************************************************************/
+
+#if (CAPTURE_ENABLED == TRUE)
+
+#define CAPTURE_RECEIVE()			CAPTURE_receive()
+#define CAPTURE_SEND(data)			CAPTURE_record(CAPTURE_TX, data)
+
+#else
+
+#define CAPTURE_RECEIVE()			UDR
+#define CAPTURE_SEND(data)
+
+#endif
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		CAPTURE_init
+* Description:			Function to empty the capture and start it, right before timer 2 starts
+* 						as its time counts from there
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void CAPTURE_init(void);
+
+/*******************************************************************************
+* Function Name:		CAPTURE_tick
+* Description:			Function to count a tick of timer 2, called from the tick ISR
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void CAPTURE_tick(void);
+
+/*******************************************************************************
+* Function Name:		CAPTURE_receive
+* Description:			Function to read UDR and save the byte with its flags, used by CAPTURE_RECEIVE
+* Parameters (in):    	None
+* Parameters (out):   	The byte
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 CAPTURE_receive(void);
+
+/*******************************************************************************
+* Function Name:		CAPTURE_record
+* Description:			Function to save an event with the time since the previous one, nothing
+* 						is saved once the capture stopped
+* Parameters (in):    	Info and data of the event
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void CAPTURE_record(uint8 info,uint8 data);
+
+/*******************************************************************************
+* Function Name:		CAPTURE_stop
+* Description:			Function to stop the capture for good so it can be read, it starts again
+* 						only after a reset
+* Parameters (in):    	None
+* Parameters (out):   	Number of events, 0 if the capture is disabled
+* Return value:      	uint16
+********************************************************************************/
+
+uint16 CAPTURE_stop(void);
+
+/*******************************************************************************
+* Function Name:		CAPTURE_getDropped
+* Description:			Function to get the number of events lost because the buffer was full
+* Parameters (in):    	None
+* Parameters (out):   	Number of events, 255 at most
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 CAPTURE_getDropped(void);
+
+/*******************************************************************************
+* Function Name:		CAPTURE_readEvent
+* Description:			Function to read an event of the stopped capture
+* Parameters (in):    	Index of the event, 0 for the oldest, and pointer to the event
+* Parameters (out):   	The event
+* Return value:      	void
+********************************************************************************/
+
+void CAPTURE_readEvent(uint16 index,Capture_EventType *event);
+
+#endif /* LIB_CAPTURE_H_ */
@@ -0,0 +1,28 @@
+/******************************************************************************
+*  File name:		crc16.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "crc16.h"
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+uint16 CRC16_update(uint16 crc,const uint8 *data,uint16 length)
+{
+	for(uint16 i = 0 ; i < length ; i++)
+	{
+		crc ^= (uint16)data[i]<<8;
+		for(uint8 bit = 0 ; bit < 8 ; bit++)
+		{
+			crc = (crc & 0x8000) ? ((crc<<1) ^ CRC16_POLYNOMIAL) : (crc<<1);
+		}
+	}
+	return crc;
+}
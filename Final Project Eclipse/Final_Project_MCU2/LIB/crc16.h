@@ -0,0 +1,38 @@
+/******************************************************************************
+*  File name:		crc16.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef LIB_CRC16_H_
+#define LIB_CRC16_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define CRC16_INITIAL_VALUE			0xFFFF	/* CRC-16/CCITT-FALSE initial value */
+#define CRC16_POLYNOMIAL			0x1021
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		CRC16_update
+* Description:			Function to add bytes to a CRC-16/CCITT, start with CRC16_INITIAL_VALUE
+* 						and pass the result again to continue over more bytes.
+* Parameters (in):    	The CRC so far, the data and its length
+* Parameters (out):   	The new CRC
+* Return value:      	uint16
+********************************************************************************/
+
+uint16 CRC16_update(uint16 crc,const uint8 *data,uint16 length);
+
+#endif /* LIB_CRC16_H_ */
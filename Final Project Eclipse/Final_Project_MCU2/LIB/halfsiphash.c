@@ -0,0 +1,129 @@
+/******************************************************************************
+*  File name:		halfsiphash.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "halfsiphash.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define HALFSIPHASH_C_ROUNDS		2
+#define HALFSIPHASH_D_ROUNDS		4
+
+#define ROTL32(x,b)		(uint32)( ((x)<<(b)) | ((x)>>(32-(b))) )
+
+#define SIPROUND()											\
+	do{														\
+		v0 += v1; v1 = ROTL32(v1,5); v1 ^= v0; v0 = ROTL32(v0,16);	\
+		v2 += v3; v3 = ROTL32(v3,8); v3 ^= v2;						\
+		v0 += v3; v3 = ROTL32(v3,7); v3 ^= v0;						\
+		v2 += v1; v1 = ROTL32(v1,13); v1 ^= v2; v2 = ROTL32(v2,16);	\
+	}while(0)
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint32 HALFSIPHASH_load(const uint8 *bytes);
+static void HALFSIPHASH_store(uint8 *bytes,uint32 value);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void HALFSIPHASH_compute(const uint8 *key,const uint8 *data,uint8 length,uint8 *out)
+{
+	uint32 k0 = HALFSIPHASH_load(key);
+	uint32 k1 = HALFSIPHASH_load(key + 4);
+	uint32 v0 = k0;
+	uint32 v1 = k1 ^ 0xEE; /* 64-bit output */
+	uint32 v2 = k0 ^ 0x6C796765UL;
+	uint32 v3 = k1 ^ 0x74656462UL;
+	uint32 m;
+	uint8 i;
+	uint8 round;
+
+	/* every full 4 bytes block */
+	for(i = 0 ; (uint8)(i + 4) <= length ; i += 4)
+	{
+		m = HALFSIPHASH_load(data + i);
+		v3 ^= m;
+		for(round = 0 ; round < HALFSIPHASH_C_ROUNDS ; round++)
+		{
+			SIPROUND();
+		}
+		v0 ^= m;
+	}
+
+	/* the last block holds the remaining bytes and the length */
+	m = (uint32)length<<24;
+	switch(length & 3)
+	{
+	case 3:
+		m |= (uint32)data[i + 2]<<16;
+		/* no break */
+	case 2:
+		m |= (uint32)data[i + 1]<<8;
+		/* no break */
+	case 1:
+		m |= (uint32)data[i];
+		break;
+	}
+	v3 ^= m;
+	for(round = 0 ; round < HALFSIPHASH_C_ROUNDS ; round++)
+	{
+		SIPROUND();
+	}
+	v0 ^= m;
+
+	/* finalization, two rounds of output for the 64-bit hash */
+	v2 ^= 0xEE;
+	for(round = 0 ; round < HALFSIPHASH_D_ROUNDS ; round++)
+	{
+		SIPROUND();
+	}
+	HALFSIPHASH_store(out, v1 ^ v3);
+
+	v1 ^= 0xDD;
+	for(round = 0 ; round < HALFSIPHASH_D_ROUNDS ; round++)
+	{
+		SIPROUND();
+	}
+	HALFSIPHASH_store(out + 4, v1 ^ v3);
+}
+
+/*******************************************************************************
+* Function Name:		HALFSIPHASH_load
+* Description:			Function to read a little endian 32-bit word
+* Parameters (in):    	Pointer to the 4 bytes
+* Parameters (out):   	The word
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 HALFSIPHASH_load(const uint8 *bytes)
+{
+	return (uint32)bytes[0] | ((uint32)bytes[1]<<8) | ((uint32)bytes[2]<<16) | ((uint32)bytes[3]<<24);
+}
+
+/*******************************************************************************
+* Function Name:		HALFSIPHASH_store
+* Description:			Function to write a 32-bit word in little endian
+* Parameters (in):    	Pointer to the 4 bytes and the word
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void HALFSIPHASH_store(uint8 *bytes,uint32 value)
+{
+	bytes[0] = (uint8)value;
+	bytes[1] = (uint8)(value>>8);
+	bytes[2] = (uint8)(value>>16);
+	bytes[3] = (uint8)(value>>24);
+}
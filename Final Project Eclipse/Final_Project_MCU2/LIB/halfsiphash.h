@@ -0,0 +1,43 @@
+/******************************************************************************
+*  File name:		halfsiphash.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef LIB_HALFSIPHASH_H_
+#define LIB_HALFSIPHASH_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * HalfSipHash-2-4 is the 32-bit version of SipHash, an 8-bit MCU handles 32-bit
+ * additions, XORs and byte rotations inline while the 64-bit SipHash needs a
+ * library call for every shift.
+ */
+#define HALFSIPHASH_KEY_SIZE		8
+#define HALFSIPHASH_OUTPUT_SIZE		8
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		HALFSIPHASH_compute
+* Description:			Function to calculate the 64-bit HalfSipHash-2-4 of a message
+* Parameters (in):    	Key of HALFSIPHASH_KEY_SIZE bytes, the message and its length,
+* 						array of HALFSIPHASH_OUTPUT_SIZE bytes to store the hash in.
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void HALFSIPHASH_compute(const uint8 *key,const uint8 *data,uint8 length,uint8 *out);
+
+#endif /* LIB_HALFSIPHASH_H_ */
@@ -0,0 +1,65 @@
+/******************************************************************************
+*  File name:		stack.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "stack.h"
+
+#if (STACK_PAINT_ENABLED == TRUE)
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+extern uint8 __heap_start; /* end of .bss, nothing but the stack goes above it */
+
+#endif
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void STACK_init(void)
+{
+#if (STACK_PAINT_ENABLED == TRUE)
+	uint8 sreg = SREG;
+	cli(); /* nothing may push while the free part of the stack is painted */
+	for(uint8 *byte = &__heap_start ; byte <= (uint8 *)SP ; byte++)
+	{
+		*byte = STACK_PAINT;
+	}
+	SREG = sreg;
+#endif
+}
+
+uint16 STACK_getUsed(void)
+{
+#if (STACK_PAINT_ENABLED == TRUE)
+	const uint8 *byte = &__heap_start;
+
+	while( (byte <= (const uint8 *)RAMEND) && (*byte == STACK_PAINT) )
+	{
+		byte++;
+	}
+	return (uint16)((const uint8 *)RAMEND + 1 - byte);
+#else
+	return 0;
+#endif
+}
+
+uint16 STACK_getSize(void)
+{
+#if (STACK_PAINT_ENABLED == TRUE)
+	return (uint16)((const uint8 *)RAMEND + 1 - &__heap_start);
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,369 @@
+/******************************************************************************
+*  File name:		trace.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "trace.h"
+#include "../MCAL/TIMER1/timer1.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define TRACE_WINDOW_CYCLES			((uint32)TRACE_LOAD_WINDOW << 16)
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+#if (TRACE_ENABLED == TRUE)
+
+Trace_EventType g_traceBuffer[TRACE_BUFFER_SIZE];
+uint8 g_traceIndex = 0; /* of the next event, wraps */
+static uint16 g_traceTotal = 0; /* events saved since the ring was emptied, counted up to g_traceCounted */
+static uint8 g_traceCounted = 0; /* g_traceIndex when g_traceTotal was counted */
+volatile uint8 g_traceWraps = 0;
+volatile boolean g_traceRecording = FALSE;
+
+#endif
+
+#if (TRACE_STATS_ENABLED == TRUE)
+
+static Trace_IsrStatsType g_traceIsrStats[TRACE_NUM_VECTORS];
+static uint32 g_traceIsrCycles = 0; /* of every ISR, wraps */
+static uint16 g_traceWorstLatency = 0;
+static volatile uint16 g_traceOverflows = 0; /* high half of the 32-bit time */
+static uint8 g_traceWindowOverflows = 0;
+static boolean g_traceIdle = FALSE;
+static uint32 g_traceIdleStart; /* time the main loop started waiting or the window started */
+static uint32 g_traceIdleIsrCycles; /* g_traceIsrCycles at that time */
+static uint32 g_traceIdleCycles = 0; /* in the current window */
+static volatile uint8 g_traceLoad = 0;
+static volatile uint8 g_traceMaxLoad = 0;
+
+#endif
+
+#if (TRACE_USES_TIMER1 == TRUE)
+
+static Timer1_ConfigType g_traceTimer = {0,0,TIMER1_FCPU_1,NORMAL};
+
+#endif
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+#if (TRACE_USES_TIMER1 == TRUE)
+
+static void TRACE_overflow(void);
+
+#endif
+
+#if (TRACE_ENABLED == TRUE)
+
+static void TRACE_count(void);
+
+#endif
+
+#if (TRACE_STATS_ENABLED == TRUE)
+
+static uint32 TRACE_now(void);
+static void TRACE_addIdle(void);
+static void TRACE_closeWindow(void);
+
+#endif
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void TRACE_init(void)
+{
+#if (TRACE_USES_TIMER1 == TRUE)
+	TIMER1_OVF_setCallBack(TRACE_overflow);
+	TIMER1_init(&g_traceTimer);
+#endif
+#if (TRACE_ENABLED == TRUE)
+	TRACE_restart();
+	/* the cost of a probe, seen by the decoder as the shortest possible region */
+	TRACE_ENTER(PROBE);
+	TRACE_EXIT(PROBE);
+#endif
+}
+
+uint8 TRACE_pause(void)
+{
+#if (TRACE_ENABLED == TRUE)
+	uint8 sreg = SREG;
+	cli();
+	g_traceRecording = FALSE;
+	TRACE_count();
+	SREG = sreg;
+	return (g_traceTotal < TRACE_BUFFER_SIZE) ? (uint8)g_traceTotal : TRACE_BUFFER_SIZE;
+#else
+	return 0;
+#endif
+}
+
+uint8 TRACE_getDropped(void)
+{
+#if (TRACE_ENABLED == TRUE)
+	uint16 dropped = (g_traceTotal > TRACE_BUFFER_SIZE) ? (g_traceTotal - TRACE_BUFFER_SIZE) : 0;
+	return (dropped > 0xFF) ? 0xFF : (uint8)dropped;
+#else
+	return 0;
+#endif
+}
+
+void TRACE_readEvent(uint8 age,Trace_EventType *event)
+{
+#if (TRACE_ENABLED == TRUE)
+	uint8 oldest = (g_traceTotal < TRACE_BUFFER_SIZE) ? 0 : g_traceIndex;
+	*event = g_traceBuffer[(uint8)(oldest + age) & (TRACE_BUFFER_SIZE - 1)];
+#else
+	(void)age;
+	(void)event;
+#endif
+}
+
+void TRACE_restart(void)
+{
+#if (TRACE_ENABLED == TRUE)
+	uint8 sreg = SREG;
+	cli();
+	g_traceIndex = 0;
+	g_traceCounted = 0;
+	g_traceTotal = 0;
+	g_traceRecording = TRUE;
+	SREG = sreg;
+#endif
+}
+
+void TRACE_isrExit(Trace_VectorType vector,uint16 start)
+{
+#if (TRACE_STATS_ENABLED == TRUE)
+	Trace_IsrStatsType *stats = &g_traceIsrStats[vector];
+	uint16 cycles = TCNT1 - start;
+
+	if(vector == TRACE_VECTOR_TIMER1_OVF)
+	{
+		/* the timer was at 0 when the flag was set */
+		if(start > g_traceWorstLatency)
+			g_traceWorstLatency = start;
+	}
+	if(stats->samples == 0xFFFF)
+	{
+		stats->samples >>= 1;
+		stats->sum >>= 1;
+	}
+	stats->count++;
+	stats->samples++;
+	stats->sum += cycles;
+	if(cycles > stats->max)
+		stats->max = cycles;
+	g_traceIsrCycles += cycles;
+#else
+	(void)vector;
+	(void)start;
+#endif
+}
+
+void TRACE_idleEnter(void)
+{
+#if (TRACE_STATS_ENABLED == TRUE)
+	uint8 sreg = SREG;
+	cli();
+	g_traceIdleStart = TRACE_now();
+	g_traceIdleIsrCycles = g_traceIsrCycles;
+	g_traceIdle = TRUE;
+	SREG = sreg;
+#endif
+}
+
+void TRACE_idleExit(void)
+{
+#if (TRACE_STATS_ENABLED == TRUE)
+	uint8 sreg = SREG;
+	cli();
+	if(g_traceIdle)
+	{
+		TRACE_addIdle();
+		g_traceIdle = FALSE;
+	}
+	SREG = sreg;
+#endif
+}
+
+void TRACE_readIsrStats(Trace_VectorType vector,Trace_IsrStatsType *stats)
+{
+#if (TRACE_STATS_ENABLED == TRUE)
+	uint8 sreg = SREG;
+	cli();
+	*stats = g_traceIsrStats[vector];
+	SREG = sreg;
+#else
+	(void)vector;
+	stats->count = 0;
+	stats->sum = 0;
+	stats->samples = 0;
+	stats->max = 0;
+#endif
+}
+
+uint16 TRACE_getWorstLatency(void)
+{
+#if (TRACE_STATS_ENABLED == TRUE)
+	uint16 latency;
+	uint8 sreg = SREG;
+	cli();
+	latency = g_traceWorstLatency;
+	SREG = sreg;
+	return latency;
+#else
+	return 0;
+#endif
+}
+
+uint8 TRACE_getLoad(void)
+{
+#if (TRACE_STATS_ENABLED == TRUE)
+	return g_traceLoad;
+#else
+	return 0;
+#endif
+}
+
+uint8 TRACE_getMaxLoad(void)
+{
+#if (TRACE_STATS_ENABLED == TRUE)
+	return g_traceMaxLoad;
+#else
+	return 0;
+#endif
+}
+
+#if (TRACE_USES_TIMER1 == TRUE)
+
+/*******************************************************************************
+* Function Name:		TRACE_overflow
+* Description:			Call back of the overflow of timer 1, every 65536 cycles
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void TRACE_overflow(void)
+{
+#if (TRACE_ENABLED == TRUE)
+	g_traceWraps++;
+	TRACE_count();
+#endif
+#if (TRACE_STATS_ENABLED == TRUE)
+	g_traceOverflows++;
+	g_traceWindowOverflows++;
+	if(g_traceWindowOverflows == TRACE_LOAD_WINDOW)
+	{
+		g_traceWindowOverflows = 0;
+		TRACE_closeWindow();
+	}
+#endif
+}
+
+#endif
+
+#if (TRACE_ENABLED == TRUE)
+
+/*******************************************************************************
+* Function Name:		TRACE_count
+* Description:			Function to add the events saved since the last count to the total, with
+* 						the interrupts disabled
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void TRACE_count(void)
+{
+	g_traceTotal += (uint8)(g_traceIndex - g_traceCounted);
+	g_traceCounted = g_traceIndex;
+}
+
+#endif
+
+#if (TRACE_STATS_ENABLED == TRUE)
+
+/*******************************************************************************
+* Function Name:		TRACE_now
+* Description:			Function to get the 32-bit time, with the interrupts disabled
+* Parameters (in):    	None
+* Parameters (out):   	Cycles since timer 1 started, wraps after about 9 minutes at 8 MHz
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 TRACE_now(void)
+{
+	uint16 time = TCNT1;
+	uint16 overflows = g_traceOverflows;
+
+	/* the overflow isn't counted yet while the interrupts are disabled */
+	if( (TIFR & (1<<TOV1)) && ((time & 0x8000) == 0) )
+	{
+		overflows++;
+	}
+	return ((uint32)overflows << 16) | time;
+}
+
+/*******************************************************************************
+* Function Name:		TRACE_addIdle
+* Description:			Function to add the wait of the main loop up to now to the window, without
+* 						the ISRs that ran meanwhile, and to start counting it again from now
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void TRACE_addIdle(void)
+{
+	uint32 now = TRACE_now();
+
+	g_traceIdleCycles += (now - g_traceIdleStart) - (g_traceIsrCycles - g_traceIdleIsrCycles);
+	g_traceIdleStart = now;
+	g_traceIdleIsrCycles = g_traceIsrCycles;
+}
+
+/*******************************************************************************
+* Function Name:		TRACE_closeWindow
+* Description:			Function to get the CPU load of the window that ends and to start the next one
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void TRACE_closeWindow(void)
+{
+	uint8 load;
+
+	if(g_traceIdle)
+	{
+		TRACE_addIdle(); /* the rest of the wait goes to the next window */
+	}
+	if(g_traceIdleCycles >= TRACE_WINDOW_CYCLES)
+	{
+		load = 0;
+	}
+	else
+	{
+		load = (uint8)(TRACE_MAX_LOAD - ((g_traceIdleCycles * TRACE_MAX_LOAD) / TRACE_WINDOW_CYCLES));
+	}
+	g_traceIdleCycles = 0;
+	g_traceLoad = load;
+	if(load > g_traceMaxLoad)
+		g_traceMaxLoad = load;
+}
+
+#endif
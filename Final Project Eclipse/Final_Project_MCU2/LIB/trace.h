@@ -0,0 +1,359 @@
+/******************************************************************************
+*  File name:		trace.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef LIB_TRACE_H_
+#define LIB_TRACE_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "std_types.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/*
+ * Tracing of the time spent in the regions of trace_regions.h. TRACE_ENTER and
+ * TRACE_EXIT save the id of the region and a 24-bit time stamp in a RAM ring,
+ * the oldest events are overwritten when it is full. The time is TCNT1 running
+ * at F_CPU with the number of its overflows as the high byte, it wraps after
+ * about 2 s at 8 MHz so no region may last longer. The ring is sent over the
+ * link on MSG_ReadTrace and trace_decode of the host build turns it into the
+ * time of every region.
+ *
+ * The statistics of the interrupts are kept in the field : TRACE_ISR_ENTER and
+ * TRACE_ISR_EXIT in every ISR count its calls, its average and longest time from
+ * the end of its prologue. The worst time the interrupts stay disabled is seen
+ * from the timer 1 overflow, the cycles from the overflow to its ISR are sampled
+ * every 65536 cycles, prologue included. The CPU load is the part of every
+ * window of TRACE_LOAD_WINDOW overflows not spent between TRACE_IDLE_ENTER and
+ * TRACE_IDLE_EXIT, where the main loop waits for MCU1 or for the door, less the
+ * ISRs that ran meanwhile. They are sent over the link on MSG_ReadStats.
+ *
+ * The ring is indexed in 8 bits, the events are counted from the index on every
+ * overflow of timer 1 so no more than 255 may be saved in 65536 cycles. In an ISR
+ * or a callback of one TRACE_ENTER_ISR and TRACE_EXIT_ISR don't save SREG and
+ * disable the interrupts, they are already disabled.
+ *
+ * Timer 1 belongs to the trace while either is enabled and its overflow then
+ * interrupts every 65536 cycles. Both are disabled by default, the probes are
+ * empty and nothing is added to the image, set them from the build
+ * (-DTRACE_ENABLED=TRUE, -DTRACE_STATS_ENABLED=TRUE) to trace.
+ */
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED				FALSE
+#endif
+#ifndef TRACE_STATS_ENABLED
+#define TRACE_STATS_ENABLED			FALSE
+#endif
+#if (TRACE_ENABLED == TRUE) || (TRACE_STATS_ENABLED == TRUE)
+#define TRACE_USES_TIMER1			TRUE
+#else
+#define TRACE_USES_TIMER1			FALSE
+#endif
+#define TRACE_BUFFER_SIZE			64		/* events in the ring, a power of 2 */
+#define TRACE_EVENT_SIZE			4		/* bytes of an event on the link */
+#define TRACE_EXIT_FLAG				0x80	/* set in the id of the exit of a region */
+#define TRACE_LOAD_WINDOW			128		/* overflows of timer 1 in a CPU load window, 1.05 s at 8 MHz */
+#define TRACE_MAX_LOAD				100		/* % */
+
+#if ((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) != 0) || (TRACE_BUFFER_SIZE > 128)
+
+#error "The trace ring must be a power of 2 and its size must fit in 8 bits"
+
+#endif
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Trace_RegionType
+* Type: Enumeration
+* Description: Data type to represent the id of a traced region
+********************************************************************************/
+
+#define TRACE_REGION(name)			TRACE_##name,
+typedef enum
+{
+#include "trace_regions.h"
+	TRACE_NUM_REGIONS
+}Trace_RegionType;
+#undef TRACE_REGION
+
+/*******************************************************************************
+* Name: Trace_VectorType
+* Type: Enumeration
+* Description: Data type to represent an interrupt vector with statistics
+********************************************************************************/
+
+#define TRACE_VECTOR(name)			TRACE_VECTOR_##name,
+typedef enum
+{
+#include "trace_vectors.h"
+	TRACE_NUM_VECTORS
+}Trace_VectorType;
+#undef TRACE_VECTOR
+
+/*******************************************************************************
+* Name: Trace_IsrStatsType
+* Type: Structure
+* Description: Data type to represent the statistics of an interrupt vector
+********************************************************************************/
+
+typedef struct
+{
+	uint32 count;	/* calls since the reset */
+	uint32 sum;		/* cycles of the last samples calls */
+	uint16 samples;	/* halved with sum before it overflows, the average stays the same */
+	uint16 max;		/* cycles of the longest call */
+}Trace_IsrStatsType;
+
+/*******************************************************************************
+* Name: Trace_EventType
+* Type: Structure
+* Description: Data type to represent an entry to or an exit from a region, sent in this
+* 			   order on the link
+********************************************************************************/
+
+typedef struct
+{
+	uint8 id;		/* Trace_RegionType, with TRACE_EXIT_FLAG on the exit */
+	uint16 time;	/* TCNT1, little endian */
+	uint8 wraps;	/* overflows of timer 1, the high byte of the time */
+}Trace_EventType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+#if (TRACE_ENABLED == TRUE)
+
+/* only used by the probes, they are inlined so the time of a call isn't added to every region */
+extern Trace_EventType g_traceBuffer[TRACE_BUFFER_SIZE];
+extern uint8 g_traceIndex;
+extern volatile uint8 g_traceWraps;
+extern volatile boolean g_traceRecording;
+
+#endif
+
+/*******************************************************************************
+*                      		Probes				             	           *
+*******************************************************************************/
+
+#if (TRACE_ENABLED == TRUE)
+
+#define TRACE_ENTER(region)			TRACE_record(TRACE_##region)
+#define TRACE_EXIT(region)			TRACE_record(TRACE_##region | TRACE_EXIT_FLAG)
+#define TRACE_ENTER_ISR(region)		TRACE_save(TRACE_##region)
+#define TRACE_EXIT_ISR(region)		TRACE_save(TRACE_##region | TRACE_EXIT_FLAG)
+
+/*******************************************************************************
+* Function Name:		TRACE_save
+* Description:			Function to save an event with the time it happened, with the interrupts
+* 						disabled. The timer is read first so the rest of the probe counts in the region
+* Parameters (in):    	Id of the region with TRACE_EXIT_FLAG on the exit
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static inline __attribute__((always_inline)) void TRACE_save(uint8 id)
+{
+	uint16 time = TCNT1;
+	uint8 wraps;
+	Trace_EventType *event;
+
+	if(g_traceRecording)
+	{
+		wraps = g_traceWraps;
+		/* the overflow isn't counted yet while the interrupts are disabled */
+		if( (TIFR & (1<<TOV1)) && ((time & 0x8000) == 0) )
+		{
+			wraps++;
+		}
+		event = &g_traceBuffer[g_traceIndex & (TRACE_BUFFER_SIZE - 1)];
+		event->id = id;
+		event->time = time;
+		event->wraps = wraps;
+		g_traceIndex++;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		TRACE_record
+* Description:			Function to save an event with the time it happened out of an ISR
+* Parameters (in):    	Id of the region with TRACE_EXIT_FLAG on the exit
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static inline __attribute__((always_inline)) void TRACE_record(uint8 id)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	TRACE_save(id);
+	SREG = sreg;
+}
+
+#else
+
+#define TRACE_ENTER(region)
+#define TRACE_EXIT(region)
+#define TRACE_ENTER_ISR(region)
+#define TRACE_EXIT_ISR(region)
+
+#endif
+
+#if (TRACE_STATS_ENABLED == TRUE)
+
+/* first and last statement of an ISR, the ISRs don't nest so 16 bits of time are enough */
+#define TRACE_ISR_ENTER(vector)		uint16 traceIsrStart = TCNT1
+#define TRACE_ISR_EXIT(vector)		TRACE_isrExit(TRACE_VECTOR_##vector, traceIsrStart)
+#define TRACE_IDLE_ENTER()			TRACE_idleEnter()
+#define TRACE_IDLE_EXIT()			TRACE_idleExit()
+
+#else
+
+#define TRACE_ISR_ENTER(vector)
+#define TRACE_ISR_EXIT(vector)
+#define TRACE_IDLE_ENTER()
+#define TRACE_IDLE_EXIT()
+
+#endif
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		TRACE_init
+* Description:			Function to start timer 1 as the clock of the trace and the statistics and to
+* 						empty the ring, nothing is done if both are disabled
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void TRACE_init(void);
+
+/*******************************************************************************
+* Function Name:		TRACE_pause
+* Description:			Function to stop saving events so the ring can be read, the probes still
+* 						run and take the same time
+* Parameters (in):    	None
+* Parameters (out):   	Number of events in the ring, 0 if the tracing is disabled
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 TRACE_pause(void);
+
+/*******************************************************************************
+* Function Name:		TRACE_getDropped
+* Description:			Function to get the number of events overwritten since the ring was emptied
+* Parameters (in):    	None
+* Parameters (out):   	Number of events, 255 at most
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 TRACE_getDropped(void);
+
+/*******************************************************************************
+* Function Name:		TRACE_readEvent
+* Description:			Function to read an event of the paused ring
+* Parameters (in):    	Age of the event, 0 for the oldest, and pointer to the event
+* Parameters (out):   	The event
+* Return value:      	void
+********************************************************************************/
+
+void TRACE_readEvent(uint8 age,Trace_EventType *event);
+
+/*******************************************************************************
+* Function Name:		TRACE_restart
+* Description:			Function to empty the ring and save events again
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void TRACE_restart(void);
+
+/*******************************************************************************
+* Function Name:		TRACE_isrExit
+* Description:			Function to add a call of an ISR to its statistics, used by TRACE_ISR_EXIT
+* Parameters (in):    	Vector and TCNT1 at the start of the ISR
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void TRACE_isrExit(Trace_VectorType vector,uint16 start);
+
+/*******************************************************************************
+* Function Name:		TRACE_idleEnter
+* Description:			Function to tell the CPU load that the main loop starts waiting
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void TRACE_idleEnter(void);
+
+/*******************************************************************************
+* Function Name:		TRACE_idleExit
+* Description:			Function to tell the CPU load that the main loop stops waiting
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void TRACE_idleExit(void);
+
+/*******************************************************************************
+* Function Name:		TRACE_readIsrStats
+* Description:			Function to read the statistics of an interrupt vector, all 0 if the
+* 						statistics are disabled
+* Parameters (in):    	Vector and pointer to the statistics
+* Parameters (out):   	The statistics
+* Return value:      	void
+********************************************************************************/
+
+void TRACE_readIsrStats(Trace_VectorType vector,Trace_IsrStatsType *stats);
+
+/*******************************************************************************
+* Function Name:		TRACE_getWorstLatency
+* Description:			Function to get the longest time seen from an overflow of timer 1 to its ISR
+* Parameters (in):    	None
+* Parameters (out):   	Cycles
+* Return value:      	uint16
+********************************************************************************/
+
+uint16 TRACE_getWorstLatency(void);
+
+/*******************************************************************************
+* Function Name:		TRACE_getLoad
+* Description:			Function to get the CPU load of the last window
+* Parameters (in):    	None
+* Parameters (out):   	Load in %
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 TRACE_getLoad(void);
+
+/*******************************************************************************
+* Function Name:		TRACE_getMaxLoad
+* Description:			Function to get the highest CPU load of a window since the reset
+* Parameters (in):    	None
+* Parameters (out):   	Load in %
+* Return value:      	uint8
+********************************************************************************/
+
+uint8 TRACE_getMaxLoad(void);
+
+#endif /* LIB_TRACE_H_ */
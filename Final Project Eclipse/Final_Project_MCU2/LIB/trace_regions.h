@@ -0,0 +1,20 @@
+/******************************************************************************
+*  File name:		trace_regions.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * The regions timed by the trace probes, one TRACE_REGION(name) per region in the
+ * order of their ids. This file is included with a definition of TRACE_REGION
+ * by trace.h to make the ids and by the host decoder to print their names, so it
+ * includes nothing. The ids go up to 127, bit 7 of an event marks an exit.
+ */
+
+TRACE_REGION(PROBE)				/* two probes back to back, the cost of the tracing itself */
+TRACE_REGION(TICK)				/* TIMER2_TICK_ISR, the motor, the buzzer and the seconds */
+TRACE_REGION(CHECK_PASSWORD)	/* APP_checkPassword, from the message of MCU1 to the answer */
+TRACE_REGION(READ_PASSWORD)		/* APP_readPassword, journal read of the hash of the main password */
+TRACE_REGION(MATCH)				/* CREDENTIAL_match of the main password */
+TRACE_REGION(VERIFY)			/* CREDENTIAL_verify, the users table */
+TRACE_REGION(AUDIT_FLUSH)		/* AUDIT_flush, the staged events written to the EEPROM */
@@ -0,0 +1,16 @@
+/******************************************************************************
+*  File name:		trace_vectors.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * The interrupt vectors with statistics, one TRACE_VECTOR(name) per vector in the
+ * order they are sent on MSG_ReadStats. Like trace_regions.h it is included by
+ * trace.h and by the host decoder so it includes nothing.
+ */
+
+TRACE_VECTOR(TIMER1_COMPA)		/* timer1.c, the tones of the buzzer don't use it */
+TRACE_VECTOR(TIMER1_OVF)		/* timer1.c, the clock of the trace itself */
+TRACE_VECTOR(TIMER2_COMP)		/* timer2.c, the 8 ms tick */
+TRACE_VECTOR(USART_RXC)			/* uart.c, only with a UART in interrupt mode */
@@ -0,0 +1,44 @@
+/******************************************************************************
+*  File name:		adc.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "adc.h"
+#include "avr/io.h"
+#include "../../LIB/common_macros.h"
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+void ADC_init(const ADC_ConfigType * Config_Ptr)
+{
+	ADMUX = (uint8)(Config_Ptr->ref_volt << REFS0); /* right adjusted result, channel 0 */
+	ADCSRA = (1<<ADEN) | (1<<ADIF) | (Config_Ptr->prescaler); /* no auto trigger nor interrupt, a pending flag is cleared */
+}
+
+uint16 ADC_readChannel(uint8 channel_num)
+{
+	ADC_startConversion(channel_num);
+	while(ADC_isConversionComplete() == FALSE){}
+	return ADC_getResult();
+}
+
+void ADC_startConversion(uint8 channel_num)
+{
+	ADMUX = (ADMUX & 0xE0) | (channel_num & 0x1F);
+	ADCSRA |= (1<<ADIF) | (1<<ADSC); /* ADIF is cleared by writing 1 to it */
+}
+
+boolean ADC_isConversionComplete(void)
+{
+	return BIT_IS_SET(ADCSRA,ADIF) ? TRUE : FALSE;
+}
+
+uint16 ADC_getResult(void)
+{
+	return ADC; /* ADCL then ADCH */
+}
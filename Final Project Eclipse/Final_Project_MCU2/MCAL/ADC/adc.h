@@ -0,0 +1,115 @@
+/******************************************************************************
+*  File name:		adc.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef MCAL_ADC_ADC_H_
+#define MCAL_ADC_ADC_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+#define ADC_MAXIMUM_VALUE		1023
+#define ADC_NUM_OF_CHANNELS		8		/* single ended inputs ADC0 to ADC7 on PORTA */
+#define ADC_CHANNEL_BANDGAP		0x1E	/* internal 1.22 V reference */
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: ADC_ReferenceVoltage
+* Type: Enumeration
+* Description: Data type to represent the voltage of ADC_MAXIMUM_VALUE
+********************************************************************************/
+typedef enum
+{
+	ADC_AREF,				/* external voltage on the AREF pin */
+	ADC_AVCC,				/* AVCC with a capacitor on the AREF pin */
+	ADC_INTERNAL_2_56V = 3	/* internal 2.56 V with a capacitor on the AREF pin */
+}ADC_ReferenceVoltage;
+
+/*******************************************************************************
+* Name: ADC_Prescaler
+* Type: Enumeration
+* Description: Data type to represent the ADC clock prescaler, the clock should be
+* 			   between 50 KHz and 200 KHz for the full resolution
+********************************************************************************/
+typedef enum
+{
+	ADC_FCPU_2 = 1,
+	ADC_FCPU_4,
+	ADC_FCPU_8,
+	ADC_FCPU_16,
+	ADC_FCPU_32,
+	ADC_FCPU_64,
+	ADC_FCPU_128
+}ADC_Prescaler;
+
+/*******************************************************************************
+* Name: ADC_ConfigType
+* Type: Structure
+* Description: Data type to dynamic configure the ADC module
+********************************************************************************/
+typedef struct {
+ ADC_ReferenceVoltage ref_volt;
+ ADC_Prescaler prescaler;
+} ADC_ConfigType;
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		ADC_init
+* Description:			Function to dynamic configure the ADC module, the interrupt is not used
+* Parameters (in):    	Pointer to structure of type ADC_ConfigType
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void ADC_init(const ADC_ConfigType * Config_Ptr);
+
+/*******************************************************************************
+* Function Name:		ADC_readChannel
+* Description:			Function to convert a channel and wait for the result, 13 ADC clocks
+* Parameters (in):    	Channel number
+* Parameters (out):   	Digital value of the channel
+* Return value:      	uint16
+********************************************************************************/
+uint16 ADC_readChannel(uint8 channel_num);
+
+/*******************************************************************************
+* Function Name:		ADC_startConversion
+* Description:			Function to start converting a channel without waiting, the result is read
+* 						with ADC_getResult once ADC_isConversionComplete returns TRUE
+* Parameters (in):    	Channel number or MUX4:0 value like ADC_CHANNEL_BANDGAP
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void ADC_startConversion(uint8 channel_num);
+
+/*******************************************************************************
+* Function Name:		ADC_isConversionComplete
+* Description:			Function to check if the last started conversion is done
+* Parameters (in):    	None
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+boolean ADC_isConversionComplete(void);
+
+/*******************************************************************************
+* Function Name:		ADC_getResult
+* Description:			Function to get the result of the last finished conversion
+* Parameters (in):    	None
+* Parameters (out):   	Digital value of the channel
+* Return value:      	uint16
+********************************************************************************/
+uint16 ADC_getResult(void);
+
+#endif /* MCAL_ADC_ADC_H_ */
@@ -0,0 +1,48 @@
+/******************************************************************************
+*  File name:		int_eeprom.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "int_eeprom.h"
+#include <avr/eeprom.h>
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+uint8 INT_EEPROM_readBlock(uint16 address,uint8 *data,uint8 length)
+{
+	uint8 i;
+
+	if( ((uint32)address + length) > INT_EEPROM_SIZE )
+		return ERROR;
+
+	for(i = 0; i < length; i++)
+	{
+		data[i] = eeprom_read_byte((const uint8 *)(uintptr_t)(address + i));
+	}
+	return SUCCESS;
+}
+
+uint8 INT_EEPROM_writeBlock(uint16 address,const uint8 *data,uint8 length)
+{
+	uint8 i;
+
+	if( ((uint32)address + length) > INT_EEPROM_SIZE )
+		return ERROR;
+
+	for(i = 0; i < length; i++)
+	{
+		uint8 *cell = (uint8 *)(uintptr_t)(address + i); /* avr-libc takes the EEPROM address as a pointer */
+		if(eeprom_read_byte(cell) != data[i])
+		{
+			eeprom_write_byte(cell, data[i]);
+			if(eeprom_read_byte(cell) != data[i]) /* waits for the end of the write */
+				return ERROR;
+		}
+	}
+	return SUCCESS;
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+*  File name:		int_eeprom.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef MCAL_INT_EEPROM_INT_EEPROM_H_
+#define MCAL_INT_EEPROM_INT_EEPROM_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+#define ERROR 0
+#define SUCCESS 1
+
+/*
+ * The 1 KB EEPROM inside the ATmega32 keeps the secrets of the lock. Unlike the 24C16 it
+ * can't be unplugged and read, and with the lock bits programmed (mode 3, LB1 and LB2,
+ * lock byte 0xFC) neither the programmer nor JTAG can read it back. A write takes 8.5 ms
+ * per byte and a byte lasts about 100000 writes, what is written there must rarely change.
+ * The bytes go through the avr-libc routines: EEWE must be set within 4 cycles of EEMWE,
+ * which the C code of the -O0 Debug build can't do.
+ */
+#define INT_EEPROM_SIZE			1024
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		INT_EEPROM_readBlock
+* Description:			Function to read bytes of the internal EEPROM, waits for a running write
+* Parameters (in):    	Address and number of bytes
+* Parameters (out):   	Bytes read
+* Return value:      	SUCCESS or ERROR if the block is out of the EEPROM
+********************************************************************************/
+uint8 INT_EEPROM_readBlock(uint16 address,uint8 *data,uint8 length);
+
+/*******************************************************************************
+* Function Name:		INT_EEPROM_writeBlock
+* Description:			Function to write bytes of the internal EEPROM and read them back, a byte
+* 						that already holds its value isn't written again
+* Parameters (in):    	Address, bytes and number of bytes
+* Parameters (out):   	None
+* Return value:      	SUCCESS or ERROR if the block is out of the EEPROM or doesn't read back
+********************************************************************************/
+uint8 INT_EEPROM_writeBlock(uint16 address,const uint8 *data,uint8 length);
+
+#endif /* MCAL_INT_EEPROM_INT_EEPROM_H_ */
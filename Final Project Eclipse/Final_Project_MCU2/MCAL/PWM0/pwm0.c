@@ -11,16 +11,32 @@
 #include "pwm0.h"
 #include "avr/io.h"
 #include "../GPIO/gpio.h"
+#include "../../../SHARED/board_mcu2.h" /* PWM0_OC0 */
 
-void PWM_Timer0_Start(uint8 duty_cycle)
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void PWM_Timer0_Init(const Pwm0_ConfigType * Config_Ptr)
 {
-	/* Configure the timer with
-	 * Non inverting fast PWM Mode
-	 * Clock frequency = F_CPU/8
-	 */
+	TCCR0 = 0; /* stop it while it is configured */
 	TCNT0 = 0;
-	OCR0 = (uint8)((uint16)(duty_cycle*255)/100) ; /* casting the value so we don't get overflow */
-	GPIO_setupPinDirection(PORTB_ID, PIN3_ID, PIN_OUTPUT); /* PWM pin as O/P */
-	TCCR0 = (1<<WGM01) | (1<<WGM00) | (1<<COM01) | (1<<CS01);
+	OCR0 = Config_Ptr->duty_cycle;
+	GPIO_OUTPUT(PWM0_OC0); /* PWM pin as O/P */
+	/* Non inverting fast PWM Mode */
+	TCCR0 = (1<<WGM01) | (1<<WGM00) | (1<<COM01) | (Config_Ptr->prescaler);
+}
 
+void PWM_Timer0_SetDuty(uint8 duty_cycle)
+{
+	/* OCR0 is double buffered in PWM mode, the timer loads it at the overflow */
+	OCR0 = duty_cycle;
+}
+
+void PWM_Timer0_DeInit(void)
+{
+	TCCR0 = 0; /* OC0 disconnected, the pin is back to PORTB */
+	TCNT0 = 0;
+	OCR0 = 0;
+	GPIO_LOW(PWM0_OC0);
 }
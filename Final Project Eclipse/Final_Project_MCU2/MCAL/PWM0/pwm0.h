@@ -13,19 +13,77 @@
 
 #include "../../LIB/std_types.h"
 
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define PWM0_MAX_DUTY		255		/* always high, the duty is in 1/256 of the period */
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Pwm0_Prescaler
+* Type: Enumeration
+* Description: Data type to represent the timer prescaler, the PWM frequency is
+* 			   F_CPU / (prescaler * 256) : 3.9 KHz with F_CPU/8 at 8 MHz
+********************************************************************************/
+
+typedef enum
+{
+	PWM0_OFF,
+	PWM0_FCPU_1,
+	PWM0_FCPU_8,
+	PWM0_FCPU_64,
+	PWM0_FCPU_256,
+	PWM0_FCPU_1024
+}Pwm0_Prescaler;
+
+/*******************************************************************************
+* Name: Pwm0_ConfigType
+* Type: Structure
+* Description: Data type to dynamic configure the PWM, it always runs in non inverting fast PWM mode on OC0
+********************************************************************************/
+
+typedef struct {
+ Pwm0_Prescaler prescaler;
+ uint8 duty_cycle; /* first duty cycle, 0 to PWM0_MAX_DUTY */
+} Pwm0_ConfigType;
+
 /*******************************************************************************
 *                      Functions Prototypes                                   *
 *******************************************************************************/
 
 /*******************************************************************************
-* Function Name:		PWM_Timer0_Start
-* Description:			Function to control the PWM with timer 0 and set the duty cycle
-* Parameters (in):    	The required duty cycle for the PWM
+* Function Name:		PWM_Timer0_Init
+* Description:			Function to setup timer 0 and its pin for the PWM, called once
+* Parameters (in):    	Pointer to structure of type Pwm0_ConfigType
 * Parameters (out):   	None
 * Return value:      	void
 ********************************************************************************/
 
-void PWM_Timer0_Start(uint8 duty_cycle);
+void PWM_Timer0_Init(const Pwm0_ConfigType * Config_Ptr);
+
+/*******************************************************************************
+* Function Name:		PWM_Timer0_SetDuty
+* Description:			Function to change the duty cycle of the running PWM, the new value is
+* 						used from the next period so no period is cut short
+* Parameters (in):    	The required duty cycle, 0 to PWM0_MAX_DUTY
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void PWM_Timer0_SetDuty(uint8 duty_cycle);
+
+/*******************************************************************************
+* Function Name:		PWM_Timer0_DeInit
+* Description:			Function to stop timer 0 and drive its pin low
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
 
+void PWM_Timer0_DeInit(void);
 
 #endif /* PWM0_PWM0_H_ */
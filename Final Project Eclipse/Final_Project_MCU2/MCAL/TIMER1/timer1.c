@@ -10,30 +10,37 @@
 #include "timer1.h"
 #include "avr/interrupt.h"
 #include "avr/io.h"
+#include "../GPIO/gpio.h"
+#include "../../../SHARED/board_mcu2.h" /* TIMER1_OC1A */
+#include "../../LIB/trace.h"
 
 /*******************************************************************************
 *                           Global Variables                                  *
 *******************************************************************************/
-static volatile void (*g_callBackPtr1)(void) = NULL_PTR; /* to store the address of the function */
-static volatile void (*g_callBackPtr2)(void) = NULL_PTR; /* to store the address of the function */
+static void (*volatile g_callBackPtr1)(void) = NULL_PTR; /* to store the address of the function */
+static void (*volatile g_callBackPtr2)(void) = NULL_PTR; /* to store the address of the function */
 
 /*******************************************************************************
 *                      Functions Definitions                                   *
 *******************************************************************************/
 ISR(TIMER1_COMPA_vect)
 {
+	TRACE_ISR_ENTER(TIMER1_COMPA);
 	if(g_callBackPtr1 != NULL_PTR)
 	{
 		(*g_callBackPtr1)();
 	}
+	TRACE_ISR_EXIT(TIMER1_COMPA);
 }
 
 ISR(TIMER1_OVF_vect)
 {
+	TRACE_ISR_ENTER(TIMER1_OVF);
 	if(g_callBackPtr2 != NULL_PTR)
 	{
 		(*g_callBackPtr2)();
 	}
+	TRACE_ISR_EXIT(TIMER1_OVF);
 }
 
 void TIMER1_init(Timer1_ConfigType * Config_Ptr)
@@ -46,8 +53,12 @@ void TIMER1_init(Timer1_ConfigType * Config_Ptr)
 	if(Config_Ptr->mode == COMPARE)
 	{
 		OCR1A = Config_Ptr->compare_value;
+		TIMSK |= (1<<OCIE1A) ;
+	}
+	else
+	{
+		TIMSK |= (1<<TOIE1) ; /* the overflow is the only event in normal mode */
 	}
-	TIMSK |= (1<<OCIE1A) ;
 }
 
 void TIMER1_deInit()
@@ -58,6 +69,38 @@ void TIMER1_deInit()
 	OCR1A = 0;
 }
 
+void TIMER1_startTone(uint16 frequency)
+{
+	/* OC1A toggles at every compare match so f = F_CPU / (2 * N * (1 + OCR1A)) */
+	uint32 compare = (F_CPU / 2) / frequency;
+	Timer1_Prescaler prescaler = TIMER1_FCPU_1;
+	if(compare > 0x10000UL)
+	{
+		compare /= 8;
+		prescaler = TIMER1_FCPU_8;
+	}
+	if(compare > 0x10000UL)
+	{
+		compare = 0x10000UL; /* lowest tone */
+	}
+
+	TIMSK &= ~((1<<OCIE1A) | (1<<TOIE1));
+	TCCR1B = 0; /* stop it while it is configured */
+	TCNT1 = 0;
+	OCR1A = (uint16)(compare - 1);
+	GPIO_OUTPUT(TIMER1_OC1A); /* OC1A as O/P */
+	TCCR1A = (1<<COM1A0) | (1<<FOC1A); /* toggle OC1A on compare match */
+	TCCR1B = (1<<WGM12) | prescaler; /* CTC mode */
+}
+
+void TIMER1_stopTone(void)
+{
+	TCCR1B = 0;
+	TCCR1A = 0; /* OC1A disconnected, the pin is back to PORTD */
+	TCNT1 = 0;
+	GPIO_LOW(TIMER1_OC1A);
+}
+
 void TIMER1_COMP_setCallBack( void(*a_ptr)(void) )
 {
 	g_callBackPtr1 = a_ptr;
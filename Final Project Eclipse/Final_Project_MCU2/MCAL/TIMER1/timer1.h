@@ -76,6 +76,25 @@ void TIMER1_init(Timer1_ConfigType * Config_Ptr);
 ********************************************************************************/
 void TIMER1_deInit();
 
+/*******************************************************************************
+* Function Name:		TIMER1_startTone
+* Description:			Function to output a square wave on OC1A (PD5) without any interrupt,
+* 						the timer can't be used for anything else until TIMER1_stopTone
+* Parameters (in):    	Frequency in Hz, from 16 Hz
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void TIMER1_startTone(uint16 frequency);
+
+/*******************************************************************************
+* Function Name:		TIMER1_stopTone
+* Description:			Function to stop the square wave and drive OC1A low
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void TIMER1_stopTone(void);
+
 /*******************************************************************************
 * Function Name:		TIMER1_COMP_setCallBack
 * Description:			Function to set the ISR for timer in case using compare mode
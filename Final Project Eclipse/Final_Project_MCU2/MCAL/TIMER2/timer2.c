@@ -0,0 +1,53 @@
+/******************************************************************************
+*  File name:		timer2.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "timer2.h"
+#include "avr/interrupt.h"
+#include "avr/io.h"
+#include "../../LIB/trace.h"
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+static void (*volatile g_callBackPtr)(void) = NULL_PTR; /* to store the address of the function */
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+ISR(TIMER2_COMP_vect)
+{
+	TRACE_ISR_ENTER(TIMER2_COMP);
+	if(g_callBackPtr != NULL_PTR)
+	{
+		(*g_callBackPtr)();
+	}
+	TRACE_ISR_EXIT(TIMER2_COMP);
+}
+
+void TIMER2_init(const Timer2_ConfigType * Config_Ptr)
+{
+	TCCR2 = 0; /* stop it while it is configured */
+	TCNT2 = 0;
+	OCR2 = Config_Ptr->compare_value;
+	TIMSK |= (1<<OCIE2);
+	TCCR2 = (1<<FOC2) | (1<<WGM21) | (Config_Ptr->prescaler); /* CTC mode, OC2 disconnected */
+}
+
+void TIMER2_deInit()
+{
+	TCCR2 = 0;
+	TCNT2 = 0;
+	OCR2 = 0;
+	TIMSK &= ~(1<<OCIE2);
+}
+
+void TIMER2_COMP_setCallBack( void(*a_ptr)(void) )
+{
+	g_callBackPtr = a_ptr;
+}
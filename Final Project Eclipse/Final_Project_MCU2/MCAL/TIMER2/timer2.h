@@ -0,0 +1,78 @@
+/******************************************************************************
+*  File name:		timer2.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef MCAL_TIMER2_TIMER2_H_
+#define MCAL_TIMER2_TIMER2_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Timer2_Prescaler
+* Type: Enumeration
+* Description: Data type to represent the timer prescaler
+********************************************************************************/
+typedef enum
+{
+	TIMER2_OFF,
+	TIMER2_FCPU_1,
+	TIMER2_FCPU_8,
+	TIMER2_FCPU_32,
+	TIMER2_FCPU_64,
+	TIMER2_FCPU_128,
+	TIMER2_FCPU_256,
+	TIMER2_FCPU_1024
+}Timer2_Prescaler;
+
+/*******************************************************************************
+* Name: Timer2_ConfigType
+* Type: Structure
+* Description: Data type to dynamic configure the timer module, it always runs in
+* 			   compare mode and gives an interrupt every (compare_value + 1) counts
+********************************************************************************/
+typedef struct {
+ uint8 compare_value;
+ Timer2_Prescaler prescaler;
+} Timer2_ConfigType;
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		TIMER2_init
+* Description:			Function to dynamic configure the timer module
+* Parameters (in):    	Pointer to structure of type Timer2_ConfigType
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void TIMER2_init(const Timer2_ConfigType * Config_Ptr);
+
+/*******************************************************************************
+* Function Name:		TIMER2_deInit
+* Description:			Function to de-initialize the timer module and stop it
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void TIMER2_deInit();
+
+/*******************************************************************************
+* Function Name:		TIMER2_COMP_setCallBack
+* Description:			Function to set the ISR for timer compare match
+* Parameters (in):    	Pointer to function to be the ISR
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void TIMER2_COMP_setCallBack( void(*a_ptr)(void) );
+
+#endif /* MCAL_TIMER2_TIMER2_H_ */
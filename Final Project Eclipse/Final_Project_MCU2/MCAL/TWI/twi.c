@@ -10,59 +10,220 @@
 
 #include "twi.h"
 #include "avr/io.h"
+#include "util/delay.h"
 #include "../../LIB/common_macros.h"
 
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define TWI_MAX_PRESCALER		3		/* TWPS = 3 divides by 64 */
+#define TWI_BITS_PER_BYTE		9		/* 8 data bits and the ACK */
+#define TWI_RECOVERY_HALF_US	5		/* SCL half period while recovering, 100 KHz */
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static uint32 g_twiTimeout = 0; /* us to wait for TWINT, set from the bit rate */
+static uint8 g_twiFault = FALSE; /* the current transfer failed, cleared by the next start */
+static TWI_ErrorCountersType g_twiErrors = {0,0,0,0};
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void TWI_wait(void);
+static void TWI_fail(void);
+
 /*******************************************************************************
 *                      Functions Definitions                                   *
 *******************************************************************************/
 
 void TWI_init(const TWI_ConfigType * Config_Ptr)
 {
-	uint8 TWBR_value;
+	uint32 rate = (uint32)(Config_Ptr->bit_rate) * 1000UL;
+	uint32 twbr = 0xFFUL << (2 * TWI_MAX_PRESCALER); /* slowest rate if none is given */
+	uint8 prescaler = 0;
+	uint32 bitCycles;
+
+	/* SCL = F_CPU / (16 + 2 * TWBR * 4^TWPS), the smallest prescaler that fits TWBR in 8 bits keeps the best resolution */
+	if(rate != 0)
+	{
+		uint32 divider = (F_CPU + rate - 1) / rate; /* rounded up so the bus is never faster than asked */
+		twbr = (divider > 16) ? ((divider - 16 + 1) / 2) : 0;
+	}
+	while( (twbr > 0xFF) && (prescaler < TWI_MAX_PRESCALER) )
+	{
+		prescaler++;
+		twbr = (twbr + 3) / 4;
+	}
+	if(twbr > 0xFF)
+	{
+		twbr = 0xFF; /* slowest possible rate */
+	}
+	if(twbr < TWI_MIN_TWBR)
+	{
+		twbr = TWI_MIN_TWBR;
+	}
+
 	TWCR = (1<<TWEN);
 	TWAR = Config_Ptr->address;
-	TWSR = 0x00; /* assuming it is equal to 0 always and get TWBR based on that assumption */
-	TWBR = (uint8)(((F_CPU/((Config_Ptr->bit_rate)*1000))-16) /2);
+	TWSR = prescaler; /* TWPS1:0 are the only writable bits */
+	TWBR = (uint8)twbr;
 
+	bitCycles = 16 + ((2 * twbr) << (2 * prescaler));
+	g_twiTimeout = ((TWI_TIMEOUT_BYTES * TWI_BITS_PER_BYTE * bitCycles) / (F_CPU / 1000000UL)) + TWI_TIMEOUT_MARGIN_US;
+	g_twiFault = FALSE;
 }
 
 void TWI_start()
 {
+	g_twiFault = FALSE;
 	TWCR = (1<<TWEN)| (1<<TWINT) | (1<<TWSTA) ;
-	while( BIT_IS_CLEAR(TWCR,TWINT) ){}
-
+	TWI_wait();
 }
 
 void TWI_stop()
 {
+	if(g_twiFault)
+		return; /* the bus was already released by the recovery */
+
 	TWCR = (1<<TWEN)| (1<<TWINT) | (1<<TWSTO) ;
+	/* TWSTO is cleared once the STOP is on the bus, a new start before that is lost */
+	for(uint32 us = 0 ; BIT_IS_SET(TWCR,TWSTO) ; us++)
+	{
+		if(us >= g_twiTimeout)
+		{
+			g_twiErrors.timeouts++;
+			TWI_fail();
+			return;
+		}
+		_delay_us(1);
+	}
 }
 
 void TWI_writeByte(uint8 byte)
 {
+	if(g_twiFault)
+		return;
+
 	TWDR = byte;
 
 	TWCR = (1<<TWEN)| (1<<TWINT) ;
-	while( BIT_IS_CLEAR(TWCR,TWINT) ){}
+	TWI_wait();
 }
 
 uint8 TWI_readByteWithACK(void)
 {
+	if(g_twiFault)
+		return 0xFF;
+
 	TWCR = (1<<TWEN)| (1<<TWINT) | (1<<TWEA) ;
-	while( BIT_IS_CLEAR(TWCR,TWINT) ){}
+	TWI_wait();
 	return TWDR;
 }
 
 uint8 TWI_readByteWithNACK(void)
 {
+	if(g_twiFault)
+		return 0xFF;
+
 	TWCR = (1<<TWEN)| (1<<TWINT) ;
-	while( BIT_IS_CLEAR(TWCR,TWINT) ){}
+	TWI_wait();
 	return TWDR;
 }
 
 uint8 TWI_getStatus(void)
 {
 	uint8 status;
+	if(g_twiFault)
+		return TWI_BUS_FAULT;
+
     status = TWSR & 0xF8;
 	return status;
 }
+
+void TWI_recoverBus(void)
+{
+	TWCR = 0; /* the pins go back to the GPIO */
+
+	/* both lines are open drain : driven low as outputs, released as inputs without pull-up */
+	GPIO_LOW(TWI_SCL);
+	GPIO_LOW(TWI_SDA);
+	GPIO_INPUT(TWI_SDA);
+	GPIO_INPUT(TWI_SCL);
+
+	/* a slave that still holds SDA low finishes its byte after at most 9 clocks */
+	for(uint8 i = 0 ; (i < TWI_RECOVERY_PULSES) && (GPIO_READ(TWI_SDA) == LOGIC_LOW) ; i++)
+	{
+		GPIO_OUTPUT(TWI_SCL);
+		_delay_us(TWI_RECOVERY_HALF_US);
+		GPIO_INPUT(TWI_SCL);
+		_delay_us(TWI_RECOVERY_HALF_US);
+	}
+
+	/* START then STOP while SCL is high so every slave resets its state machine */
+	GPIO_OUTPUT(TWI_SDA);
+	_delay_us(TWI_RECOVERY_HALF_US);
+	GPIO_INPUT(TWI_SDA);
+	_delay_us(TWI_RECOVERY_HALF_US);
+
+	TWCR = (1<<TWEN);
+	g_twiErrors.recoveries++;
+}
+
+void TWI_getErrorCounters(TWI_ErrorCountersType *counters)
+{
+	*counters = g_twiErrors;
+}
+
+/*******************************************************************************
+* Function Name:		TWI_wait
+* Description:			Function to wait for the end of the current operation, the transfer
+* 						fails if it takes longer than the time of TWI_TIMEOUT_BYTES bytes
+* 						or ends with a bus error.
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void TWI_wait(void)
+{
+	for(uint32 us = 0 ; BIT_IS_CLEAR(TWCR,TWINT) ; us++)
+	{
+		if(us >= g_twiTimeout)
+		{
+			g_twiErrors.timeouts++;
+			TWI_fail();
+			return;
+		}
+		_delay_us(1);
+	}
+
+	switch(TWSR & 0xF8)
+	{
+	case TWI_BUS_ERROR:
+		g_twiErrors.bus_errors++;
+		TWI_fail();
+		break;
+	case TWI_ARB_LOST:
+		g_twiErrors.arbitration_lost++; /* the module left the bus by itself, the caller sees the status */
+		break;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		TWI_fail
+* Description:			Function to end the current transfer after a problem, the bus is
+* 						recovered and the next operations are skipped until the next start.
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void TWI_fail(void)
+{
+	g_twiFault = TRUE;
+	TWI_recoverBus();
+}
@@ -12,6 +12,8 @@
 *******************************************************************************/
 
 #include "../../LIB/std_types.h"
+#include "../GPIO/gpio.h"
+#include "../../../SHARED/board_mcu2.h" /* TWI_SCL and TWI_SDA */
 
 /*******************************************************************************
 *                        		Definitions                                    *
@@ -25,6 +27,14 @@
 #define TWI_MT_DATA_ACK   0x28 /* Master transmit data and ACK has been received from Slave. */
 #define TWI_MR_DATA_ACK   0x50 /* Master received data and send ACK to slave. */
 #define TWI_MR_DATA_NACK  0x58 /* Master received data but doesn't send ACK to slave. */
+#define TWI_ARB_LOST      0x38 /* Another master took the bus. */
+#define TWI_BUS_ERROR     0x00 /* Illegal START or STOP condition on the bus. */
+#define TWI_BUS_FAULT     0x01 /* Not a TWSR value : the transfer timed out or hit a bus error and the bus was recovered. */
+
+#define TWI_MIN_TWBR			10		/* lower values give a wrong output on SDA and SCL in master mode */
+#define TWI_TIMEOUT_BYTES		4		/* a wait is given up after the time of that many bytes */
+#define TWI_TIMEOUT_MARGIN_US	100
+#define TWI_RECOVERY_PULSES		9		/* enough for a slave to finish the byte it is sending */
 
 /*******************************************************************************
 *                         Types Declaration                                   *
@@ -38,9 +48,22 @@
 
 typedef struct{
  uint8 address;
- uint16 bit_rate; /* in Kbps */
+ uint16 bit_rate; /* in Kbps, the closest rate that isn't faster is used */
 }TWI_ConfigType;
 
+/*******************************************************************************
+* Name: TWI_ErrorCountersType
+* Type: Structure
+* Description: Data type to represent the number of bus problems since the reset
+********************************************************************************/
+
+typedef struct{
+ uint16 timeouts; /* TWINT wasn't set in time */
+ uint16 bus_errors;
+ uint16 arbitration_lost;
+ uint16 recoveries; /* number of times the bus was released by clocking SCL */
+}TWI_ErrorCountersType;
+
 /*******************************************************************************
 *                      Functions Prototypes                                   *
 *******************************************************************************/
@@ -110,10 +133,31 @@ uint8 TWI_readByteWithNACK(void);
 * Function Name:		TWI_getStatus
 * Description:			Function to check the I2C bus status.
 * Parameters (in):    	None
-* Parameters (out):   	Bus status
+* Parameters (out):   	Bus status, TWI_BUS_FAULT if the transfer failed since the last start
 * Return value:      	uint8
 ********************************************************************************/
 
 uint8 TWI_getStatus(void);
 
+/*******************************************************************************
+* Function Name:		TWI_recoverBus
+* Description:			Function to free a bus held low by a slave, SCL is clocked until the
+* 						slave releases SDA then a STOP is sent and the module is enabled again.
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void TWI_recoverBus(void);
+
+/*******************************************************************************
+* Function Name:		TWI_getErrorCounters
+* Description:			Function to get the number of bus problems since the reset.
+* Parameters (in):    	Pointer to store the counters in.
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void TWI_getErrorCounters(TWI_ErrorCountersType *counters);
+
 #endif /* MCAL_TWI_TWI_H_ */
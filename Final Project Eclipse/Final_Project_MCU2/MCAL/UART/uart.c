@@ -12,13 +12,15 @@
 #include "avr/io.h"
 #include "../../LIB/common_macros.h"
 #include "avr/interrupt.h"
+#include "../../LIB/trace.h"
+#include "../../LIB/capture.h"
 
 /*******************************************************************************
 *                           Global Variables                                  *
 *******************************************************************************/
 
 static uint8 g_endStringChar; /* to store the special char to end sting at */
-static volatile void (*g_callBackPtr)(void) = NULL_PTR; /* to store the address of the function */
+static void (*volatile g_callBackPtr)(void) = NULL_PTR; /* to store the address of the function */
 
 /*******************************************************************************
 *                       Interrupt Service Routines                            *
@@ -26,10 +28,12 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR; /* to store the address
 
 ISR(USART_RXC_vect)
 {
+	TRACE_ISR_ENTER(USART_RXC);
 	if(g_callBackPtr != NULL_PTR)
 	{
 		(*g_callBackPtr)();
 	}
+	TRACE_ISR_EXIT(USART_RXC);
 }
 /*
  * if you want to receive string a_ptr can be:
@@ -67,14 +71,12 @@ void UART_init(const UART_ConfigType * Configptr)
 	UCSRB = (1<<RXEN) | (1<<TXEN) ;	/* Transmission and receive enable */
 	UCSRB = (UCSRB & CLEAR_RECEIVE_METHOD_MASK ) | ( (Configptr->RECEVIE_METHOD<<7) ) ; /* To configure the UART with interrupt or polling */
 
-	SET_BIT(UCSRC,URSEL); /* so we can write in UCSRC register */
-	UCSRC = (UCSRC & CLEAR_CHAR_SIZE_MASK ) | ( (Configptr->CHAR_SIZE)<<1) ; /* setting the number of bits in UART frame */
-	UCSRC = (UCSRC & CLEAR_STOP_BITS_MASK) | ( (Configptr->STOP_BIT)<<3) ; /* set the number of stop bits */
-	UCSRC = (UCSRC & CLEAR_PARITY_MASK ) | ( (Configptr->PARITY)<<4) ; /* setting the PARITY */
+	/* UCSRC shares its address with UBRRH and a single read gives UBRRH, so it is written in one go with URSEL set.
+	 * A read-modify-write would copy UBRRH into it and leave a 5-bit frame */
+	UCSRC = (1<<URSEL) | ( (Configptr->PARITY)<<UPM0 ) | ( (Configptr->STOP_BIT)<<USBS ) | ( (Configptr->CHAR_SIZE)<<UCSZ0 ) ;
 
-	CLEAR_BIT(UBRRH,URSEL); /* to access UBRRH not UCSRC */
 	ubrr_value = (uint16)(((F_CPU / (Configptr->BAUD_RATE * 8UL))) - 1);
-	UBRRH = ubrr_value>>8;
+	UBRRH = (ubrr_value>>8) & 0x0F; /* URSEL cleared to write UBRRH not UCSRC */
 	UBRRL = ubrr_value;
 
 	g_endStringChar = Configptr->END_SRTING;
@@ -84,14 +86,33 @@ void UART_sendByte(const uint8 data)
 {
 	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
 
+	/* clear the transmit complete flag, it is set again when this byte is out. FE, DOR and PE
+	 * must be written as 0, a read-modify-write of UCSRA would write them back */
+	UCSRA = (UCSRA & ((1<<U2X)|(1<<MPCM))) | (1<<TXC);
 	UDR = data;
+	CAPTURE_SEND(data);
 }
 
 uint8 UART_receiveByte()
 {
-	while(BIT_IS_CLEAR(UCSRA,RXC)){}
+	if(BIT_IS_CLEAR(UCSRA,RXC))
+	{
+		TRACE_IDLE_ENTER(); /* the main loop waits for MCU1 here */
+		while(BIT_IS_CLEAR(UCSRA,RXC)){}
+		TRACE_IDLE_EXIT();
+	}
+
+	return CAPTURE_RECEIVE(); /* UDR, with the byte saved if the link is captured */
+}
 
-	return UDR;
+boolean UART_isByteReceived(void)
+{
+	return BIT_IS_SET(UCSRA,RXC) ? TRUE : FALSE;
+}
+
+void UART_waitTransmitComplete(void)
+{
+	while(BIT_IS_CLEAR(UCSRA,TXC)){}
 }
 
 void UART_sendString(const uint8 *Str)
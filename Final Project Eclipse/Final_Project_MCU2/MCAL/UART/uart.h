@@ -17,9 +17,6 @@
 *                        		Definitions                                    *
 *******************************************************************************/
 
-#define CLEAR_PARITY_MASK				0xCF
-#define CLEAR_STOP_BITS_MASK			0xF7
-#define CLEAR_CHAR_SIZE_MASK			0xF9
 #define CLEAR_RECEIVE_METHOD_MASK		0x7F
 
 /*******************************************************************************
@@ -127,6 +124,27 @@ void UART_sendByte(const uint8 data);
 
 uint8 UART_receiveByte();
 
+/*******************************************************************************
+* Function Name:		UART_isByteReceived
+* Description:			Function to check if a byte is waiting to be read, so the caller can stop waiting.
+* Parameters (in):    	None
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+boolean UART_isByteReceived(void);
+
+/*******************************************************************************
+* Function Name:		UART_waitTransmitComplete
+* Description:			Function to wait until the last byte sent left the shift register, needed
+* 						before changing the baud rate. Only call it after sending a byte.
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+void UART_waitTransmitComplete(void);
+
 /*******************************************************************************
 * Function Name:		UART_sendString
 * Description:			Send the required string through UART to the other UART device.
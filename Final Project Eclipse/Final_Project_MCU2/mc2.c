@@ -13,7 +13,8 @@
 *                        		Configurations                                 *
 *******************************************************************************/
 UART_ConfigType UART_Configuration = {9600,'#',UART_1_STOP_BIT,UART_8_BITS,UART_DISABLED_PARTIY,POLLING};
-TWI_ConfigType TWI_Configuration = {1,400}; /* Slave Address = 1 , Baud rate = 400 Kbps */
+TWI_ConfigType TWI_Configuration = {1,400}; /* Slave Address = 1 , Baud rate = 400 Kbps (limited to 222 Kbps at 8 MHz) */
+Timer2_ConfigType TIMER2_Configuration = {TIMER2_OCR2,TIMER2_FCPU_256}; /* 8 ms tick */
 
 /*******************************************************************************
 *           					Main Function                                 *
@@ -21,15 +22,33 @@ TWI_ConfigType TWI_Configuration = {1,400}; /* Slave Address = 1 , Baud rate = 4
 int main(void)
 {
 	/* Initialize different modules */
+	uint8 bootStatus = SUCCESS;
+	STACK_init(); /* before anything else uses the stack */
+	TRACE_init(); /* the clock of the interrupts statistics and of the trace */
+	UART_init(&UART_Configuration); /* MC_Ready waits in UDR if MCU1 is up first, the first boot writes the device keys for 0.2 s */
 	TWI_init(&TWI_Configuration);
+	CREDENTIAL_seed(); /* before the motor takes the ADC */
+	bootStatus &= JOURNAL_init(); /* scan the EEPROM journal once to find the newest records */
+	bootStatus &= CREDENTIAL_init(); /* build the RAM index of the users table */
+	if(bootStatus == SUCCESS)
+	{
+		bootStatus = APP_checkKeys(); /* the password and the users are erased if they can't be checked anymore */
+	}
+	bootStatus &= LOCKOUT_init(); /* restore the wrong passwords count saved before the reset */
+	bootStatus &= AUDIT_init(); /* find the end of the audit log */
+	AUDIT_log(AUDIT_EVENT_BOOT, AUDIT_NO_SLOT, bootStatus);
+	APP_checkBus();
+	TIMER2_COMP_setCallBack(TIMER2_TICK_ISR);
+	CAPTURE_init(); /* the time of the capture starts with timer 2 */
+	TIMER2_init(&TIMER2_Configuration); /* counts the lockout time even while the door or the alarm is running, and ramps the motor */
 	BUZZER_init();
 	DcMotor_Init();
-	UART_init(&UART_Configuration);
 	sei();
 	/* waiting MCU1 to be ready */
 	while( UART_receiveByte() != MC_Ready){}
 
 	APP_isPasswordSet(); /* To check if password is set in the EEPROM or not for first time entring the program */
+	AUDIT_flush();
 
 	while(1)
 	{
@@ -53,6 +72,49 @@ int main(void)
 		case MSG_checkPassword:
 			APP_checkPassword();
 			break;
+		/* In case MCU1 wants to know if the password checks are locked */
+		case MSG_LockoutStatus:
+			APP_sendLockout();
+			break;
+		/* In case MCU1 wants to add a new user */
+		case MSG_AddUser:
+			APP_addUser();
+			break;
+		/* In case MCU1 wants to remove a user */
+		case MSG_RevokeUser:
+			APP_revokeUser();
+			break;
+		/* In case the EEPROM is going to be backed up or restored over the link */
+		case MSG_Maintenance:
+			APP_maintenance(&UART_Configuration);
+			break;
+		/* In case the whole audit log is asked for */
+		case MSG_ReadAudit:
+			APP_sendAudit();
+			break;
+		/* In case the trace of the hot paths is asked for */
+		case MSG_ReadTrace:
+			APP_sendTrace();
+			break;
+		/* In case the statistics of the interrupts and the CPU load are asked for */
+		case MSG_ReadStats:
+			APP_sendStats();
+			break;
+		/* In case the stack high-water mark is asked for */
+		case MSG_ReadStack:
+			APP_sendStack();
+			break;
+		/* In case the capture of the link is asked for */
+		case MSG_ReadCapture:
+			APP_sendCapture();
+			break;
+		}
+		APP_endAdminSession(MSG); /* an admin password check allows only the admin operation right after it */
+		/* write the staged events to the EEPROM, except right after a password check as MSG_Motor may follow */
+		if(MSG != MSG_checkPassword)
+		{
+			APP_checkBus();
+			AUDIT_flush();
 		}
 	}
 }
@@ -0,0 +1,32 @@
+/******************************************************************************
+*  File name:		eeprom.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef HOST_AVR_EEPROM_H_
+#define HOST_AVR_EEPROM_H_
+
+#include <avr/io.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* the avr-libc routines are in assembly for the 4 cycles between EEMWE and EEWE, the simulator runs them itself */
+#define eeprom_read_byte(address)			SIM_eepromReadByte(address)
+#define eeprom_write_byte(address,value)	SIM_eepromWriteByte((address), (value))
+#define eeprom_is_ready()					(SIM_eepromIsBusy() == 0)
+#define eeprom_busy_wait()					do {} while(!eeprom_is_ready())
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/* wait for the write in progress like the avr-libc routines, then read or start the 8.5 ms write of a byte */
+unsigned char SIM_eepromReadByte(const unsigned char *address);
+void SIM_eepromWriteByte(unsigned char *address,unsigned char value);
+unsigned char SIM_eepromIsBusy(void);
+
+#endif /* HOST_AVR_EEPROM_H_ */
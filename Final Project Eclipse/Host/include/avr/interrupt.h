@@ -0,0 +1,34 @@
+/******************************************************************************
+*  File name:		interrupt.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* an ISR is a plain function the simulator calls between two accesses of the firmware */
+#define ISR(vector, ...)	void vector(void); void vector(void)
+#define EMPTY_INTERRUPT(vector)	ISR(vector) {}
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+#define ISR_NAKED
+
+#define sei()	SIM_sei()
+#define cli()	SIM_cli()
+#define reti()	return
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+void SIM_sei(void);
+void SIM_cli(void);
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
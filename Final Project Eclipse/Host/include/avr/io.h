@@ -0,0 +1,418 @@
+/******************************************************************************
+*  File name:		io.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * ATmega32 registers for the host build. Every register is a byte of the register
+ * file of the running MCU at its data space address (I/O address + 0x20), the
+ * firmware is built with the accesses instrumented so the simulator sees every
+ * read and write and gives them the meaning they have on the chip.
+ */
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SIM_IO_SIZE			0x60	/* registers 0x00 to 0x5F of the data space */
+
+extern __thread uint8_t *SIM_io;	/* register file of the MCU running on this thread */
+
+#define _SFR_MEM8(address)	(*(volatile uint8_t *)(SIM_io + (address)))
+#define _SFR_MEM16(address)	(*(volatile uint16_t *)(SIM_io + (address)))
+#define _BV(bit)			(1 << (bit))
+
+/* TWI */
+#define TWBR	_SFR_MEM8(0x20)
+#define TWSR	_SFR_MEM8(0x21)
+#define TWAR	_SFR_MEM8(0x22)
+#define TWDR	_SFR_MEM8(0x23)
+
+/* ADC */
+#define ADC		_SFR_MEM16(0x24)
+#define ADCW	_SFR_MEM16(0x24)
+#define ADCL	_SFR_MEM8(0x24)
+#define ADCH	_SFR_MEM8(0x25)
+#define ADCSRA	_SFR_MEM8(0x26)
+#define ADCSR	_SFR_MEM8(0x26)
+#define ADMUX	_SFR_MEM8(0x27)
+#define ACSR	_SFR_MEM8(0x28)
+
+/* USART */
+#define UBRRL	_SFR_MEM8(0x29)
+#define UCSRB	_SFR_MEM8(0x2A)
+#define UCSRA	_SFR_MEM8(0x2B)
+#define UDR		_SFR_MEM8(0x2C)
+
+/* SPI */
+#define SPCR	_SFR_MEM8(0x2D)
+#define SPSR	_SFR_MEM8(0x2E)
+#define SPDR	_SFR_MEM8(0x2F)
+
+/* Ports */
+#define PIND	_SFR_MEM8(0x30)
+#define DDRD	_SFR_MEM8(0x31)
+#define PORTD	_SFR_MEM8(0x32)
+#define PINC	_SFR_MEM8(0x33)
+#define DDRC	_SFR_MEM8(0x34)
+#define PORTC	_SFR_MEM8(0x35)
+#define PINB	_SFR_MEM8(0x36)
+#define DDRB	_SFR_MEM8(0x37)
+#define PORTB	_SFR_MEM8(0x38)
+#define PINA	_SFR_MEM8(0x39)
+#define DDRA	_SFR_MEM8(0x3A)
+#define PORTA	_SFR_MEM8(0x3B)
+
+/* Internal EEPROM */
+#define EECR	_SFR_MEM8(0x3C)
+#define EEDR	_SFR_MEM8(0x3D)
+#define EEAR	_SFR_MEM16(0x3E)
+#define EEARL	_SFR_MEM8(0x3E)
+#define EEARH	_SFR_MEM8(0x3F)
+
+/* UBRRH and UCSRC share their address, URSEL selects the one written */
+#define UCSRC	_SFR_MEM8(0x40)
+#define UBRRH	_SFR_MEM8(0x40)
+
+#define WDTCR	_SFR_MEM8(0x41)
+#define ASSR	_SFR_MEM8(0x42)
+
+/* Timer 2 */
+#define OCR2	_SFR_MEM8(0x43)
+#define TCNT2	_SFR_MEM8(0x44)
+#define TCCR2	_SFR_MEM8(0x45)
+
+/* Timer 1 */
+#define ICR1	_SFR_MEM16(0x46)
+#define ICR1L	_SFR_MEM8(0x46)
+#define ICR1H	_SFR_MEM8(0x47)
+#define OCR1B	_SFR_MEM16(0x48)
+#define OCR1BL	_SFR_MEM8(0x48)
+#define OCR1BH	_SFR_MEM8(0x49)
+#define OCR1A	_SFR_MEM16(0x4A)
+#define OCR1AL	_SFR_MEM8(0x4A)
+#define OCR1AH	_SFR_MEM8(0x4B)
+#define TCNT1	_SFR_MEM16(0x4C)
+#define TCNT1L	_SFR_MEM8(0x4C)
+#define TCNT1H	_SFR_MEM8(0x4D)
+#define TCCR1B	_SFR_MEM8(0x4E)
+#define TCCR1A	_SFR_MEM8(0x4F)
+
+#define SFIOR	_SFR_MEM8(0x50)
+#define OSCCAL	_SFR_MEM8(0x51)
+#define OCDR	_SFR_MEM8(0x51)
+
+/* Timer 0 */
+#define TCNT0	_SFR_MEM8(0x52)
+#define TCCR0	_SFR_MEM8(0x53)
+
+#define MCUCSR	_SFR_MEM8(0x54)
+#define MCUCR	_SFR_MEM8(0x55)
+#define TWCR	_SFR_MEM8(0x56)
+#define SPMCR	_SFR_MEM8(0x57)
+#define TIFR	_SFR_MEM8(0x58)
+#define TIMSK	_SFR_MEM8(0x59)
+#define GIFR	_SFR_MEM8(0x5A)
+#define GICR	_SFR_MEM8(0x5B)
+#define OCR0	_SFR_MEM8(0x5C)
+#define SPL		_SFR_MEM8(0x5D)
+#define SPH		_SFR_MEM8(0x5E)
+#define SREG	_SFR_MEM8(0x5F)
+
+/* Interrupt vectors, the simulator calls __vector_N of the firmware */
+#define INT0_vect			__vector_1
+#define INT1_vect			__vector_2
+#define INT2_vect			__vector_3
+#define TIMER2_COMP_vect	__vector_4
+#define TIMER2_OVF_vect		__vector_5
+#define TIMER1_CAPT_vect	__vector_6
+#define TIMER1_COMPA_vect	__vector_7
+#define TIMER1_COMPB_vect	__vector_8
+#define TIMER1_OVF_vect		__vector_9
+#define TIMER0_COMP_vect	__vector_10
+#define TIMER0_OVF_vect		__vector_11
+#define SPI_STC_vect		__vector_12
+#define USART_RXC_vect		__vector_13
+#define USART_UDRE_vect		__vector_14
+#define USART_TXC_vect		__vector_15
+#define ADC_vect			__vector_16
+#define EE_RDY_vect			__vector_17
+#define ANA_COMP_vect		__vector_18
+#define TWI_vect			__vector_19
+#define SPM_RDY_vect		__vector_20
+
+#define _VECTORS_SIZE		84
+
+/* TWCR */
+#define TWINT	7
+#define TWEA	6
+#define TWSTA	5
+#define TWSTO	4
+#define TWWC	3
+#define TWEN	2
+#define TWIE	0
+
+/* TWAR */
+#define TWA6	7
+#define TWA5	6
+#define TWA4	5
+#define TWA3	4
+#define TWA2	3
+#define TWA1	2
+#define TWA0	1
+#define TWGCE	0
+
+/* TWSR */
+#define TWS7	7
+#define TWS6	6
+#define TWS5	5
+#define TWS4	4
+#define TWS3	3
+#define TWPS1	1
+#define TWPS0	0
+
+/* ADMUX */
+#define REFS1	7
+#define REFS0	6
+#define ADLAR	5
+#define MUX4	4
+#define MUX3	3
+#define MUX2	2
+#define MUX1	1
+#define MUX0	0
+
+/* ADCSRA */
+#define ADEN	7
+#define ADSC	6
+#define ADATE	5
+#define ADIF	4
+#define ADIE	3
+#define ADPS2	2
+#define ADPS1	1
+#define ADPS0	0
+
+/* ACSR */
+#define ACD		7
+#define ACBG	6
+#define ACO		5
+#define ACI		4
+#define ACIE	3
+#define ACIC	2
+#define ACIS1	1
+#define ACIS0	0
+
+/* UCSRA */
+#define RXC		7
+#define TXC		6
+#define UDRE	5
+#define FE		4
+#define DOR		3
+#define PE		2
+#define U2X		1
+#define MPCM	0
+
+/* UCSRB */
+#define RXCIE	7
+#define TXCIE	6
+#define UDRIE	5
+#define RXEN	4
+#define TXEN	3
+#define UCSZ2	2
+#define RXB8	1
+#define TXB8	0
+
+/* UCSRC */
+#define URSEL	7
+#define UMSEL	6
+#define UPM1	5
+#define UPM0	4
+#define USBS	3
+#define UCSZ1	2
+#define UCSZ0	1
+#define UCPOL	0
+
+/* SPCR */
+#define SPIE	7
+#define SPE		6
+#define DORD	5
+#define MSTR	4
+#define CPOL	3
+#define CPHA	2
+#define SPR1	1
+#define SPR0	0
+
+/* SPSR */
+#define SPIF	7
+#define WCOL	6
+#define SPI2X	0
+
+/* EECR */
+#define EERIE	3
+#define EEMWE	2
+#define EEWE	1
+#define EERE	0
+
+/* WDTCR */
+#define WDTOE	4
+#define WDE		3
+#define WDP2	2
+#define WDP1	1
+#define WDP0	0
+
+/* ASSR */
+#define AS2		3
+#define TCN2UB	2
+#define OCR2UB	1
+#define TCR2UB	0
+
+/* TCCR2 */
+#define FOC2	7
+#define WGM20	6
+#define COM21	5
+#define COM20	4
+#define WGM21	3
+#define CS22	2
+#define CS21	1
+#define CS20	0
+
+/* TCCR1A */
+#define COM1A1	7
+#define COM1A0	6
+#define COM1B1	5
+#define COM1B0	4
+#define FOC1A	3
+#define FOC1B	2
+#define WGM11	1
+#define WGM10	0
+
+/* TCCR1B */
+#define ICNC1	7
+#define ICES1	6
+#define WGM13	4
+#define WGM12	3
+#define CS12	2
+#define CS11	1
+#define CS10	0
+
+/* SFIOR */
+#define ADTS2	7
+#define ADTS1	6
+#define ADTS0	5
+#define ACME	3
+#define PUD		2
+#define PSR2	1
+#define PSR10	0
+
+/* TCCR0 */
+#define FOC0	7
+#define WGM00	6
+#define COM01	5
+#define COM00	4
+#define WGM01	3
+#define CS02	2
+#define CS01	1
+#define CS00	0
+
+/* MCUCSR */
+#define JTD		7
+#define ISC2	6
+#define JTRF	4
+#define WDRF	3
+#define BORF	2
+#define EXTRF	1
+#define PORF	0
+
+/* MCUCR */
+#define SE		7
+#define SM2		6
+#define SM1		5
+#define SM0		4
+#define ISC11	3
+#define ISC10	2
+#define ISC01	1
+#define ISC00	0
+
+/* TIFR */
+#define OCF2	7
+#define TOV2	6
+#define ICF1	5
+#define OCF1A	4
+#define OCF1B	3
+#define TOV1	2
+#define OCF0	1
+#define TOV0	0
+
+/* TIMSK */
+#define OCIE2	7
+#define TOIE2	6
+#define TICIE1	5
+#define OCIE1A	4
+#define OCIE1B	3
+#define TOIE1	2
+#define OCIE0	1
+#define TOIE0	0
+
+/* GIFR */
+#define INTF1	7
+#define INTF0	6
+#define INTF2	5
+
+/* GICR */
+#define INT1	7
+#define INT0	6
+#define INT2	5
+#define IVSEL	1
+#define IVCE	0
+
+/* SREG */
+#define SREG_I	7
+
+/* Port pins */
+#define PA7		7
+#define PA6		6
+#define PA5		5
+#define PA4		4
+#define PA3		3
+#define PA2		2
+#define PA1		1
+#define PA0		0
+#define PB7		7
+#define PB6		6
+#define PB5		5
+#define PB4		4
+#define PB3		3
+#define PB2		2
+#define PB1		1
+#define PB0		0
+#define PC7		7
+#define PC6		6
+#define PC5		5
+#define PC4		4
+#define PC3		3
+#define PC2		2
+#define PC1		1
+#define PC0		0
+#define PD7		7
+#define PD6		6
+#define PD5		5
+#define PD4		4
+#define PD3		3
+#define PD2		2
+#define PD1		1
+#define PD0		0
+
+/* Memory */
+#define RAMSTART	0x60
+#define RAMEND		0x85F
+#define XRAMEND		RAMEND
+#define E2END		0x3FF
+#define FLASHEND	0x7FFF
+#define SPM_PAGESIZE	128
+
+#endif /* HOST_AVR_IO_H_ */
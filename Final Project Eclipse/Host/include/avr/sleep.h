@@ -0,0 +1,36 @@
+/******************************************************************************
+*  File name:		sleep.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef HOST_AVR_SLEEP_H_
+#define HOST_AVR_SLEEP_H_
+
+#include <avr/io.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SLEEP_MODE_IDLE			0
+#define SLEEP_MODE_ADC			(1<<SM0)
+#define SLEEP_MODE_PWR_DOWN		(1<<SM1)
+#define SLEEP_MODE_PWR_SAVE		((1<<SM0) | (1<<SM1))
+#define SLEEP_MODE_STANDBY		((1<<SM1) | (1<<SM2))
+#define SLEEP_MODE_EXT_STANDBY	((1<<SM0) | (1<<SM1) | (1<<SM2))
+
+#define set_sleep_mode(mode)	(MCUCR = (MCUCR & ~((1<<SM0) | (1<<SM1) | (1<<SM2))) | (mode))
+#define sleep_enable()			(MCUCR |= (1<<SE))
+#define sleep_disable()			(MCUCR &= ~(1<<SE))
+#define sleep_cpu()				SIM_sleep()
+#define sleep_mode()			do { sleep_enable(); sleep_cpu(); sleep_disable(); } while(0)
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/* waits for the next interrupt, sleeping with the interrupts disabled ends the simulation like in simavr */
+void SIM_sleep(void);
+
+#endif /* HOST_AVR_SLEEP_H_ */
@@ -0,0 +1,17 @@
+/******************************************************************************
+*  File name:		stdlib.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/* the C library of the host with the avr-libc extensions the firmware uses */
+
+#ifndef HOST_STDLIB_H_
+#define HOST_STDLIB_H_
+
+#include_next <stdlib.h>
+
+char *itoa(int value, char *string, int radix);
+char *utoa(unsigned int value, char *string, int radix);
+
+#endif /* HOST_STDLIB_H_ */
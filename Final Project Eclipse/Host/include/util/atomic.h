@@ -0,0 +1,36 @@
+/******************************************************************************
+*  File name:		atomic.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef HOST_UTIL_ATOMIC_H_
+#define HOST_UTIL_ATOMIC_H_
+
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* same shape as avr-libc : the global interrupt flag is saved, cleared and restored when the block is left */
+#define ATOMIC_BLOCK(type)		for(type, __ToDo = SIM_atomicEnter() ; __ToDo ; __ToDo = 0)
+#define NONATOMIC_BLOCK(type)	for(type, __ToDo = SIM_atomicLeave() ; __ToDo ; __ToDo = 0)
+
+#define ATOMIC_RESTORESTATE		unsigned char sreg_save __attribute__((__cleanup__(SIM_restoreState))) = SIM_saveState()
+#define ATOMIC_FORCEON			unsigned char sreg_save __attribute__((__cleanup__(SIM_forceOn))) = 0
+#define NONATOMIC_RESTORESTATE	ATOMIC_RESTORESTATE
+#define NONATOMIC_FORCEOFF		unsigned char sreg_save __attribute__((__cleanup__(SIM_forceOff))) = 0
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+unsigned char SIM_saveState(void);
+void SIM_restoreState(const unsigned char *sreg);
+void SIM_forceOn(const unsigned char *sreg);
+void SIM_forceOff(const unsigned char *sreg);
+unsigned char SIM_atomicEnter(void);
+unsigned char SIM_atomicLeave(void);
+
+#endif /* HOST_UTIL_ATOMIC_H_ */
@@ -0,0 +1,28 @@
+/******************************************************************************
+*  File name:		delay.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+#ifndef F_CPU
+#error "F_CPU must be defined for the delays"
+#endif
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* the virtual clock moves by the cycles of the busy loop, the interrupts still run meanwhile */
+#define _delay_ms(ms)	SIM_delayCycles((unsigned long long)((double)(ms) * ((F_CPU) / 1000.0)))
+#define _delay_us(us)	SIM_delayCycles((unsigned long long)((double)(us) * ((F_CPU) / 1000000.0)))
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+void SIM_delayCycles(unsigned long long cycles);
+
+#endif /* HOST_UTIL_DELAY_H_ */
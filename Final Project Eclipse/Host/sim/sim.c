@@ -0,0 +1,847 @@
+/******************************************************************************
+*  File name:		sim.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SIM_IS_REGISTER(ctx,addr)	((uintptr_t)((uint8 *)(addr) - (ctx)->io) < SIM_IO_SIZE)
+#define SIM_MIN(a,b)				(((a) < (b)) ? (a) : (b))
+#define SIM_LOOP_MIX(hash,x)		(((hash) ^ (uint32)(x)) * 0x01000193UL)	/* FNV-1a on words */
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+__thread Sim_ContextType *g_simCurrent = NULL_PTR;
+__thread uint8_t *SIM_io = NULL_PTR;
+
+static const char *const g_simVectorNames[SIM_NUM_VECTORS] =
+{
+	"RESET", "INT0", "INT1", "INT2", "TIMER2_COMP", "TIMER2_OVF", "TIMER1_CAPT",
+	"TIMER1_COMPA", "TIMER1_COMPB", "TIMER1_OVF", "TIMER0_COMP", "TIMER0_OVF",
+	"SPI_STC", "USART_RXC", "USART_UDRE", "USART_TXC", "ADC", "EE_RDY",
+	"ANA_COMP", "TWI", "SPM_RDY"
+};
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void SIM_entry(void);
+/* noipa : the callers of SIM_giveBack must not keep values in the registers it seems to leave alone */
+static void SIM_jump(void **buffer) __attribute__((noipa, noreturn));
+static void SIM_giveBack(Sim_ContextType *ctx) __attribute__((noipa));
+static uint64 SIM_countInterrupts(const Sim_ContextType *ctx);
+static void SIM_service(Sim_ContextType *ctx);
+static uint8 SIM_getPendingInterrupt(Sim_ContextType *ctx);
+static void SIM_interrupt(Sim_ContextType *ctx,uint8 vector);
+static void SIM_resolveWrite(Sim_ContextType *ctx);
+static inline Sim_ContextType *SIM_access(void);
+static void SIM_loopPoint(Sim_ContextType *ctx,uint32 key,const void *frame);
+static uint32 SIM_hashStack(const Sim_ContextType *ctx,const void *frame);
+static void SIM_dataRead(void *addr,uint8 size);
+static void SIM_dataWrite(void *addr);
+static void SIM_volatileRead(void *addr,uint8 size,const void *frame);
+static void SIM_volatileWrite(void *addr,uint8 size);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+uint8 SIM_init(Sim_ContextType *ctx,const Sim_FirmwareType *firmware,const char *name)
+{
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->firmware = firmware;
+	ctx->name = (name != NULL_PTR) ? name : firmware->name;
+	ctx->stopReason = SIM_RUNNING;
+
+	/* reset values of the registers that aren't 0 */
+	ctx->io[SIM_SPL] = (uint8)RAMEND;
+	ctx->io[SIM_SPH] = (uint8)(RAMEND >> 8);
+	ctx->io[SIM_TWBR] = 0;
+	ctx->twi.status = 0xF8; /* no relevant state */
+	ctx->uart.ucsrc = (1<<URSEL) | (1<<UCSZ1) | (1<<UCSZ0); /* 8N1 */
+	ctx->adc.firstConversion = TRUE;
+	memset(ctx->intEeprom.memory, 0xFF, sizeof(ctx->intEeprom.memory)); /* erased */
+
+	ctx->stack = malloc(SIM_STACK_SIZE);
+	if(ctx->stack == NULL_PTR)
+		return ERROR;
+	ctx->stackOwned = TRUE;
+
+	getcontext(&ctx->fiber);
+	ctx->fiber.uc_stack.ss_sp = ctx->stack;
+	ctx->fiber.uc_stack.ss_size = SIM_STACK_SIZE;
+	ctx->fiber.uc_link = NULL_PTR; /* SIM_entry never returns */
+	makecontext(&ctx->fiber, SIM_entry, 0);
+	return SUCCESS;
+}
+
+void SIM_deinit(Sim_ContextType *ctx)
+{
+	if(ctx->stopReason == SIM_RUNNING)
+	{
+		ctx->stopReason = SIM_STOPPED;
+	}
+	if(ctx->stackOwned)
+	{
+		free(ctx->stack);
+	}
+	ctx->stack = NULL_PTR;
+	ctx->stackOwned = FALSE;
+}
+
+void SIM_setStack(Sim_ContextType *ctx,void *stack)
+{
+	if(ctx->stackOwned)
+	{
+		free(ctx->stack);
+	}
+	ctx->stack = stack;
+	ctx->stackOwned = FALSE;
+	/* nothing ran on the old one, the entry is made again at the top of the new one */
+	getcontext(&ctx->fiber);
+	ctx->fiber.uc_stack.ss_sp = ctx->stack;
+	ctx->fiber.uc_stack.ss_size = SIM_STACK_SIZE;
+	ctx->fiber.uc_link = NULL_PTR;
+	makecontext(&ctx->fiber, SIM_entry, 0);
+}
+
+boolean SIM_resume(Sim_ContextType *ctx,uint64 until)
+{
+	Sim_ContextType *previous = g_simCurrent;
+
+	if(ctx->stopReason != SIM_RUNNING)
+		return FALSE;
+	if(ctx->cycles >= until)
+		return TRUE;
+
+	ctx->resumeUntil = until;
+	ctx->nextEvent = ctx->cycles; /* the next access looks at the peripherals again */
+	g_simCurrent = ctx;
+	SIM_io = ctx->io;
+	if(__builtin_setjmp(ctx->callerJump) == 0)
+	{
+		if(ctx->started)
+		{
+			SIM_jump(ctx->fiberJump);
+		}
+		ctx->started = TRUE;
+		setcontext(&ctx->fiber);
+	}
+	g_simCurrent = previous;
+	SIM_io = (previous != NULL_PTR) ? previous->io : NULL_PTR;
+	return (ctx->stopReason == SIM_RUNNING) ? TRUE : FALSE;
+}
+
+void SIM_stop(Sim_ContextType *ctx,Sim_StopReasonType reason)
+{
+	ctx->stopReason = reason;
+	if(ctx == g_simCurrent)
+	{
+		SIM_jump(ctx->callerJump); /* never comes back */
+	}
+}
+
+void SIM_yield(Sim_ContextType *ctx)
+{
+	if(ctx->resumeUntil > ctx->cycles)
+	{
+		ctx->resumeUntil = ctx->cycles;
+	}
+	ctx->nextEvent = ctx->cycles;
+}
+
+void SIM_wait(Sim_ContextType *ctx)
+{
+	ctx->waiting = TRUE;
+	SIM_giveBack(ctx);
+	ctx->waiting = FALSE;
+}
+
+void SIM_schedule(Sim_ContextType *ctx,uint64 cycle)
+{
+	if(cycle < ctx->nextEvent)
+	{
+		ctx->nextEvent = cycle;
+	}
+}
+
+void SIM_advance(uint64 cycles)
+{
+	Sim_ContextType *ctx = g_simCurrent;
+	ctx->cycles += cycles;
+	if(ctx->cycles >= ctx->nextEvent)
+	{
+		SIM_service(ctx);
+	}
+}
+
+const char *SIM_getVectorName(uint8 vector)
+{
+	return (vector < SIM_NUM_VECTORS) ? g_simVectorNames[vector] : "?";
+}
+
+/*******************************************************************************
+*                Functions called by the firmware headers                     *
+*******************************************************************************/
+
+void SIM_sei(void)
+{
+	Sim_ContextType *ctx = SIM_access();
+	if(ctx != NULL_PTR)
+	{
+		ctx->io[SIM_SREG] |= (1<<SREG_I);
+		ctx->nextEvent = ctx->cycles; /* a pending interrupt runs after the next instruction */
+	}
+}
+
+void SIM_cli(void)
+{
+	Sim_ContextType *ctx = SIM_access();
+	if(ctx != NULL_PTR)
+	{
+		ctx->io[SIM_SREG] &= ~(1<<SREG_I);
+	}
+}
+
+unsigned char SIM_saveState(void)
+{
+	Sim_ContextType *ctx = SIM_access();
+	return (ctx != NULL_PTR) ? ctx->io[SIM_SREG] : 0;
+}
+
+void SIM_restoreState(const unsigned char *sreg)
+{
+	Sim_ContextType *ctx = SIM_access();
+	if(ctx != NULL_PTR)
+	{
+		ctx->io[SIM_SREG] = *sreg;
+		ctx->nextEvent = ctx->cycles;
+	}
+}
+
+void SIM_forceOn(const unsigned char *sreg)
+{
+	(void)sreg;
+	SIM_sei();
+}
+
+void SIM_forceOff(const unsigned char *sreg)
+{
+	(void)sreg;
+	SIM_cli();
+}
+
+unsigned char SIM_atomicEnter(void)
+{
+	SIM_cli();
+	return 1;
+}
+
+unsigned char SIM_atomicLeave(void)
+{
+	SIM_sei();
+	return 1;
+}
+
+void SIM_sleep(void)
+{
+	Sim_ContextType *ctx = SIM_access();
+	uint64 interrupts;
+	uint64 start;
+
+	if(ctx == NULL_PTR)
+		return;
+	if((ctx->io[SIM_SREG] & (1<<SREG_I)) == 0)
+	{
+		SIM_stop(ctx, SIM_SLEEP_FOREVER); /* nothing can wake it up */
+	}
+
+	start = ctx->cycles;
+	interrupts = SIM_countInterrupts(ctx);
+	/* jump from one peripheral event to the next until one of them is an interrupt */
+	while(SIM_countInterrupts(ctx) == interrupts)
+	{
+		if(ctx->nextEvent == SIM_FOREVER)
+		{
+			SIM_stop(ctx, SIM_SLEEP_FOREVER);
+		}
+		if(ctx->nextEvent > ctx->cycles)
+		{
+			ctx->cycles = ctx->nextEvent;
+		}
+		SIM_service(ctx);
+	}
+	ctx->stats.sleepCycles += ctx->cycles - start;
+}
+
+void SIM_delayCycles(unsigned long long cycles)
+{
+	Sim_ContextType *ctx = SIM_access();
+	uint64 end;
+
+	if(ctx == NULL_PTR)
+		return;
+	end = ctx->cycles + cycles;
+	ctx->stats.delayCycles += cycles;
+	while(ctx->cycles < end)
+	{
+		if(ctx->nextEvent >= end)
+		{
+			ctx->cycles = end;
+		}
+		else if(ctx->nextEvent > ctx->cycles)
+		{
+			ctx->cycles = ctx->nextEvent;
+		}
+		if(ctx->cycles >= ctx->nextEvent)
+		{
+			SIM_service(ctx);
+		}
+	}
+}
+
+/*******************************************************************************
+*                Instrumentation of the firmware accesses                     *
+*******************************************************************************/
+
+void __tsan_init(void) {}
+
+void __tsan_func_entry(void *pc)
+{
+	Sim_ContextType *ctx = g_simCurrent;
+	if(ctx != NULL_PTR)
+	{
+		ctx->stats.calls++;
+		ctx->cycles += SIM_CYCLES_PER_CALL;
+		if( ctx->skipLoops && (ctx->pendingWrite == FALSE) )
+		{
+			SIM_loopPoint(ctx, (uint32)(uintptr_t)pc, __builtin_dwarf_cfa());
+		}
+	}
+}
+
+void __tsan_func_exit(void) {}
+
+void __tsan_read1(void *addr) { SIM_dataRead(addr, 1); }
+void __tsan_read2(void *addr) { SIM_dataRead(addr, 2); }
+void __tsan_read4(void *addr) { SIM_dataRead(addr, 4); }
+void __tsan_read8(void *addr) { SIM_dataRead(addr, 8); }
+void __tsan_read16(void *addr) { SIM_dataRead(addr, 16); }
+void __tsan_write1(void *addr) { SIM_dataWrite(addr); }
+void __tsan_write2(void *addr) { SIM_dataWrite(addr); }
+void __tsan_write4(void *addr) { SIM_dataWrite(addr); }
+void __tsan_write8(void *addr) { SIM_dataWrite(addr); }
+void __tsan_write16(void *addr) { SIM_dataWrite(addr); }
+void __tsan_unaligned_read2(void *addr) { SIM_dataRead(addr, 2); }
+void __tsan_unaligned_read4(void *addr) { SIM_dataRead(addr, 4); }
+void __tsan_unaligned_read8(void *addr) { SIM_dataRead(addr, 8); }
+void __tsan_unaligned_read16(void *addr) { SIM_dataRead(addr, 16); }
+void __tsan_unaligned_write2(void *addr) { SIM_dataWrite(addr); }
+void __tsan_unaligned_write4(void *addr) { SIM_dataWrite(addr); }
+void __tsan_unaligned_write8(void *addr) { SIM_dataWrite(addr); }
+void __tsan_unaligned_write16(void *addr) { SIM_dataWrite(addr); }
+
+void __tsan_read_range(void *addr,unsigned long size)
+{
+	Sim_ContextType *ctx = g_simCurrent;
+	(void)addr;
+	if(ctx != NULL_PTR)
+	{
+		ctx->stats.accesses += size;
+		ctx->cycles += SIM_CYCLES_PER_ACCESS * (uint64)size;
+		SIM_access();
+	}
+}
+
+void __tsan_write_range(void *addr,unsigned long size)
+{
+	__tsan_read_range(addr, size);
+}
+
+/* clang calls these for the copies it doesn't inline, gcc calls the C library, they cost nothing in both */
+void *__tsan_memcpy(void *dest,const void *src,unsigned long size) { return memcpy(dest, src, size); }
+void *__tsan_memmove(void *dest,const void *src,unsigned long size) { return memmove(dest, src, size); }
+void *__tsan_memset(void *dest,int value,unsigned long size) { return memset(dest, value, size); }
+
+/* the stack pointer of the firmware is where the hook was called from */
+void __tsan_volatile_read1(void *addr) { SIM_volatileRead(addr, 1, __builtin_dwarf_cfa()); }
+void __tsan_volatile_read2(void *addr) { SIM_volatileRead(addr, 2, __builtin_dwarf_cfa()); }
+void __tsan_volatile_read4(void *addr) { SIM_volatileRead(addr, 4, __builtin_dwarf_cfa()); }
+void __tsan_volatile_read8(void *addr) { SIM_volatileRead(addr, 8, __builtin_dwarf_cfa()); }
+void __tsan_volatile_read16(void *addr) { SIM_volatileRead(addr, 16, __builtin_dwarf_cfa()); }
+void __tsan_volatile_write1(void *addr) { SIM_volatileWrite(addr, 1); }
+void __tsan_volatile_write2(void *addr) { SIM_volatileWrite(addr, 2); }
+void __tsan_volatile_write4(void *addr) { SIM_volatileWrite(addr, 4); }
+void __tsan_volatile_write8(void *addr) { SIM_volatileWrite(addr, 8); }
+void __tsan_volatile_write16(void *addr) { SIM_volatileWrite(addr, 16); }
+void __tsan_unaligned_volatile_read2(void *addr) { SIM_volatileRead(addr, 2, __builtin_dwarf_cfa()); }
+void __tsan_unaligned_volatile_read4(void *addr) { SIM_volatileRead(addr, 4, __builtin_dwarf_cfa()); }
+void __tsan_unaligned_volatile_read8(void *addr) { SIM_volatileRead(addr, 8, __builtin_dwarf_cfa()); }
+void __tsan_unaligned_volatile_read16(void *addr) { SIM_volatileRead(addr, 16, __builtin_dwarf_cfa()); }
+void __tsan_unaligned_volatile_write2(void *addr) { SIM_volatileWrite(addr, 2); }
+void __tsan_unaligned_volatile_write4(void *addr) { SIM_volatileWrite(addr, 4); }
+void __tsan_unaligned_volatile_write8(void *addr) { SIM_volatileWrite(addr, 8); }
+void __tsan_unaligned_volatile_write16(void *addr) { SIM_volatileWrite(addr, 16); }
+
+/*******************************************************************************
+* Function Name:		SIM_entry
+* Description:			Function the stack of a context starts with, it runs the firmware
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_entry(void)
+{
+	Sim_ContextType *ctx = g_simCurrent;
+	ctx->firmware->main();
+	ctx->stopReason = SIM_RETURNED;
+	SIM_jump(ctx->callerJump);
+}
+
+/*******************************************************************************
+* Function Name:		SIM_jump
+* Description:			Function to go back to where __builtin_setjmp saved a buffer, it can't
+* 						be done in the function that saved it
+* Parameters (in):    	Jump buffer
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_jump(void **buffer)
+{
+	__builtin_longjmp(buffer, 1);
+}
+
+/*******************************************************************************
+* Function Name:		SIM_giveBack
+* Description:			Function to give the thread back to SIM_resume, it returns when the
+* 						context is resumed
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_giveBack(Sim_ContextType *ctx)
+{
+	if(__builtin_setjmp(ctx->fiberJump) == 0)
+	{
+		SIM_jump(ctx->callerJump);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_countInterrupts
+* Description:			Function to count the ISRs a context ran so far
+* Parameters (in):    	Context
+* Parameters (out):   	Number of ISRs
+* Return value:      	uint64
+********************************************************************************/
+
+static uint64 SIM_countInterrupts(const Sim_ContextType *ctx)
+{
+	uint64 count = 0;
+	for(uint8 i = 0 ; i < SIM_NUM_VECTORS ; i++)
+	{
+		count += ctx->stats.interrupts[i];
+	}
+	return count;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_service
+* Description:			Function to run the peripherals up to the clock, then the interrupts that
+* 						became pending, and to give the thread back at the end of the resume
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_service(Sim_ContextType *ctx)
+{
+	uint8 vector;
+
+	do
+	{
+		uint64 next = ctx->resumeUntil;
+		next = SIM_MIN(next, SIM_TIMER_run(ctx));
+		next = SIM_MIN(next, SIM_UART_run(ctx));
+		next = SIM_MIN(next, SIM_TWI_run(ctx));
+		next = SIM_MIN(next, SIM_ADC_run(ctx));
+		next = SIM_MIN(next, SIM_INT_EEPROM_run(ctx));
+		ctx->nextEvent = next;
+		if(ctx->onEvent != NULL_PTR)
+		{
+			ctx->onEvent(ctx); /* may move nextEvent closer */
+		}
+
+		vector = SIM_getPendingInterrupt(ctx);
+		if(vector != 0)
+		{
+			SIM_interrupt(ctx, vector);
+		}
+	}while(vector != 0);
+
+	if(ctx->cycles >= ctx->resumeUntil)
+	{
+		SIM_giveBack(ctx);
+		/* resumed, SIM_resume asked for a new look at the peripherals */
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_getPendingInterrupt
+* Description:			Function to find the enabled interrupt with the highest priority
+* Parameters (in):    	Context
+* Parameters (out):   	Vector number or 0 if none
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 SIM_getPendingInterrupt(Sim_ContextType *ctx)
+{
+	uint8 flags;
+
+	if((ctx->io[SIM_SREG] & (1<<SREG_I)) == 0)
+		return 0;
+
+	/* the timer vectors follow the TIFR bits from bit 7 (TIMER2_COMP) down to bit 0 (TIMER0_OVF) */
+	flags = ctx->io[SIM_TIMSK] & ctx->io[SIM_TIFR];
+	if(flags != 0)
+	{
+		uint8 bit = 7;
+		while((flags & (1<<bit)) == 0)
+		{
+			bit--;
+		}
+		return (uint8)(4 + (7 - bit));
+	}
+	if((ctx->io[SIM_UCSRB] & (1<<RXCIE)) && (ctx->uart.rxCount != 0))
+		return 13;
+	if((ctx->io[SIM_UCSRB] & (1<<UDRIE)) && (ctx->uart.txBufferFull == FALSE))
+		return 14;
+	if((ctx->io[SIM_UCSRB] & (1<<TXCIE)) && (ctx->uart.txComplete == TRUE))
+		return 15;
+	if((ctx->io[SIM_ADCSRA] & (1<<ADIE)) && (ctx->adc.complete == TRUE))
+		return 16;
+	if((ctx->twi.twcr & (1<<TWIE)) && (ctx->twi.twcr & (1<<TWINT)))
+		return 19;
+	return 0;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_interrupt
+* Description:			Function to run an ISR of the firmware like the chip would, the flags
+* 						that the hardware clears on the way in are cleared
+* Parameters (in):    	Context and vector number
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_interrupt(Sim_ContextType *ctx,uint8 vector)
+{
+	void (*isr)(void) = ctx->firmware->vectors[vector];
+	uint64 start = ctx->cycles;
+
+	if( (vector >= 4) && (vector <= 11) )
+	{
+		ctx->io[SIM_TIFR] &= ~(1 << (7 - (vector - 4)));
+	}
+	else if(vector == 15)
+	{
+		ctx->uart.txComplete = FALSE;
+	}
+	else if(vector == 16)
+	{
+		ctx->adc.complete = FALSE;
+	}
+
+	if(isr == NULL_PTR)
+	{
+		SIM_stop(ctx, SIM_BAD_INTERRUPT); /* __bad_interrupt jumps to the reset vector */
+		return;
+	}
+
+	ctx->io[SIM_SREG] &= ~(1<<SREG_I);
+	ctx->cycles += SIM_CYCLES_PER_INTERRUPT;
+	ctx->stats.interrupts[vector]++;
+	ctx->inInterrupt = TRUE;
+	isr();
+	if(ctx->pendingWrite)
+	{
+		SIM_resolveWrite(ctx); /* the last store of the ISR */
+	}
+	ctx->inInterrupt = FALSE;
+	ctx->io[SIM_SREG] |= (1<<SREG_I); /* RETI */
+	ctx->stats.interruptCycles[vector] += ctx->cycles - start;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_resolveWrite
+* Description:			Function to give its meaning to the last register write, the hook runs
+* 						before the store so it is looked at by the next access
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_resolveWrite(Sim_ContextType *ctx)
+{
+	uint8 address = ctx->pendingAddress;
+	uint16 value = (ctx->pendingSize == 2) ? SIM_REG16(ctx, address) : ctx->io[address];
+
+	ctx->pendingWrite = FALSE;
+	if(ctx->skipLoops)
+	{
+		ctx->loop.hash = SIM_LOOP_MIX(SIM_LOOP_MIX(ctx->loop.hash, address), value);
+	}
+	if(ctx->onAccess != NULL_PTR)
+	{
+		ctx->onAccess(ctx, address, TRUE, value);
+	}
+	SIM_IO_write(ctx, address, ctx->pendingSize, ctx->pendingOld);
+	ctx->nextEvent = ctx->cycles; /* a peripheral or an interrupt may have been started */
+}
+
+/*******************************************************************************
+* Function Name:		SIM_access
+* Description:			Function called for every access of the firmware, it moves the clock
+* Parameters (in):    	None
+* Parameters (out):   	Running context or NULL_PTR if the code runs outside the simulator
+* Return value:      	Sim_ContextType *
+********************************************************************************/
+
+static inline Sim_ContextType *SIM_access(void)
+{
+	Sim_ContextType *ctx = g_simCurrent;
+	if(ctx == NULL_PTR)
+		return NULL_PTR;
+
+	if(ctx->pendingWrite)
+	{
+		SIM_resolveWrite(ctx);
+	}
+	ctx->stats.accesses++;
+	ctx->cycles += SIM_CYCLES_PER_ACCESS;
+	if(ctx->cycles >= ctx->nextEvent)
+	{
+		SIM_service(ctx);
+	}
+	return ctx;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_loopPoint
+* Description:			Function to look for a loop at a detection point and to jump to the next
+* 						event of the peripherals when the firmware runs the same loop again and
+* 						again, the clock moves by whole turns of the loop
+* Parameters (in):    	Context, what the point is (register, variable or caller) and the stack
+* 						pointer of the firmware
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_loopPoint(Sim_ContextType *ctx,uint32 key,const void *frame)
+{
+	Sim_LoopType *loop = &ctx->loop;
+	uint8 index = (uint8)((loop->index + 1) & (SIM_LOOP_HISTORY - 1));
+	uint32 hash = SIM_LOOP_MIX(loop->hash, key);
+
+	loop->index = index;
+	loop->points[index] = hash;
+	loop->cycles[index] = ctx->cycles;
+	loop->hash = 0;
+
+	for(uint8 period = 1 ; period <= SIM_LOOP_MAX_PERIOD ; period++)
+	{
+		uint8 before = (uint8)((index - period) & (SIM_LOOP_HISTORY - 1));
+		uint64 length;
+		uint64 target;
+
+		if(loop->points[before] != hash)
+		{
+			loop->runs[period] = 0;
+			continue;
+		}
+		if(++loop->runs[period] < (SIM_LOOP_REPEATS - 1) * period)
+			continue;
+
+		/* the accesses of the last turns were all the same, the locals must be too */
+		if( (loop->candidate != period) || (loop->runs[period] < SIM_LOOP_REPEATS * period) )
+		{
+			if(loop->candidate != period)
+			{
+				if( (loop->candidate != 0) && (loop->runs[loop->candidate] != 0) )
+					continue; /* a part of the loop being checked, like the same read of its columns */
+				loop->candidate = period;
+				ctx->uart.peerObserved = FALSE;
+				loop->frame = frame;
+				loop->stackHash = SIM_hashStack(ctx, frame);
+			}
+			return; /* one more turn to compare with */
+		}
+		length = ctx->cycles - loop->cycles[before];
+		target = SIM_MIN(ctx->nextEvent, ctx->resumeUntil);
+		if(ctx->uart.peerObserved)
+		{
+			/* a loop that polls the receiver can't go past a byte the peer hasn't sent yet */
+			target = SIM_MIN(target, SIM_UART_getHorizon(ctx));
+		}
+		if( (frame == loop->frame) && (SIM_hashStack(ctx, frame) == loop->stackHash) && (length != 0)
+				&& (target > ctx->cycles + length) && (ctx->inInterrupt == FALSE) )
+		{
+			uint64 skipped = ((target - ctx->cycles) / length) * length;
+			ctx->cycles += skipped;
+			ctx->stats.skippedCycles += skipped;
+			ctx->stats.skips++;
+		}
+		loop->candidate = 0;
+		memset(loop->runs, 0, sizeof(loop->runs));
+		return;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_hashStack
+* Description:			Function to hash the part of the stack of the firmware that is in use
+* Parameters (in):    	Context and stack pointer of the firmware
+* Parameters (out):   	Hash, 0 if the stack pointer isn't on the stack of the context
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 SIM_hashStack(const Sim_ContextType *ctx,const void *frame)
+{
+	const uint8 *top = (const uint8 *)ctx->stack + SIM_STACK_SIZE;
+	const uint8 *word = (const uint8 *)((uintptr_t)frame & ~(uintptr_t)(sizeof(uint64) - 1));
+	uint32 hash = 0;
+
+	if( (word < (const uint8 *)ctx->stack) || (word >= top) )
+		return 0;
+	for( ; word < top ; word += sizeof(uint64))
+	{
+		uint64 value;
+		memcpy(&value, word, sizeof(value));
+		hash = SIM_LOOP_MIX(SIM_LOOP_MIX(hash, value), value >> 32);
+	}
+	return hash;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_dataRead
+* Description:			Function called for every read of a variable, the value goes in the hash
+* 						of the loops
+* Parameters (in):    	Address and size of the access
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_dataRead(void *addr,uint8 size)
+{
+	Sim_ContextType *ctx = SIM_access();
+	if( (ctx != NULL_PTR) && ctx->skipLoops )
+	{
+		uint64 value = 0;
+		memcpy(&value, addr, (size < sizeof(value)) ? size : sizeof(value));
+		ctx->loop.hash = SIM_LOOP_MIX(SIM_LOOP_MIX(SIM_LOOP_MIX(ctx->loop.hash, (uintptr_t)addr), value), value >> 32);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_dataWrite
+* Description:			Function called for every write of a variable, the value is seen by the
+* 						next read of it
+* Parameters (in):    	Address of the access
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_dataWrite(void *addr)
+{
+	Sim_ContextType *ctx = SIM_access();
+	if( (ctx != NULL_PTR) && ctx->skipLoops )
+	{
+		ctx->loop.hash = SIM_LOOP_MIX(ctx->loop.hash, (uintptr_t)addr);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_volatileRead
+* Description:			Function to prepare the value of a register just before the firmware reads it
+* Parameters (in):    	Address and size of the access, stack pointer of the firmware
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_volatileRead(void *addr,uint8 size,const void *frame)
+{
+	Sim_ContextType *ctx = SIM_access();
+	if(ctx == NULL_PTR)
+		return;
+
+	if(SIM_IS_REGISTER(ctx, addr))
+	{
+		uint8 address = (uint8)((uint8 *)addr - ctx->io);
+		uint16 value;
+		ctx->stats.registerReads[address]++;
+		SIM_IO_read(ctx, address, size);
+		value = (size == 2) ? SIM_REG16(ctx, address) : ctx->io[address];
+		if(ctx->onAccess != NULL_PTR)
+		{
+			ctx->onAccess(ctx, address, FALSE, value);
+		}
+		if(ctx->skipLoops)
+		{
+			ctx->loop.hash = SIM_LOOP_MIX(ctx->loop.hash, value);
+			SIM_loopPoint(ctx, address, frame);
+		}
+	}
+	else if(ctx->skipLoops)
+	{
+		/* a flag set by an ISR */
+		uint64 value = 0;
+		memcpy(&value, addr, (size < sizeof(value)) ? size : sizeof(value));
+		ctx->loop.hash = SIM_LOOP_MIX(SIM_LOOP_MIX(ctx->loop.hash, value), value >> 32);
+		SIM_loopPoint(ctx, (uint32)(uintptr_t)addr, frame);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_volatileWrite
+* Description:			Function to remember a register write, it is resolved by the next access
+* Parameters (in):    	Address and size of the access
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_volatileWrite(void *addr,uint8 size)
+{
+	Sim_ContextType *ctx = SIM_access();
+	if( (ctx != NULL_PTR) && ctx->skipLoops && (SIM_IS_REGISTER(ctx, addr) == FALSE) )
+	{
+		ctx->loop.hash = SIM_LOOP_MIX(ctx->loop.hash, (uintptr_t)addr);
+	}
+	if( (ctx != NULL_PTR) && SIM_IS_REGISTER(ctx, addr) )
+	{
+		uint8 address = (uint8)((uint8 *)addr - ctx->io);
+		ctx->stats.registerWrites[address]++;
+		SIM_IO_beforeWrite(ctx, address, size);
+		ctx->pendingWrite = TRUE;
+		ctx->pendingAddress = address;
+		ctx->pendingSize = size;
+		ctx->pendingOld = (size == 2) ? SIM_REG16(ctx, address) : ctx->io[address];
+	}
+}
@@ -0,0 +1,543 @@
+/******************************************************************************
+*  File name:		sim.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Register level simulator of the ATmega32 for the host build. The firmware is
+ * compiled by the host gcc with -fsanitize=thread, which calls a hook before
+ * every memory access it makes : the hooks move the virtual clock by the cycles
+ * of the access, run the peripherals and the interrupts that are due and give the
+ * registers their meaning (reading UDR pops the receiver, writing TWCR starts a
+ * bus operation ...). Every MCU is a context with its own register file, clock
+ * and stack, the firmware runs on the stack of its context until its clock
+ * reaches the time it was resumed for, so several MCUs can share one thread.
+ */
+
+#ifndef HOST_SIM_SIM_H_
+#define HOST_SIM_SIM_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "../../Final_Project_MCU2/LIB/std_types.h"
+#include <avr/io.h>
+#include <ucontext.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* same as the firmware */
+#define ERROR 0
+#define SUCCESS 1
+
+#define SIM_F_CPU					8000000ULL
+#define SIM_NUM_VECTORS				21		/* reset then the 20 interrupts of the ATmega32 */
+#define SIM_NUM_PORTS				4
+#define SIM_NUM_TIMERS				3
+#define SIM_ADC_CHANNELS			8
+#define SIM_INT_EEPROM_SIZE			1024	/* bytes of the internal EEPROM */
+#define SIM_UART_FIFO_SIZE			2		/* received bytes waiting in UDR */
+#define SIM_UART_LINE_SIZE			256		/* bytes sent to the receiver but not on the wire yet */
+#define SIM_TWI_MAX_DEVICES			4
+#define SIM_STACK_SIZE				(1024UL * 1024UL)
+#define SIM_LOOP_HISTORY			128		/* detection points kept to find a loop, a power of 2 */
+#define SIM_LOOP_MAX_PERIOD			64		/* longest loop found, in detection points */
+#define SIM_LOOP_REPEATS			3		/* times a loop must run the same way before it is skipped */
+
+/* cost of the firmware on the virtual clock, close to what avr-gcc -O0 spends */
+#define SIM_CYCLES_PER_ACCESS		2		/* one LD or ST */
+#define SIM_CYCLES_PER_CALL			8		/* CALL, RET and the frame pointer setup */
+#define SIM_CYCLES_PER_INTERRUPT	36		/* response, prologue, epilogue and RETI of an ISR */
+
+#define SIM_FOREVER					0xFFFFFFFFFFFFFFFFULL
+
+/* data space addresses of the registers the models use, the same as in avr/io.h */
+#define SIM_TWBR			0x20
+#define SIM_TWSR			0x21
+#define SIM_TWAR			0x22
+#define SIM_TWDR			0x23
+#define SIM_ADCL			0x24
+#define SIM_ADCH			0x25
+#define SIM_ADCSRA			0x26
+#define SIM_ADMUX			0x27
+#define SIM_UBRRL			0x29
+#define SIM_UCSRB			0x2A
+#define SIM_UCSRA			0x2B
+#define SIM_UDR				0x2C
+#define SIM_PIND			0x30	/* PINx, DDRx then PORTx, port D first */
+#define SIM_PORTA			0x3B
+#define SIM_UBRRH			0x40	/* UCSRC too */
+#define SIM_OCR2			0x43
+#define SIM_TCNT2			0x44
+#define SIM_TCCR2			0x45
+#define SIM_ICR1L			0x46
+#define SIM_OCR1BL			0x48
+#define SIM_OCR1AL			0x4A
+#define SIM_TCNT1L			0x4C
+#define SIM_TCNT1H			0x4D
+#define SIM_TCCR1B			0x4E
+#define SIM_TCCR1A			0x4F
+#define SIM_TCNT0			0x52
+#define SIM_TCCR0			0x53
+#define SIM_TWCR			0x56
+#define SIM_TIFR			0x58
+#define SIM_TIMSK			0x59
+#define SIM_OCR0			0x5C
+#define SIM_SPL				0x5D
+#define SIM_SPH				0x5E
+#define SIM_SREG			0x5F
+
+#define SIM_PIN_ADDRESS(port)	(SIM_PORTA - 2 - (3 * (port)))	/* port 0 is PORTA */
+#define SIM_DDR_ADDRESS(port)	(SIM_PORTA - 1 - (3 * (port)))
+#define SIM_PORT_ADDRESS(port)	(SIM_PORTA - (3 * (port)))
+#define SIM_REG16(ctx,address)	((uint16)(ctx)->io[address] | ((uint16)(ctx)->io[(address) + 1] << 8))
+
+#define SIM_MS_TO_CYCLES(ms)		((uint64)(ms) * (SIM_F_CPU / 1000ULL))
+#define SIM_CYCLES_TO_US(cycles)	((cycles) / (SIM_F_CPU / 1000000ULL))
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+typedef struct Sim_ContextType Sim_ContextType;
+
+/*******************************************************************************
+* Name: Sim_FirmwareType
+* Type: Structure
+* Description: Entry point and interrupt vectors of a firmware built for the host,
+* 			   one is generated next to every firmware by sim_firmware.c
+********************************************************************************/
+typedef struct
+{
+	const char *name;
+	int (*main)(void);
+	void (*vectors[SIM_NUM_VECTORS])(void); /* NULL_PTR if the firmware has no ISR for it */
+}Sim_FirmwareType;
+
+/*******************************************************************************
+* Name: Sim_StopReasonType
+* Type: Enumeration
+* Description: Why a context doesn't run anymore
+********************************************************************************/
+typedef enum
+{
+	SIM_RUNNING,
+	SIM_STOPPED,			/* SIM_stop was called */
+	SIM_RETURNED,			/* main returned */
+	SIM_SLEEP_FOREVER,		/* sleep with the interrupts disabled */
+	SIM_BAD_INTERRUPT		/* an enabled interrupt has no ISR, the chip would reset */
+}Sim_StopReasonType;
+
+/*******************************************************************************
+* Name: Sim_TimerType
+* Type: Structure
+* Description: State of a timer that isn't kept in its registers, the counter is
+* 			   only brought up to date when it is used
+********************************************************************************/
+typedef struct
+{
+	uint64 lastCycle;		/* cycle the counter is up to date with */
+	uint32 prescalerCount;	/* CPU cycles counted towards the next timer clock */
+	uint16 count;
+	uint32 toggles;			/* changes of the OCxA pin in toggle mode */
+}Sim_TimerType;
+
+/*******************************************************************************
+* Name: Sim_UartType
+* Type: Structure
+* Description: State of the USART, the line queue holds bytes the other end sent
+* 			   which aren't in the receiver yet with the bit time they were sent at and
+* 			   the cycle their start bit was put on the wire
+********************************************************************************/
+typedef struct
+{
+	uint8 ubrrh;
+	uint8 ucsrc;
+	/* transmitter */
+	boolean txBusy;
+	uint8 txShift;
+	uint64 txEnd;
+	boolean txBufferFull;
+	uint8 txBuffer;
+	boolean txComplete;
+	/* receiver */
+	boolean rxBusy;
+	uint8 rxShift;
+	boolean rxShiftError;
+	uint64 rxEnd;
+	uint8 rxFifo[SIM_UART_FIFO_SIZE];
+	uint8 rxFifoErrors[SIM_UART_FIFO_SIZE];	/* FE and DOR of every byte */
+	uint8 rxHead;
+	uint8 rxCount;
+	uint8 line[SIM_UART_LINE_SIZE];
+	uint32 lineBitCycles[SIM_UART_LINE_SIZE];
+	uint64 lineStart[SIM_UART_LINE_SIZE];
+	uint16 lineHead;
+	uint16 lineCount;
+	uint64 nextPoll;	/* the source isn't asked again before this cycle */
+	/* the other end */
+	Sim_ContextType *peer;		/* MCU on the other end of the wires, it gets every byte as it starts */
+	sint32 peerErrorPpm;		/* error of the bit time the peer sees, the two clocks are never the same */
+	boolean peerObserved;		/* the receiver was looked at since the loop detector took its candidate */
+	void (*sink)(Sim_ContextType *ctx, uint8 byte, uint32 bitCycles);	/* called when a byte is out */
+	sint16 (*source)(Sim_ContextType *ctx);	/* asked for a byte when the line is idle, -1 if none */
+	boolean sourceAtOnce;		/* the source fills an empty UDR when the firmware looks at it, no time on the wire */
+	/* statistics */
+	uint32 txBytes;
+	uint32 rxBytes;
+	uint32 frameErrors;
+	uint32 overruns;
+}Sim_UartType;
+
+/*******************************************************************************
+* Name: Sim_TwiDeviceType
+* Type: Structure
+* Description: Slave on the TWI bus, every callback gets the device itself
+********************************************************************************/
+typedef struct Sim_TwiDeviceType
+{
+	uint8 address;	/* 7 bits */
+	uint8 mask;		/* address bits the device ignores, a 24C16 answers on 8 addresses */
+	boolean (*start)(struct Sim_TwiDeviceType *device, uint8 sla, uint64 cycle);	/* SLA+R/W, TRUE to ACK */
+	boolean (*write)(struct Sim_TwiDeviceType *device, uint8 byte, uint64 cycle);	/* TRUE to ACK */
+	uint8 (*read)(struct Sim_TwiDeviceType *device, boolean ack, uint64 cycle);
+	void (*stop)(struct Sim_TwiDeviceType *device, uint64 cycle);
+	void *state;
+}Sim_TwiDeviceType;
+
+typedef enum
+{
+	SIM_TWI_IDLE,
+	SIM_TWI_STARTED,		/* START or repeated START sent, SLA+R/W comes next */
+	SIM_TWI_TRANSMITTER,
+	SIM_TWI_RECEIVER,
+	SIM_TWI_NOT_ACKED		/* the slave didn't answer, only START or STOP make sense */
+}Sim_TwiStateType;
+
+typedef enum
+{
+	SIM_TWI_START,
+	SIM_TWI_STOP,
+	SIM_TWI_BYTE
+}Sim_TwiOperationType;
+
+/*******************************************************************************
+* Name: Sim_TwiType
+* Type: Structure
+* Description: State of the TWI master, an operation ends after the bits it puts on the bus
+********************************************************************************/
+typedef struct
+{
+	uint8 twcr;
+	uint8 status;
+	uint8 data;
+	uint8 prescaler;
+	Sim_TwiStateType state;
+	Sim_TwiDeviceType *active;
+	boolean busy;
+	Sim_TwiOperationType operation;
+	boolean ack;			/* TWEA of the running operation */
+	uint64 end;
+	Sim_TwiDeviceType *devices[SIM_TWI_MAX_DEVICES];
+	uint8 numDevices;
+	/* statistics */
+	uint32 starts;
+	uint32 bytes;
+	uint32 nacks;
+}Sim_TwiType;
+
+/*******************************************************************************
+* Name: Sim_AdcType
+* Type: Structure
+* Description: State of the ADC, the inputs are set by the board model in ADC units
+********************************************************************************/
+typedef struct
+{
+	boolean busy;
+	boolean complete;
+	boolean firstConversion;	/* the first one after ADEN takes 25 clocks */
+	uint64 end;
+	uint16 result;
+	uint16 inputs[SIM_ADC_CHANNELS];
+	uint32 conversions;
+}Sim_AdcType;
+
+/*******************************************************************************
+* Name: Sim_IntEepromType
+* Type: Structure
+* Description: State of the internal EEPROM, the firmware reaches it through the
+* 			   avr-libc routines of avr/eeprom.h. It keeps its content when the board
+* 			   is powered down, a tool that cuts the power copies it to the new board
+********************************************************************************/
+typedef struct
+{
+	uint8 memory[SIM_INT_EEPROM_SIZE];
+	boolean busy;
+	uint64 end;
+	uint16 address;			/* of the running write */
+	uint8 data;
+	uint32 reads;
+	uint32 writes;
+}Sim_IntEepromType;
+
+/*******************************************************************************
+* Name: Sim_GpioType
+* Type: Structure
+* Description: Levels the board puts on the pins, a pin nobody drives reads high
+********************************************************************************/
+typedef struct
+{
+	uint8 level[SIM_NUM_PORTS];
+	uint8 driven[SIM_NUM_PORTS];
+	void (*onChange)(Sim_ContextType *ctx, uint8 port);	/* PORTx or DDRx was written */
+}Sim_GpioType;
+
+/*******************************************************************************
+* Name: Sim_LoopType
+* Type: Structure
+* Description: Finds the loops that wait for a peripheral. The accesses between two
+* 			   detection points (volatile reads and calls) are hashed with the values
+* 			   read, when the hashes repeat the stack of the firmware is compared one
+* 			   turn apart too since the locals aren't instrumented. A loop that runs
+* 			   the same way again and again can only change when a peripheral does,
+* 			   so the clock jumps to the next event at once
+********************************************************************************/
+typedef struct
+{
+	uint32 hash;							/* accesses since the last detection point */
+	uint32 points[SIM_LOOP_HISTORY];		/* hash of the last detection points */
+	uint64 cycles[SIM_LOOP_HISTORY];		/* clock at the last detection points */
+	uint8 index;
+	uint8 runs[SIM_LOOP_MAX_PERIOD + 1];	/* points in a row that repeat the one a period before */
+	uint8 candidate;						/* period of the loop whose stack was hashed, 0 if none */
+	const void *frame;						/* stack pointer of the firmware when it was hashed */
+	uint32 stackHash;
+}Sim_LoopType;
+
+/*******************************************************************************
+* Name: Sim_StatsType
+* Type: Structure
+* Description: What the firmware did, for the benchmarks
+********************************************************************************/
+typedef struct
+{
+	uint64 accesses;		/* memory accesses, registers included */
+	uint64 calls;
+	uint64 registerReads[SIM_IO_SIZE];
+	uint64 registerWrites[SIM_IO_SIZE];
+	uint64 interrupts[SIM_NUM_VECTORS];
+	uint64 interruptCycles[SIM_NUM_VECTORS];
+	uint64 delayCycles;		/* spent in _delay_ms and _delay_us */
+	uint64 sleepCycles;
+	uint64 skippedCycles;	/* jumped over in the loops waiting for a peripheral */
+	uint64 skips;
+}Sim_StatsType;
+
+/*******************************************************************************
+* Name: Sim_ContextType
+* Type: Structure
+* Description: One simulated MCU
+********************************************************************************/
+struct Sim_ContextType
+{
+	uint8 io[SIM_IO_SIZE];	/* register file, what the firmware reads and writes */
+	const Sim_FirmwareType *firmware;
+	const char *name;
+	uint64 cycles;			/* virtual clock */
+	uint64 nextEvent;		/* the peripherals have nothing to do before this cycle */
+	uint64 resumeUntil;		/* the context gives the thread back at this cycle */
+	Sim_StopReasonType stopReason;
+	boolean skipLoops;		/* only right when every variable is in memory, as with -O0 */
+	boolean inInterrupt;
+	boolean waiting;		/* gave the thread back in the middle of an access for another context to catch up */
+	Sim_LoopType loop;
+	/* write seen by a hook but not in the register file yet */
+	boolean pendingWrite;
+	uint8 pendingAddress;
+	uint8 pendingSize;
+	uint16 pendingOld;
+	uint8 lastRead;			/* a second read of UBRRH in a row gives UCSRC */
+	Sim_TimerType timers[SIM_NUM_TIMERS];
+	Sim_UartType uart;
+	Sim_TwiType twi;
+	Sim_AdcType adc;
+	Sim_IntEepromType intEeprom;
+	Sim_GpioType gpio;
+	Sim_StatsType stats;
+	/* optional hooks of the tools built on the simulator */
+	void (*onAccess)(Sim_ContextType *ctx, uint8 address, boolean write, uint16 value);	/* every register access */
+	void (*onEvent)(Sim_ContextType *ctx);	/* after the peripherals ran */
+	void *user;
+	/* stack of the firmware, entered once with setcontext then switched with the
+	 * jump buffers of __builtin_setjmp that don't save the signal mask */
+	ucontext_t fiber;
+	boolean started;
+	void *fiberJump[5];
+	void *callerJump[5];
+	void *stack;
+	boolean stackOwned;		/* allocated by SIM_init, FALSE after SIM_setStack */
+};
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+extern __thread Sim_ContextType *g_simCurrent; /* context running on this thread */
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		SIM_init
+* Description:			Function to reset a context to the state of the chip after power up,
+* 						the firmware starts with the first SIM_resume
+* Parameters (in):    	Context, the firmware to run and a name for the reports
+* Parameters (out):   	SUCCESS or ERROR if the stack couldn't be allocated
+* Return value:      	uint8
+********************************************************************************/
+uint8 SIM_init(Sim_ContextType *ctx,const Sim_FirmwareType *firmware,const char *name);
+
+/*******************************************************************************
+* Function Name:		SIM_deinit
+* Description:			Function to free the stack of a context, it can't be resumed anymore
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_deinit(Sim_ContextType *ctx);
+
+/*******************************************************************************
+* Function Name:		SIM_setStack
+* Description:			Function to run a context that hasn't started on a stack of the caller,
+* 						of SIM_STACK_SIZE bytes, instead of the one of SIM_init
+* Parameters (in):    	Context and the stack
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_setStack(Sim_ContextType *ctx,void *stack);
+
+/*******************************************************************************
+* Function Name:		SIM_resume
+* Description:			Function to run the firmware of a context until its clock reaches a cycle
+* Parameters (in):    	Context and the cycle to stop at
+* Parameters (out):   	TRUE while the context can still run
+* Return value:      	boolean
+********************************************************************************/
+boolean SIM_resume(Sim_ContextType *ctx,uint64 until);
+
+/*******************************************************************************
+* Function Name:		SIM_stop
+* Description:			Function to stop a context for good, from its firmware or a model
+* Parameters (in):    	Context and the reason
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_stop(Sim_ContextType *ctx,Sim_StopReasonType reason);
+
+/*******************************************************************************
+* Function Name:		SIM_yield
+* Description:			Function for the models to end the running SIM_resume at the next access,
+* 						when something the caller waits for happened
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_yield(Sim_ContextType *ctx);
+
+/*******************************************************************************
+* Function Name:		SIM_wait
+* Description:			Function for the models to give the thread back in the middle of an access
+* 						of the running context, it returns when the context is resumed
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_wait(Sim_ContextType *ctx);
+
+/*******************************************************************************
+* Function Name:		SIM_schedule
+* Description:			Function for the models to have the peripherals run at a cycle at the latest
+* Parameters (in):    	Context and the cycle
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_schedule(Sim_ContextType *ctx,uint64 cycle);
+
+/*******************************************************************************
+* Function Name:		SIM_delayCycles
+* Description:			Function behind _delay_ms and _delay_us, also for the routines of the
+* 						firmware the simulator runs itself: the clock of the running context
+* 						moves while the peripherals and the interrupts run
+* Parameters (in):    	Number of cycles
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_delayCycles(unsigned long long cycles);
+
+/*******************************************************************************
+* Function Name:		SIM_advance
+* Description:			Function to move the clock of the running context, called by the hooks
+* Parameters (in):    	Cycles
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_advance(uint64 cycles);
+
+/*******************************************************************************
+* Function Name:		SIM_getRegisterName
+* Description:			Function to get the name of a register for the reports
+* Parameters (in):    	Data space address
+* Parameters (out):   	Name or NULL_PTR if the address isn't a register
+* Return value:      	const char *
+********************************************************************************/
+const char *SIM_getRegisterName(uint8 address);
+
+/*******************************************************************************
+* Function Name:		SIM_getVectorName
+* Description:			Function to get the name of an interrupt vector for the reports
+* Parameters (in):    	Vector number
+* Parameters (out):   	Name
+* Return value:      	const char *
+********************************************************************************/
+const char *SIM_getVectorName(uint8 vector);
+
+/* registers, sim_io.c */
+void SIM_IO_read(Sim_ContextType *ctx,uint8 address,uint8 size);
+void SIM_IO_beforeWrite(Sim_ContextType *ctx,uint8 address,uint8 size);
+void SIM_IO_write(Sim_ContextType *ctx,uint8 address,uint8 size,uint16 old);
+
+/* peripherals, every one runs what is due at the clock and tells when it needs to run again */
+uint8 SIM_GPIO_readPin(Sim_ContextType *ctx,uint8 port);
+void SIM_GPIO_drive(Sim_ContextType *ctx,uint8 port,uint8 pin,uint8 level);
+void SIM_GPIO_release(Sim_ContextType *ctx,uint8 port,uint8 pin);
+uint8 SIM_GPIO_getOutput(Sim_ContextType *ctx,uint8 port);
+
+uint64 SIM_TIMER_run(Sim_ContextType *ctx);
+void SIM_TIMER_sync(Sim_ContextType *ctx);
+void SIM_TIMER_setCount(Sim_ContextType *ctx,uint8 timer,uint16 count);
+
+uint64 SIM_UART_run(Sim_ContextType *ctx);
+void SIM_UART_transmit(Sim_ContextType *ctx,uint8 byte);
+uint8 SIM_UART_readStatus(Sim_ContextType *ctx);
+uint8 SIM_UART_readData(Sim_ContextType *ctx);
+void SIM_UART_receive(Sim_ContextType *ctx,uint8 byte,uint32 bitCycles,uint64 start);
+uint32 SIM_UART_getBitCycles(Sim_ContextType *ctx);
+uint8 SIM_UART_getFrameBits(Sim_ContextType *ctx);
+uint64 SIM_UART_getHorizon(Sim_ContextType *ctx);
+
+uint64 SIM_TWI_run(Sim_ContextType *ctx);
+void SIM_TWI_control(Sim_ContextType *ctx,uint8 twcr);
+void SIM_TWI_attach(Sim_ContextType *ctx,Sim_TwiDeviceType *device);
+
+uint64 SIM_ADC_run(Sim_ContextType *ctx);
+void SIM_ADC_start(Sim_ContextType *ctx);
+uint8 SIM_ADC_readControl(Sim_ContextType *ctx);
+
+uint64 SIM_INT_EEPROM_run(Sim_ContextType *ctx);
+
+#endif /* HOST_SIM_SIM_H_ */
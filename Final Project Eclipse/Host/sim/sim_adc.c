@@ -0,0 +1,68 @@
+/******************************************************************************
+*  File name:		sim_adc.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SIM_ADC_CLOCKS				13		/* ADC clocks of a conversion */
+#define SIM_ADC_FIRST_CLOCKS		25		/* the first one after ADEN sets up the analog part */
+#define SIM_ADC_MAXIMUM_VALUE		1023
+#define SIM_ADC_MUX_BANDGAP			0x1E
+#define SIM_ADC_BANDGAP				250		/* 1.22 V against AVCC, without any noise so the runs stay reproducible */
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_ADC_start(Sim_ContextType *ctx)
+{
+	uint8 adps = ctx->io[SIM_ADCSRA] & 0x07;
+	uint32 prescaler = (adps == 0) ? 2 : (1UL << adps);
+	uint32 clocks = ctx->adc.firstConversion ? SIM_ADC_FIRST_CLOCKS : SIM_ADC_CLOCKS;
+
+	if(ctx->adc.busy)
+		return; /* ADSC is ignored while converting */
+
+	ctx->adc.busy = TRUE;
+	ctx->adc.firstConversion = FALSE;
+	ctx->adc.end = ctx->cycles + (uint64)clocks * prescaler;
+}
+
+uint64 SIM_ADC_run(Sim_ContextType *ctx)
+{
+	if(ctx->adc.busy && (ctx->adc.end <= ctx->cycles))
+	{
+		/* single ended channels and the band-gap only, the input is sampled at the end */
+		uint8 mux = ctx->io[SIM_ADMUX] & 0x1F;
+		uint16 input = (mux == SIM_ADC_MUX_BANDGAP) ? SIM_ADC_BANDGAP : ctx->adc.inputs[mux & 0x07];
+		ctx->adc.busy = FALSE;
+		ctx->adc.complete = TRUE;
+		ctx->adc.result = (input > SIM_ADC_MAXIMUM_VALUE) ? SIM_ADC_MAXIMUM_VALUE : input;
+		ctx->adc.conversions++;
+	}
+	return ctx->adc.busy ? ctx->adc.end : SIM_FOREVER;
+}
+
+uint8 SIM_ADC_readControl(Sim_ContextType *ctx)
+{
+	uint8 control = ctx->io[SIM_ADCSRA] & ~((1<<ADSC) | (1<<ADIF));
+	if(ctx->adc.busy)
+	{
+		control |= (1<<ADSC);
+	}
+	if(ctx->adc.complete)
+	{
+		control |= (1<<ADIF);
+	}
+	return control;
+}
@@ -0,0 +1,245 @@
+/******************************************************************************
+*  File name:		sim_board.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * The door lock board. The pins of the models come from the headers of the two
+ * firmwares so the board follows them when they are moved, the rest is what the
+ * hardware is : a 4x4 keypad and a 2x16 LCD on MCU1, a 24C16, the bolt motor
+ * and an active buzzer on MCU2.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <string.h>
+
+#include "../../Final_Project_MCU1/MCAL/GPIO/gpio.h"
+#include "../../Final_Project_MCU1/HAL/KEYPAD/keypad.h"
+#include "../../Final_Project_MCU1/HAL/LCD/lcd.h"
+#include "../../Final_Project_MCU2/HAL/MOTOR/motor.h"
+#include "../../Final_Project_MCU2/HAL/BUZZER/buzzer.h"
+#include "../../Final_Project_MCU2/HAL/EXT_EEPORM/eeprom.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define BOARD_MOTOR_TRAVEL_MS		2000	/* end to end at full speed */
+#define BOARD_MOTOR_RUN_CURRENT		40		/* ADC units, 0.4 A, it stalls at 4 times more */
+
+/* the motor model has one port for its inputs and its end-stops */
+#if (DCMOTOR_IN2_PORT_ID != DCMOTOR_IN1_PORT_ID) || (DCMOTOR_OPENED_PORT_ID != DCMOTOR_IN1_PORT_ID) || \
+	(DCMOTOR_CLOSED_PORT_ID != DCMOTOR_IN1_PORT_ID)
+
+#error "The board needs DCMOTOR_IN1, DCMOTOR_IN2, DCMOTOR_OPENED and DCMOTOR_CLOSED on one port"
+
+#endif
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+extern const Sim_FirmwareType SIM_FIRMWARE_MCU1;
+extern const Sim_FirmwareType SIM_FIRMWARE_MCU2;
+
+/* buttons row after row, C is ON/C */
+static const char g_boardKeypadLayout[KEYPAD_NUM_ROWS * KEYPAD_NUM_COLS + 1] = "789%456*123-C0=+";
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void BOARD_mcu1Change(Sim_ContextType *ctx,uint8 port);
+static void BOARD_mcu1Access(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value);
+static void BOARD_mcu2Change(Sim_ContextType *ctx,uint8 port);
+static void BOARD_mcu2Access(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value);
+static void BOARD_mcu2Event(Sim_ContextType *ctx);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+uint8 SIM_BOARD_init(Sim_BoardType *board,sint32 errorPpm)
+{
+	memset(board, 0, sizeof(*board));
+	if(SIM_init(&board->mcu1, &SIM_FIRMWARE_MCU1, NULL_PTR) == ERROR)
+		return ERROR;
+	if(SIM_BOARD_initMcu2(board) == ERROR)
+	{
+		SIM_deinit(&board->mcu1);
+		return ERROR;
+	}
+	board->mcu1.skipLoops = TRUE;
+
+	/* MCU1 */
+	board->keypad.rowPort = KEYPAD_ROW_PORT_ID;
+	board->keypad.firstRowPin = KEYPAD_ROW_PIN_ID;
+	board->keypad.colPort = KEYPAD_COL_PORT_ID;
+	board->keypad.firstColPin = KEYPAD_COL_PIN_ID;
+	board->keypad.numRows = KEYPAD_NUM_ROWS;
+	board->keypad.numCols = KEYPAD_NUM_COLS;
+	board->keypad.layout = g_boardKeypadLayout;
+	board->keypad.pressed = -1;
+
+	SIM_LCD_init(&board->lcd);
+	board->lcd.rsPort = LCD_RS_PORT_ID;
+	board->lcd.rsPin = LCD_RS_PIN_ID;
+	board->lcd.ePort = LCD_E_PORT_ID;
+	board->lcd.ePin = LCD_E_PIN_ID;
+	board->lcd.dataPort = LCD_DATA_PORT_ID;
+	board->lcd.firstDataPin = LCD_DATA_PIN_ID;
+	board->lcd.fourPins = (LCD_DATA_BITS_MODE == 4) ? TRUE : FALSE;
+
+	board->mcu1.user = board;
+	board->mcu1.gpio.onChange = BOARD_mcu1Change;
+	board->mcu1.onAccess = BOARD_mcu1Access;
+
+	SIM_LINK_connect(&board->link, &board->mcu1, &board->mcu2, errorPpm);
+	return SUCCESS;
+}
+
+uint8 SIM_BOARD_initMcu2(Sim_BoardType *board)
+{
+	if(SIM_init(&board->mcu2, &SIM_FIRMWARE_MCU2, NULL_PTR) == ERROR)
+		return ERROR;
+	board->mcu2.skipLoops = TRUE;
+
+	SIM_EEPROM_init(&board->eeprom, EEPROM_SIZE, EEPROM_PAGE_SIZE, EEPROM_DEVICE_ADDRESS >> 1);
+	SIM_TWI_attach(&board->mcu2, &board->eeprom.device);
+
+	SIM_MOTOR_init(&board->motor);
+	board->motor.port = DCMOTOR_IN1_PORT_ID;
+	board->motor.in1Pin = DCMOTOR_IN1_PIN_ID;
+	board->motor.in2Pin = DCMOTOR_IN2_PIN_ID;
+	board->motor.openedPin = DCMOTOR_OPENED_PIN_ID;
+	board->motor.closedPin = DCMOTOR_CLOSED_PIN_ID;
+	board->motor.currentChannel = DCMOTOR_CURRENT_CHANNEL;
+	board->motor.travelMs = BOARD_MOTOR_TRAVEL_MS;
+	board->motor.jamAt = SIM_MOTOR_NO_JAM;
+	board->motor.runCurrent = BOARD_MOTOR_RUN_CURRENT;
+	board->motor.endStops = TRUE;
+
+	board->buzzer.port = BUZZER_PORT_ID;
+	board->buzzer.pin = BUZZER_PIN_ID;
+
+	board->mcu2.user = board;
+	board->mcu2.gpio.onChange = BOARD_mcu2Change;
+	board->mcu2.onAccess = BOARD_mcu2Access;
+	board->mcu2.onEvent = BOARD_mcu2Event;
+	SIM_MOTOR_update(&board->mcu2, &board->motor); /* end-stops */
+	return SUCCESS;
+}
+
+void SIM_BOARD_deinit(Sim_BoardType *board)
+{
+	SIM_deinit(&board->mcu1);
+	SIM_deinit(&board->mcu2);
+}
+
+/*******************************************************************************
+* Function Name:		BOARD_mcu1Change
+* Description:			Function to pass a change of the outputs of MCU1 to its models
+* Parameters (in):    	Context and port
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BOARD_mcu1Change(Sim_ContextType *ctx,uint8 port)
+{
+	Sim_BoardType *board = ctx->user;
+
+	if(port == board->keypad.rowPort)
+	{
+		SIM_KEYPAD_update(ctx, &board->keypad);
+	}
+	if( (port == board->lcd.ePort) || (port == board->lcd.rsPort) || (port == board->lcd.dataPort) )
+	{
+		SIM_LCD_update(ctx, &board->lcd);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		BOARD_mcu1Access
+* Description:			Function to tell the keypad when MCU1 reads its columns
+* Parameters (in):    	Context, register address, TRUE for a write and the value
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BOARD_mcu1Access(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value)
+{
+	Sim_BoardType *board = ctx->user;
+
+	if( (write == FALSE) && (address == SIM_PIN_ADDRESS(board->keypad.colPort)) )
+	{
+		SIM_KEYPAD_read(ctx, &board->keypad, board->keypad.colPort, (uint8)value);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		BOARD_mcu2Change
+* Description:			Function to pass a change of the outputs of MCU2 to its models
+* Parameters (in):    	Context and port
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BOARD_mcu2Change(Sim_ContextType *ctx,uint8 port)
+{
+	Sim_BoardType *board = ctx->user;
+
+	if( (port == board->motor.port) || (port == SIM_MOTOR_OC0_PORT) )
+	{
+		SIM_MOTOR_update(ctx, &board->motor);
+	}
+	if(port == board->buzzer.port)
+	{
+		SIM_BUZZER_update(ctx, &board->buzzer);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		BOARD_mcu2Access
+* Description:			Function to tell the motor when the PWM of its enable pin changes
+* Parameters (in):    	Context, register address, TRUE for a write and the value
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BOARD_mcu2Access(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value)
+{
+	Sim_BoardType *board = ctx->user;
+	(void)value;
+
+	if( write && ((address == SIM_TCCR0) || (address == SIM_OCR0)) )
+	{
+		SIM_MOTOR_update(ctx, &board->motor);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		BOARD_mcu2Event
+* Description:			Function to move the bolt up to an end when it gets there
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void BOARD_mcu2Event(Sim_ContextType *ctx)
+{
+	Sim_BoardType *board = ctx->user;
+
+	if(ctx->cycles >= board->motor.nextStop)
+	{
+		SIM_MOTOR_update(ctx, &board->motor);
+	}
+	else
+	{
+		SIM_schedule(ctx, board->motor.nextStop);
+	}
+}
@@ -0,0 +1,288 @@
+/******************************************************************************
+*  File name:		sim_board.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Models of what is wired to the two MCUs on the door lock board and the UART
+ * link between them. The models only look at the registers of the MCU they are
+ * wired to and are run by its context, so the whole board runs on one thread :
+ * SIM_LINK_run moves the two MCUs forward in turns and no byte is ever seen by
+ * the receiver later than it would be on the wires.
+ */
+
+#ifndef HOST_SIM_SIM_BOARD_H_
+#define HOST_SIM_SIM_BOARD_H_
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SIM_EEPROM_MAX_SIZE				0x8000	/* 24C256 */
+#define SIM_EEPROM_MAX_PAGE_SIZE		64
+#define SIM_EEPROM_WRITE_MS				5		/* tWR, the chip doesn't answer while it writes */
+
+#define SIM_LCD_ROWS					2
+#define SIM_LCD_COLUMNS					16
+#define SIM_LCD_DDRAM_SIZE				0x80
+#define SIM_LCD_COMMAND_US				37		/* execution time of most instructions */
+#define SIM_LCD_CLEAR_US				1520	/* clear and return home */
+
+#define SIM_MOTOR_TRAVEL				1000000	/* positions from locked to unlocked */
+#define SIM_MOTOR_NO_JAM				(-1)
+#define SIM_MOTOR_OC0_PORT				1		/* the enable pin of the H-bridge is OC0, PB3 */
+#define SIM_MOTOR_OC0_PIN				3
+#define SIM_MOTOR_STALL_FACTOR			4		/* stall current against the running current */
+
+#define SIM_LINK_MAX_QUANTUM_MS			100		/* longest turn of an MCU */
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Sim_EepromType
+* Type: Structure
+* Description: 24Cxx serial EEPROM on the TWI bus. Writes go to the page buffer and
+* 			   are programmed at the STOP, the chip then doesn't acknowledge its
+* 			   address until the write cycle is over
+********************************************************************************/
+typedef struct
+{
+	Sim_TwiDeviceType device;
+	uint16 size;				/* bytes, a power of 2 */
+	uint8 pageSize;
+	uint8 addressBytes;			/* 1 up to the 24C16 whose high address bits are in the device address */
+	uint8 memory[SIM_EEPROM_MAX_SIZE];
+	uint8 page[SIM_EEPROM_MAX_PAGE_SIZE];
+	uint8 pageWritten[SIM_EEPROM_MAX_PAGE_SIZE];	/* bytes of the page buffer to program */
+	uint16 address;				/* address counter */
+	uint8 addressReceived;		/* address bytes received since the SLA+W */
+	boolean writing;			/* data bytes were received since the address */
+	uint64 busyUntil;
+	/* statistics */
+	uint32 pageWrites;
+	uint32 bytesWritten;
+	uint32 bytesRead;
+	uint32 busyNacks;
+}Sim_EepromType;
+
+/*******************************************************************************
+* Name: Sim_KeypadType
+* Type: Structure
+* Description: Matrix keypad, the rows are driven low one at a time by the MCU and
+* 			   a pressed button pulls its column down while its row is low
+********************************************************************************/
+typedef struct
+{
+	uint8 rowPort;
+	uint8 firstRowPin;
+	uint8 colPort;
+	uint8 firstColPin;
+	uint8 numRows;
+	uint8 numCols;
+	const char *layout;		/* key of every button, row after row */
+	sint8 pressed;			/* button held down, -1 if none */
+	boolean seen;			/* the MCU read the column of the pressed button low */
+	uint32 presses;
+}Sim_KeypadType;
+
+/*******************************************************************************
+* Name: Sim_LcdType
+* Type: Structure
+* Description: HD44780 character LCD on 8 or 4 data pins, the bus is latched on the
+* 			   falling edge of E
+********************************************************************************/
+typedef struct
+{
+	uint8 rsPort;
+	uint8 rsPin;
+	uint8 ePort;
+	uint8 ePin;
+	uint8 dataPort;
+	uint8 firstDataPin;		/* DB0 in 8 bits mode, DB4 when only 4 pins are wired */
+	boolean fourPins;
+	/* controller */
+	char ddram[SIM_LCD_DDRAM_SIZE];
+	uint8 address;
+	boolean increment;
+	boolean displayOn;
+	boolean cgram;			/* data goes to the character generator */
+	boolean fourBits;		/* the controller was set to 4 bits transfers */
+	boolean lowNibble;		/* the next transfer is the low nibble */
+	uint8 highNibble;
+	boolean enable;			/* level of E at the last look */
+	uint64 busyUntil;
+	/* statistics */
+	uint32 commands;
+	uint32 characters;
+	uint32 tooEarly;		/* transfers while the controller was still busy */
+	uint32 changes;			/* anything that changes what is displayed */
+}Sim_LcdType;
+
+/*******************************************************************************
+* Name: Sim_MotorType
+* Type: Structure
+* Description: DC motor of the bolt behind an H-bridge, with the two end-stops and
+* 			   the current sense resistor on an ADC channel. The position goes from
+* 			   0 (locked) to SIM_MOTOR_TRAVEL (unlocked), IN1 high turns it CW. The
+* 			   speed follows the duty cycle of OC0 on the enable pin
+********************************************************************************/
+typedef struct
+{
+	uint8 port;				/* IN1, IN2, the end-stops and the current sense pin */
+	uint8 in1Pin;
+	uint8 in2Pin;
+	uint8 openedPin;
+	uint8 closedPin;
+	uint8 currentChannel;
+	/* mechanics */
+	uint32 travelMs;		/* from end to end at full speed */
+	sint32 jamAt;			/* position the bolt gets stuck at, SIM_MOTOR_NO_JAM if none */
+	uint16 runCurrent;		/* ADC units while the bolt moves */
+	boolean endStops;		/* FALSE for a board without them */
+	/* state */
+	sint32 position;		/* 0 .. SIM_MOTOR_TRAVEL */
+	sint8 direction;		/* 1 CW, -1 CCW, 0 stopped */
+	uint16 duty;			/* 0 .. 256 */
+	uint64 nextStop;		/* cycle the bolt reaches an end or the jam */
+	uint64 lastCycle;
+	/* statistics */
+	uint32 moves;
+	uint64 runningCycles;
+	uint64 stalledCycles;
+}Sim_MotorType;
+
+/*******************************************************************************
+* Name: Sim_BuzzerType
+* Type: Structure
+* Description: Active buzzer on a GPIO pin, it sounds while the pin is high
+********************************************************************************/
+typedef struct
+{
+	uint8 port;
+	uint8 pin;
+	boolean on;
+	uint64 lastChange;
+	/* statistics */
+	uint32 beeps;
+	uint64 onCycles;
+}Sim_BuzzerType;
+
+/*******************************************************************************
+* Name: Sim_LinkType
+* Type: Structure
+* Description: Two MCUs with their UARTs wired together, run in turns
+********************************************************************************/
+typedef struct
+{
+	Sim_ContextType *mcus[2];
+	uint64 cycles;			/* both MCUs ran up to here */
+	uint32 turns;
+}Sim_LinkType;
+
+/*******************************************************************************
+* Name: Sim_BoardType
+* Type: Structure
+* Description: The door lock : MCU1 with the keypad and the LCD, MCU2 with the
+* 			   EEPROM, the motor and the buzzer
+********************************************************************************/
+typedef struct
+{
+	Sim_ContextType mcu1;
+	Sim_ContextType mcu2;
+	Sim_LinkType link;
+	Sim_KeypadType keypad;
+	Sim_LcdType lcd;
+	Sim_EepromType eeprom;
+	Sim_MotorType motor;
+	Sim_BuzzerType buzzer;
+}Sim_BoardType;
+
+/*******************************************************************************
+*                      Functions Prototypes                                   *
+*******************************************************************************/
+
+/* 24Cxx EEPROM, sim_eeprom.c */
+void SIM_EEPROM_init(Sim_EepromType *eeprom,uint16 size,uint8 pageSize,uint8 address);
+boolean SIM_EEPROM_load(Sim_EepromType *eeprom,const char *path);
+boolean SIM_EEPROM_save(const Sim_EepromType *eeprom,const char *path);
+
+/* keypad, sim_keypad.c */
+void SIM_KEYPAD_update(Sim_ContextType *ctx,Sim_KeypadType *keypad);
+void SIM_KEYPAD_read(Sim_ContextType *ctx,Sim_KeypadType *keypad,uint8 port,uint8 value);
+boolean SIM_KEYPAD_press(Sim_ContextType *ctx,Sim_KeypadType *keypad,char key);
+void SIM_KEYPAD_release(Sim_ContextType *ctx,Sim_KeypadType *keypad);
+
+/* HD44780 LCD, sim_lcd.c */
+void SIM_LCD_init(Sim_LcdType *lcd);
+void SIM_LCD_update(Sim_ContextType *ctx,Sim_LcdType *lcd);
+void SIM_LCD_getRow(const Sim_LcdType *lcd,uint8 row,char *text);
+boolean SIM_LCD_contains(const Sim_LcdType *lcd,const char *text);
+
+/* DC motor, sim_motor.c */
+void SIM_MOTOR_init(Sim_MotorType *motor);
+void SIM_MOTOR_update(Sim_ContextType *ctx,Sim_MotorType *motor);
+boolean SIM_MOTOR_isOpened(const Sim_MotorType *motor);
+boolean SIM_MOTOR_isClosed(const Sim_MotorType *motor);
+
+/* buzzer, sim_buzzer.c */
+void SIM_BUZZER_update(Sim_ContextType *ctx,Sim_BuzzerType *buzzer);
+
+/*******************************************************************************
+* Function Name:		SIM_LINK_connect
+* Description:			Function to wire the UARTs of two MCUs together
+* Parameters (in):    	Link, the two MCUs and the error of the clock of the first one
+* 						against the second one in ppm
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_LINK_connect(Sim_LinkType *link,Sim_ContextType *mcu1,Sim_ContextType *mcu2,sint32 errorPpm);
+
+/*******************************************************************************
+* Function Name:		SIM_LINK_run
+* Description:			Function to run the two MCUs up to a cycle, it returns earlier when a
+* 						model asked for it with SIM_yield
+* Parameters (in):    	Link and the cycle to stop at
+* Parameters (out):   	FALSE if one MCU stopped for good
+* Return value:      	boolean
+********************************************************************************/
+boolean SIM_LINK_run(Sim_LinkType *link,uint64 until);
+
+/*******************************************************************************
+* Function Name:		SIM_BOARD_init
+* Description:			Function to build the door lock with the two firmwares, the pins of
+* 						the models are the ones in the headers of the firmwares
+* Parameters (in):    	Board and the error of the clock of MCU1 against MCU2 in ppm
+* Parameters (out):   	SUCCESS or ERROR if a context couldn't be set up
+* Return value:      	uint8
+********************************************************************************/
+uint8 SIM_BOARD_init(Sim_BoardType *board,sint32 errorPpm);
+
+/*******************************************************************************
+* Function Name:		SIM_BOARD_initMcu2
+* Description:			Function to build only MCU2 with the EEPROM, the motor and the buzzer on a
+* 						board cleared to 0, its UART isn't wired to anything
+* Parameters (in):    	Board
+* Parameters (out):   	SUCCESS or ERROR if the context couldn't be set up
+* Return value:      	uint8
+********************************************************************************/
+uint8 SIM_BOARD_initMcu2(Sim_BoardType *board);
+
+/*******************************************************************************
+* Function Name:		SIM_BOARD_deinit
+* Description:			Function to free the two contexts of the board
+* Parameters (in):    	Board
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+void SIM_BOARD_deinit(Sim_BoardType *board);
+
+#endif /* HOST_SIM_SIM_BOARD_H_ */
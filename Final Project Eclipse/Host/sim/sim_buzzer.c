@@ -0,0 +1,35 @@
+/******************************************************************************
+*  File name:		sim_buzzer.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_BUZZER_update(Sim_ContextType *ctx,Sim_BuzzerType *buzzer)
+{
+	boolean on = (SIM_GPIO_getOutput(ctx, buzzer->port) & (1<<buzzer->pin)) ? TRUE : FALSE;
+
+	if(on == buzzer->on)
+		return;
+
+	if(on)
+	{
+		buzzer->beeps++;
+	}
+	else
+	{
+		buzzer->onCycles += ctx->cycles - buzzer->lastChange;
+	}
+	buzzer->on = on;
+	buzzer->lastChange = ctx->cycles;
+	SIM_yield(ctx);
+}
@@ -0,0 +1,564 @@
+/******************************************************************************
+*  File name:		sim_door.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Runs the whole door lock : MCU1 and MCU2 with the keypad, the LCD, the EEPROM,
+ * the motor and the buzzer, driven by a script like a user would. The lines of
+ * the script after "loop" are run again for every cycle, the statistics are then
+ * written to stderr as key=value lines and the exit status is 1 if a step failed.
+ *
+ *   door [-t seconds] [-c cycles] [-d ms] [-e eeprom.bin] [-p ppm] [-n] [-q] [-v] [script]
+ *
+ *   -t  virtual time limit of a step, 60 s by default
+ *   -c  times the lines after "loop" are run, 1 by default
+ *   -d  MCU1 comes out of reset this late, 100 ms by default. MCU2 reads its EEPROM
+ *       before it turns its UART on, about 60 ms, and a MC_Ready sent before that
+ *       is lost : with -d 0 both MCUs wait for each other forever
+ *   -e  EEPROM image, loaded if it exists and saved at the end
+ *   -p  error of the clock of MCU1 against MCU2 in ppm
+ *   -n  run the loops that wait for a peripheral instead of skipping them
+ *   -q  no statistics
+ *   -v  every step on stdout with its virtual time
+ *
+ * Script lines, # starts a comment :
+ *
+ *   wait <text>           until the LCD shows the text
+ *   key <keys>            press and let go the keys one after the other, C is ON/C
+ *   delay <ms>            let the board run
+ *   door opened|closed    until the bolt is at that end
+ *   buzzer on|off         until the buzzer is on or off
+ *   jam <percent>|none    the bolt gets stuck at that part of its travel
+ *   print                 the LCD on stdout
+ *   loop                  the lines after it make one cycle
+ *
+ * Without a script every cycle opens the door with the password 1234 and waits
+ * for it to be locked again, the password is set first on a blank EEPROM.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define DOOR_DEFAULT_STEP_SECONDS	60
+#define DOOR_DEFAULT_MCU1_DELAY_MS	100
+#define DOOR_MAX_LINES				256
+#define DOOR_LINE_SIZE				128
+#define DOOR_KEY_HOLD_MS			50		/* a key is let go this long after MCU1 saw it */
+#define DOOR_KEY_GAP_MS				50
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Door_ConditionType
+* Type: Function pointer
+* Description: What a step waits for, TRUE once it happened
+********************************************************************************/
+typedef boolean (*Door_ConditionType)(const char *argument);
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static Sim_BoardType g_doorBoard;
+static uint64 g_doorStepCycles;
+static boolean g_doorVerbose = FALSE;
+static char g_doorLines[DOOR_MAX_LINES][DOOR_LINE_SIZE];
+static uint16 g_doorNumLines = 0;
+
+static const char *const g_doorSetupScript[] =
+{
+	"wait Plz Enter Pass",
+	"key 1234C",
+	"wait Re-Enter Pass",
+	"key 1234C",
+	"wait Password Updated",
+};
+
+static const char *const g_doorCycleScript[] =
+{
+	"loop",
+	"wait + : Open Door",
+	"key +",
+	"wait Plz Enter Pass:",
+	"key 1234C",
+	"wait Unlocking",
+	"door opened",
+	"wait Door Is Locked",
+	"wait Locking",
+	"door closed",
+	"wait + : Open Door",
+};
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static boolean DOOR_loadScript(const char *path);
+static void DOOR_addLine(const char *line);
+static boolean DOOR_step(const char *line);
+static boolean DOOR_runUntil(Door_ConditionType condition,const char *argument,uint64 end);
+static boolean DOOR_wait(Door_ConditionType condition,const char *argument);
+static boolean DOOR_delay(uint32 ms);
+static boolean DOOR_typeKey(char key);
+static boolean DOOR_isShown(const char *text);
+static boolean DOOR_isKeySeen(const char *argument);
+static boolean DOOR_isOpened(const char *argument);
+static boolean DOOR_isClosed(const char *argument);
+static boolean DOOR_isBuzzerOn(const char *argument);
+static boolean DOOR_isBuzzerOff(const char *argument);
+static void DOOR_print(void);
+static void DOOR_report(uint32 cycles,uint64 cycleStart,double hostSeconds,boolean passed);
+static void DOOR_reportMcu(const Sim_ContextType *ctx);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(int argc,char **argv)
+{
+	const char *eepromPath = NULL_PTR;
+	uint32 cycles = 1;
+	uint32 done = 0;
+	uint32 mcu1Delay = DOOR_DEFAULT_MCU1_DELAY_MS;
+	sint32 errorPpm = 0;
+	boolean quiet = FALSE;
+	boolean skipLoops = TRUE;
+	boolean blank = TRUE;
+	boolean passed = TRUE;
+	uint16 loopLine = 0;
+	uint64 cycleStart;
+	struct timespec start, end;
+	int option;
+
+	g_doorStepCycles = SIM_MS_TO_CYCLES(DOOR_DEFAULT_STEP_SECONDS * 1000UL);
+	while((option = getopt(argc, argv, "t:c:d:e:p:nqv")) != -1)
+	{
+		switch(option)
+		{
+		case 't': g_doorStepCycles = (uint64)(atof(optarg) * SIM_F_CPU); break;
+		case 'c': cycles = (uint32)atol(optarg); break;
+		case 'd': mcu1Delay = (uint32)atol(optarg); break;
+		case 'e': eepromPath = optarg; break;
+		case 'p': errorPpm = (sint32)atol(optarg); break;
+		case 'n': skipLoops = FALSE; break;
+		case 'q': quiet = TRUE; break;
+		case 'v': g_doorVerbose = TRUE; break;
+		default:
+			fprintf(stderr, "usage: %s [-t seconds] [-c cycles] [-d ms] [-e eeprom.bin] [-p ppm] [-n] [-q] [-v] [script]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if(SIM_BOARD_init(&g_doorBoard, errorPpm) == ERROR)
+	{
+		fprintf(stderr, "%s: no memory for the stacks\n", argv[0]);
+		return 1;
+	}
+	g_doorBoard.mcu1.skipLoops = skipLoops;
+	g_doorBoard.mcu2.skipLoops = skipLoops;
+	g_doorBoard.mcu1.cycles = SIM_MS_TO_CYCLES(mcu1Delay); /* the link runs MCU2 alone up to there */
+	if( (eepromPath != NULL_PTR) && SIM_EEPROM_load(&g_doorBoard.eeprom, eepromPath) )
+	{
+		blank = FALSE;
+	}
+
+	if(optind < argc)
+	{
+		if(DOOR_loadScript(argv[optind]) == FALSE)
+		{
+			fprintf(stderr, "%s: can't read %s\n", argv[0], argv[optind]);
+			SIM_BOARD_deinit(&g_doorBoard);
+			return 1;
+		}
+	}
+	else
+	{
+		for(uint16 i = 0 ; blank && (i < sizeof(g_doorSetupScript) / sizeof(g_doorSetupScript[0])) ; i++)
+		{
+			DOOR_addLine(g_doorSetupScript[i]);
+		}
+		for(uint16 i = 0 ; i < sizeof(g_doorCycleScript) / sizeof(g_doorCycleScript[0]) ; i++)
+		{
+			DOOR_addLine(g_doorCycleScript[i]);
+		}
+	}
+	for(uint16 i = 0 ; i < g_doorNumLines ; i++)
+	{
+		if(strcmp(g_doorLines[i], "loop") == 0)
+		{
+			loopLine = (uint16)(i + 1);
+			break;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	/* the lines before the loop then the cycles */
+	for(uint16 i = 0 ; passed && (i < g_doorNumLines) && ( (loopLine == 0) || (i < loopLine) ) ; i++)
+	{
+		passed = DOOR_step(g_doorLines[i]);
+	}
+	cycleStart = g_doorBoard.link.cycles;
+	while( passed && (loopLine != 0) && (done < cycles) )
+	{
+		for(uint16 i = loopLine ; passed && (i < g_doorNumLines) ; i++)
+		{
+			passed = DOOR_step(g_doorLines[i]);
+		}
+		if(passed)
+		{
+			done++;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	fflush(stdout);
+
+	if( (eepromPath != NULL_PTR) && (SIM_EEPROM_save(&g_doorBoard.eeprom, eepromPath) == FALSE) )
+	{
+		fprintf(stderr, "%s: can't write %s\n", argv[0], eepromPath);
+	}
+	if(quiet == FALSE)
+	{
+		DOOR_report(done, cycleStart, (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9, passed);
+	}
+	SIM_BOARD_deinit(&g_doorBoard);
+	return passed ? 0 : 1;
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_loadScript
+* Description:			Function to read the lines of a script, without the comments and the blanks
+* Parameters (in):    	Path of the script
+* Parameters (out):   	FALSE if it can't be read
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean DOOR_loadScript(const char *path)
+{
+	char line[DOOR_LINE_SIZE];
+	FILE *file = fopen(path, "r");
+
+	if(file == NULL_PTR)
+		return FALSE;
+	while(fgets(line, sizeof(line), file) != NULL_PTR)
+	{
+		char *comment = strchr(line, '#');
+		char *last;
+		char *first = line;
+
+		if(comment != NULL_PTR)
+		{
+			*comment = '\0';
+		}
+		last = line + strlen(line);
+		while( (last > line) && ((last[-1] == '\n') || (last[-1] == '\r') || (last[-1] == ' ') || (last[-1] == '\t')) )
+		{
+			*--last = '\0';
+		}
+		while( (*first == ' ') || (*first == '\t') )
+		{
+			first++;
+		}
+		if(*first != '\0')
+		{
+			DOOR_addLine(first);
+		}
+	}
+	fclose(file);
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_addLine
+* Description:			Function to add a line at the end of the script
+* Parameters (in):    	Line
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DOOR_addLine(const char *line)
+{
+	if(g_doorNumLines < DOOR_MAX_LINES)
+	{
+		strncpy(g_doorLines[g_doorNumLines], line, DOOR_LINE_SIZE - 1);
+		g_doorNumLines++;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_step
+* Description:			Function to run one line of the script
+* Parameters (in):    	Line
+* Parameters (out):   	FALSE if the step failed or timed out
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean DOOR_step(const char *line)
+{
+	const char *argument = strchr(line, ' ');
+	size_t length = (argument != NULL_PTR) ? (size_t)(argument - line) : strlen(line);
+	boolean done = FALSE;
+
+	argument = (argument != NULL_PTR) ? (argument + 1) : "";
+	if(g_doorVerbose)
+	{
+		printf("%.3f %s\n", (double)g_doorBoard.link.cycles * 1000.0 / SIM_F_CPU, line);
+	}
+
+	if(strncmp(line, "wait", length) == 0)
+	{
+		done = DOOR_wait(DOOR_isShown, argument);
+	}
+	else if(strncmp(line, "key", length) == 0)
+	{
+		done = TRUE;
+		for(const char *key = argument ; done && (*key != '\0') ; key++)
+		{
+			if(*key != ' ')
+			{
+				done = DOOR_typeKey(*key);
+			}
+		}
+	}
+	else if(strncmp(line, "delay", length) == 0)
+	{
+		done = DOOR_delay((uint32)atol(argument));
+	}
+	else if(strncmp(line, "door", length) == 0)
+	{
+		done = DOOR_wait((strcmp(argument, "opened") == 0) ? DOOR_isOpened : DOOR_isClosed, argument);
+	}
+	else if(strncmp(line, "buzzer", length) == 0)
+	{
+		done = DOOR_wait((strcmp(argument, "on") == 0) ? DOOR_isBuzzerOn : DOOR_isBuzzerOff, argument);
+	}
+	else if(strncmp(line, "jam", length) == 0)
+	{
+		g_doorBoard.motor.jamAt = (strcmp(argument, "none") == 0) ? SIM_MOTOR_NO_JAM
+				: (sint32)((atof(argument) * SIM_MOTOR_TRAVEL) / 100.0);
+		done = TRUE;
+	}
+	else if(strncmp(line, "print", length) == 0)
+	{
+		DOOR_print();
+		done = TRUE;
+	}
+	else if(strncmp(line, "loop", length) == 0)
+	{
+		done = TRUE;
+	}
+	else
+	{
+		fprintf(stderr, "unknown step: %s\n", line);
+		return FALSE;
+	}
+
+	if(done == FALSE)
+	{
+		fprintf(stderr, "failed step at %.3f ms: %s\n", (double)g_doorBoard.link.cycles * 1000.0 / SIM_F_CPU, line);
+		DOOR_print();
+	}
+	return done;
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_runUntil
+* Description:			Function to run the board until a condition is met or up to a cycle,
+* 						the models stop the run as soon as something changes
+* Parameters (in):    	Condition or NULL_PTR to only run, its argument and the last cycle
+* Parameters (out):   	TRUE once the condition is met, or at the last cycle without one.
+* 						FALSE if an MCU stopped
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean DOOR_runUntil(Door_ConditionType condition,const char *argument,uint64 end)
+{
+	while( (condition == NULL_PTR) || (condition(argument) == FALSE) )
+	{
+		if(g_doorBoard.link.cycles >= end)
+			return (condition == NULL_PTR) ? TRUE : FALSE;
+		if(SIM_LINK_run(&g_doorBoard.link, end) == FALSE)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_wait
+* Description:			Function to run the board until a condition is met
+* Parameters (in):    	Condition and its argument
+* Parameters (out):   	FALSE at the time limit of a step or if an MCU stopped
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean DOOR_wait(Door_ConditionType condition,const char *argument)
+{
+	return DOOR_runUntil(condition, argument, g_doorBoard.link.cycles + g_doorStepCycles);
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_delay
+* Description:			Function to let the board run for a time
+* Parameters (in):    	Time in ms
+* Parameters (out):   	FALSE if an MCU stopped
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean DOOR_delay(uint32 ms)
+{
+	return DOOR_runUntil(NULL_PTR, NULL_PTR, g_doorBoard.link.cycles + SIM_MS_TO_CYCLES(ms));
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_typeKey
+* Description:			Function to press a key until MCU1 saw it, hold it a bit and let it go
+* Parameters (in):    	Key, as printed on the keypad
+* Parameters (out):   	FALSE if the key doesn't exist or MCU1 never read it
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean DOOR_typeKey(char key)
+{
+	if(SIM_KEYPAD_press(&g_doorBoard.mcu1, &g_doorBoard.keypad, key) == FALSE)
+		return FALSE;
+	if( (DOOR_wait(DOOR_isKeySeen, NULL_PTR) == FALSE) || (DOOR_delay(DOOR_KEY_HOLD_MS) == FALSE) )
+		return FALSE;
+	SIM_KEYPAD_release(&g_doorBoard.mcu1, &g_doorBoard.keypad);
+	return DOOR_delay(DOOR_KEY_GAP_MS);
+}
+
+/*******************************************************************************
+*                      Conditions of the steps                                 *
+*******************************************************************************/
+
+static boolean DOOR_isShown(const char *text)
+{
+	return SIM_LCD_contains(&g_doorBoard.lcd, text);
+}
+
+static boolean DOOR_isKeySeen(const char *argument)
+{
+	(void)argument;
+	return g_doorBoard.keypad.seen;
+}
+
+static boolean DOOR_isOpened(const char *argument)
+{
+	(void)argument;
+	return SIM_MOTOR_isOpened(&g_doorBoard.motor);
+}
+
+static boolean DOOR_isClosed(const char *argument)
+{
+	(void)argument;
+	return SIM_MOTOR_isClosed(&g_doorBoard.motor);
+}
+
+static boolean DOOR_isBuzzerOn(const char *argument)
+{
+	(void)argument;
+	return g_doorBoard.buzzer.on;
+}
+
+static boolean DOOR_isBuzzerOff(const char *argument)
+{
+	(void)argument;
+	return g_doorBoard.buzzer.on ? FALSE : TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_print
+* Description:			Function to write what the LCD shows to stdout
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DOOR_print(void)
+{
+	char row[SIM_LCD_ROWS][SIM_LCD_COLUMNS + 1];
+
+	for(uint8 i = 0 ; i < SIM_LCD_ROWS ; i++)
+	{
+		SIM_LCD_getRow(&g_doorBoard.lcd, i, row[i]);
+	}
+	printf("%.3f |%s|%s|%s\n", (double)g_doorBoard.link.cycles * 1000.0 / SIM_F_CPU, row[0], row[1],
+			g_doorBoard.lcd.displayOn ? "" : " off");
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_report
+* Description:			Function to write the statistics of the run to stderr
+* Parameters (in):    	Cycles run, cycle the first one started, host time of the run and
+* 						TRUE if every step passed
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DOOR_report(uint32 cycles,uint64 cycleStart,double hostSeconds,boolean passed)
+{
+	const Sim_BoardType *board = &g_doorBoard;
+	double virtualSeconds = (double)board->link.cycles / SIM_F_CPU;
+
+	fprintf(stderr, "result=%s\n", passed ? "pass" : "fail");
+	fprintf(stderr, "cycles=%lu\n", (unsigned long)cycles);
+	fprintf(stderr, "virtual_ms=%.3f\n", virtualSeconds * 1000.0);
+	fprintf(stderr, "host_ms=%.3f\n", hostSeconds * 1000.0);
+	fprintf(stderr, "speedup=%.1f\n", (hostSeconds > 0) ? (virtualSeconds / hostSeconds) : 0.0);
+	if(cycles != 0)
+	{
+		fprintf(stderr, "cycle_virtual_ms=%.3f\n", (double)(board->link.cycles - cycleStart) * 1000.0 / SIM_F_CPU / cycles);
+		fprintf(stderr, "cycle_host_ms=%.3f\n", hostSeconds * 1000.0 / cycles);
+	}
+	fprintf(stderr, "link_turns=%lu\n", (unsigned long)board->link.turns);
+	fprintf(stderr, "keypad_presses=%lu\n", (unsigned long)board->keypad.presses);
+	fprintf(stderr, "lcd_commands=%lu\n", (unsigned long)board->lcd.commands);
+	fprintf(stderr, "lcd_characters=%lu\n", (unsigned long)board->lcd.characters);
+	fprintf(stderr, "lcd_too_early=%lu\n", (unsigned long)board->lcd.tooEarly);
+	fprintf(stderr, "eeprom_page_writes=%lu\n", (unsigned long)board->eeprom.pageWrites);
+	fprintf(stderr, "eeprom_bytes_written=%lu\n", (unsigned long)board->eeprom.bytesWritten);
+	fprintf(stderr, "eeprom_bytes_read=%lu\n", (unsigned long)board->eeprom.bytesRead);
+	fprintf(stderr, "eeprom_busy_nacks=%lu\n", (unsigned long)board->eeprom.busyNacks);
+	fprintf(stderr, "motor_moves=%lu\n", (unsigned long)board->motor.moves);
+	fprintf(stderr, "motor_running_ms=%.3f\n", (double)board->motor.runningCycles * 1000.0 / SIM_F_CPU);
+	fprintf(stderr, "motor_stalled_ms=%.3f\n", (double)board->motor.stalledCycles * 1000.0 / SIM_F_CPU);
+	fprintf(stderr, "buzzer_beeps=%lu\n", (unsigned long)board->buzzer.beeps);
+	fprintf(stderr, "buzzer_on_ms=%.3f\n", (double)board->buzzer.onCycles * 1000.0 / SIM_F_CPU);
+	DOOR_reportMcu(&board->mcu1);
+	DOOR_reportMcu(&board->mcu2);
+}
+
+/*******************************************************************************
+* Function Name:		DOOR_reportMcu
+* Description:			Function to write the statistics of one MCU to stderr
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DOOR_reportMcu(const Sim_ContextType *ctx)
+{
+	fprintf(stderr, "%s.accesses=%llu\n", ctx->name, (unsigned long long)ctx->stats.accesses);
+	fprintf(stderr, "%s.delay_ms=%.3f\n", ctx->name, (double)ctx->stats.delayCycles * 1000.0 / SIM_F_CPU);
+	fprintf(stderr, "%s.skipped_ms=%.3f\n", ctx->name, (double)ctx->stats.skippedCycles * 1000.0 / SIM_F_CPU);
+	fprintf(stderr, "%s.skips=%llu\n", ctx->name, (unsigned long long)ctx->stats.skips);
+	fprintf(stderr, "%s.uart_tx_bytes=%lu\n", ctx->name, (unsigned long)ctx->uart.txBytes);
+	fprintf(stderr, "%s.uart_frame_errors=%lu\n", ctx->name, (unsigned long)ctx->uart.frameErrors);
+	fprintf(stderr, "%s.uart_overruns=%lu\n", ctx->name, (unsigned long)ctx->uart.overruns);
+	fprintf(stderr, "%s.int_eeprom_writes=%lu\n", ctx->name, (unsigned long)ctx->intEeprom.writes);
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+*  File name:		sim_eeprom.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * 24Cxx serial EEPROM. Up to the 24C16 the word address is one byte and the
+ * high address bits are the low bits of the device address, the bigger chips
+ * take two address bytes. A write only fills the page buffer, the bytes are
+ * programmed at the STOP and the address counter rolls over inside the page.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static boolean SIM_EEPROM_start(Sim_TwiDeviceType *device,uint8 sla,uint64 cycle);
+static boolean SIM_EEPROM_write(Sim_TwiDeviceType *device,uint8 byte,uint64 cycle);
+static uint8 SIM_EEPROM_read(Sim_TwiDeviceType *device,boolean ack,uint64 cycle);
+static void SIM_EEPROM_stop(Sim_TwiDeviceType *device,uint64 cycle);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_EEPROM_init(Sim_EepromType *eeprom,uint16 size,uint8 pageSize,uint8 address)
+{
+	memset(eeprom, 0, sizeof(*eeprom));
+	memset(eeprom->memory, 0xFF, sizeof(eeprom->memory)); /* erased */
+	eeprom->size = size;
+	eeprom->pageSize = pageSize;
+	eeprom->addressBytes = (size > 2048) ? 2 : 1;
+	eeprom->device.address = address;
+	eeprom->device.mask = (eeprom->addressBytes == 1) ? (uint8)((size - 1) >> 8) : 0;
+	eeprom->device.start = SIM_EEPROM_start;
+	eeprom->device.write = SIM_EEPROM_write;
+	eeprom->device.read = SIM_EEPROM_read;
+	eeprom->device.stop = SIM_EEPROM_stop;
+	eeprom->device.state = eeprom;
+}
+
+boolean SIM_EEPROM_load(Sim_EepromType *eeprom,const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	if(file == NULL_PTR)
+		return FALSE;
+	(void)fread(eeprom->memory, 1, eeprom->size, file); /* a shorter image leaves the end erased */
+	fclose(file);
+	return TRUE;
+}
+
+boolean SIM_EEPROM_save(const Sim_EepromType *eeprom,const char *path)
+{
+	FILE *file = fopen(path, "wb");
+	boolean done;
+	if(file == NULL_PTR)
+		return FALSE;
+	done = (fwrite(eeprom->memory, 1, eeprom->size, file) == eeprom->size) ? TRUE : FALSE;
+	fclose(file);
+	return done;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_EEPROM_start
+* Description:			Function to answer the device address, not while a write cycle runs
+* Parameters (in):    	Device, SLA+R/W and the cycle
+* Parameters (out):   	TRUE to acknowledge
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean SIM_EEPROM_start(Sim_TwiDeviceType *device,uint8 sla,uint64 cycle)
+{
+	Sim_EepromType *eeprom = device->state;
+	uint16 block = (uint16)(((sla >> 1) & device->mask) << 8);
+
+	if(cycle < eeprom->busyUntil)
+	{
+		eeprom->busyNacks++;
+		return FALSE;
+	}
+	if(eeprom->addressBytes == 1)
+	{
+		eeprom->address = (uint16)(block | (eeprom->address & 0xFF));
+	}
+	if((sla & 0x01) == 0)
+	{
+		eeprom->addressReceived = 0;
+		eeprom->writing = FALSE;
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_EEPROM_write
+* Description:			Function to receive the word address then the bytes for the page buffer
+* Parameters (in):    	Device, the byte and the cycle
+* Parameters (out):   	TRUE to acknowledge
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean SIM_EEPROM_write(Sim_TwiDeviceType *device,uint8 byte,uint64 cycle)
+{
+	Sim_EepromType *eeprom = device->state;
+	uint8 mask = (uint8)(eeprom->pageSize - 1);
+	(void)cycle;
+
+	if(eeprom->addressReceived < eeprom->addressBytes)
+	{
+		if( (eeprom->addressBytes == 2) && (eeprom->addressReceived == 0) )
+		{
+			eeprom->address = (uint16)(byte << 8);
+		}
+		else
+		{
+			eeprom->address = (uint16)((eeprom->address & 0xFF00) | byte);
+		}
+		eeprom->address &= (uint16)(eeprom->size - 1);
+		eeprom->addressReceived++;
+		return TRUE;
+	}
+
+	eeprom->page[eeprom->address & mask] = byte;
+	eeprom->pageWritten[eeprom->address & mask] = TRUE;
+	eeprom->address = (uint16)((eeprom->address & ~(uint16)mask) | ((eeprom->address + 1) & mask));
+	eeprom->writing = TRUE;
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_EEPROM_read
+* Description:			Function to send the byte at the address counter, it rolls over at the end
+* Parameters (in):    	Device, TRUE if the master acknowledges and the cycle
+* Parameters (out):   	The byte
+* Return value:      	uint8
+********************************************************************************/
+
+static uint8 SIM_EEPROM_read(Sim_TwiDeviceType *device,boolean ack,uint64 cycle)
+{
+	Sim_EepromType *eeprom = device->state;
+	uint8 byte = eeprom->memory[eeprom->address];
+	(void)ack;
+	(void)cycle;
+
+	eeprom->address = (uint16)((eeprom->address + 1) & (eeprom->size - 1));
+	eeprom->bytesRead++;
+	return byte;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_EEPROM_stop
+* Description:			Function to program the page buffer after a write, the chip is busy
+* 						for tWR from the STOP
+* Parameters (in):    	Device and the cycle
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_EEPROM_stop(Sim_TwiDeviceType *device,uint64 cycle)
+{
+	Sim_EepromType *eeprom = device->state;
+	uint16 base = eeprom->address & ~(uint16)(eeprom->pageSize - 1);
+
+	if(eeprom->writing == FALSE)
+		return;
+
+	for(uint8 i = 0 ; i < eeprom->pageSize ; i++)
+	{
+		if(eeprom->pageWritten[i])
+		{
+			eeprom->memory[base + i] = eeprom->page[i];
+			eeprom->pageWritten[i] = FALSE;
+			eeprom->bytesWritten++;
+		}
+	}
+	eeprom->writing = FALSE;
+	eeprom->pageWrites++;
+	eeprom->busyUntil = cycle + SIM_MS_TO_CYCLES(SIM_EEPROM_WRITE_MS);
+}
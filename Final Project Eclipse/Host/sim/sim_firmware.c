@@ -0,0 +1,52 @@
+/******************************************************************************
+*  File name:		sim_firmware.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Built next to every firmware : its main is renamed FIRMWARE_main by the
+ * Makefile and ISR(x_vect) defines __vector_N, the vectors it doesn't have
+ * stay NULL_PTR. The firmware and this file are linked into one object where
+ * only SIM_FIRMWARE_SYMBOL stays global, so several firmwares with the same
+ * function names can be linked in one program.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+
+#if !defined(SIM_FIRMWARE_NAME) || !defined(SIM_FIRMWARE_SYMBOL)
+#error "SIM_FIRMWARE_NAME and SIM_FIRMWARE_SYMBOL must be defined to the name of the firmware"
+#endif
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SIM_VECTOR(n)	extern void __vector_##n(void) __attribute__((weak));
+
+SIM_VECTOR(1) SIM_VECTOR(2) SIM_VECTOR(3) SIM_VECTOR(4) SIM_VECTOR(5)
+SIM_VECTOR(6) SIM_VECTOR(7) SIM_VECTOR(8) SIM_VECTOR(9) SIM_VECTOR(10)
+SIM_VECTOR(11) SIM_VECTOR(12) SIM_VECTOR(13) SIM_VECTOR(14) SIM_VECTOR(15)
+SIM_VECTOR(16) SIM_VECTOR(17) SIM_VECTOR(18) SIM_VECTOR(19) SIM_VECTOR(20)
+
+extern int FIRMWARE_main(void);
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+const Sim_FirmwareType SIM_FIRMWARE_SYMBOL =
+{
+	SIM_FIRMWARE_NAME,
+	FIRMWARE_main,
+	{
+		NULL_PTR, __vector_1, __vector_2, __vector_3, __vector_4, __vector_5,
+		__vector_6, __vector_7, __vector_8, __vector_9, __vector_10,
+		__vector_11, __vector_12, __vector_13, __vector_14, __vector_15,
+		__vector_16, __vector_17, __vector_18, __vector_19, __vector_20
+	}
+};
@@ -0,0 +1,1135 @@
+/******************************************************************************
+*  File name:		sim_fleet.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Fleet of door locks : runs N boards, each with its own MCU1, MCU2, EEPROM and
+ * bolt, for a virtual time and sends what their users do to a central controller.
+ * Every door boots from a blank EEPROM, its user sets a password of 4 digits then
+ * opens the door about -u times an hour, -x percent of the times after one wrong
+ * password.
+ *
+ * The firmwares keep their state in globals so one process can only run one door
+ * at a time. The workers are processes forked after the doors were built in one
+ * shared mapping : the boards, the stacks of their MCUs and a copy of the RAM of
+ * both firmwares. The mapping and the code are at the same addresses in every
+ * worker, so any worker can run any door once it copied its RAM in the sections
+ * of the firmwares (renamed by the Makefile like for load). A worker takes a door
+ * from the head of its own queue, runs it for one slice of -s seconds and puts it
+ * back at the tail, a worker with an empty queue steals the door at the head of
+ * another one.
+ *
+ * Every door and every MCU has its own clock, there is no global one. A door may
+ * only run its slice if the slowest door is less than -l slices behind, which
+ * bounds how late an event can reach the controller. The controller is the parent
+ * process : it takes the events of all workers from one queue in shared memory and
+ * spends -c us on each, when it can't keep up the queue fills and the workers wait.
+ *
+ *   fleet [-n doors] [-w workers] [-t hours] [-s seconds] [-l slices] [-u sessions]
+ *         [-k ms] [-x percent] [-c us] [-S seed] [-q] [-v]
+ *
+ *   -n  doors, 100 by default
+ *   -w  worker processes, one per CPU by default
+ *   -t  virtual hours every door runs, 24 by default
+ *   -s  virtual seconds of a slice, 60 by default
+ *   -l  slices a door may run ahead of the slowest one, 2 by default
+ *   -u  average sessions of the user of a door in an hour, 4 by default
+ *   -k  average time from a key let go to the next one pressed, 300 ms by default
+ *   -x  percent of the sessions that start with a wrong password, 10 by default
+ *   -c  host time the controller spends on an event, 0 us by default
+ *   -S  seed of the random numbers, 1 by default
+ *   -q  no statistics
+ *   -v  every event the controller gets on stdout with its virtual time
+ *
+ * The report is written to stderr as key=value lines : the door hours simulated
+ * per host second, the work of every worker, and the events, load, queue and late
+ * events of the controller. The exit status is 1 if a session got stuck or a
+ * worker didn't end.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define FLEET_DEFAULT_DOORS			100
+#define FLEET_DEFAULT_HOURS			24
+#define FLEET_DEFAULT_SLICE_SECONDS	60
+#define FLEET_DEFAULT_LAG			2
+#define FLEET_DEFAULT_SESSIONS		4		/* an hour */
+#define FLEET_DEFAULT_KEY_MS		300
+#define FLEET_DEFAULT_TYPO_PERCENT	10
+#define FLEET_MAX_WORKERS			256
+#define FLEET_MAX_LAG				64
+#define FLEET_COMPLETED_SIZE		(FLEET_MAX_LAG + 1)	/* slices that can be in progress */
+#define FLEET_QUEUE_SIZE			65536	/* events, a power of 2 */
+#define FLEET_MCU1_DELAY_MS			100		/* MCU1 comes out of reset after MCU2, see door -d */
+#define FLEET_KEY_HOLD_MS			80		/* average, a key is let go this long after MCU1 saw it */
+#define FLEET_STEP_SECONDS			60		/* a screen that doesn't come by then is a stuck session */
+#define FLEET_DIGITS				4
+#define FLEET_MAX_STEPS				24
+#define FLEET_NO_EVENT				0xFF
+#define FLEET_PAGE_SIZE				4096
+#define FLEET_NUM_SECTIONS			6		/* .data, .bss and .noinit of both firmwares */
+#define FLEET_IDLE_NS				200000	/* the controller sleeps this long on an empty queue */
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Fleet_EventKindType
+* Type: Enumeration
+* Description: What a door tells the controller
+********************************************************************************/
+typedef enum
+{
+	FLEET_READY,		/* the first password is set */
+	FLEET_UNLOCK,
+	FLEET_WRONG,		/* a wrong password was refused */
+	FLEET_STUCK,		/* a screen didn't come, the session was dropped */
+	FLEET_NUM_EVENTS
+}Fleet_EventKindType;
+
+/*******************************************************************************
+* Name: Fleet_TextType
+* Type: Enumeration
+* Description: Screens the user waits for, in g_fleetTexts
+********************************************************************************/
+typedef enum
+{
+	FLEET_MENU,
+	FLEET_PROMPT,
+	FLEET_REENTER,
+	FLEET_UNMATCHED,
+	FLEET_UNLOCKING,
+	FLEET_OPENED,
+	FLEET_LOCKING
+}Fleet_TextType;
+
+/*******************************************************************************
+* Name: Fleet_PhaseType
+* Type: Enumeration
+* Description: Where the user is in pressing a key
+********************************************************************************/
+typedef enum
+{
+	FLEET_PRESS,
+	FLEET_SEEN,			/* pressed, MCU1 didn't read it yet */
+	FLEET_HOLD,
+	FLEET_GAP			/* let go, the next key isn't pressed yet */
+}Fleet_PhaseType;
+
+/*******************************************************************************
+* Name: Fleet_EventType
+* Type: Structure
+* Description: Event of a door with its virtual time
+********************************************************************************/
+typedef struct
+{
+	uint64 cycle;
+	uint32 door;
+	uint8 kind;
+}Fleet_EventType;
+
+/*******************************************************************************
+* Name: Fleet_CellType
+* Type: Structure
+* Description: Cell of the queue of the controller, its sequence says if it is
+* 			   free or holds an event for the position it has
+********************************************************************************/
+typedef struct
+{
+	uint64 sequence;
+	Fleet_EventType event;
+}Fleet_CellType;
+
+/*******************************************************************************
+* Name: Fleet_SectionType
+* Type: Structure
+* Description: Section of the RAM of a firmware
+********************************************************************************/
+typedef struct
+{
+	uint8 *start;
+	uint8 *stop;
+}Fleet_SectionType;
+
+/*******************************************************************************
+* Name: Fleet_StepType
+* Type: Structure
+* Description: One step of a session, a key or a screen to wait for
+********************************************************************************/
+typedef struct
+{
+	char key;			/* '\0' to wait for the screen */
+	uint8 text;			/* Fleet_TextType */
+	uint8 event;		/* sent once the step is done, FLEET_NO_EVENT if none */
+}Fleet_StepType;
+
+/*******************************************************************************
+* Name: Fleet_DoorType
+* Type: Structure
+* Description: A door in the shared mapping, the RAM of the firmwares follows it
+* 			   then the stacks of MCU1 and MCU2
+********************************************************************************/
+typedef struct
+{
+	Sim_BoardType board;
+	/* user */
+	Fleet_StepType steps[FLEET_MAX_STEPS];
+	uint8 numSteps;		/* 0 between two sessions */
+	uint8 step;
+	uint8 phase;		/* Fleet_PhaseType */
+	uint64 wakeAt;		/* end of the hold or of the gap of a key */
+	uint64 deadline;	/* of the step */
+	uint64 nextSession;
+	uint32 random;
+	char password[FLEET_DIGITS + 1];
+	/* progress */
+	uint32 slices;		/* slices run */
+	/* statistics */
+	uint32 sessions;
+	uint32 unlocks;
+	uint32 wrong;
+	uint32 stuck;
+	uint8 ram[];		/* .data, .bss and .noinit of MCU1 then of MCU2 */
+}Fleet_DoorType;
+
+/*******************************************************************************
+* Name: Fleet_WorkerType
+* Type: Structure
+* Description: Queue of doors of a worker and its statistics, in the shared mapping
+********************************************************************************/
+typedef struct
+{
+	uint8 lock;
+	uint32 head;
+	uint32 count;
+	uint32 *doors;		/* ring of g_fleetNumDoors indexes */
+	/* statistics */
+	uint64 slices;
+	uint32 steals;
+	uint32 maxAhead;	/* slices a door it ran was ahead of the slowest one */
+	uint64 clock;		/* end of the latest slice it ran, its virtual time */
+	uint64 busyNs;
+	uint64 idleNs;		/* nothing it could run */
+	uint64 stallNs;		/* the queue of the controller was full */
+}Fleet_WorkerType;
+
+/*******************************************************************************
+* Name: Fleet_SharedType
+* Type: Structure
+* Description: Start of the shared mapping
+********************************************************************************/
+typedef struct
+{
+	uint32 floor;		/* slices every door has run */
+	uint32 finished;	/* doors that ran all their slices */
+	uint32 completed[FLEET_COMPLETED_SIZE];	/* doors that ran a slice, by slice modulo the size */
+	uint64 tail;		/* next position the workers write */
+	uint64 head;		/* next position the controller reads */
+	Fleet_CellType queue[FLEET_QUEUE_SIZE];
+	Fleet_WorkerType workers[FLEET_MAX_WORKERS];
+}Fleet_SharedType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+/* RAM of the firmwares, the sections are renamed in build/load, weak as a firmware may not have one */
+extern uint8 __start_mcu1_data[] __attribute__((weak)), __stop_mcu1_data[] __attribute__((weak));
+extern uint8 __start_mcu1_bss[] __attribute__((weak)), __stop_mcu1_bss[] __attribute__((weak));
+extern uint8 __start_mcu1_noinit[] __attribute__((weak)), __stop_mcu1_noinit[] __attribute__((weak));
+extern uint8 __start_mcu2_data[] __attribute__((weak)), __stop_mcu2_data[] __attribute__((weak));
+extern uint8 __start_mcu2_bss[] __attribute__((weak)), __stop_mcu2_bss[] __attribute__((weak));
+extern uint8 __start_mcu2_noinit[] __attribute__((weak)), __stop_mcu2_noinit[] __attribute__((weak));
+
+static const Fleet_SectionType g_fleetSections[] =
+{
+	{__start_mcu1_data, __stop_mcu1_data}, {__start_mcu1_bss, __stop_mcu1_bss}, {__start_mcu1_noinit, __stop_mcu1_noinit},
+	{__start_mcu2_data, __stop_mcu2_data}, {__start_mcu2_bss, __stop_mcu2_bss}, {__start_mcu2_noinit, __stop_mcu2_noinit}
+};
+
+static const char *const g_fleetTexts[] =
+{
+	"+ : Open Door", "Plz Enter Pass", "Re-Enter Pass", "UnMatched", "Unlocking", "Door Is Locked", "Locking"
+};
+
+static const char *const g_fleetEventNames[FLEET_NUM_EVENTS] = {"ready", "unlock", "wrong_password", "stuck"};
+
+/* the mapping, the same in every worker */
+static Fleet_SharedType *g_fleetShared;
+static uint8 *g_fleetDoors;
+static size_t g_fleetDoorSize;			/* a door with its RAM and its stacks */
+static size_t g_fleetRamSize;
+static size_t g_fleetMappingSize;
+
+static uint32 g_fleetNumDoors = FLEET_DEFAULT_DOORS;
+static uint32 g_fleetNumWorkers;
+static uint32 g_fleetNumSlices;
+static uint32 g_fleetLag = FLEET_DEFAULT_LAG;
+static uint64 g_fleetSliceCycles = SIM_MS_TO_CYCLES(FLEET_DEFAULT_SLICE_SECONDS * 1000UL);
+static boolean g_fleetVerbose = FALSE;
+
+/* user model */
+static uint32 g_fleetSessionMs = 3600000UL / FLEET_DEFAULT_SESSIONS;	/* average time between two sessions */
+static uint32 g_fleetKeyMs = FLEET_DEFAULT_KEY_MS;
+static uint32 g_fleetTypoPercent = FLEET_DEFAULT_TYPO_PERCENT;
+
+/* controller */
+static uint32 g_fleetServiceNs = 0;
+static uint64 g_fleetEvents[FLEET_NUM_EVENTS];
+static uint32 *g_fleetPerMinute = NULL_PTR;
+static uint32 g_fleetMinutes;
+static uint64 g_fleetNewest = 0;		/* latest virtual time of an event so far */
+static uint64 g_fleetLate = 0;
+static uint64 g_fleetMaxLate = 0;		/* cycles */
+static uint64 g_fleetMaxQueue = 0;
+static uint64 g_fleetBusyNs = 0;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static boolean FLEET_build(uint32 seed);
+static void FLEET_work(uint32 id);
+static void FLEET_runSlice(Fleet_WorkerType *worker,Fleet_DoorType *door,uint32 index);
+static boolean FLEET_step(Fleet_WorkerType *worker,Fleet_DoorType *door,uint32 index,uint64 end);
+static void FLEET_startSession(Fleet_DoorType *door);
+static void FLEET_addPassword(Fleet_DoorType *door,const char *password);
+static void FLEET_addStep(Fleet_DoorType *door,char key,uint8 text,uint8 event);
+static void FLEET_nextStep(Fleet_WorkerType *worker,Fleet_DoorType *door,uint32 index);
+static void FLEET_endSession(Fleet_DoorType *door);
+static void FLEET_copyRam(Fleet_DoorType *door,boolean in);
+static Fleet_DoorType *FLEET_getDoor(uint32 index);
+static void FLEET_push(Fleet_WorkerType *worker,uint32 index);
+static sint32 FLEET_pop(Fleet_WorkerType *worker);
+static void FLEET_complete(uint32 slice);
+static void FLEET_post(Fleet_WorkerType *worker,uint32 index,uint8 kind,uint64 cycle);
+static boolean FLEET_control(pid_t *workers);
+static void FLEET_serve(const Fleet_EventType *event);
+static uint32 FLEET_rand(uint32 *state);
+static uint32 FLEET_vary(uint32 *state,uint32 average);
+static uint64 FLEET_now(void);
+static void FLEET_report(double hostSeconds,boolean passed);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(int argc,char **argv)
+{
+	pid_t workers[FLEET_MAX_WORKERS];
+	double hours = FLEET_DEFAULT_HOURS;
+	uint32 seed = 1;
+	uint32 sessions = FLEET_DEFAULT_SESSIONS;
+	boolean quiet = FALSE;
+	boolean usage = FALSE;
+	boolean passed;
+	uint64 start;
+	int option;
+
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	g_fleetNumWorkers = (cpus > 0) ? (uint32)cpus : 1;
+	while((option = getopt(argc, argv, "n:w:t:s:l:u:k:x:c:S:qv")) != -1)
+	{
+		switch(option)
+		{
+		case 'n': g_fleetNumDoors = (uint32)atol(optarg); break;
+		case 'w': g_fleetNumWorkers = (uint32)atol(optarg); break;
+		case 't': hours = atof(optarg); break;
+		case 's': g_fleetSliceCycles = (uint64)(atof(optarg) * SIM_F_CPU); break;
+		case 'l': g_fleetLag = (uint32)atol(optarg); break;
+		case 'u': sessions = (uint32)atol(optarg); break;
+		case 'k': g_fleetKeyMs = (uint32)atol(optarg); break;
+		case 'x': g_fleetTypoPercent = (uint32)atol(optarg); break;
+		case 'c': g_fleetServiceNs = (uint32)atol(optarg) * 1000UL; break;
+		case 'S': seed = (uint32)atol(optarg); break;
+		case 'q': quiet = TRUE; break;
+		case 'v': g_fleetVerbose = TRUE; break;
+		default: usage = TRUE; break;
+		}
+	}
+	if( usage || (optind < argc) || (g_fleetNumDoors == 0) || (g_fleetNumWorkers == 0) || (g_fleetNumWorkers > FLEET_MAX_WORKERS)
+			|| (hours <= 0) || (g_fleetSliceCycles == 0) || (g_fleetLag == 0) || (g_fleetLag > FLEET_MAX_LAG) || (sessions == 0) )
+	{
+		fprintf(stderr, "usage: %s [-n doors] [-w workers (1 to %u)] [-t hours] [-s seconds] [-l slices (1 to %u)]\n"
+				"       [-u sessions] [-k ms] [-x percent] [-c us] [-S seed] [-q] [-v]\n", argv[0], FLEET_MAX_WORKERS, FLEET_MAX_LAG);
+		return 2;
+	}
+	g_fleetSessionMs = 3600000UL / sessions;
+	g_fleetNumSlices = (uint32)((hours * 3600.0 * SIM_F_CPU + (double)g_fleetSliceCycles - 1) / (double)g_fleetSliceCycles);
+	g_fleetMinutes = (uint32)((uint64)g_fleetNumSlices * g_fleetSliceCycles / SIM_MS_TO_CYCLES(60000UL)) + 1;
+	g_fleetPerMinute = calloc(g_fleetMinutes, sizeof(uint32));
+
+	if( (g_fleetPerMinute == NULL_PTR) || (FLEET_build(seed) == FALSE) )
+	{
+		fprintf(stderr, "%s: no memory for %lu doors\n", argv[0], (unsigned long)g_fleetNumDoors);
+		return 1;
+	}
+
+	start = FLEET_now();
+	fflush(stdout);
+	for(uint32 i = 0 ; i < g_fleetNumWorkers ; i++)
+	{
+		workers[i] = fork();
+		if(workers[i] == 0)
+		{
+			FLEET_work(i);
+			_exit(0);
+		}
+		if(workers[i] < 0)
+		{
+			perror("fork");
+			for(uint32 j = 0 ; j < i ; j++)
+			{
+				kill(workers[j], SIGKILL);
+			}
+			return 1;
+		}
+	}
+	passed = FLEET_control(workers);
+	fflush(stdout);
+
+	for(uint32 i = 0 ; i < g_fleetNumDoors ; i++)
+	{
+		passed = passed && (FLEET_getDoor(i)->stuck == 0);
+	}
+	if(quiet == FALSE)
+	{
+		FLEET_report((double)(FLEET_now() - start) / 1e9, passed);
+	}
+	munmap(g_fleetShared, g_fleetMappingSize);
+	free(g_fleetPerMinute);
+	return passed ? 0 : 1;
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		FLEET_build
+* Description:			Function to map the shared memory and build every door in it, with the
+* 						reset RAM of the firmwares and a boot as its first session, then to
+* 						deal the doors to the queues of the workers
+* Parameters (in):    	Seed of the random numbers
+* Parameters (out):   	FALSE if there is no memory for them
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean FLEET_build(uint32 seed)
+{
+	size_t sharedSize;
+	uint8 *mapping;
+	uint32 *queues;
+
+	g_fleetRamSize = 0;
+	for(uint8 i = 0 ; i < FLEET_NUM_SECTIONS ; i++)
+	{
+		g_fleetRamSize += (size_t)(g_fleetSections[i].stop - g_fleetSections[i].start);
+	}
+	g_fleetDoorSize = ((sizeof(Fleet_DoorType) + g_fleetRamSize + FLEET_PAGE_SIZE - 1) & ~(size_t)(FLEET_PAGE_SIZE - 1))
+			+ 2 * SIM_STACK_SIZE;
+	sharedSize = (sizeof(Fleet_SharedType) + (size_t)g_fleetNumWorkers * g_fleetNumDoors * sizeof(uint32) + FLEET_PAGE_SIZE - 1)
+			& ~(size_t)(FLEET_PAGE_SIZE - 1);
+	g_fleetMappingSize = sharedSize + (size_t)g_fleetNumDoors * g_fleetDoorSize;
+
+	/* the stacks are mostly never touched and take no memory */
+	mapping = mmap(NULL_PTR, g_fleetMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if(mapping == MAP_FAILED)
+		return FALSE;
+	g_fleetShared = (Fleet_SharedType *)mapping;
+	g_fleetDoors = mapping + sharedSize;
+	queues = (uint32 *)(mapping + sizeof(Fleet_SharedType));
+	for(uint32 i = 0 ; i < FLEET_QUEUE_SIZE ; i++)
+	{
+		g_fleetShared->queue[i].sequence = i;
+	}
+	for(uint32 i = 0 ; i < g_fleetNumWorkers ; i++)
+	{
+		g_fleetShared->workers[i].doors = queues + (size_t)i * g_fleetNumDoors;
+	}
+
+	for(uint32 i = 0 ; i < g_fleetNumDoors ; i++)
+	{
+		Fleet_DoorType *door = FLEET_getDoor(i);
+		uint8 *stacks = (uint8 *)door + g_fleetDoorSize - 2 * SIM_STACK_SIZE;
+		uint8 *ram = door->ram;
+
+		if(SIM_BOARD_init(&door->board, 0) == ERROR)
+			return FALSE;
+		SIM_setStack(&door->board.mcu1, stacks);
+		SIM_setStack(&door->board.mcu2, stacks + SIM_STACK_SIZE);
+		door->board.mcu1.cycles = SIM_MS_TO_CYCLES(FLEET_MCU1_DELAY_MS);
+		/* nothing ran yet, the sections hold the reset values */
+		for(uint8 j = 0 ; j < FLEET_NUM_SECTIONS ; j++)
+		{
+			size_t size = (size_t)(g_fleetSections[j].stop - g_fleetSections[j].start);
+			memcpy(ram, g_fleetSections[j].start, size);
+			ram += size;
+		}
+
+		door->random = (seed ^ (i * 0x9E3779B9UL)) ? (seed ^ (i * 0x9E3779B9UL)) : 1;
+		for(uint8 j = 0 ; j < FLEET_DIGITS ; j++)
+		{
+			door->password[j] = (char)('0' + FLEET_rand(&door->random) % 10);
+		}
+		door->password[FLEET_DIGITS] = '\0';
+		/* the first session sets the password on the blank EEPROM */
+		FLEET_addStep(door, '\0', FLEET_PROMPT, FLEET_NO_EVENT);
+		FLEET_addPassword(door, door->password);
+		FLEET_addStep(door, '\0', FLEET_REENTER, FLEET_NO_EVENT);
+		FLEET_addPassword(door, door->password);
+		FLEET_addStep(door, '\0', FLEET_MENU, FLEET_READY);
+		door->deadline = SIM_MS_TO_CYCLES(FLEET_STEP_SECONDS * 1000UL);
+
+		FLEET_push(&g_fleetShared->workers[i % g_fleetNumWorkers], i);
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_work
+* Description:			Function run by a worker until every door ran all its slices
+* Parameters (in):    	Number of the worker
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_work(uint32 id)
+{
+	Fleet_WorkerType *worker = &g_fleetShared->workers[id];
+	uint32 deferred = 0;	/* doors in a row that were too far ahead */
+
+	while(__atomic_load_n(&g_fleetShared->finished, __ATOMIC_ACQUIRE) < g_fleetNumDoors)
+	{
+		sint32 index = FLEET_pop(worker);
+		uint64 start = FLEET_now();
+		Fleet_DoorType *door;
+		uint32 ahead;
+
+		/* steal from the next workers first so the thieves spread out */
+		for(uint32 i = 1 ; (index < 0) && (i < g_fleetNumWorkers) ; i++)
+		{
+			index = FLEET_pop(&g_fleetShared->workers[(id + i) % g_fleetNumWorkers]);
+			worker->steals += (index >= 0) ? 1 : 0;
+		}
+		if(index < 0)
+		{
+			sched_yield();
+			worker->idleNs += FLEET_now() - start;
+			continue;
+		}
+
+		door = FLEET_getDoor((uint32)index);
+		ahead = door->slices - __atomic_load_n(&g_fleetShared->floor, __ATOMIC_ACQUIRE);
+		if(ahead >= g_fleetLag)
+		{
+			FLEET_push(worker, (uint32)index);
+			deferred++;
+			if(deferred > worker->count)
+			{
+				/* every door it has waits for the slow ones */
+				sched_yield();
+				worker->idleNs += FLEET_now() - start;
+				deferred = 0;
+			}
+			continue;
+		}
+		deferred = 0;
+		worker->maxAhead = (ahead > worker->maxAhead) ? ahead : worker->maxAhead;
+
+		FLEET_runSlice(worker, door, (uint32)index);
+		worker->busyNs += FLEET_now() - start;
+		worker->slices++;
+		worker->clock = (uint64)door->slices * g_fleetSliceCycles;
+		FLEET_complete(door->slices - 1);
+		if(door->slices == g_fleetNumSlices)
+		{
+			__atomic_add_fetch(&g_fleetShared->finished, 1, __ATOMIC_RELEASE);
+		}
+		else
+		{
+			FLEET_push(worker, (uint32)index);
+		}
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_runSlice
+* Description:			Function to run a door up to the end of its next slice, in the firmwares
+* 						of this worker
+* Parameters (in):    	Worker, door and its index
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_runSlice(Fleet_WorkerType *worker,Fleet_DoorType *door,uint32 index)
+{
+	uint64 end = (uint64)(door->slices + 1) * g_fleetSliceCycles;
+
+	FLEET_copyRam(door, TRUE);
+	while(door->board.link.cycles < end)
+	{
+		if(FLEET_step(worker, door, index, end) == FALSE)
+		{
+			fprintf(stderr, "fleet: door %lu stopped at %.3f ms\n", (unsigned long)index,
+					(double)door->board.link.cycles * 1000.0 / SIM_F_CPU);
+			_exit(1);
+		}
+	}
+	FLEET_copyRam(door, FALSE);
+	door->slices++;
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_step
+* Description:			Function to do what the user of a door does next, or to run the board
+* 						until the user has something to do
+* Parameters (in):    	Worker, door, its index and the end of the slice
+* Parameters (out):   	FALSE if an MCU stopped
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean FLEET_step(Fleet_WorkerType *worker,Fleet_DoorType *door,uint32 index,uint64 end)
+{
+	Sim_BoardType *board = &door->board;
+	uint64 now = board->link.cycles;
+	const Fleet_StepType *step;
+	uint64 limit;
+
+	if(door->numSteps == 0)
+	{
+		if(now >= door->nextSession)
+		{
+			FLEET_startSession(door);
+			return TRUE;
+		}
+		return SIM_LINK_run(&board->link, (door->nextSession < end) ? door->nextSession : end);
+	}
+
+	step = &door->steps[door->step];
+	if(now >= door->deadline)
+	{
+		door->stuck++;
+		FLEET_post(worker, index, FLEET_STUCK, now);
+		SIM_KEYPAD_release(&board->mcu1, &board->keypad);
+		FLEET_endSession(door);
+		return TRUE;
+	}
+	limit = (door->deadline < end) ? door->deadline : end;
+
+	if(step->key == '\0')
+	{
+		/* the LCD yields when it changes */
+		if(SIM_LCD_contains(&board->lcd, g_fleetTexts[step->text]))
+		{
+			FLEET_nextStep(worker, door, index);
+			return TRUE;
+		}
+		return SIM_LINK_run(&board->link, limit);
+	}
+
+	switch(door->phase)
+	{
+	case FLEET_PRESS:
+		SIM_KEYPAD_press(&board->mcu1, &board->keypad, step->key);
+		door->phase = FLEET_SEEN;
+		return TRUE;
+	case FLEET_SEEN:
+		if(board->keypad.seen)
+		{
+			door->phase = FLEET_HOLD;
+			door->wakeAt = now + SIM_MS_TO_CYCLES(FLEET_vary(&door->random, FLEET_KEY_HOLD_MS));
+			return TRUE;
+		}
+		return SIM_LINK_run(&board->link, limit);
+	case FLEET_HOLD:
+		if(now >= door->wakeAt)
+		{
+			SIM_KEYPAD_release(&board->mcu1, &board->keypad);
+			door->phase = FLEET_GAP;
+			door->wakeAt = now + SIM_MS_TO_CYCLES(FLEET_vary(&door->random, g_fleetKeyMs));
+			return TRUE;
+		}
+		return SIM_LINK_run(&board->link, (door->wakeAt < end) ? door->wakeAt : end);
+	default:
+		if(now >= door->wakeAt)
+		{
+			FLEET_nextStep(worker, door, index);
+			return TRUE;
+		}
+		return SIM_LINK_run(&board->link, (door->wakeAt < end) ? door->wakeAt : end);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_startSession
+* Description:			Function to write the steps of opening the door, after a wrong password
+* 						if the user mistypes one digit
+* Parameters (in):    	Door
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_startSession(Fleet_DoorType *door)
+{
+	door->sessions++;
+	FLEET_addStep(door, '+', 0, FLEET_NO_EVENT);
+	FLEET_addStep(door, '\0', FLEET_PROMPT, FLEET_NO_EVENT);
+	if((FLEET_rand(&door->random) % 100) < g_fleetTypoPercent)
+	{
+		char wrong[FLEET_DIGITS + 1];
+		uint8 position = (uint8)(FLEET_rand(&door->random) % FLEET_DIGITS);
+
+		strcpy(wrong, door->password);
+		wrong[position] = (char)('0' + (wrong[position] - '0' + 1 + FLEET_rand(&door->random) % 9) % 10);
+		FLEET_addPassword(door, wrong);
+		FLEET_addStep(door, '\0', FLEET_UNMATCHED, FLEET_WRONG);
+		FLEET_addStep(door, '\0', FLEET_PROMPT, FLEET_NO_EVENT);
+	}
+	FLEET_addPassword(door, door->password);
+	FLEET_addStep(door, '\0', FLEET_UNLOCKING, FLEET_UNLOCK);
+	FLEET_addStep(door, '\0', FLEET_OPENED, FLEET_NO_EVENT);
+	FLEET_addStep(door, '\0', FLEET_LOCKING, FLEET_NO_EVENT);
+	FLEET_addStep(door, '\0', FLEET_MENU, FLEET_NO_EVENT);
+	door->deadline = door->board.link.cycles + SIM_MS_TO_CYCLES(FLEET_STEP_SECONDS * 1000UL);
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_addPassword
+* Description:			Function to add the keys of a password then Enter to the session
+* Parameters (in):    	Door and password as digits
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_addPassword(Fleet_DoorType *door,const char *password)
+{
+	for(const char *digit = password ; *digit != '\0' ; digit++)
+	{
+		FLEET_addStep(door, *digit, 0, FLEET_NO_EVENT);
+	}
+	FLEET_addStep(door, 'C', 0, FLEET_NO_EVENT);
+}
+
+static void FLEET_addStep(Fleet_DoorType *door,char key,uint8 text,uint8 event)
+{
+	Fleet_StepType *step = &door->steps[door->numSteps++];
+
+	step->key = key;
+	step->text = text;
+	step->event = event;
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_nextStep
+* Description:			Function to send the event of a step that is done and to go to the
+* 						next one, or to draw the time of the next session after the last one
+* Parameters (in):    	Worker, door and its index
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_nextStep(Fleet_WorkerType *worker,Fleet_DoorType *door,uint32 index)
+{
+	uint8 event = door->steps[door->step].event;
+	uint64 now = door->board.link.cycles;
+
+	if(event != FLEET_NO_EVENT)
+	{
+		door->unlocks += (event == FLEET_UNLOCK) ? 1 : 0;
+		door->wrong += (event == FLEET_WRONG) ? 1 : 0;
+		FLEET_post(worker, index, event, now);
+	}
+	door->step++;
+	door->phase = FLEET_PRESS;
+	door->deadline = now + SIM_MS_TO_CYCLES(FLEET_STEP_SECONDS * 1000UL);
+	if(door->step == door->numSteps)
+	{
+		FLEET_endSession(door);
+	}
+}
+
+static void FLEET_endSession(Fleet_DoorType *door)
+{
+	door->numSteps = 0;
+	door->step = 0;
+	door->phase = FLEET_PRESS;
+	door->nextSession = door->board.link.cycles + SIM_MS_TO_CYCLES(FLEET_vary(&door->random, g_fleetSessionMs));
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_copyRam
+* Description:			Function to give the firmwares of this process the RAM of a door, or to
+* 						save it back in the door
+* Parameters (in):    	Door and TRUE to copy it in the firmwares
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_copyRam(Fleet_DoorType *door,boolean in)
+{
+	uint8 *ram = door->ram;
+
+	for(uint8 i = 0 ; i < FLEET_NUM_SECTIONS ; i++)
+	{
+		size_t size = (size_t)(g_fleetSections[i].stop - g_fleetSections[i].start);
+		if(in)
+		{
+			memcpy(g_fleetSections[i].start, ram, size);
+		}
+		else
+		{
+			memcpy(ram, g_fleetSections[i].start, size);
+		}
+		ram += size;
+	}
+}
+
+static Fleet_DoorType *FLEET_getDoor(uint32 index)
+{
+	return (Fleet_DoorType *)(g_fleetDoors + (size_t)index * g_fleetDoorSize);
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_push
+* Description:			Function to put a door at the tail of the queue of a worker
+* Parameters (in):    	Worker and index of the door
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_push(Fleet_WorkerType *worker,uint32 index)
+{
+	while(__atomic_test_and_set(&worker->lock, __ATOMIC_ACQUIRE)){}
+	worker->doors[(worker->head + worker->count) % g_fleetNumDoors] = index;
+	worker->count++;
+	__atomic_clear(&worker->lock, __ATOMIC_RELEASE);
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_pop
+* Description:			Function to take the door at the head of the queue of a worker, the one
+* 						that waited the longest
+* Parameters (in):    	Worker
+* Parameters (out):   	Index of the door, -1 if the queue is empty
+* Return value:      	sint32
+********************************************************************************/
+
+static sint32 FLEET_pop(Fleet_WorkerType *worker)
+{
+	sint32 index = -1;
+
+	if(__atomic_load_n(&worker->count, __ATOMIC_RELAXED) == 0)
+		return -1; /* without the lock, thieves look at many empty queues */
+	while(__atomic_test_and_set(&worker->lock, __ATOMIC_ACQUIRE)){}
+	if(worker->count != 0)
+	{
+		index = (sint32)worker->doors[worker->head];
+		worker->head = (worker->head + 1) % g_fleetNumDoors;
+		worker->count--;
+	}
+	__atomic_clear(&worker->lock, __ATOMIC_RELEASE);
+	return index;
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_complete
+* Description:			Function to count a door that ran a slice, the slowest slice moves on
+* 						once every door ran it
+* Parameters (in):    	The slice, from 0
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_complete(uint32 slice)
+{
+	uint32 *completed = g_fleetShared->completed;
+
+	if(__atomic_add_fetch(&completed[slice % FLEET_COMPLETED_SIZE], 1, __ATOMIC_ACQ_REL) != g_fleetNumDoors)
+		return;
+	for(;;)
+	{
+		uint32 floor = __atomic_load_n(&g_fleetShared->floor, __ATOMIC_ACQUIRE);
+		if(__atomic_load_n(&completed[floor % FLEET_COMPLETED_SIZE], __ATOMIC_ACQUIRE) != g_fleetNumDoors)
+			return;
+		/* no door runs a slice that far ahead before the floor moves, the counter can be reused */
+		if(__atomic_compare_exchange_n(&g_fleetShared->floor, &floor, floor + 1, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		{
+			__atomic_store_n(&completed[floor % FLEET_COMPLETED_SIZE], 0, __ATOMIC_RELEASE);
+		}
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_post
+* Description:			Function to send an event to the controller, the worker waits while
+* 						the queue is full
+* Parameters (in):    	Worker, index of the door, kind and virtual time of the event
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_post(Fleet_WorkerType *worker,uint32 index,uint8 kind,uint64 cycle)
+{
+	uint64 position = __atomic_load_n(&g_fleetShared->tail, __ATOMIC_RELAXED);
+	uint64 stalled = 0;
+	Fleet_CellType *cell;
+
+	for(;;)
+	{
+		sint64 difference;
+
+		cell = &g_fleetShared->queue[position & (FLEET_QUEUE_SIZE - 1)];
+		difference = (sint64)(__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - position);
+		if(difference == 0)
+		{
+			if(__atomic_compare_exchange_n(&g_fleetShared->tail, &position, position + 1, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+				break;
+		}
+		else if(difference < 0)
+		{
+			/* full, the controller didn't take this cell yet */
+			stalled = (stalled != 0) ? stalled : FLEET_now();
+			sched_yield();
+			position = __atomic_load_n(&g_fleetShared->tail, __ATOMIC_RELAXED);
+		}
+		else
+		{
+			position = __atomic_load_n(&g_fleetShared->tail, __ATOMIC_RELAXED);
+		}
+	}
+	cell->event.cycle = cycle;
+	cell->event.door = index;
+	cell->event.kind = kind;
+	__atomic_store_n(&cell->sequence, position + 1, __ATOMIC_RELEASE);
+	if(stalled != 0)
+	{
+		worker->stallNs += FLEET_now() - stalled;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_control
+* Description:			Function of the controller : takes the events until every worker ended
+* 						and the queue is empty. A worker that fails ends the others
+* Parameters (in):    	Process ids of the workers
+* Parameters (out):   	FALSE if a worker failed
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean FLEET_control(pid_t *workers)
+{
+	uint32 running = g_fleetNumWorkers;
+
+	for(;;)
+	{
+		uint64 head = g_fleetShared->head;
+		Fleet_CellType *cell = &g_fleetShared->queue[head & (FLEET_QUEUE_SIZE - 1)];
+		uint64 depth;
+		int status;
+		pid_t pid;
+
+		if(__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) == head + 1)
+		{
+			Fleet_EventType event = cell->event;
+
+			depth = __atomic_load_n(&g_fleetShared->tail, __ATOMIC_RELAXED) - head;
+			g_fleetMaxQueue = (depth > g_fleetMaxQueue) ? depth : g_fleetMaxQueue;
+			__atomic_store_n(&cell->sequence, head + FLEET_QUEUE_SIZE, __ATOMIC_RELEASE);
+			g_fleetShared->head = head + 1;
+			FLEET_serve(&event);
+			continue;
+		}
+		if(running == 0)
+			break;
+
+		pid = waitpid(-1, &status, WNOHANG);
+		if(pid > 0)
+		{
+			running--;
+			if( (WIFEXITED(status) == 0) || (WEXITSTATUS(status) != 0) )
+			{
+				/* the doors it held never finish */
+				fprintf(stderr, "fleet: worker %ld failed\n", (long)pid);
+				for(uint32 i = 0 ; i < g_fleetNumWorkers ; i++)
+				{
+					kill(workers[i], SIGKILL);
+				}
+				while(wait(NULL_PTR) > 0){}
+				return FALSE;
+			}
+			continue;
+		}
+		nanosleep(&(struct timespec){0, FLEET_IDLE_NS}, NULL_PTR);
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_serve
+* Description:			Function to handle an event in the controller : it takes -c us and is
+* 						counted by kind and by virtual minute, and as late if an event with a
+* 						later virtual time came before
+* Parameters (in):    	Event
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_serve(const Fleet_EventType *event)
+{
+	uint64 start = FLEET_now();
+	uint32 minute = (uint32)(event->cycle / SIM_MS_TO_CYCLES(60000UL));
+
+	if(g_fleetVerbose)
+	{
+		printf("%.3f door %lu %s\n", (double)event->cycle * 1000.0 / SIM_F_CPU, (unsigned long)event->door,
+				g_fleetEventNames[event->kind]);
+	}
+	g_fleetEvents[event->kind]++;
+	if(minute < g_fleetMinutes)
+	{
+		g_fleetPerMinute[minute]++;
+	}
+	if(event->cycle < g_fleetNewest)
+	{
+		g_fleetLate++;
+		g_fleetMaxLate = ((g_fleetNewest - event->cycle) > g_fleetMaxLate) ? (g_fleetNewest - event->cycle) : g_fleetMaxLate;
+	}
+	else
+	{
+		g_fleetNewest = event->cycle;
+	}
+	/* the work of a real controller */
+	while(FLEET_now() - start < g_fleetServiceNs){}
+	g_fleetBusyNs += FLEET_now() - start;
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_rand
+* Description:			Function to draw a random number of a door, xorshift32 so a seed gives
+* 						the same sessions whatever worker runs the door
+* Parameters (in):    	State of the door
+* Parameters (out):   	The number
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 FLEET_rand(uint32 *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return *state;
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_vary
+* Description:			Function to draw a time between half and one and a half of an average
+* Parameters (in):    	State of the door and the average
+* Parameters (out):   	The time
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 FLEET_vary(uint32 *state,uint32 average)
+{
+	return (average != 0) ? (average / 2 + FLEET_rand(state) % (average + 1)) : 0;
+}
+
+static uint64 FLEET_now(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64)now.tv_sec * 1000000000ULL + (uint64)now.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name:		FLEET_report
+* Description:			Function to write the statistics of the run to stderr
+* Parameters (in):    	Host time of the run and TRUE if it passed
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FLEET_report(double hostSeconds,boolean passed)
+{
+	double virtualSeconds = (double)g_fleetNumSlices * (double)g_fleetSliceCycles / SIM_F_CPU;
+	double doorHours = virtualSeconds * g_fleetNumDoors / 3600.0;
+	uint64 sessions = 0, unlocks = 0, wrong = 0, stuck = 0;
+	uint64 slices = 0, steals = 0, stallNs = 0;
+	uint32 maxAhead = 0;
+	uint32 peak = 0;
+
+	for(uint32 i = 0 ; i < g_fleetNumDoors ; i++)
+	{
+		const Fleet_DoorType *door = FLEET_getDoor(i);
+		sessions += door->sessions;
+		unlocks += door->unlocks;
+		wrong += door->wrong;
+		stuck += door->stuck;
+	}
+	for(uint32 i = 0 ; i < g_fleetMinutes ; i++)
+	{
+		peak = (g_fleetPerMinute[i] > peak) ? g_fleetPerMinute[i] : peak;
+	}
+
+	fprintf(stderr, "result=%s\n", passed ? "pass" : "fail");
+	fprintf(stderr, "doors=%lu\n", (unsigned long)g_fleetNumDoors);
+	fprintf(stderr, "workers=%lu\n", (unsigned long)g_fleetNumWorkers);
+	fprintf(stderr, "virtual_hours=%.3f\n", virtualSeconds / 3600.0);
+	fprintf(stderr, "host_ms=%.3f\n", hostSeconds * 1000.0);
+	fprintf(stderr, "door_hours_per_second=%.3f\n", (hostSeconds > 0) ? (doorHours / hostSeconds) : 0.0);
+	fprintf(stderr, "speedup=%.1f\n", (hostSeconds > 0) ? (doorHours * 3600.0 / hostSeconds) : 0.0);
+	fprintf(stderr, "sessions=%llu\n", (unsigned long long)sessions);
+	fprintf(stderr, "unlocks=%llu\n", (unsigned long long)unlocks);
+	fprintf(stderr, "wrong_passwords=%llu\n", (unsigned long long)wrong);
+	fprintf(stderr, "stuck=%llu\n", (unsigned long long)stuck);
+
+	for(uint32 i = 0 ; i < g_fleetNumWorkers ; i++)
+	{
+		const Fleet_WorkerType *worker = &g_fleetShared->workers[i];
+		fprintf(stderr, "worker.%lu.slices=%llu\n", (unsigned long)i, (unsigned long long)worker->slices);
+		fprintf(stderr, "worker.%lu.steals=%lu\n", (unsigned long)i, (unsigned long)worker->steals);
+		fprintf(stderr, "worker.%lu.busy_ms=%.3f\n", (unsigned long)i, (double)worker->busyNs / 1e6);
+		fprintf(stderr, "worker.%lu.idle_ms=%.3f\n", (unsigned long)i, (double)worker->idleNs / 1e6);
+		fprintf(stderr, "worker.%lu.stall_ms=%.3f\n", (unsigned long)i, (double)worker->stallNs / 1e6);
+		fprintf(stderr, "worker.%lu.clock_s=%.3f\n", (unsigned long)i, (double)worker->clock / SIM_F_CPU);
+		slices += worker->slices;
+		steals += worker->steals;
+		stallNs += worker->stallNs;
+		maxAhead = (worker->maxAhead > maxAhead) ? worker->maxAhead : maxAhead;
+	}
+	fprintf(stderr, "slices=%llu\n", (unsigned long long)slices);
+	fprintf(stderr, "steals=%llu\n", (unsigned long long)steals);
+	fprintf(stderr, "max_slices_ahead=%lu\n", (unsigned long)maxAhead);
+
+	for(uint8 i = 0 ; i < FLEET_NUM_EVENTS ; i++)
+	{
+		fprintf(stderr, "controller.%s=%llu\n", g_fleetEventNames[i], (unsigned long long)g_fleetEvents[i]);
+	}
+	fprintf(stderr, "controller_peak_per_minute=%lu\n", (unsigned long)peak);
+	fprintf(stderr, "controller_busy_ms=%.3f\n", (double)g_fleetBusyNs / 1e6);
+	fprintf(stderr, "controller_busy_percent=%.1f\n", (hostSeconds > 0) ? ((double)g_fleetBusyNs / 1e7 / hostSeconds) : 0.0);
+	fprintf(stderr, "controller_max_queue=%llu\n", (unsigned long long)g_fleetMaxQueue);
+	fprintf(stderr, "controller_stall_ms=%.3f\n", (double)stallNs / 1e6);
+	fprintf(stderr, "controller_late_events=%llu\n", (unsigned long long)g_fleetLate);
+	fprintf(stderr, "controller_max_late_s=%.3f\n", (double)g_fleetMaxLate / SIM_F_CPU);
+}
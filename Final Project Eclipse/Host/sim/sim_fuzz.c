@@ -0,0 +1,559 @@
+/******************************************************************************
+*  File name:		sim_fuzz.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Fuzz target of the command dispatcher of MCU2, with the libFuzzer interface :
+ * LLVMFuzzerTestOneInput runs MCU2 on the simulated board (the 24C16, the motor
+ * and the buzzer) and gives it the input on its UART like MCU1 would, stray
+ * bytes and cut messages included. The bytes don't take time on the wire, the
+ * next one is in UDR as soon as MCU2 looks at its receiver, and the bolt of the
+ * board travels in FUZZ_TRAVEL_MS so a door move ends as soon as the driver looks
+ * at its end-stop, after the inrush of the motor. The first
+ * byte of an input picks the state MCU2 starts from :
+ *
+ *   0  blank EEPROM, MCU1 just said MC_Ready
+ *   1  password 1234 set, no admin session
+ *   2  password 1234 set and just checked, one admin operation is allowed
+ *
+ * The three states are made once by booting MCU2 and are snapshots of its RAM
+ * (the .data, .bss and .noinit of the firmware, renamed by the Makefile so they
+ * can be found), of the stack of its context and of the board. Every input is
+ * run from a copy of one of them, the boot and the EEPROM scans are never run
+ * again. Once MCU2 waits for its next byte with the input all taken and its
+ * answer all sent, the EEPROM is checked :
+ *
+ *   - MCU2 is still running
+ *   - every page of the journal is erased or holds a valid record, no two
+ *     records of a key have the same sequence and the password is never lost
+ *   - every credential that isn't empty or revoked is valid
+ *   - without an admin password check the password and the users table don't
+ *     change and the maintenance mode isn't entered, the check is seen from
+ *     MSG_Matched followed by ROLE_ADMIN on the link
+ *
+ * A broken invariant is written to stderr and the target aborts, which libFuzzer
+ * and sim_fuzz_main.c both report as a crash with the input that caused it.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../SHARED/shared_config.h"
+#include "../../Final_Project_MCU2/HAL/EXT_EEPORM/journal.h"
+#include "../../Final_Project_MCU2/HAL/EXT_EEPORM/credential.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define FUZZ_WAIT_POLLS				4		/* reads of an empty receiver in a row that end a run */
+#define FUZZ_MAX_MS					3000	/* longest run, the alarm is cut there */
+#define FUZZ_BYTE_MS				2		/* more time for every byte of the input */
+#define FUZZ_TRAVEL_MS				1		/* the bolt from end to end at full speed */
+#define FUZZ_STACK_PAINT			0xA5	/* bytes of the context stack never used */
+#define FUZZ_OUTPUT_SIZE			64		/* bytes MCU2 sent, kept for the boot checks */
+#define FUZZ_PASSWORD_KEY			0		/* JOURNAL_KEY_PASSWORD of app.h */
+#define FUZZ_ERASED					0xFF
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+typedef enum
+{
+	FUZZ_BLANK,
+	FUZZ_LOCKED,
+	FUZZ_ADMIN,
+	FUZZ_NUM_STARTS
+}Fuzz_StartType;
+
+typedef struct
+{
+	Sim_BoardType board;
+	uint8 *ram;				/* .data, .bss then .noinit of the firmware */
+	uint8 *stack;			/* the used top of the context stack */
+	size_t stackOffset;		/* of the copy in the context stack */
+	boolean hasPassword;
+	uint8 password[JOURNAL_DATA_SIZE];	/* newest password record */
+	boolean admin;
+}Fuzz_SnapshotType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+/* RAM of the firmware, the sections are renamed in build/fuzz/mcu2.o */
+extern uint8 __start_mcu2_data[], __stop_mcu2_data[];
+extern uint8 __start_mcu2_bss[], __stop_mcu2_bss[];
+extern uint8 __start_mcu2_noinit[], __stop_mcu2_noinit[];
+
+static const char *const g_fuzzStartNames[FUZZ_NUM_STARTS] = {"blank", "locked", "admin"};
+
+static Sim_BoardType g_fuzzBoard;
+static Fuzz_SnapshotType g_fuzzSnapshots[FUZZ_NUM_STARTS];
+static boolean g_fuzzReady = FALSE;
+static void (*g_fuzzBoardAccess)(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value);
+
+/* the running input */
+static const uint8 *g_fuzzInput;
+static size_t g_fuzzInputSize;
+static size_t g_fuzzInputIndex;
+static uint8 g_fuzzPolls;
+static boolean g_fuzzWaiting;
+static uint8 g_fuzzOutput[FUZZ_OUTPUT_SIZE];
+static uint8 g_fuzzOutputCount;
+static uint8 g_fuzzLastByte;
+static boolean g_fuzzAuthenticated;
+static boolean g_fuzzMaintenance;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void FUZZ_boot(void);
+static void FUZZ_save(Fuzz_SnapshotType *snapshot,boolean admin);
+static void FUZZ_restore(const Fuzz_SnapshotType *snapshot);
+static void FUZZ_run(const uint8 *input,size_t size);
+static sint16 FUZZ_source(Sim_ContextType *ctx);
+static void FUZZ_sink(Sim_ContextType *ctx,uint8 byte,uint32 bitCycles);
+static void FUZZ_access(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value);
+static boolean FUZZ_sent(uint8 byte);
+static uint16 FUZZ_crc(const uint8 *data,uint16 length);
+static boolean FUZZ_findPassword(const uint8 *memory,uint8 *password);
+static void FUZZ_check(const Fuzz_SnapshotType *snapshot);
+static void FUZZ_fail(const Fuzz_SnapshotType *snapshot,const char *format,...);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+int LLVMFuzzerTestOneInput(const uint8 *data,size_t size)
+{
+	const Fuzz_SnapshotType *snapshot;
+
+	if(g_fuzzReady == FALSE)
+	{
+		FUZZ_boot();
+	}
+	if(size == 0)
+		return 0;
+
+	snapshot = &g_fuzzSnapshots[data[0] % FUZZ_NUM_STARTS];
+	FUZZ_restore(snapshot);
+	g_fuzzAuthenticated = snapshot->admin;
+	FUZZ_run(data + 1, size - 1);
+	FUZZ_check(snapshot);
+	return 0;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_boot
+* Description:			Function to boot MCU2 once and save the states the inputs start from,
+* 						the process ends if MCU2 doesn't answer like it should
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_boot(void)
+{
+	static const uint8 ready[] = {MC_Ready};
+	static const uint8 update[] = {MSG_UpdatePassword, 4, '1', '2', '3', '4'};
+	static const uint8 check[] = {MSG_checkPassword, 4, '1', '2', '3', '4'};
+	size_t ramSize = (size_t)(__stop_mcu2_data - __start_mcu2_data) + (size_t)(__stop_mcu2_bss - __start_mcu2_bss)
+			+ (size_t)(__stop_mcu2_noinit - __start_mcu2_noinit);
+
+	memset(&g_fuzzBoard, 0, sizeof(g_fuzzBoard));
+	if(SIM_BOARD_initMcu2(&g_fuzzBoard) == ERROR)
+	{
+		fprintf(stderr, "fuzz: no memory for the stack\n");
+		exit(1);
+	}
+	memset(g_fuzzBoard.mcu2.stack, FUZZ_STACK_PAINT, SIM_STACK_SIZE);
+	g_fuzzBoard.mcu2.uart.sink = FUZZ_sink;
+	g_fuzzBoard.mcu2.uart.sourceAtOnce = TRUE;
+	g_fuzzBoard.motor.travelMs = FUZZ_TRAVEL_MS;
+	g_fuzzBoardAccess = g_fuzzBoard.mcu2.onAccess;
+	g_fuzzBoard.mcu2.onAccess = FUZZ_access;
+	for(uint8 i = 0 ; i < FUZZ_NUM_STARTS ; i++)
+	{
+		g_fuzzSnapshots[i].ram = malloc(ramSize);
+		if(g_fuzzSnapshots[i].ram == NULL_PTR)
+		{
+			fprintf(stderr, "fuzz: no memory for the snapshots\n");
+			exit(1);
+		}
+	}
+
+	FUZZ_run(ready, sizeof(ready));
+	if(FUZZ_sent(PasswordNotSET) == FALSE)
+	{
+		fprintf(stderr, "fuzz: MCU2 didn't boot with a blank EEPROM\n");
+		exit(1);
+	}
+	FUZZ_save(&g_fuzzSnapshots[FUZZ_BLANK], FALSE);
+
+	FUZZ_run(update, sizeof(update));
+	if(FUZZ_sent(MSG_Committed) == FALSE)
+	{
+		fprintf(stderr, "fuzz: MCU2 didn't save the first password\n");
+		exit(1);
+	}
+	FUZZ_save(&g_fuzzSnapshots[FUZZ_LOCKED], FALSE);
+
+	g_fuzzAuthenticated = FALSE;
+	FUZZ_run(check, sizeof(check));
+	if(g_fuzzAuthenticated == FALSE)
+	{
+		fprintf(stderr, "fuzz: MCU2 didn't match the admin password\n");
+		exit(1);
+	}
+	FUZZ_save(&g_fuzzSnapshots[FUZZ_ADMIN], TRUE);
+	g_fuzzReady = TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_save
+* Description:			Function to save the state of MCU2 and of its board
+* Parameters (in):    	Snapshot and TRUE if an admin operation is allowed
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_save(Fuzz_SnapshotType *snapshot,boolean admin)
+{
+	const uint8 *stack = g_fuzzBoard.mcu2.stack;
+	size_t used = 0;
+	uint8 *ram = snapshot->ram;
+
+	snapshot->board = g_fuzzBoard;
+	memcpy(ram, __start_mcu2_data, (size_t)(__stop_mcu2_data - __start_mcu2_data));
+	ram += __stop_mcu2_data - __start_mcu2_data;
+	memcpy(ram, __start_mcu2_bss, (size_t)(__stop_mcu2_bss - __start_mcu2_bss));
+	ram += __stop_mcu2_bss - __start_mcu2_bss;
+	memcpy(ram, __start_mcu2_noinit, (size_t)(__stop_mcu2_noinit - __start_mcu2_noinit));
+
+	/* the stack grows down from the end, what was never touched doesn't need to be saved */
+	while( (used < SIM_STACK_SIZE) && (stack[used] == FUZZ_STACK_PAINT) )
+	{
+		used++;
+	}
+	snapshot->stackOffset = used;
+	snapshot->stack = malloc(SIM_STACK_SIZE - used);
+	if(snapshot->stack == NULL_PTR)
+	{
+		fprintf(stderr, "fuzz: no memory for the snapshots\n");
+		exit(1);
+	}
+	memcpy(snapshot->stack, stack + used, SIM_STACK_SIZE - used);
+
+	snapshot->hasPassword = FUZZ_findPassword(g_fuzzBoard.eeprom.memory, snapshot->password);
+	snapshot->admin = admin;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_restore
+* Description:			Function to put MCU2 and its board back in a saved state
+* Parameters (in):    	Snapshot
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_restore(const Fuzz_SnapshotType *snapshot)
+{
+	const uint8 *ram = snapshot->ram;
+
+	g_fuzzBoard = snapshot->board; /* in place, the pointers of the context stay right */
+	memcpy(__start_mcu2_data, ram, (size_t)(__stop_mcu2_data - __start_mcu2_data));
+	ram += __stop_mcu2_data - __start_mcu2_data;
+	memcpy(__start_mcu2_bss, ram, (size_t)(__stop_mcu2_bss - __start_mcu2_bss));
+	ram += __stop_mcu2_bss - __start_mcu2_bss;
+	memcpy(__start_mcu2_noinit, ram, (size_t)(__stop_mcu2_noinit - __start_mcu2_noinit));
+	memcpy((uint8 *)g_fuzzBoard.mcu2.stack + snapshot->stackOffset, snapshot->stack, SIM_STACK_SIZE - snapshot->stackOffset);
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_run
+* Description:			Function to send bytes to MCU2 and run it until it waits for the next one
+* Parameters (in):    	Bytes and their number
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_run(const uint8 *input,size_t size)
+{
+	Sim_ContextType *ctx = &g_fuzzBoard.mcu2;
+	uint64 limit = ctx->cycles + SIM_MS_TO_CYCLES(FUZZ_MAX_MS + (uint64)size * FUZZ_BYTE_MS);
+
+	g_fuzzInput = input;
+	g_fuzzInputSize = size;
+	g_fuzzInputIndex = 0;
+	g_fuzzOutputCount = 0;
+	g_fuzzLastByte = 0;
+	g_fuzzMaintenance = FALSE;
+	g_fuzzPolls = 0;
+	g_fuzzWaiting = FALSE;
+	ctx->uart.source = FUZZ_source;
+
+	while( (ctx->cycles < limit) && (g_fuzzWaiting == FALSE) )
+	{
+		if(SIM_resume(ctx, limit) == FALSE)
+			break;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_source
+* Description:			Function to give the UART the next byte of the input
+* Parameters (in):    	Context
+* Parameters (out):   	Byte or -1 at the end of the input
+* Return value:      	sint16
+********************************************************************************/
+
+static sint16 FUZZ_source(Sim_ContextType *ctx)
+{
+	if(g_fuzzInputIndex == g_fuzzInputSize)
+	{
+		ctx->uart.source = NULL_PTR;
+		return -1;
+	}
+	return g_fuzzInput[g_fuzzInputIndex++];
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_sink
+* Description:			Function to see what MCU2 sends, an admin password check opens the
+* 						operations the invariants otherwise forbid
+* Parameters (in):    	Context, the byte and its bit time
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_sink(Sim_ContextType *ctx,uint8 byte,uint32 bitCycles)
+{
+	(void)ctx;
+	(void)bitCycles;
+	if( (g_fuzzLastByte == MSG_Matched) && (byte == ROLE_ADMIN) )
+	{
+		g_fuzzAuthenticated = TRUE;
+	}
+	g_fuzzLastByte = byte;
+	if(g_fuzzOutputCount < FUZZ_OUTPUT_SIZE)
+	{
+		g_fuzzOutput[g_fuzzOutputCount++] = byte;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_access
+* Description:			Function to see the maintenance mode, the only code that changes the baud
+* 						rate after the boot, and MCU2 waiting for a byte that won't come, then to
+* 						pass the access to the board
+* Parameters (in):    	Context, register address, TRUE for a write and the value
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_access(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value)
+{
+	if( write && (address == SIM_UBRRL) && g_fuzzReady )
+	{
+		g_fuzzMaintenance = TRUE;
+	}
+	if( (write == FALSE) && (address == SIM_UCSRA) )
+	{
+		/* a wait for UDRE before a byte is sent is a single read, a wait for the next byte goes on */
+		if( (ctx->uart.source == NULL_PTR) && ((value & (1<<RXC)) == 0) && (ctx->uart.txBusy == FALSE) )
+		{
+			g_fuzzPolls++;
+		}
+		else
+		{
+			g_fuzzPolls = 0;
+		}
+		if(g_fuzzPolls == FUZZ_WAIT_POLLS)
+		{
+			g_fuzzWaiting = TRUE;
+			SIM_yield(ctx);
+		}
+	}
+	else if( write && (address == SIM_UDR) )
+	{
+		g_fuzzPolls = 0;
+	}
+	g_fuzzBoardAccess(ctx, address, write, value);
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_sent
+* Description:			Function to know if MCU2 sent a byte in the last run
+* Parameters (in):    	Byte
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean FUZZ_sent(uint8 byte)
+{
+	for(uint8 i = 0 ; i < g_fuzzOutputCount ; i++)
+	{
+		if(g_fuzzOutput[i] == byte)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_crc
+* Description:			Function to calculate the CRC-16/CCITT-FALSE of the records, like LIB/crc16.c
+* Parameters (in):    	Bytes and their number
+* Parameters (out):   	CRC
+* Return value:      	uint16
+********************************************************************************/
+
+static uint16 FUZZ_crc(const uint8 *data,uint16 length)
+{
+	uint16 crc = 0xFFFF;
+
+	for(uint16 i = 0 ; i < length ; i++)
+	{
+		crc ^= (uint16)data[i] << 8;
+		for(uint8 bit = 0 ; bit < 8 ; bit++)
+		{
+			crc = (crc & 0x8000) ? (uint16)((crc << 1) ^ 0x1021) : (uint16)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_findPassword
+* Description:			Function to find the newest valid password record of the journal
+* Parameters (in):    	EEPROM image and array of JOURNAL_DATA_SIZE for the record
+* Parameters (out):   	TRUE if there is one
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean FUZZ_findPassword(const uint8 *memory,uint8 *password)
+{
+	uint32 newest = 0;
+
+	for(uint8 page = 0 ; page < JOURNAL_NUM_PAGES ; page++)
+	{
+		const Journal_RecordType *record = (const Journal_RecordType *)(memory + JOURNAL_START_ADDRESS + page * JOURNAL_RECORD_SIZE);
+		uint32 sequence = record->sequence[0] | ((uint32)record->sequence[1] << 8) | ((uint32)record->sequence[2] << 16);
+		uint16 crc = FUZZ_crc((const uint8 *)record, JOURNAL_RECORD_SIZE - 2);
+
+		if( (record->key == FUZZ_PASSWORD_KEY) && (sequence > newest) && (sequence <= JOURNAL_MAX_SEQUENCE)
+				&& (record->crc[0] == (uint8)crc) && (record->crc[1] == (uint8)(crc >> 8)) )
+		{
+			newest = sequence;
+			memcpy(password, record->data, JOURNAL_DATA_SIZE);
+		}
+	}
+	return (newest != 0) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_check
+* Description:			Function to check the invariants after a run
+* Parameters (in):    	Snapshot the run started from
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_check(const Fuzz_SnapshotType *snapshot)
+{
+	const uint8 *memory = g_fuzzBoard.eeprom.memory;
+	const uint8 *table = memory + CREDENTIAL_START_ADDRESS;
+	const uint8 *oldTable = snapshot->board.eeprom.memory + CREDENTIAL_START_ADDRESS;
+	uint8 password[JOURNAL_DATA_SIZE];
+	boolean hasPassword = FUZZ_findPassword(memory, password);
+
+	if(g_fuzzBoard.mcu2.stopReason != SIM_RUNNING)
+		FUZZ_fail(snapshot, "MCU2 stopped, reason %u", g_fuzzBoard.mcu2.stopReason);
+
+	if( g_fuzzMaintenance && snapshot->hasPassword && (g_fuzzAuthenticated == FALSE) )
+		FUZZ_fail(snapshot, "maintenance mode without an admin password check");
+	if(g_fuzzMaintenance)
+		return; /* the host may write anything in the EEPROM */
+
+	for(uint8 page = 0 ; page < JOURNAL_NUM_PAGES ; page++)
+	{
+		const uint8 *bytes = memory + JOURNAL_START_ADDRESS + page * JOURNAL_RECORD_SIZE;
+		const Journal_RecordType *record = (const Journal_RecordType *)bytes;
+		uint32 sequence = record->sequence[0] | ((uint32)record->sequence[1] << 8) | ((uint32)record->sequence[2] << 16);
+		uint16 crc = FUZZ_crc(bytes, JOURNAL_RECORD_SIZE - 2);
+		uint8 erased = 0;
+
+		for(uint8 i = 0 ; i < JOURNAL_RECORD_SIZE ; i++)
+		{
+			erased += (bytes[i] == FUZZ_ERASED) ? 1 : 0;
+		}
+		if(erased == JOURNAL_RECORD_SIZE)
+			continue;
+		if( (record->key >= JOURNAL_MAX_KEYS) || (sequence == 0) || (sequence > JOURNAL_MAX_SEQUENCE)
+				|| (record->crc[0] != (uint8)crc) || (record->crc[1] != (uint8)(crc >> 8)) )
+			FUZZ_fail(snapshot, "journal page %u is neither erased nor a valid record", page);
+		for(uint8 other = 0 ; other < page ; other++)
+		{
+			const Journal_RecordType *before = (const Journal_RecordType *)(memory + JOURNAL_START_ADDRESS + other * JOURNAL_RECORD_SIZE);
+			if( (before->key == record->key) && (memcmp(before->sequence, record->sequence, JOURNAL_SEQUENCE_SIZE) == 0) )
+				FUZZ_fail(snapshot, "journal page %u repeats the sequence of an older page", page);
+		}
+	}
+	if( snapshot->hasPassword && (hasPassword == FALSE) )
+		FUZZ_fail(snapshot, "the password was lost");
+	if( hasPassword && ((password[0] < PASSWORD_MIN_SIZE) || (password[0] > PASSWORD_MAX_SIZE)) )
+		FUZZ_fail(snapshot, "the password record holds a length of %u", password[0]);
+
+	for(uint8 slot = 0 ; slot < CREDENTIAL_NUM_SLOTS ; slot++)
+	{
+		const uint8 *bytes = table + slot * CREDENTIAL_RECORD_SIZE;
+		const Credential_RecordType *record = (const Credential_RecordType *)bytes;
+		uint16 crc = FUZZ_crc(bytes, CREDENTIAL_RECORD_SIZE - 2);
+
+		if( (record->tag == CREDENTIAL_TAG_EMPTY) || (record->tag == CREDENTIAL_TAG_REVOKED) )
+			continue;
+		if( (record->crc[0] != (uint8)crc) || (record->crc[1] != (uint8)(crc >> 8))
+				|| ((record->role != ROLE_ADMIN) && (record->role != ROLE_USER))
+				|| (record->secret.length < PASSWORD_MIN_SIZE) || (record->secret.length > PASSWORD_MAX_SIZE) )
+			FUZZ_fail(snapshot, "credential %u isn't valid", slot);
+	}
+
+	if(g_fuzzAuthenticated == FALSE)
+	{
+		if( snapshot->hasPassword && (memcmp(password, snapshot->password, JOURNAL_DATA_SIZE) != 0) )
+			FUZZ_fail(snapshot, "the password changed without an admin password check");
+		if(memcmp(table, oldTable, CREDENTIAL_NUM_SLOTS * CREDENTIAL_RECORD_SIZE) != 0)
+			FUZZ_fail(snapshot, "the users table changed without an admin password check");
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_fail
+* Description:			Function to report a broken invariant and abort
+* Parameters (in):    	Snapshot the run started from, then the message like printf
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_fail(const Fuzz_SnapshotType *snapshot,const char *format,...)
+{
+	va_list args;
+
+	fprintf(stderr, "fuzz: from the %s state, ", g_fuzzStartNames[snapshot - g_fuzzSnapshots]);
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fprintf(stderr, " at %.3f ms\n", (double)g_fuzzBoard.mcu2.cycles * 1000.0 / SIM_F_CPU);
+	abort();
+}
@@ -0,0 +1,570 @@
+/******************************************************************************
+*  File name:		sim_fuzz_main.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Small coverage guided fuzzer for LLVMFuzzerTestOneInput, for the hosts without
+ * clang and libFuzzer : the firmware is built by gcc with
+ * -fsanitize-coverage=trace-pc,trace-cmp, every branch taken calls
+ * __sanitizer_cov_trace_pc and every comparison one of the trace_cmp hooks below.
+ * The edges between two branches are counted in a 64 KB map like AFL does and an
+ * input is kept in the corpus when it gives an edge or a count bucket never seen.
+ * The constants the firmware compares with are kept as a dictionary, it finds the
+ * message ids and the MC_Ready handshake without being told about them.
+ *
+ *   fuzz_mcu2 [-runs=N] [-max_len=N] [-seed=N] [-max_total_time=S] [corpus_dir]
+ *   fuzz_mcu2 crash-file...
+ *
+ * The options have the names libFuzzer gives them so the harness can be linked
+ * with -fsanitize=fuzzer instead of this file where clang exists. With a
+ * directory the inputs found are written in it and it is read back first, with
+ * files every file is run once, to reproduce a crash. A crash writes the input
+ * that caused it to crash-<hash> in the current directory.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "../../Final_Project_MCU2/LIB/std_types.h"
+#include <dirent.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define FUZZ_MAP_SIZE				65536	/* edges, a power of 2 */
+#define FUZZ_MAX_CORPUS				4096
+#define FUZZ_DICTIONARY_SIZE		256		/* one flag per byte value */
+#define FUZZ_DEFAULT_MAX_LEN		256
+#define FUZZ_MUTATIONS				4		/* most changes made to an input before it is run */
+#define FUZZ_REPORT_SECONDS			5
+#define FUZZ_NAME_SIZE				4096
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+typedef struct
+{
+	uint8 *data;
+	size_t size;
+}Fuzz_InputType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+int LLVMFuzzerTestOneInput(const uint8 *data,size_t size);
+
+static uint8 g_fuzzMap[FUZZ_MAP_SIZE];		/* hits of every edge in the running input */
+static uint8 g_fuzzSeen[FUZZ_MAP_SIZE];		/* buckets of hits seen for every edge */
+static __thread uintptr_t g_fuzzPrevious;	/* last branch, shifted */
+static boolean g_fuzzDictionary[FUZZ_DICTIONARY_SIZE];
+static uint8 g_fuzzWords[FUZZ_DICTIONARY_SIZE];
+static uint16 g_fuzzNumWords = 0;
+
+static Fuzz_InputType g_fuzzCorpus[FUZZ_MAX_CORPUS];
+static uint32 g_fuzzCorpusSize = 0;
+static uint32 g_fuzzEdges = 0;
+static uint64 g_fuzzRandom = 0x9E3779B97F4A7C15ULL;
+
+/* the running input, written by the crash handler */
+static const uint8 *volatile g_fuzzCurrent;
+static volatile size_t g_fuzzCurrentSize;
+
+/* first inputs : nothing, the handshake and the messages of a session */
+static const uint8 g_fuzzSeed0[] = {0, 0xFC};
+static const uint8 g_fuzzSeed1[] = {1, 0x77, 4, '1', '2', '3', '4'};
+static const uint8 g_fuzzSeed2[] = {2, 0x99, 5, '5', '6', '7', '8', '9'};
+static const uint8 g_fuzzSeed3[] = {2, 0x3C};
+static const Fuzz_InputType g_fuzzSeeds[] =
+{
+	{(uint8 *)g_fuzzSeed0, sizeof(g_fuzzSeed0)},
+	{(uint8 *)g_fuzzSeed1, sizeof(g_fuzzSeed1)},
+	{(uint8 *)g_fuzzSeed2, sizeof(g_fuzzSeed2)},
+	{(uint8 *)g_fuzzSeed3, sizeof(g_fuzzSeed3)},
+};
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint32 FUZZ_random(uint32 limit);
+static uint64 FUZZ_hash(const uint8 *data,size_t size);
+static void FUZZ_addWord(uint64 value);
+static boolean FUZZ_run(const uint8 *data,size_t size);
+static void FUZZ_keep(const uint8 *data,size_t size,const char *directory);
+static size_t FUZZ_mutate(uint8 *data,size_t size,size_t maxLength);
+static boolean FUZZ_readFile(const char *name,Fuzz_InputType *input);
+static void FUZZ_writeFile(const char *name,const uint8 *data,size_t size);
+static void FUZZ_crash(int signal);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(int argc,char **argv)
+{
+	uint64 runs = 0;
+	uint64 maxRuns = 0;
+	size_t maxLength = FUZZ_DEFAULT_MAX_LEN;
+	uint32 maxTime = 0;
+	const char *directory = NULL_PTR;
+	time_t start = time(NULL_PTR);
+	time_t report = start;
+	uint8 *buffer;
+	int files = 0;
+
+	for(int i = 1 ; i < argc ; i++)
+	{
+		if(strncmp(argv[i], "-runs=", 6) == 0)
+			maxRuns = strtoull(argv[i] + 6, NULL_PTR, 0);
+		else if(strncmp(argv[i], "-max_len=", 9) == 0)
+			maxLength = strtoul(argv[i] + 9, NULL_PTR, 0);
+		else if(strncmp(argv[i], "-seed=", 6) == 0)
+			g_fuzzRandom = strtoull(argv[i] + 6, NULL_PTR, 0) | 1;
+		else if(strncmp(argv[i], "-max_total_time=", 16) == 0)
+			maxTime = strtoul(argv[i] + 16, NULL_PTR, 0);
+		else if(argv[i][0] == '-')
+		{
+			fprintf(stderr, "usage: %s [-runs=N] [-max_len=N] [-seed=N] [-max_total_time=S] [corpus_dir | file...]\n", argv[0]);
+			return 2;
+		}
+		else
+		{
+			struct stat info;
+			if( (stat(argv[i], &info) == 0) && S_ISDIR(info.st_mode) )
+				directory = argv[i];
+			else
+				argv[++files] = argv[i];
+		}
+	}
+	if(maxLength < 2)
+		maxLength = 2;
+
+	signal(SIGABRT, FUZZ_crash);
+	signal(SIGSEGV, FUZZ_crash);
+	signal(SIGBUS, FUZZ_crash);
+	signal(SIGFPE, FUZZ_crash);
+
+	/* reproduce */
+	if(files != 0)
+	{
+		for(int i = 1 ; i <= files ; i++)
+		{
+			Fuzz_InputType input;
+			if(FUZZ_readFile(argv[i], &input) == FALSE)
+			{
+				perror(argv[i]);
+				return 1;
+			}
+			printf("running %s, %zu bytes\n", argv[i], input.size);
+			FUZZ_run(input.data, input.size);
+			free(input.data);
+		}
+		printf("done, no crash\n");
+		return 0;
+	}
+
+	/* the corpus of the last runs then the seeds */
+	if(directory != NULL_PTR)
+	{
+		DIR *dir = opendir(directory);
+		struct dirent *entry;
+		while( (dir != NULL_PTR) && ((entry = readdir(dir)) != NULL_PTR) )
+		{
+			char name[FUZZ_NAME_SIZE];
+			Fuzz_InputType input;
+			if(entry->d_name[0] == '.')
+				continue;
+			snprintf(name, sizeof(name), "%s/%s", directory, entry->d_name);
+			if( FUZZ_readFile(name, &input) && (input.size != 0) && (input.size <= maxLength) )
+			{
+				if(FUZZ_run(input.data, input.size))
+					FUZZ_keep(input.data, input.size, NULL_PTR);
+				runs++;
+			}
+			free(input.data);
+		}
+		if(dir != NULL_PTR)
+			closedir(dir);
+	}
+	for(uint8 i = 0 ; i < sizeof(g_fuzzSeeds) / sizeof(g_fuzzSeeds[0]) ; i++)
+	{
+		if(FUZZ_run(g_fuzzSeeds[i].data, g_fuzzSeeds[i].size))
+			FUZZ_keep(g_fuzzSeeds[i].data, g_fuzzSeeds[i].size, directory);
+		runs++;
+	}
+	printf("#%llu INITED cov: %u corp: %u\n", (unsigned long long)runs, g_fuzzEdges, g_fuzzCorpusSize);
+	fflush(stdout);
+
+	buffer = malloc(maxLength);
+	if(buffer == NULL_PTR)
+		return 1;
+	while( ((maxRuns == 0) || (runs < maxRuns)) && ((maxTime == 0) || (time(NULL_PTR) - start < (time_t)maxTime)) )
+	{
+		const Fuzz_InputType *parent = &g_fuzzCorpus[FUZZ_random(g_fuzzCorpusSize)];
+		size_t size = (parent->size < maxLength) ? parent->size : maxLength;
+		time_t now;
+
+		memcpy(buffer, parent->data, size);
+		size = FUZZ_mutate(buffer, size, maxLength);
+		if(FUZZ_run(buffer, size))
+		{
+			FUZZ_keep(buffer, size, directory);
+			printf("#%llu NEW cov: %u corp: %u len: %zu\n", (unsigned long long)runs, g_fuzzEdges, g_fuzzCorpusSize, size);
+			fflush(stdout);
+		}
+		runs++;
+
+		now = time(NULL_PTR);
+		if(now - report >= FUZZ_REPORT_SECONDS)
+		{
+			report = now;
+			printf("#%llu pulse cov: %u corp: %u exec/s: %llu\n", (unsigned long long)runs, g_fuzzEdges, g_fuzzCorpusSize,
+					(unsigned long long)(runs / (uint64)(now - start)));
+			fflush(stdout);
+		}
+	}
+	printf("#%llu DONE cov: %u corp: %u exec/s: %llu\n", (unsigned long long)runs, g_fuzzEdges, g_fuzzCorpusSize,
+			(unsigned long long)(runs / (uint64)((time(NULL_PTR) - start) ? (time(NULL_PTR) - start) : 1)));
+	free(buffer);
+	return 0;
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/* the hooks gcc calls, they must not be instrumented themselves */
+
+void __sanitizer_cov_trace_pc(void)
+{
+	uintptr_t location = (uintptr_t)__builtin_return_address(0);
+	location = (location ^ (location >> 16)) & (FUZZ_MAP_SIZE - 1);
+	if(g_fuzzMap[location ^ g_fuzzPrevious] != 0xFF)
+		g_fuzzMap[location ^ g_fuzzPrevious]++;
+	g_fuzzPrevious = location >> 1;
+}
+
+void __sanitizer_cov_trace_cmp1(uint8 arg1,uint8 arg2) { FUZZ_addWord(arg1); FUZZ_addWord(arg2); }
+void __sanitizer_cov_trace_cmp2(uint16 arg1,uint16 arg2) { FUZZ_addWord(arg1); FUZZ_addWord(arg2); }
+void __sanitizer_cov_trace_cmp4(uint32 arg1,uint32 arg2) { FUZZ_addWord(arg1); FUZZ_addWord(arg2); }
+void __sanitizer_cov_trace_cmp8(uint64 arg1,uint64 arg2) { FUZZ_addWord(arg1); FUZZ_addWord(arg2); }
+void __sanitizer_cov_trace_const_cmp1(uint8 arg1,uint8 arg2) { FUZZ_addWord(arg1); (void)arg2; }
+void __sanitizer_cov_trace_const_cmp2(uint16 arg1,uint16 arg2) { FUZZ_addWord(arg1); (void)arg2; }
+void __sanitizer_cov_trace_const_cmp4(uint32 arg1,uint32 arg2) { FUZZ_addWord(arg1); (void)arg2; }
+void __sanitizer_cov_trace_const_cmp8(uint64 arg1,uint64 arg2) { FUZZ_addWord(arg1); (void)arg2; }
+void __sanitizer_cov_trace_cmpf(float arg1,float arg2) { (void)arg1; (void)arg2; }
+void __sanitizer_cov_trace_cmpd(double arg1,double arg2) { (void)arg1; (void)arg2; }
+
+/* cases[0] is the number of cases, cases[1] their size in bits, then the cases */
+void __sanitizer_cov_trace_switch(uint64 value,uint64 *cases)
+{
+	(void)value;
+	for(uint64 i = 0 ; i < cases[0] ; i++)
+	{
+		FUZZ_addWord(cases[i + 2]);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_random
+* Description:			Function to get a random number, xorshift64
+* Parameters (in):    	Limit, not 0
+* Parameters (out):   	Number from 0 to limit - 1
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 FUZZ_random(uint32 limit)
+{
+	g_fuzzRandom ^= g_fuzzRandom << 13;
+	g_fuzzRandom ^= g_fuzzRandom >> 7;
+	g_fuzzRandom ^= g_fuzzRandom << 17;
+	return (uint32)(g_fuzzRandom % limit);
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_hash
+* Description:			Function to name an input by its content, FNV-1a
+* Parameters (in):    	Bytes and their number
+* Parameters (out):   	Hash
+* Return value:      	uint64
+********************************************************************************/
+
+static uint64 FUZZ_hash(const uint8 *data,size_t size)
+{
+	uint64 hash = 0xCBF29CE484222325ULL;
+
+	for(size_t i = 0 ; i < size ; i++)
+	{
+		hash = (hash ^ data[i]) * 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_addWord
+* Description:			Function to add a value the firmware compared with to the dictionary,
+* 						the link carries bytes so only the values of a byte are kept
+* Parameters (in):    	Value
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_addWord(uint64 value)
+{
+	if( (value < FUZZ_DICTIONARY_SIZE) && (g_fuzzDictionary[value] == FALSE) )
+	{
+		g_fuzzDictionary[value] = TRUE;
+		g_fuzzWords[g_fuzzNumWords++] = (uint8)value;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_run
+* Description:			Function to run an input and merge its edges with the ones seen
+* Parameters (in):    	Bytes and their number
+* Parameters (out):   	TRUE if the input gave a new edge or a new count of an edge
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean FUZZ_run(const uint8 *data,size_t size)
+{
+	boolean found = FALSE;
+	uint64 *map = (uint64 *)g_fuzzMap;
+
+	memset(g_fuzzMap, 0, sizeof(g_fuzzMap));
+	g_fuzzPrevious = 0;
+	g_fuzzCurrent = data;
+	g_fuzzCurrentSize = size;
+	LLVMFuzzerTestOneInput(data, size);
+
+	for(uint32 word = 0 ; word < FUZZ_MAP_SIZE / sizeof(uint64) ; word++)
+	{
+		if(map[word] == 0)
+			continue;
+		for(uint32 edge = word * sizeof(uint64) ; edge < (word + 1) * sizeof(uint64) ; edge++)
+		{
+			uint8 hits = g_fuzzMap[edge];
+			uint8 bucket;
+			if(hits == 0)
+				continue;
+			/* 1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+ like AFL */
+			bucket = (hits < 4) ? (uint8)(1 << (hits - 1)) : (hits < 8) ? 0x08 : (hits < 16) ? 0x10
+					: (hits < 32) ? 0x20 : (hits < 128) ? 0x40 : 0x80;
+			if((g_fuzzSeen[edge] & bucket) == 0)
+			{
+				if(g_fuzzSeen[edge] == 0)
+					g_fuzzEdges++;
+				g_fuzzSeen[edge] |= bucket;
+				found = TRUE;
+			}
+		}
+	}
+	return found;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_keep
+* Description:			Function to add an input to the corpus and to write it in the corpus directory
+* Parameters (in):    	Bytes, their number and the directory, NULL_PTR to not write it
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_keep(const uint8 *data,size_t size,const char *directory)
+{
+	Fuzz_InputType *input;
+
+	if(g_fuzzCorpusSize == FUZZ_MAX_CORPUS)
+		input = &g_fuzzCorpus[FUZZ_random(FUZZ_MAX_CORPUS)]; /* full, an older input goes */
+	else
+		input = &g_fuzzCorpus[g_fuzzCorpusSize++];
+	free(input->data);
+	input->data = malloc(size);
+	if(input->data == NULL_PTR)
+	{
+		fprintf(stderr, "fuzz: no memory for the corpus\n");
+		exit(1);
+	}
+	memcpy(input->data, data, size);
+	input->size = size;
+
+	if(directory != NULL_PTR)
+	{
+		char name[FUZZ_NAME_SIZE];
+		snprintf(name, sizeof(name), "%s/%016llx", directory, (unsigned long long)FUZZ_hash(data, size));
+		FUZZ_writeFile(name, data, size);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_mutate
+* Description:			Function to change an input a few times, the first byte picks the state
+* 						the harness starts from and is only changed on its own
+* Parameters (in):    	Bytes, their number and the most bytes the input may have
+* Parameters (out):   	New number of bytes
+* Return value:      	size_t
+********************************************************************************/
+
+static size_t FUZZ_mutate(uint8 *data,size_t size,size_t maxLength)
+{
+	uint8 count = (uint8)(1 + FUZZ_random(FUZZ_MUTATIONS));
+
+	if(size == 0)
+		data[size++] = 0;
+	for(uint8 i = 0 ; i < count ; i++)
+	{
+		size_t position = 1 + FUZZ_random((uint32)size);	/* 1 to size */
+		size_t length = 1 + FUZZ_random(8);
+
+		switch(FUZZ_random(9))
+		{
+		case 0: /* flip a bit */
+			if(size > 1)
+				data[1 + FUZZ_random((uint32)size - 1)] ^= (uint8)(1 << FUZZ_random(8));
+			break;
+		case 1: /* random byte */
+			if(size > 1)
+				data[1 + FUZZ_random((uint32)size - 1)] = (uint8)FUZZ_random(256);
+			break;
+		case 2: /* byte the firmware compares with */
+			if( (size > 1) && (g_fuzzNumWords != 0) )
+				data[1 + FUZZ_random((uint32)size - 1)] = g_fuzzWords[FUZZ_random(g_fuzzNumWords)];
+			break;
+		case 3: /* insert a byte the firmware compares with */
+			if( (size < maxLength) && (g_fuzzNumWords != 0) )
+			{
+				memmove(data + position + 1, data + position, size - position);
+				data[position] = g_fuzzWords[FUZZ_random(g_fuzzNumWords)];
+				size++;
+			}
+			break;
+		case 4: /* insert random bytes */
+			length = (size + length > maxLength) ? (maxLength - size) : length;
+			memmove(data + position + length, data + position, size - position);
+			for(size_t k = 0 ; k < length ; k++)
+			{
+				data[position + k] = (uint8)FUZZ_random(256);
+			}
+			size += length;
+			break;
+		case 5: /* delete bytes */
+			if(position < size)
+			{
+				length = (position + length > size) ? (size - position) : length;
+				memmove(data + position, data + position + length, size - position - length);
+				size -= length;
+			}
+			break;
+		case 6: /* repeat bytes, a message sent twice */
+			if( (position < size) && (size < maxLength) )
+			{
+				length = (position + length > size) ? (size - position) : length;
+				length = (size + length > maxLength) ? (maxLength - size) : length;
+				memmove(data + position + length, data + position, size - position);
+				size += length;
+			}
+			break;
+		case 7: /* splice the tail of another input */
+		{
+			const Fuzz_InputType *other = &g_fuzzCorpus[FUZZ_random(g_fuzzCorpusSize)];
+			if(other->size > 1)
+			{
+				size_t from = 1 + FUZZ_random((uint32)other->size - 1);
+				length = other->size - from;
+				length = (position + length > maxLength) ? (maxLength - position) : length;
+				memcpy(data + position, other->data + from, length);
+				size = position + length;
+			}
+			break;
+		}
+		default: /* other state to start from */
+			data[0] = (uint8)FUZZ_random(256);
+			break;
+		}
+	}
+	return size;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_readFile
+* Description:			Function to read a whole file in memory
+* Parameters (in):    	Name and the input to fill, its data must be freed
+* Parameters (out):   	TRUE or FALSE if the file couldn't be read
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean FUZZ_readFile(const char *name,Fuzz_InputType *input)
+{
+	FILE *file = fopen(name, "rb");
+	long size;
+
+	input->data = NULL_PTR;
+	input->size = 0;
+	if(file == NULL_PTR)
+		return FALSE;
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	rewind(file);
+	input->data = malloc((size > 0) ? (size_t)size : 1);
+	if( (size < 0) || (input->data == NULL_PTR) || (fread(input->data, 1, (size_t)size, file) != (size_t)size) )
+	{
+		fclose(file);
+		return FALSE;
+	}
+	input->size = (size_t)size;
+	fclose(file);
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_writeFile
+* Description:			Function to write bytes to a file, it is replaced if it exists
+* Parameters (in):    	Name, bytes and their number
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_writeFile(const char *name,const uint8 *data,size_t size)
+{
+	FILE *file = fopen(name, "wb");
+
+	if(file == NULL_PTR)
+	{
+		perror(name);
+		return;
+	}
+	fwrite(data, 1, size, file);
+	fclose(file);
+}
+
+/*******************************************************************************
+* Function Name:		FUZZ_crash
+* Description:			Signal handler to save the input that crashed, a broken invariant aborts
+* Parameters (in):    	Signal
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void FUZZ_crash(int signal)
+{
+	char name[32];
+
+	snprintf(name, sizeof(name), "crash-%016llx", (unsigned long long)FUZZ_hash(g_fuzzCurrent, g_fuzzCurrentSize));
+	FUZZ_writeFile(name, g_fuzzCurrent, g_fuzzCurrentSize);
+	fprintf(stderr, "fuzz: signal %d, input of %zu bytes written to %s\n", signal, (size_t)g_fuzzCurrentSize, name);
+	_exit(1);
+}
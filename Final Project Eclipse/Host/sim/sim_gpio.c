@@ -0,0 +1,49 @@
+/******************************************************************************
+*  File name:		sim_gpio.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+uint8 SIM_GPIO_readPin(Sim_ContextType *ctx,uint8 port)
+{
+	uint8 ddr = ctx->io[SIM_DDR_ADDRESS(port)];
+	uint8 output = ctx->io[SIM_PORT_ADDRESS(port)];
+	/* an input nobody drives is held high by its pull-up or the one on the board */
+	uint8 input = (ctx->gpio.driven[port] & ctx->gpio.level[port]) | (uint8)~ctx->gpio.driven[port];
+
+	return (output & ddr) | (input & (uint8)~ddr);
+}
+
+void SIM_GPIO_drive(Sim_ContextType *ctx,uint8 port,uint8 pin,uint8 level)
+{
+	ctx->gpio.driven[port] |= (1<<pin);
+	if(level == LOGIC_HIGH)
+	{
+		ctx->gpio.level[port] |= (1<<pin);
+	}
+	else
+	{
+		ctx->gpio.level[port] &= ~(1<<pin);
+	}
+}
+
+void SIM_GPIO_release(Sim_ContextType *ctx,uint8 port,uint8 pin)
+{
+	ctx->gpio.driven[port] &= ~(1<<pin);
+}
+
+uint8 SIM_GPIO_getOutput(Sim_ContextType *ctx,uint8 port)
+{
+	/* pins driven high by the MCU, an input pin is never driven */
+	return ctx->io[SIM_PORT_ADDRESS(port)] & ctx->io[SIM_DDR_ADDRESS(port)];
+}
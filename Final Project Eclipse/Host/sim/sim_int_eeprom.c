@@ -0,0 +1,99 @@
+/******************************************************************************
+*  File name:		sim_int_eeprom.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+#include <avr/eeprom.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SIM_INT_EEPROM_READ_CYCLES		12		/* eeprom_read_byte of avr-libc, the CPU is halted 4 of them */
+#define SIM_INT_EEPROM_START_CYCLES		20		/* eeprom_write_byte of avr-libc up to EEWE */
+#define SIM_INT_EEPROM_WRITE_US			8500	/* 8448 clocks of the 1 MHz calibrated oscillator */
+#define SIM_INT_EEPROM_ADDRESS_MASK		(SIM_INT_EEPROM_SIZE - 1)
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void SIM_INT_EEPROM_wait(Sim_ContextType *ctx);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+uint64 SIM_INT_EEPROM_run(Sim_ContextType *ctx)
+{
+	Sim_IntEepromType *eeprom = &ctx->intEeprom;
+
+	if(eeprom->busy && (eeprom->end <= ctx->cycles))
+	{
+		eeprom->memory[eeprom->address] = eeprom->data;
+		eeprom->busy = FALSE;
+		eeprom->writes++;
+	}
+	return eeprom->busy ? eeprom->end : SIM_FOREVER;
+}
+
+unsigned char SIM_eepromReadByte(const unsigned char *address)
+{
+	Sim_ContextType *ctx = g_simCurrent;
+
+	if(ctx == NULL_PTR)
+		return 0xFF;
+
+	SIM_INT_EEPROM_wait(ctx);
+	SIM_delayCycles(SIM_INT_EEPROM_READ_CYCLES);
+	ctx->intEeprom.reads++;
+	return ctx->intEeprom.memory[(uintptr_t)address & SIM_INT_EEPROM_ADDRESS_MASK];
+}
+
+void SIM_eepromWriteByte(unsigned char *address,unsigned char value)
+{
+	Sim_ContextType *ctx = g_simCurrent;
+	Sim_IntEepromType *eeprom;
+
+	if(ctx == NULL_PTR)
+		return;
+
+	eeprom = &ctx->intEeprom;
+	SIM_INT_EEPROM_wait(ctx);
+	SIM_delayCycles(SIM_INT_EEPROM_START_CYCLES);
+	eeprom->busy = TRUE;
+	eeprom->end = ctx->cycles + (uint64)SIM_INT_EEPROM_WRITE_US * (SIM_F_CPU / 1000000ULL);
+	eeprom->address = (uint16)((uintptr_t)address & SIM_INT_EEPROM_ADDRESS_MASK);
+	eeprom->data = value;
+	SIM_schedule(ctx, eeprom->end);
+}
+
+unsigned char SIM_eepromIsBusy(void)
+{
+	Sim_ContextType *ctx = g_simCurrent;
+	return (ctx != NULL_PTR) && ctx->intEeprom.busy;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_INT_EEPROM_wait
+* Description:			Function to let the clock run to the end of the write in progress, the
+* 						avr-libc routines poll EEWE meanwhile
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_INT_EEPROM_wait(Sim_ContextType *ctx)
+{
+	while(ctx->intEeprom.busy)
+	{
+		SIM_delayCycles((ctx->intEeprom.end > ctx->cycles) ? (ctx->intEeprom.end - ctx->cycles) : 0);
+	}
+}
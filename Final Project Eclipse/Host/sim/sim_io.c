@@ -0,0 +1,243 @@
+/******************************************************************************
+*  File name:		sim_io.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Meaning of the register accesses. The register file holds what the firmware
+ * reads and writes, a read is prepared from the state of the peripheral just
+ * before it happens and a write is handed to the peripheral just after the store.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static const char *const g_simRegisterNames[SIM_IO_SIZE] =
+{
+	[0x20] = "TWBR", [0x21] = "TWSR", [0x22] = "TWAR", [0x23] = "TWDR",
+	[0x24] = "ADCL", [0x25] = "ADCH", [0x26] = "ADCSRA", [0x27] = "ADMUX",
+	[0x28] = "ACSR", [0x29] = "UBRRL", [0x2A] = "UCSRB", [0x2B] = "UCSRA",
+	[0x2C] = "UDR", [0x2D] = "SPCR", [0x2E] = "SPSR", [0x2F] = "SPDR",
+	[0x30] = "PIND", [0x31] = "DDRD", [0x32] = "PORTD",
+	[0x33] = "PINC", [0x34] = "DDRC", [0x35] = "PORTC",
+	[0x36] = "PINB", [0x37] = "DDRB", [0x38] = "PORTB",
+	[0x39] = "PINA", [0x3A] = "DDRA", [0x3B] = "PORTA",
+	[0x3C] = "EECR", [0x3D] = "EEDR", [0x3E] = "EEARL", [0x3F] = "EEARH",
+	[0x40] = "UBRRH/UCSRC", [0x41] = "WDTCR", [0x42] = "ASSR",
+	[0x43] = "OCR2", [0x44] = "TCNT2", [0x45] = "TCCR2",
+	[0x46] = "ICR1L", [0x47] = "ICR1H", [0x48] = "OCR1BL", [0x49] = "OCR1BH",
+	[0x4A] = "OCR1AL", [0x4B] = "OCR1AH", [0x4C] = "TCNT1L", [0x4D] = "TCNT1H",
+	[0x4E] = "TCCR1B", [0x4F] = "TCCR1A", [0x50] = "SFIOR", [0x51] = "OSCCAL",
+	[0x52] = "TCNT0", [0x53] = "TCCR0", [0x54] = "MCUCSR", [0x55] = "MCUCR",
+	[0x56] = "TWCR", [0x57] = "SPMCR", [0x58] = "TIFR", [0x59] = "TIMSK",
+	[0x5A] = "GIFR", [0x5B] = "GICR", [0x5C] = "OCR0", [0x5D] = "SPL",
+	[0x5E] = "SPH", [0x5F] = "SREG"
+};
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static boolean SIM_IO_isTimerRegister(uint8 address);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+const char *SIM_getRegisterName(uint8 address)
+{
+	return (address < SIM_IO_SIZE) ? g_simRegisterNames[address] : NULL_PTR;
+}
+
+void SIM_IO_read(Sim_ContextType *ctx,uint8 address,uint8 size)
+{
+	uint8 previous = ctx->lastRead;
+	ctx->lastRead = address;
+
+	switch(address)
+	{
+	case 0x30: case 0x33: case 0x36: case 0x39: /* PINx */
+		ctx->io[address] = SIM_GPIO_readPin(ctx, (uint8)((SIM_PORTA - 2 - address) / 3));
+		break;
+	case SIM_UCSRA:
+		ctx->io[address] = (ctx->io[address] & ((1<<U2X) | (1<<MPCM))) | SIM_UART_readStatus(ctx);
+		break;
+	case SIM_UDR:
+		ctx->io[address] = SIM_UART_readData(ctx);
+		break;
+	case SIM_UBRRH:
+		/* UCSRC is only read by two reads in a row */
+		ctx->io[address] = (previous == SIM_UBRRH) ? ctx->uart.ucsrc : ctx->uart.ubrrh;
+		break;
+	case SIM_TWCR:
+		ctx->io[address] = ctx->twi.twcr;
+		break;
+	case SIM_TWSR:
+		ctx->io[address] = (ctx->twi.status & 0xF8) | ctx->twi.prescaler;
+		break;
+	case SIM_TWDR:
+		ctx->io[address] = ctx->twi.data;
+		break;
+	case SIM_ADCSRA:
+		ctx->io[address] = SIM_ADC_readControl(ctx);
+		break;
+	case SIM_ADCL: case SIM_ADCH:
+	{
+		uint16 result = ctx->adc.result;
+		if(ctx->io[SIM_ADMUX] & (1<<ADLAR))
+		{
+			result <<= 6;
+		}
+		ctx->io[SIM_ADCL] = (uint8)result;
+		ctx->io[SIM_ADCH] = (uint8)(result >> 8);
+		break;
+	}
+	case SIM_TCNT0:
+		SIM_TIMER_sync(ctx);
+		ctx->io[address] = (uint8)ctx->timers[0].count;
+		break;
+	case SIM_TCNT1L: case SIM_TCNT1H:
+		SIM_TIMER_sync(ctx);
+		ctx->io[SIM_TCNT1L] = (uint8)ctx->timers[1].count;
+		ctx->io[SIM_TCNT1H] = (uint8)(ctx->timers[1].count >> 8);
+		break;
+	case SIM_TCNT2:
+		SIM_TIMER_sync(ctx);
+		ctx->io[address] = (uint8)ctx->timers[2].count;
+		break;
+	case SIM_TIFR:
+		SIM_TIMER_sync(ctx); /* sets the flags up to now */
+		break;
+	default:
+		break;
+	}
+	(void)size;
+}
+
+void SIM_IO_beforeWrite(Sim_ContextType *ctx,uint8 address,uint8 size)
+{
+	ctx->lastRead = 0;
+	/* the timer counted with its old settings up to this write */
+	if( SIM_IO_isTimerRegister(address) || ((size == 2) && SIM_IO_isTimerRegister(address + 1)) )
+	{
+		SIM_TIMER_sync(ctx);
+	}
+}
+
+void SIM_IO_write(Sim_ContextType *ctx,uint8 address,uint8 size,uint16 old)
+{
+	uint8 value = ctx->io[address];
+
+	switch(address)
+	{
+	case 0x30: case 0x33: case 0x36: case 0x39: /* PINx is read only on the ATmega32 */
+		ctx->io[address] = (uint8)old;
+		break;
+	case 0x31: case 0x32: case 0x34: case 0x35: case 0x37: case 0x38: case 0x3A: case 0x3B: /* DDRx and PORTx */
+		if(ctx->gpio.onChange != NULL_PTR)
+		{
+			ctx->gpio.onChange(ctx, (uint8)((SIM_PORTA - address) / 3));
+		}
+		break;
+	case SIM_UDR:
+		SIM_UART_transmit(ctx, value);
+		break;
+	case SIM_UCSRA:
+		if(value & (1<<TXC))
+		{
+			ctx->uart.txComplete = FALSE; /* cleared by writing 1 */
+		}
+		ctx->io[address] = value & ((1<<U2X) | (1<<MPCM));
+		break;
+	case SIM_UBRRH:
+		if(value & (1<<URSEL))
+		{
+			ctx->uart.ucsrc = value;
+		}
+		else
+		{
+			ctx->uart.ubrrh = value & 0x0F;
+		}
+		ctx->io[address] = ctx->uart.ubrrh;
+		break;
+	case SIM_TWCR:
+		SIM_TWI_control(ctx, value);
+		ctx->io[address] = ctx->twi.twcr;
+		break;
+	case SIM_TWSR:
+		ctx->twi.prescaler = value & ((1<<TWPS1) | (1<<TWPS0));
+		break;
+	case SIM_TWDR:
+		if(ctx->twi.twcr & (1<<TWINT))
+		{
+			ctx->twi.data = value;
+		}
+		else
+		{
+			ctx->twi.twcr |= (1<<TWWC); /* the byte on the bus can't be changed */
+		}
+		break;
+	case SIM_ADCSRA:
+		if(value & (1<<ADIF))
+		{
+			ctx->adc.complete = FALSE;
+		}
+		if((value & (1<<ADEN)) == 0)
+		{
+			ctx->adc.busy = FALSE;
+			ctx->adc.firstConversion = TRUE;
+		}
+		else if(value & (1<<ADSC))
+		{
+			SIM_ADC_start(ctx);
+		}
+		ctx->io[address] = value & ~((1<<ADSC) | (1<<ADIF));
+		break;
+	case SIM_TCNT0:
+		SIM_TIMER_setCount(ctx, 0, value);
+		break;
+	case SIM_TCNT1L: case SIM_TCNT1H:
+		SIM_TIMER_setCount(ctx, 1, SIM_REG16(ctx, SIM_TCNT1L));
+		break;
+	case SIM_TCNT2:
+		SIM_TIMER_setCount(ctx, 2, value);
+		break;
+	case SIM_TCCR0:
+		ctx->io[address] = value & ~(1<<FOC0); /* strobes read as 0 */
+		break;
+	case SIM_TCCR1A:
+		ctx->io[address] = value & ~((1<<FOC1A) | (1<<FOC1B));
+		break;
+	case SIM_TCCR2:
+		ctx->io[address] = value & ~(1<<FOC2);
+		break;
+	case SIM_TIFR:
+		ctx->io[address] = (uint8)old & ~value; /* flags are cleared by writing 1 */
+		break;
+	default:
+		break;
+	}
+	(void)size;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_IO_isTimerRegister
+* Description:			Function to know if a write changes how the timers count
+* Parameters (in):    	Address
+* Parameters (out):   	TRUE or FALSE
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean SIM_IO_isTimerRegister(uint8 address)
+{
+	return ( ((address >= SIM_OCR2) && (address <= SIM_TCCR1A)) || (address == SIM_TCNT0) || (address == SIM_TCCR0)
+			|| (address == SIM_TIFR) || (address == SIM_TIMSK) || (address == SIM_OCR0) ) ? TRUE : FALSE;
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+*  File name:		sim_keypad.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Matrix keypad with one button held at a time. The button ties its row to its
+ * column, so the column reads low while the MCU drives the row low and follows
+ * the pull-up the rest of the time. A key is seen once the MCU read its column
+ * low, the caller then knows when it can let the button go.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <string.h>
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_KEYPAD_update(Sim_ContextType *ctx,Sim_KeypadType *keypad)
+{
+	uint8 row, col;
+
+	if(keypad->pressed < 0)
+		return;
+
+	row = (uint8)(keypad->firstRowPin + keypad->pressed / keypad->numCols);
+	col = (uint8)(keypad->firstColPin + keypad->pressed % keypad->numCols);
+	/* the row is driven low when it is an output at 0, an input row floats */
+	if( (ctx->io[SIM_DDR_ADDRESS(keypad->rowPort)] & (1<<row)) && !(ctx->io[SIM_PORT_ADDRESS(keypad->rowPort)] & (1<<row)) )
+	{
+		SIM_GPIO_drive(ctx, keypad->colPort, col, LOGIC_LOW);
+	}
+	else
+	{
+		SIM_GPIO_release(ctx, keypad->colPort, col);
+	}
+}
+
+void SIM_KEYPAD_read(Sim_ContextType *ctx,Sim_KeypadType *keypad,uint8 port,uint8 value)
+{
+	uint8 col;
+
+	if( (keypad->pressed < 0) || keypad->seen || (port != keypad->colPort) )
+		return;
+
+	col = (uint8)(keypad->firstColPin + keypad->pressed % keypad->numCols);
+	if((value & (1<<col)) == 0)
+	{
+		keypad->seen = TRUE;
+		SIM_yield(ctx);
+	}
+}
+
+boolean SIM_KEYPAD_press(Sim_ContextType *ctx,Sim_KeypadType *keypad,char key)
+{
+	const char *button = strchr(keypad->layout, key);
+
+	if( (key == '\0') || (button == NULL_PTR) )
+		return FALSE;
+
+	SIM_KEYPAD_release(ctx, keypad);
+	keypad->pressed = (sint8)(button - keypad->layout);
+	keypad->seen = FALSE;
+	keypad->presses++;
+	SIM_KEYPAD_update(ctx, keypad);
+	return TRUE;
+}
+
+void SIM_KEYPAD_release(Sim_ContextType *ctx,Sim_KeypadType *keypad)
+{
+	if(keypad->pressed < 0)
+		return;
+
+	SIM_GPIO_release(ctx, keypad->colPort, (uint8)(keypad->firstColPin + keypad->pressed % keypad->numCols));
+	keypad->pressed = -1;
+	keypad->seen = FALSE;
+}
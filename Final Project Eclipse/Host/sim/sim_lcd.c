@@ -0,0 +1,231 @@
+/******************************************************************************
+*  File name:		sim_lcd.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * HD44780 controller. RS and the data pins are latched on the falling edge of
+ * E, in 4 bits mode the high nibble comes first. Only what shows on a 2x16
+ * display is modelled : the DDRAM with its two lines at 0x00 and 0x40, the
+ * address counter and the instructions that move it. The CGRAM writes and the
+ * display shift are accepted but change nothing. A transfer during the execution
+ * time of the one before is done anyway and counted, the real controller could
+ * drop it.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <string.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SIM_LCD_LINE_LENGTH		0x28	/* DDRAM bytes of a line */
+#define SIM_LCD_SECOND_LINE		0x40
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void SIM_LCD_execute(Sim_ContextType *ctx,Sim_LcdType *lcd,boolean data,uint8 byte);
+static void SIM_LCD_move(Sim_LcdType *lcd,boolean increment);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_LCD_init(Sim_LcdType *lcd)
+{
+	/* state after the internal reset : 8 bits, display off, increment */
+	memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+	lcd->address = 0;
+	lcd->increment = TRUE;
+	lcd->displayOn = FALSE;
+	lcd->cgram = FALSE;
+	lcd->fourBits = FALSE;
+	lcd->lowNibble = FALSE;
+	lcd->enable = FALSE;
+	lcd->busyUntil = 0;
+}
+
+void SIM_LCD_update(Sim_ContextType *ctx,Sim_LcdType *lcd)
+{
+	boolean enable = (SIM_GPIO_getOutput(ctx, lcd->ePort) & (1<<lcd->ePin)) ? TRUE : FALSE;
+	boolean data;
+	uint8 bus;
+	uint8 byte;
+
+	if( (lcd->enable == FALSE) || enable )
+	{
+		lcd->enable = enable;
+		return;
+	}
+	lcd->enable = FALSE;
+
+	/* falling edge of E */
+	data = (SIM_GPIO_getOutput(ctx, lcd->rsPort) & (1<<lcd->rsPin)) ? TRUE : FALSE;
+	bus = (uint8)(SIM_GPIO_getOutput(ctx, lcd->dataPort) >> lcd->firstDataPin);
+	if(lcd->fourPins)
+	{
+		bus = (uint8)((bus & 0x0F) << 4); /* DB0..DB3 aren't wired and read 0 */
+	}
+	if(lcd->fourBits)
+	{
+		if(lcd->lowNibble == FALSE)
+		{
+			lcd->highNibble = bus & 0xF0;
+			lcd->lowNibble = TRUE;
+			return;
+		}
+		byte = (uint8)(lcd->highNibble | (bus >> 4));
+		lcd->lowNibble = FALSE;
+	}
+	else
+	{
+		byte = bus;
+	}
+
+	if(ctx->cycles < lcd->busyUntil)
+	{
+		lcd->tooEarly++;
+	}
+	SIM_LCD_execute(ctx, lcd, data, byte);
+}
+
+void SIM_LCD_getRow(const Sim_LcdType *lcd,uint8 row,char *text)
+{
+	for(uint8 i = 0 ; i < SIM_LCD_COLUMNS ; i++)
+	{
+		char c = lcd->ddram[(row == 0 ? 0 : SIM_LCD_SECOND_LINE) + i];
+		text[i] = ( (c >= ' ') && (c <= '~') ) ? c : '?'; /* the custom characters aren't known */
+	}
+	text[SIM_LCD_COLUMNS] = '\0';
+}
+
+boolean SIM_LCD_contains(const Sim_LcdType *lcd,const char *text)
+{
+	char row[SIM_LCD_COLUMNS + 1];
+
+	if(lcd->displayOn == FALSE)
+		return FALSE;
+	for(uint8 i = 0 ; i < SIM_LCD_ROWS ; i++)
+	{
+		SIM_LCD_getRow(lcd, i, row);
+		if(strstr(row, text) != NULL_PTR)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_LCD_execute
+* Description:			Function to run an instruction or write a character
+* Parameters (in):    	Context, LCD, TRUE for data (RS high) and the byte
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_LCD_execute(Sim_ContextType *ctx,Sim_LcdType *lcd,boolean data,uint8 byte)
+{
+	uint32 us = SIM_LCD_COMMAND_US;
+
+	if(data)
+	{
+		if(lcd->cgram == FALSE)
+		{
+			lcd->ddram[lcd->address] = (char)byte;
+			lcd->characters++;
+			lcd->changes++;
+			SIM_LCD_move(lcd, lcd->increment);
+			SIM_yield(ctx);
+		}
+	}
+	else
+	{
+		lcd->commands++;
+		if(byte & 0x80)			/* set DDRAM address */
+		{
+			lcd->address = byte & 0x7F;
+			lcd->cgram = FALSE;
+		}
+		else if(byte & 0x40)	/* set CGRAM address */
+		{
+			lcd->cgram = TRUE;
+		}
+		else if(byte & 0x20)	/* function set */
+		{
+			lcd->fourBits = (byte & 0x10) ? FALSE : TRUE;
+			lcd->lowNibble = FALSE;
+		}
+		else if(byte & 0x10)	/* cursor or display shift */
+		{
+			if((byte & 0x08) == 0)
+			{
+				SIM_LCD_move(lcd, (byte & 0x04) ? TRUE : FALSE);
+			}
+		}
+		else if(byte & 0x08)	/* display on/off control */
+		{
+			lcd->displayOn = (byte & 0x04) ? TRUE : FALSE;
+			lcd->changes++;
+			SIM_yield(ctx);
+		}
+		else if(byte & 0x04)	/* entry mode set */
+		{
+			lcd->increment = (byte & 0x02) ? TRUE : FALSE;
+		}
+		else if(byte & 0x02)	/* return home */
+		{
+			lcd->address = 0;
+			lcd->cgram = FALSE;
+			us = SIM_LCD_CLEAR_US;
+		}
+		else if(byte & 0x01)	/* clear display */
+		{
+			memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+			lcd->address = 0;
+			lcd->increment = TRUE;
+			lcd->cgram = FALSE;
+			lcd->changes++;
+			us = SIM_LCD_CLEAR_US;
+			SIM_yield(ctx);
+		}
+	}
+	lcd->busyUntil = ctx->cycles + (uint64)us * (SIM_F_CPU / 1000000ULL);
+}
+
+/*******************************************************************************
+* Function Name:		SIM_LCD_move
+* Description:			Function to step the address counter, the end of a line goes to the
+* 						start of the other one
+* Parameters (in):    	LCD and TRUE to increment
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_LCD_move(Sim_LcdType *lcd,boolean increment)
+{
+	if(increment)
+	{
+		if(lcd->address == SIM_LCD_LINE_LENGTH - 1)
+			lcd->address = SIM_LCD_SECOND_LINE;
+		else if(lcd->address == SIM_LCD_SECOND_LINE + SIM_LCD_LINE_LENGTH - 1)
+			lcd->address = 0;
+		else
+			lcd->address++;
+	}
+	else
+	{
+		if(lcd->address == 0)
+			lcd->address = SIM_LCD_SECOND_LINE + SIM_LCD_LINE_LENGTH - 1;
+		else if(lcd->address == SIM_LCD_SECOND_LINE)
+			lcd->address = SIM_LCD_LINE_LENGTH - 1;
+		else
+			lcd->address--;
+	}
+}
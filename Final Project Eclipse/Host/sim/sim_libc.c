@@ -0,0 +1,50 @@
+/******************************************************************************
+*  File name:		sim_libc.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/* avr-libc functions the C library of the host doesn't have */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include <stdlib.h>
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+char *utoa(unsigned int value,char *string,int radix)
+{
+	char digits[sizeof(value) * 8];
+	unsigned char length = 0;
+	unsigned char i = 0;
+
+	do
+	{
+		unsigned int digit = value % (unsigned int)radix;
+		digits[length++] = (char)((digit < 10) ? ('0' + digit) : ('a' + digit - 10));
+		value /= (unsigned int)radix;
+	}while(value != 0);
+
+	while(length != 0)
+	{
+		string[i++] = digits[--length];
+	}
+	string[i] = '\0';
+	return string;
+}
+
+char *itoa(int value,char *string,int radix)
+{
+	/* like avr-libc only base 10 has a sign */
+	if( (value < 0) && (radix == 10) )
+	{
+		string[0] = '-';
+		utoa(0U - (unsigned int)value, string + 1, radix);
+		return string;
+	}
+	return utoa((unsigned int)value, string, radix);
+}
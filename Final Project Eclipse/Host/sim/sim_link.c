@@ -0,0 +1,105 @@
+/******************************************************************************
+*  File name:		sim_link.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Two MCUs run in turns on one thread. A byte reaches the peer when its start
+ * bit is sent and is only in the peer's UDR a frame later, an MCU that looks at
+ * its receiver further ahead waits in the middle of the access for the other
+ * one to catch up. The turns can then be long, they only bound how far the
+ * caller sees one MCU ahead of the other. An RX interrupt could come late that
+ * way, while one is on the turns are one frame at the fastest baud rate.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint64 SIM_LINK_getQuantum(const Sim_LinkType *link);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_LINK_connect(Sim_LinkType *link,Sim_ContextType *mcu1,Sim_ContextType *mcu2,sint32 errorPpm)
+{
+	link->mcus[0] = mcu1;
+	link->mcus[1] = mcu2;
+	link->cycles = (mcu1->cycles < mcu2->cycles) ? mcu1->cycles : mcu2->cycles;
+	link->turns = 0;
+	/* a clock that runs fast sends shorter bits */
+	mcu1->uart.peer = mcu2;
+	mcu1->uart.peerErrorPpm = -errorPpm;
+	mcu2->uart.peer = mcu1;
+	mcu2->uart.peerErrorPpm = errorPpm;
+}
+
+boolean SIM_LINK_run(Sim_LinkType *link,uint64 until)
+{
+	while(link->cycles < until)
+	{
+		uint64 end = link->cycles + SIM_LINK_getQuantum(link);
+		boolean yielded = FALSE;
+
+		end = (end < until) ? end : until;
+		/* an MCU that waits for the other one to catch up is resumed once it did */
+		while( (link->mcus[0]->cycles < end) || (link->mcus[1]->cycles < end) )
+		{
+			for(uint8 i = 0 ; i < 2 ; i++)
+			{
+				Sim_ContextType *mcu = link->mcus[i];
+				if(mcu->cycles >= end)
+					continue;
+				if(SIM_resume(mcu, end) == FALSE)
+				{
+					link->cycles = mcu->cycles;
+					return FALSE;
+				}
+				if( (mcu->cycles < end) && (mcu->waiting == FALSE) )
+				{
+					/* a model that yielded has something for the caller, the other MCU doesn't go further */
+					end = mcu->cycles;
+					yielded = TRUE;
+				}
+			}
+		}
+		link->cycles = (link->mcus[0]->cycles < link->mcus[1]->cycles) ? link->mcus[0]->cycles : link->mcus[1]->cycles;
+		link->turns++;
+		if(yielded)
+			return TRUE;
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_LINK_getQuantum
+* Description:			Function to get how far an MCU can run ahead of the other one
+* Parameters (in):    	Link
+* Parameters (out):   	Cycles of a turn
+* Return value:      	uint64
+********************************************************************************/
+
+static uint64 SIM_LINK_getQuantum(const Sim_LinkType *link)
+{
+	uint64 quantum = SIM_MS_TO_CYCLES(SIM_LINK_MAX_QUANTUM_MS);
+
+	for(uint8 i = 0 ; i < 2 ; i++)
+	{
+		Sim_ContextType *mcu = link->mcus[i];
+		Sim_ContextType *peer = link->mcus[1 - i];
+		if( (mcu->io[SIM_UCSRB] & (1<<RXCIE)) && (peer->io[SIM_UCSRB] & (1<<TXEN)) )
+		{
+			uint64 frame = (uint64)SIM_UART_getFrameBits(peer) * SIM_UART_getBitCycles(peer);
+			quantum = (frame < quantum) ? frame : quantum;
+		}
+	}
+	return quantum;
+}
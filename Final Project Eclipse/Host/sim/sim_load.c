@@ -0,0 +1,1131 @@
+/******************************************************************************
+*  File name:		sim_load.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Load test of the door lock : runs MCU1 and MCU2 on the simulated board and plays
+ * thousands of user sessions one after the other, picked at random from a mix of
+ *
+ *   unlock   '+', the password, the door opens and locks again. With -x percent
+ *            of them the user first mistypes one digit
+ *   burst    '+' then wrong passwords until the alarm, and the lockout runs out
+ *   rotate   '-', the password, then a new password of 4 to 8 digits twice
+ *
+ * The keys are pressed and let go at a random speed around -k ms, and -r percent
+ * of the sessions lose the power at a random time in their first 12 s : both MCUs
+ * start again from their reset values with the EEPROM and the bolt where they were,
+ * and the next session first waits for the menu. A password change cut in the
+ * middle leaves either password, the next check tries the new one then the old one.
+ *
+ *   load [-s sessions] [-m unlock,burst,rotate] [-k ms] [-x percent] [-r percent]
+ *        [-i ms] [-S seed] [-t seconds] [-q] [-v]
+ *
+ *   -s  sessions to run, 1000 by default
+ *   -m  weights of the three sessions, 80,10,10 by default
+ *   -k  average time from a key let go to the next one pressed, 300 ms by default
+ *   -x  percent of the unlocks that start with a wrong password, 10 by default
+ *   -r  percent of the sessions cut by a power loss, 0 by default
+ *   -i  average time between two sessions, 2000 ms by default
+ *   -S  seed of the random numbers, 1 by default, a run is the same for a seed
+ *   -t  virtual time limit of a step, 60 s by default
+ *   -q  no statistics
+ *   -v  every session on stdout with its virtual time
+ *
+ * The report is written to stderr as key=value lines : the unlocks per simulated
+ * hour, the percentiles of the time from the Enter key of a right password to the
+ * motor turning on, and the EEPROM page writes and bytes written of every kind of
+ * session and of a boot after a power loss. The exit status is 1 if a session got
+ * stuck or the password was lost.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../SHARED/shared_config.h"
+#include "../../Final_Project_MCU2/APP/lockout.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define LOAD_DEFAULT_SESSIONS		1000
+#define LOAD_DEFAULT_KEY_MS			300
+#define LOAD_DEFAULT_TYPO_PERCENT	10
+#define LOAD_DEFAULT_IDLE_MS		2000
+#define LOAD_DEFAULT_STEP_SECONDS	60
+#define LOAD_MCU1_DELAY_MS			100		/* MCU1 comes out of reset after MCU2, see door -d */
+#define LOAD_KEY_HOLD_MS			80		/* average, a key is let go this long after MCU1 saw it */
+#define LOAD_CUT_WINDOW_MS			12000	/* about one unlock, a power loss falls in there */
+#define LOAD_MAX_WRONG				8		/* wrong passwords of a burst before it gives up */
+#define LOAD_MIN_DIGITS				4
+#define LOAD_MAX_DIGITS				8
+/* the longest lockout, a sixteenth more as MCU1 counts it down with its own clock, and the time
+ * to show the menu again */
+#define LOAD_LOCKOUT_SECONDS		((((uint32)LOCKOUT_BASE_SECONDS << LOCKOUT_MAX_SHIFT) * 17 / 16) + LOAD_DEFAULT_STEP_SECONDS)
+#define LOAD_MENU					"+ : Open Door"
+#define LOAD_FIRST_PASSWORD			"1234"
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Load_OperationType
+* Type: Enumeration
+* Description: The sessions, and the boot after a power loss which is counted
+* 			   like one for its EEPROM writes
+********************************************************************************/
+typedef enum
+{
+	LOAD_UNLOCK,
+	LOAD_BURST,
+	LOAD_ROTATE,
+	LOAD_BOOT,
+	LOAD_NUM_OPERATIONS
+}Load_OperationType;
+
+#define LOAD_NUM_SESSIONS			LOAD_BOOT	/* the operations a user starts */
+
+/*******************************************************************************
+* Name: Load_CheckType
+* Type: Enumeration
+* Description: How a password check ended, the LCD shows the prompt again after
+* 			   LOAD_UNMATCHED and the menu after LOAD_ALARM and LOAD_LOCKED
+********************************************************************************/
+typedef enum
+{
+	LOAD_MATCHED,
+	LOAD_UNMATCHED,
+	LOAD_ALARM,
+	LOAD_LOCKED,
+	LOAD_STUCK		/* a step timed out or the power was cut */
+}Load_CheckType;
+
+/*******************************************************************************
+* Name: Load_StatsType
+* Type: Structure
+* Description: Counters of one kind of operation, only the ones that ended count
+* 			   for the EEPROM writes
+********************************************************************************/
+typedef struct
+{
+	uint32 count;
+	uint32 cut;				/* by a power loss */
+	uint32 stuck;
+	uint64 pageWrites;
+	uint64 bytesWritten;
+	uint32 maxPageWrites;
+	uint64 cycles;
+}Load_StatsType;
+
+/*******************************************************************************
+* Name: Load_TextsType
+* Type: Structure
+* Description: Texts the LCD may show next and the first one it shows
+********************************************************************************/
+typedef struct
+{
+	const char *const *texts;
+	uint8 count;
+	sint8 found;
+}Load_TextsType;
+
+/*******************************************************************************
+* Name: Load_ConditionType
+* Type: Function pointer
+* Description: What a step waits for, TRUE once it happened
+********************************************************************************/
+typedef boolean (*Load_ConditionType)(void *argument);
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+/* RAM of the firmwares, the sections are renamed in build/load, weak as a firmware may not have one */
+extern uint8 __start_mcu1_data[] __attribute__((weak)), __stop_mcu1_data[] __attribute__((weak));
+extern uint8 __start_mcu1_bss[] __attribute__((weak)), __stop_mcu1_bss[] __attribute__((weak));
+extern uint8 __start_mcu2_data[] __attribute__((weak)), __stop_mcu2_data[] __attribute__((weak));
+extern uint8 __start_mcu2_bss[] __attribute__((weak)), __stop_mcu2_bss[] __attribute__((weak));
+
+static const char *const g_loadNames[LOAD_NUM_OPERATIONS] = {"unlock", "burst", "rotate", "boot"};
+
+static Sim_BoardType g_loadBoard;
+static void (*g_loadBoardChange)(Sim_ContextType *ctx,uint8 port);
+static uint8 *g_loadResetData;			/* .data of MCU1 then of MCU2 before they ran */
+static uint64 g_loadStepCycles;
+static boolean g_loadVerbose = FALSE;
+static uint32 g_loadRandom = 1;
+
+/* user model */
+static uint32 g_loadKeyMs = LOAD_DEFAULT_KEY_MS;
+static uint32 g_loadTypoPercent = LOAD_DEFAULT_TYPO_PERCENT;
+static uint32 g_loadCutPercent = 0;
+static uint32 g_loadIdleMs = LOAD_DEFAULT_IDLE_MS;
+static uint32 g_loadWeights[LOAD_NUM_SESSIONS] = {80, 10, 10};
+
+/* the lock as the users know it */
+static char g_loadPassword[LOAD_MAX_DIGITS + 1] = LOAD_FIRST_PASSWORD;
+static char g_loadOldPassword[LOAD_MAX_DIGITS + 1];
+static boolean g_loadUnsure = FALSE;	/* a change was cut, the old password may still be the one */
+
+/* power loss */
+static uint64 g_loadCutAt = SIM_FOREVER;
+static boolean g_loadCut = FALSE;
+
+/* latency of the unlocks */
+static uint64 g_loadEnterCycle;			/* the Enter key of the last password was pressed */
+static uint64 g_loadMotorCycle;			/* the motor turned on */
+static uint32 g_loadMotorMoves;
+static uint32 *g_loadLatencies = NULL_PTR;	/* cycles */
+static uint32 g_loadNumLatencies = 0;
+static uint32 g_loadLatencySize = 0;
+
+/* results */
+static Load_StatsType g_loadStats[LOAD_NUM_OPERATIONS];
+static uint32 g_loadUnlocks = 0;
+static uint32 g_loadWrong = 0;
+static uint32 g_loadAlarms = 0;
+static uint32 g_loadLockedOut = 0;
+static uint32 g_loadKeptOld = 0;		/* a cut change left the old password */
+static uint32 g_loadKeptNew = 0;
+static boolean g_loadLost = FALSE;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static boolean LOAD_start(void);
+static void LOAD_hook(void);
+static void LOAD_mcu2Change(Sim_ContextType *ctx,uint8 port);
+static void LOAD_powerCut(void);
+static Load_OperationType LOAD_pick(void);
+static boolean LOAD_session(Load_OperationType operation);
+static boolean LOAD_unlock(void);
+static boolean LOAD_burst(void);
+static boolean LOAD_rotate(void);
+static boolean LOAD_boot(void);
+static Load_CheckType LOAD_openPrompt(char menuKey);
+static Load_CheckType LOAD_enterPassword(const char *password);
+static Load_CheckType LOAD_enterKnown(void);
+static boolean LOAD_runUntil(Load_ConditionType condition,void *argument,uint64 end);
+static boolean LOAD_wait(const char *text);
+static sint8 LOAD_waitAny(const char *const *texts,uint8 count,uint64 limit);
+static boolean LOAD_delay(uint32 ms);
+static boolean LOAD_typeKey(char key);
+static boolean LOAD_typePassword(const char *password);
+static void LOAD_newPassword(char *password);
+static void LOAD_mistype(const char *password,char *wrong);
+static uint32 LOAD_rand(void);
+static uint32 LOAD_vary(uint32 average);
+static boolean LOAD_isShown(void *argument);
+static boolean LOAD_isAnyShown(void *argument);
+static boolean LOAD_isKeySeen(void *argument);
+static boolean LOAD_isMotorOn(void *argument);
+static boolean LOAD_isOpened(void *argument);
+static boolean LOAD_isClosed(void *argument);
+static void LOAD_print(void);
+static int LOAD_compare(const void *a,const void *b);
+static void LOAD_report(uint32 sessions,double hostSeconds,boolean passed);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(int argc,char **argv)
+{
+	uint32 sessions = LOAD_DEFAULT_SESSIONS;
+	uint32 done = 0;
+	boolean quiet = FALSE;
+	boolean passed = TRUE;
+	boolean running = TRUE;
+	struct timespec start, end;
+	int option;
+
+	g_loadStepCycles = SIM_MS_TO_CYCLES(LOAD_DEFAULT_STEP_SECONDS * 1000UL);
+	while((option = getopt(argc, argv, "s:m:k:x:r:i:S:t:qv")) != -1)
+	{
+		switch(option)
+		{
+		case 's': sessions = (uint32)atol(optarg); break;
+		case 'm':
+			if(sscanf(optarg, "%u,%u,%u", &g_loadWeights[LOAD_UNLOCK], &g_loadWeights[LOAD_BURST], &g_loadWeights[LOAD_ROTATE]) != 3)
+				g_loadWeights[LOAD_UNLOCK] = g_loadWeights[LOAD_BURST] = g_loadWeights[LOAD_ROTATE] = 0;
+			break;
+		case 'k': g_loadKeyMs = (uint32)atol(optarg); break;
+		case 'x': g_loadTypoPercent = (uint32)atol(optarg); break;
+		case 'r': g_loadCutPercent = (uint32)atol(optarg); break;
+		case 'i': g_loadIdleMs = (uint32)atol(optarg); break;
+		case 'S': g_loadRandom = (uint32)atol(optarg); break;
+		case 't': g_loadStepCycles = (uint64)(atof(optarg) * SIM_F_CPU); break;
+		case 'q': quiet = TRUE; break;
+		case 'v': g_loadVerbose = TRUE; break;
+		default:
+			g_loadWeights[LOAD_UNLOCK] = g_loadWeights[LOAD_BURST] = g_loadWeights[LOAD_ROTATE] = 0;
+			break;
+		}
+	}
+	if( (g_loadWeights[LOAD_UNLOCK] + g_loadWeights[LOAD_BURST] + g_loadWeights[LOAD_ROTATE] == 0) || (optind < argc) )
+	{
+		fprintf(stderr, "usage: %s [-s sessions] [-m unlock,burst,rotate] [-k ms] [-x percent] [-r percent]\n"
+				"       [-i ms] [-S seed] [-t seconds] [-q] [-v]\n", argv[0]);
+		return 2;
+	}
+	g_loadRandom = (g_loadRandom != 0) ? g_loadRandom : 1;
+
+	if(LOAD_start() == FALSE)
+	{
+		fprintf(stderr, "%s: no memory for the board\n", argv[0]);
+		return 1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	/* the password is set on the blank EEPROM first, it isn't a session */
+	if( (LOAD_wait("Plz Enter Pass") == FALSE) || (LOAD_typePassword(g_loadPassword) == FALSE)
+			|| (LOAD_wait("Re-Enter Pass") == FALSE) || (LOAD_typePassword(g_loadPassword) == FALSE)
+			|| (LOAD_wait(LOAD_MENU) == FALSE) )
+	{
+		fprintf(stderr, "%s: the first password couldn't be set\n", argv[0]);
+		LOAD_print();
+		passed = FALSE;
+		running = FALSE;
+	}
+
+	while( running && (done < sessions) )
+	{
+		Load_OperationType operation = LOAD_pick();
+
+		if(LOAD_delay(LOAD_vary(g_loadIdleMs)) == FALSE)
+			break;
+		if(LOAD_session(operation) == FALSE)
+		{
+			passed = FALSE;
+			/* the power is cut to get the lock back to its menu */
+			if(g_loadCut == FALSE)
+			{
+				LOAD_powerCut();
+			}
+			running = LOAD_boot();
+		}
+		else if(g_loadCut)
+		{
+			running = LOAD_boot();
+			passed = passed && running;
+		}
+		running = running && (g_loadLost == FALSE);
+		done++;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	fflush(stdout);
+
+	passed = passed && running && (g_loadLost == FALSE);
+	if(quiet == FALSE)
+	{
+		LOAD_report(done, (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9, passed);
+	}
+	SIM_BOARD_deinit(&g_loadBoard);
+	free(g_loadResetData);
+	free(g_loadLatencies);
+	return passed ? 0 : 1;
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		LOAD_start
+* Description:			Function to save the RAM of the firmwares before they run and to build
+* 						the board with a blank EEPROM
+* Parameters (in):    	None
+* Parameters (out):   	FALSE if there is no memory for it
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_start(void)
+{
+	size_t mcu1Size = (size_t)(__stop_mcu1_data - __start_mcu1_data);
+	size_t mcu2Size = (size_t)(__stop_mcu2_data - __start_mcu2_data);
+
+	g_loadResetData = malloc(mcu1Size + mcu2Size + 1);
+	if(g_loadResetData == NULL_PTR)
+		return FALSE;
+	memcpy(g_loadResetData, __start_mcu1_data, mcu1Size);
+	memcpy(g_loadResetData + mcu1Size, __start_mcu2_data, mcu2Size);
+
+	if(SIM_BOARD_init(&g_loadBoard, 0) == ERROR)
+		return FALSE;
+	g_loadBoard.mcu1.cycles = SIM_MS_TO_CYCLES(LOAD_MCU1_DELAY_MS);
+	LOAD_hook();
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_hook
+* Description:			Function to see the motor turn on, after the board was built
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void LOAD_hook(void)
+{
+	g_loadBoardChange = g_loadBoard.mcu2.gpio.onChange;
+	g_loadBoard.mcu2.gpio.onChange = LOAD_mcu2Change;
+	g_loadMotorMoves = g_loadBoard.motor.moves;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_mcu2Change
+* Description:			Function to pass a change of the outputs of MCU2 to the board and to
+* 						save the cycle the motor turned on
+* Parameters (in):    	Context and port
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void LOAD_mcu2Change(Sim_ContextType *ctx,uint8 port)
+{
+	g_loadBoardChange(ctx, port);
+	if(g_loadBoard.motor.moves != g_loadMotorMoves)
+	{
+		g_loadMotorMoves = g_loadBoard.motor.moves;
+		g_loadMotorCycle = ctx->cycles;
+		SIM_yield(ctx);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_powerCut
+* Description:			Function to cut the power of the board and give it back : both firmwares
+* 						start from their reset values, the EEPROM and the bolt stay as they were
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void LOAD_powerCut(void)
+{
+	static Sim_EepromType eeprom;
+	static Sim_IntEepromType intEeprom;
+	Sim_BoardType *board = &g_loadBoard;
+	Sim_MotorType motor = board->motor;
+	uint64 now = board->link.cycles;
+	size_t mcu1Size = (size_t)(__stop_mcu1_data - __start_mcu1_data);
+
+	if(g_loadVerbose)
+	{
+		printf("%.3f power cut\n", (double)now * 1000.0 / SIM_F_CPU);
+	}
+	eeprom = board->eeprom;
+	intEeprom = board->mcu2.intEeprom; /* a write in progress is lost */
+	SIM_BOARD_deinit(board);
+	memcpy(__start_mcu1_data, g_loadResetData, mcu1Size);
+	memset(__start_mcu1_bss, 0, (size_t)(__stop_mcu1_bss - __start_mcu1_bss));
+	memcpy(__start_mcu2_data, g_loadResetData + mcu1Size, (size_t)(__stop_mcu2_data - __start_mcu2_data));
+	memset(__start_mcu2_bss, 0, (size_t)(__stop_mcu2_bss - __start_mcu2_bss));
+
+	if(SIM_BOARD_init(board, 0) == ERROR)
+	{
+		fprintf(stderr, "load: no memory for the board\n");
+		exit(1);
+	}
+	memcpy(board->eeprom.memory, eeprom.memory, sizeof(eeprom.memory));
+	board->eeprom.pageWrites = eeprom.pageWrites;
+	board->eeprom.bytesWritten = eeprom.bytesWritten;
+	board->eeprom.bytesRead = eeprom.bytesRead;
+	board->eeprom.busyNacks = eeprom.busyNacks;
+	memcpy(board->mcu2.intEeprom.memory, intEeprom.memory, sizeof(intEeprom.memory));
+	board->mcu2.intEeprom.reads = intEeprom.reads;
+	board->mcu2.intEeprom.writes = intEeprom.writes;
+	board->motor.position = motor.position;
+	board->motor.moves = motor.moves;
+	board->motor.runningCycles = motor.runningCycles;
+	board->motor.stalledCycles = motor.stalledCycles;
+
+	/* the clocks go on from the cut */
+	board->mcu2.cycles = now;
+	board->mcu1.cycles = now + SIM_MS_TO_CYCLES(LOAD_MCU1_DELAY_MS);
+	board->link.cycles = now;
+	board->motor.lastCycle = now;
+	SIM_MOTOR_update(&board->mcu2, &board->motor); /* end-stops */
+	LOAD_hook();
+	g_loadCut = TRUE;
+	g_loadCutAt = SIM_FOREVER;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_pick
+* Description:			Function to pick the next session from the weights
+* Parameters (in):    	None
+* Parameters (out):   	The session
+* Return value:      	Load_OperationType
+********************************************************************************/
+
+static Load_OperationType LOAD_pick(void)
+{
+	uint32 total = g_loadWeights[LOAD_UNLOCK] + g_loadWeights[LOAD_BURST] + g_loadWeights[LOAD_ROTATE];
+	uint32 draw = LOAD_rand() % total;
+
+	for(uint8 i = 0 ; i < LOAD_NUM_SESSIONS ; i++)
+	{
+		if(draw < g_loadWeights[i])
+			return (Load_OperationType)i;
+		draw -= g_loadWeights[i];
+	}
+	return LOAD_UNLOCK;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_session
+* Description:			Function to run one session with its EEPROM writes and time, the power
+* 						is cut in it if it drew it
+* Parameters (in):    	The session
+* Parameters (out):   	FALSE if it got stuck
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_session(Load_OperationType operation)
+{
+	Load_StatsType *stats = &g_loadStats[operation];
+	uint64 start = g_loadBoard.link.cycles;
+	uint32 pageWrites = g_loadBoard.eeprom.pageWrites;
+	uint32 bytesWritten = g_loadBoard.eeprom.bytesWritten;
+	boolean done = FALSE;
+
+	if(g_loadVerbose)
+	{
+		printf("%.3f %s\n", (double)start * 1000.0 / SIM_F_CPU, g_loadNames[operation]);
+	}
+	g_loadCut = FALSE;
+	g_loadCutAt = SIM_FOREVER;
+	if( (g_loadCutPercent != 0) && ((LOAD_rand() % 100) < g_loadCutPercent) )
+	{
+		g_loadCutAt = start + SIM_MS_TO_CYCLES(LOAD_rand() % LOAD_CUT_WINDOW_MS);
+	}
+
+	switch(operation)
+	{
+	case LOAD_UNLOCK: done = LOAD_unlock(); break;
+	case LOAD_BURST: done = LOAD_burst(); break;
+	default: done = LOAD_rotate(); break;
+	}
+	g_loadCutAt = SIM_FOREVER;
+
+	stats->count++;
+	if(g_loadCut)
+	{
+		stats->cut++;
+		return TRUE;
+	}
+	if(done == FALSE)
+	{
+		stats->stuck++;
+		fprintf(stderr, "%s session stuck at %.3f ms\n", g_loadNames[operation], (double)g_loadBoard.link.cycles * 1000.0 / SIM_F_CPU);
+		LOAD_print();
+		return FALSE;
+	}
+	pageWrites = g_loadBoard.eeprom.pageWrites - pageWrites;
+	stats->pageWrites += pageWrites;
+	stats->bytesWritten += g_loadBoard.eeprom.bytesWritten - bytesWritten;
+	stats->maxPageWrites = (pageWrites > stats->maxPageWrites) ? pageWrites : stats->maxPageWrites;
+	stats->cycles += g_loadBoard.link.cycles - start;
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_unlock
+* Description:			Function to open the door with the password, after a wrong one if the
+* 						user mistypes, and to wait for it to be locked again
+* Parameters (in):    	None
+* Parameters (out):   	FALSE if a step got stuck or the power was cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_unlock(void)
+{
+	Load_CheckType check = LOAD_openPrompt('+');
+	uint64 latency;
+
+	if( (check == LOAD_UNMATCHED) && ((LOAD_rand() % 100) < g_loadTypoPercent) )
+	{
+		char wrong[LOAD_MAX_DIGITS + 1];
+		LOAD_mistype(g_loadPassword, wrong);
+		check = LOAD_enterPassword(wrong);
+	}
+	if(check == LOAD_UNMATCHED)
+	{
+		check = LOAD_enterKnown();
+	}
+	if(check != LOAD_MATCHED)
+	{
+		return (check == LOAD_STUCK) ? FALSE : TRUE; /* the alarm or a lockout, no unlock but no error */
+	}
+
+	if( (LOAD_runUntil(LOAD_isMotorOn, NULL_PTR, g_loadBoard.link.cycles + g_loadStepCycles) == FALSE)
+			|| (LOAD_runUntil(LOAD_isOpened, NULL_PTR, g_loadBoard.link.cycles + g_loadStepCycles) == FALSE) )
+		return FALSE;
+	latency = g_loadMotorCycle - g_loadEnterCycle;
+	if(g_loadNumLatencies == g_loadLatencySize)
+	{
+		uint32 size = (g_loadLatencySize != 0) ? (2 * g_loadLatencySize) : 1024;
+		uint32 *latencies = realloc(g_loadLatencies, size * sizeof(uint32));
+		if(latencies == NULL_PTR)
+			return FALSE;
+		g_loadLatencies = latencies;
+		g_loadLatencySize = size;
+	}
+	g_loadLatencies[g_loadNumLatencies++] = (latency > 0xFFFFFFFFUL) ? 0xFFFFFFFFUL : (uint32)latency;
+	g_loadUnlocks++;
+
+	return LOAD_wait("Door Is Locked") && LOAD_wait("Locking")
+			&& LOAD_runUntil(LOAD_isClosed, NULL_PTR, g_loadBoard.link.cycles + g_loadStepCycles) && LOAD_wait(LOAD_MENU);
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_burst
+* Description:			Function to enter wrong passwords until the alarm, then to wait for the
+* 						end of the lockout
+* Parameters (in):    	None
+* Parameters (out):   	FALSE if a step got stuck or the power was cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_burst(void)
+{
+	Load_CheckType check = LOAD_openPrompt('+');
+
+	for(uint8 i = 0 ; (check == LOAD_UNMATCHED) && (i < LOAD_MAX_WRONG) ; i++)
+	{
+		char wrong[LOAD_MAX_DIGITS + 1];
+		LOAD_mistype(g_loadPassword, wrong);
+		check = LOAD_enterPassword(wrong);
+	}
+	if(check == LOAD_MATCHED)
+	{
+		/* a cut change left the password that was typed wrong on purpose, open the door */
+		return LOAD_runUntil(LOAD_isOpened, NULL_PTR, g_loadBoard.link.cycles + g_loadStepCycles) && LOAD_wait("Door Is Locked")
+				&& LOAD_runUntil(LOAD_isClosed, NULL_PTR, g_loadBoard.link.cycles + g_loadStepCycles) && LOAD_wait(LOAD_MENU);
+	}
+	return ( (check == LOAD_ALARM) || (check == LOAD_LOCKED) ) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_rotate
+* Description:			Function to change the password to a new random one
+* Parameters (in):    	None
+* Parameters (out):   	FALSE if a step got stuck or the power was cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_rotate(void)
+{
+	Load_CheckType check = LOAD_openPrompt('-');
+	char password[LOAD_MAX_DIGITS + 1];
+
+	if(check == LOAD_UNMATCHED)
+	{
+		check = LOAD_enterKnown();
+	}
+	if(check != LOAD_MATCHED)
+	{
+		return (check == LOAD_STUCK) ? FALSE : TRUE;
+	}
+
+	LOAD_newPassword(password);
+	if( (LOAD_wait("Set New Password") == FALSE) || (LOAD_wait("Plz Enter Pass") == FALSE) || (LOAD_typePassword(password) == FALSE)
+			|| (LOAD_wait("Re-Enter Pass") == FALSE) )
+		return FALSE;
+	/* from the second Enter MCU2 may have either password until it says which */
+	strcpy(g_loadOldPassword, g_loadPassword);
+	strcpy(g_loadPassword, password);
+	g_loadUnsure = TRUE;
+	if( (LOAD_typePassword(password) == FALSE) || (LOAD_wait("Password Updated") == FALSE) )
+		return FALSE;
+	g_loadUnsure = FALSE;
+	return LOAD_wait(LOAD_MENU);
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_boot
+* Description:			Function to wait for the menu after a power loss, the password must
+* 						still be set
+* Parameters (in):    	None
+* Parameters (out):   	FALSE if the menu doesn't come or the password was lost
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_boot(void)
+{
+	static const char *const screens[] = {LOAD_MENU, "Set New Password"};
+	Load_StatsType *stats = &g_loadStats[LOAD_BOOT];
+	uint64 start = g_loadBoard.link.cycles;
+	uint32 pageWrites = g_loadBoard.eeprom.pageWrites;
+	uint32 bytesWritten = g_loadBoard.eeprom.bytesWritten;
+	sint8 screen;
+
+	g_loadCut = FALSE;
+	screen = LOAD_waitAny(screens, 2, g_loadStepCycles);
+	stats->count++;
+	if(screen < 0)
+	{
+		stats->stuck++;
+		fprintf(stderr, "boot stuck at %.3f ms\n", (double)g_loadBoard.link.cycles * 1000.0 / SIM_F_CPU);
+		LOAD_print();
+		return FALSE;
+	}
+	if(screen == 1)
+	{
+		fprintf(stderr, "password lost at %.3f ms\n", (double)g_loadBoard.link.cycles * 1000.0 / SIM_F_CPU);
+		g_loadLost = TRUE;
+		return FALSE;
+	}
+	pageWrites = g_loadBoard.eeprom.pageWrites - pageWrites;
+	stats->pageWrites += pageWrites;
+	stats->bytesWritten += g_loadBoard.eeprom.bytesWritten - bytesWritten;
+	stats->maxPageWrites = (pageWrites > stats->maxPageWrites) ? pageWrites : stats->maxPageWrites;
+	stats->cycles += g_loadBoard.link.cycles - start;
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_openPrompt
+* Description:			Function to press a key of the menu and wait for the password prompt
+* Parameters (in):    	Key
+* Parameters (out):   	LOAD_UNMATCHED once the prompt is shown, LOAD_LOCKED after a running
+* 						lockout is over or LOAD_STUCK
+* Return value:      	Load_CheckType
+********************************************************************************/
+
+static Load_CheckType LOAD_openPrompt(char menuKey)
+{
+	static const char *const screens[] = {"Plz Enter Pass:", "Locked Out"};
+	sint8 screen;
+
+	if(LOAD_typeKey(menuKey) == FALSE)
+		return LOAD_STUCK;
+	screen = LOAD_waitAny(screens, 2, g_loadStepCycles);
+	if(screen == 0)
+		return LOAD_UNMATCHED;
+	if(screen == 1)
+	{
+		g_loadLockedOut++;
+		if(LOAD_runUntil(LOAD_isShown, (void *)LOAD_MENU, g_loadBoard.link.cycles + SIM_MS_TO_CYCLES(LOAD_LOCKOUT_SECONDS * 1000ULL)))
+			return LOAD_LOCKED;
+	}
+	return LOAD_STUCK;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_enterPassword
+* Description:			Function to type a password at the prompt and wait for the answer
+* Parameters (in):    	Password as digits
+* Parameters (out):   	LOAD_MATCHED, LOAD_UNMATCHED with the prompt shown again, LOAD_ALARM
+* 						once the lockout is over or LOAD_STUCK
+* Return value:      	Load_CheckType
+********************************************************************************/
+
+static Load_CheckType LOAD_enterPassword(const char *password)
+{
+	/* UnMatched holds Matched, it is looked for first */
+	static const char *const screens[] = {"UnMatched", "ERROR !!!", "Matched"};
+	sint8 screen;
+
+	if(LOAD_typePassword(password) == FALSE)
+		return LOAD_STUCK;
+	screen = LOAD_waitAny(screens, 3, g_loadStepCycles);
+	switch(screen)
+	{
+	case 0:
+		g_loadWrong++;
+		return LOAD_wait("Plz Enter Pass:") ? LOAD_UNMATCHED : LOAD_STUCK;
+	case 1:
+		g_loadWrong++;
+		g_loadAlarms++;
+		return LOAD_runUntil(LOAD_isShown, (void *)LOAD_MENU, g_loadBoard.link.cycles + SIM_MS_TO_CYCLES(LOAD_LOCKOUT_SECONDS * 1000ULL))
+				? LOAD_ALARM : LOAD_STUCK;
+	case 2:
+		return LOAD_MATCHED;
+	default:
+		return LOAD_STUCK;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_enterKnown
+* Description:			Function to type the password at the prompt, and the old one if a cut
+* 						change may have left it. The password is lost if neither matches
+* Parameters (in):    	None
+* Parameters (out):   	As LOAD_enterPassword
+* Return value:      	Load_CheckType
+********************************************************************************/
+
+static Load_CheckType LOAD_enterKnown(void)
+{
+	Load_CheckType check = LOAD_enterPassword(g_loadPassword);
+
+	if(g_loadUnsure == FALSE)
+	{
+		if(check == LOAD_UNMATCHED)
+		{
+			fprintf(stderr, "password %s refused at %.3f ms\n", g_loadPassword, (double)g_loadBoard.link.cycles * 1000.0 / SIM_F_CPU);
+			g_loadLost = TRUE;
+			return LOAD_STUCK;
+		}
+		return check;
+	}
+	if(check == LOAD_MATCHED)
+	{
+		g_loadKeptNew++;
+		g_loadUnsure = FALSE;
+		return check;
+	}
+	if(check != LOAD_UNMATCHED)
+		return check;
+
+	check = LOAD_enterPassword(g_loadOldPassword);
+	if(check == LOAD_MATCHED)
+	{
+		g_loadKeptOld++;
+		g_loadUnsure = FALSE;
+		strcpy(g_loadPassword, g_loadOldPassword);
+	}
+	else if(check == LOAD_UNMATCHED)
+	{
+		fprintf(stderr, "passwords %s and %s refused at %.3f ms\n", g_loadPassword, g_loadOldPassword,
+				(double)g_loadBoard.link.cycles * 1000.0 / SIM_F_CPU);
+		g_loadLost = TRUE;
+		return LOAD_STUCK;
+	}
+	return check;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_runUntil
+* Description:			Function to run the board until a condition is met or up to a cycle,
+* 						the power is cut on the way if the session drew it
+* Parameters (in):    	Condition or NULL_PTR to only run, its argument and the last cycle
+* Parameters (out):   	TRUE once the condition is met, or at the last cycle without one.
+* 						FALSE if an MCU stopped or the power was cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_runUntil(Load_ConditionType condition,void *argument,uint64 end)
+{
+	while( (condition == NULL_PTR) || (condition(argument) == FALSE) )
+	{
+		uint64 until = (g_loadCutAt < end) ? g_loadCutAt : end;
+
+		if(g_loadBoard.link.cycles >= g_loadCutAt)
+		{
+			LOAD_powerCut();
+			return FALSE;
+		}
+		if(g_loadBoard.link.cycles >= end)
+			return (condition == NULL_PTR) ? TRUE : FALSE;
+		if(SIM_LINK_run(&g_loadBoard.link, until) == FALSE)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_wait
+* Description:			Function to run the board until the LCD shows a text
+* Parameters (in):    	Text
+* Parameters (out):   	FALSE at the time limit of a step, if an MCU stopped or the power was cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_wait(const char *text)
+{
+	return LOAD_runUntil(LOAD_isShown, (void *)text, g_loadBoard.link.cycles + g_loadStepCycles);
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_waitAny
+* Description:			Function to run the board until the LCD shows one of some texts
+* Parameters (in):    	Texts, their number and the time limit in cycles
+* Parameters (out):   	Index of the first text shown, -1 if none was
+* Return value:      	sint8
+********************************************************************************/
+
+static sint8 LOAD_waitAny(const char *const *texts,uint8 count,uint64 limit)
+{
+	Load_TextsType argument = {texts, count, -1};
+
+	if(LOAD_runUntil(LOAD_isAnyShown, &argument, g_loadBoard.link.cycles + limit) == FALSE)
+		return -1;
+	return argument.found;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_delay
+* Description:			Function to let the board run for a time
+* Parameters (in):    	Time in ms
+* Parameters (out):   	FALSE if an MCU stopped or the power was cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_delay(uint32 ms)
+{
+	return LOAD_runUntil(NULL_PTR, NULL_PTR, g_loadBoard.link.cycles + SIM_MS_TO_CYCLES(ms));
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_typeKey
+* Description:			Function to press a key until MCU1 saw it, hold it and let it go, then
+* 						to wait for the next key
+* Parameters (in):    	Key, as printed on the keypad
+* Parameters (out):   	FALSE if MCU1 never read it or the power was cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_typeKey(char key)
+{
+	if(SIM_KEYPAD_press(&g_loadBoard.mcu1, &g_loadBoard.keypad, key) == FALSE)
+		return FALSE;
+	if( (LOAD_runUntil(LOAD_isKeySeen, NULL_PTR, g_loadBoard.link.cycles + g_loadStepCycles) == FALSE)
+			|| (LOAD_delay(LOAD_vary(LOAD_KEY_HOLD_MS)) == FALSE) )
+		return FALSE;
+	SIM_KEYPAD_release(&g_loadBoard.mcu1, &g_loadBoard.keypad);
+	return LOAD_delay(LOAD_vary(g_loadKeyMs));
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_typePassword
+* Description:			Function to type the digits of a password then Enter, the cycle Enter
+* 						is pressed is saved for the latency
+* Parameters (in):    	Password as digits
+* Parameters (out):   	FALSE if a key wasn't seen or the power was cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean LOAD_typePassword(const char *password)
+{
+	for(const char *digit = password ; *digit != '\0' ; digit++)
+	{
+		if(LOAD_typeKey(*digit) == FALSE)
+			return FALSE;
+	}
+	g_loadEnterCycle = g_loadBoard.link.cycles;
+	return LOAD_typeKey('C');
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_newPassword
+* Description:			Function to draw a password of LOAD_MIN_DIGITS to LOAD_MAX_DIGITS digits
+* 						that isn't the one in use
+* Parameters (in):    	Array of LOAD_MAX_DIGITS + 1 for it
+* Parameters (out):   	The password
+* Return value:      	void
+********************************************************************************/
+
+static void LOAD_newPassword(char *password)
+{
+	do
+	{
+		uint8 length = (uint8)(LOAD_MIN_DIGITS + LOAD_rand() % (LOAD_MAX_DIGITS - LOAD_MIN_DIGITS + 1));
+		for(uint8 i = 0 ; i < length ; i++)
+		{
+			password[i] = (char)('0' + LOAD_rand() % 10);
+		}
+		password[length] = '\0';
+	}while(strcmp(password, g_loadPassword) == 0);
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_mistype
+* Description:			Function to change one digit of a password like a user mistyping it
+* Parameters (in):    	Password and array of LOAD_MAX_DIGITS + 1 for the wrong one
+* Parameters (out):   	The wrong password
+* Return value:      	void
+********************************************************************************/
+
+static void LOAD_mistype(const char *password,char *wrong)
+{
+	size_t length = strlen(password);
+	size_t position = LOAD_rand() % length;
+
+	strcpy(wrong, password);
+	wrong[position] = (char)('0' + (wrong[position] - '0' + 1 + LOAD_rand() % 9) % 10);
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_rand
+* Description:			Function to draw a random number, xorshift32 so a seed gives the same run
+* 						everywhere
+* Parameters (in):    	None
+* Parameters (out):   	The number
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 LOAD_rand(void)
+{
+	g_loadRandom ^= g_loadRandom << 13;
+	g_loadRandom ^= g_loadRandom >> 17;
+	g_loadRandom ^= g_loadRandom << 5;
+	return g_loadRandom;
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_vary
+* Description:			Function to draw a time between half and one and a half of an average
+* Parameters (in):    	Average
+* Parameters (out):   	The time
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 LOAD_vary(uint32 average)
+{
+	return (average != 0) ? (average / 2 + LOAD_rand() % (average + 1)) : 0;
+}
+
+/*******************************************************************************
+*                      Conditions of the steps                                 *
+*******************************************************************************/
+
+static boolean LOAD_isShown(void *argument)
+{
+	return SIM_LCD_contains(&g_loadBoard.lcd, (const char *)argument);
+}
+
+static boolean LOAD_isAnyShown(void *argument)
+{
+	Load_TextsType *texts = argument;
+
+	for(uint8 i = 0 ; i < texts->count ; i++)
+	{
+		if(SIM_LCD_contains(&g_loadBoard.lcd, texts->texts[i]))
+		{
+			texts->found = (sint8)i;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+static boolean LOAD_isKeySeen(void *argument)
+{
+	(void)argument;
+	return g_loadBoard.keypad.seen;
+}
+
+static boolean LOAD_isMotorOn(void *argument)
+{
+	(void)argument;
+	return (g_loadMotorCycle >= g_loadEnterCycle) ? TRUE : FALSE;
+}
+
+static boolean LOAD_isOpened(void *argument)
+{
+	(void)argument;
+	return SIM_MOTOR_isOpened(&g_loadBoard.motor);
+}
+
+static boolean LOAD_isClosed(void *argument)
+{
+	(void)argument;
+	return SIM_MOTOR_isClosed(&g_loadBoard.motor);
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_print
+* Description:			Function to write what the LCD shows to stderr
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void LOAD_print(void)
+{
+	char row[SIM_LCD_ROWS][SIM_LCD_COLUMNS + 1];
+
+	for(uint8 i = 0 ; i < SIM_LCD_ROWS ; i++)
+	{
+		SIM_LCD_getRow(&g_loadBoard.lcd, i, row[i]);
+	}
+	fprintf(stderr, "%.3f |%s|%s|\n", (double)g_loadBoard.link.cycles * 1000.0 / SIM_F_CPU, row[0], row[1]);
+}
+
+static int LOAD_compare(const void *a,const void *b)
+{
+	uint32 left = *(const uint32 *)a;
+	uint32 right = *(const uint32 *)b;
+	return (left > right) - (left < right);
+}
+
+/*******************************************************************************
+* Function Name:		LOAD_report
+* Description:			Function to write the statistics of the run to stderr
+* Parameters (in):    	Sessions run, host time of the run and TRUE if none got stuck
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void LOAD_report(uint32 sessions,double hostSeconds,boolean passed)
+{
+	static const uint8 percentiles[] = {50, 90, 99};
+	const Sim_BoardType *board = &g_loadBoard;
+	double virtualSeconds = (double)board->link.cycles / SIM_F_CPU;
+
+	fprintf(stderr, "result=%s\n", passed ? "pass" : "fail");
+	fprintf(stderr, "sessions=%lu\n", (unsigned long)sessions);
+	fprintf(stderr, "virtual_hours=%.3f\n", virtualSeconds / 3600.0);
+	fprintf(stderr, "host_ms=%.3f\n", hostSeconds * 1000.0);
+	fprintf(stderr, "speedup=%.1f\n", (hostSeconds > 0) ? (virtualSeconds / hostSeconds) : 0.0);
+	fprintf(stderr, "unlocks=%lu\n", (unsigned long)g_loadUnlocks);
+	fprintf(stderr, "unlocks_per_hour=%.1f\n", (virtualSeconds > 0) ? (g_loadUnlocks * 3600.0 / virtualSeconds) : 0.0);
+	fprintf(stderr, "wrong_passwords=%lu\n", (unsigned long)g_loadWrong);
+	fprintf(stderr, "alarms=%lu\n", (unsigned long)g_loadAlarms);
+	fprintf(stderr, "locked_out=%lu\n", (unsigned long)g_loadLockedOut);
+	fprintf(stderr, "cut_changes_kept_old=%lu\n", (unsigned long)g_loadKeptOld);
+	fprintf(stderr, "cut_changes_kept_new=%lu\n", (unsigned long)g_loadKeptNew);
+	fprintf(stderr, "password_lost=%u\n", g_loadLost ? 1 : 0);
+
+	if(g_loadNumLatencies != 0)
+	{
+		qsort(g_loadLatencies, g_loadNumLatencies, sizeof(uint32), LOAD_compare);
+		fprintf(stderr, "latency_min_ms=%.3f\n", (double)g_loadLatencies[0] * 1000.0 / SIM_F_CPU);
+		for(uint8 i = 0 ; i < sizeof(percentiles) ; i++)
+		{
+			/* nearest rank */
+			uint32 rank = (uint32)(((uint64)percentiles[i] * g_loadNumLatencies + 99) / 100);
+			fprintf(stderr, "latency_p%u_ms=%.3f\n", percentiles[i], (double)g_loadLatencies[rank - 1] * 1000.0 / SIM_F_CPU);
+		}
+		fprintf(stderr, "latency_max_ms=%.3f\n", (double)g_loadLatencies[g_loadNumLatencies - 1] * 1000.0 / SIM_F_CPU);
+	}
+
+	for(uint8 i = 0 ; i < LOAD_NUM_OPERATIONS ; i++)
+	{
+		const Load_StatsType *stats = &g_loadStats[i];
+		uint32 ended = stats->count - stats->cut - stats->stuck;
+
+		fprintf(stderr, "%s.count=%lu\n", g_loadNames[i], (unsigned long)stats->count);
+		if(i != LOAD_BOOT)
+		{
+			fprintf(stderr, "%s.power_cuts=%lu\n", g_loadNames[i], (unsigned long)stats->cut);
+		}
+		fprintf(stderr, "%s.stuck=%lu\n", g_loadNames[i], (unsigned long)stats->stuck);
+		if(ended != 0)
+		{
+			fprintf(stderr, "%s.virtual_ms=%.3f\n", g_loadNames[i], (double)stats->cycles * 1000.0 / SIM_F_CPU / ended);
+			fprintf(stderr, "%s.eeprom_page_writes=%.2f\n", g_loadNames[i], (double)stats->pageWrites / ended);
+			fprintf(stderr, "%s.eeprom_page_writes_max=%lu\n", g_loadNames[i], (unsigned long)stats->maxPageWrites);
+			fprintf(stderr, "%s.eeprom_bytes_written=%.2f\n", g_loadNames[i], (double)stats->bytesWritten / ended);
+		}
+	}
+	fprintf(stderr, "eeprom_page_writes=%lu\n", (unsigned long)board->eeprom.pageWrites);
+	fprintf(stderr, "eeprom_bytes_written=%lu\n", (unsigned long)board->eeprom.bytesWritten);
+	fprintf(stderr, "eeprom_busy_nacks=%lu\n", (unsigned long)board->eeprom.busyNacks);
+	fprintf(stderr, "motor_moves=%lu\n", (unsigned long)board->motor.moves);
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+*  File name:		sim_motor.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Bolt driven by a DC motor through an H-bridge. The bolt moves at a speed that
+ * follows the mean voltage on the enable pin, OC0 in fast PWM or the pin level
+ * when the timer doesn't drive it, without inertia. At an end or at the jam the
+ * motor stalls and the current on the sense resistor goes up. The position is
+ * brought up to date whenever the MCU touches the bridge and at the cycle the
+ * bolt would reach an end, so nothing runs while it doesn't move.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint16 SIM_MOTOR_getDuty(Sim_ContextType *ctx);
+static sint32 SIM_MOTOR_getTarget(const Sim_MotorType *motor);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_MOTOR_init(Sim_MotorType *motor)
+{
+	motor->position = 0; /* locked */
+	motor->direction = 0;
+	motor->duty = 0;
+	motor->nextStop = SIM_FOREVER;
+	motor->lastCycle = 0;
+}
+
+void SIM_MOTOR_update(Sim_ContextType *ctx,Sim_MotorType *motor)
+{
+	uint64 travelCycles = SIM_MS_TO_CYCLES(motor->travelMs);
+	uint64 elapsed = ctx->cycles - motor->lastCycle;
+	uint8 output = SIM_GPIO_getOutput(ctx, motor->port);
+	boolean in1 = (output & (1<<motor->in1Pin)) ? TRUE : FALSE;
+	boolean in2 = (output & (1<<motor->in2Pin)) ? TRUE : FALSE;
+	sint32 target = SIM_MOTOR_getTarget(motor);
+	sint8 direction;
+	uint16 current = 0;
+
+	/* the way the bolt went since the last look */
+	if( (motor->direction != 0) && (motor->duty != 0) )
+	{
+		uint64 span = (elapsed > 2 * travelCycles) ? (2 * travelCycles) : elapsed; /* longer is past an end anyway */
+		uint64 step = (span * motor->duty * SIM_MOTOR_TRAVEL) / (256ULL * travelCycles);
+		sint64 room = (motor->direction > 0) ? (target - motor->position) : (motor->position - target);
+
+		if((sint64)step >= room)
+		{
+			uint64 moving = (uint64)room * 256ULL * travelCycles / ((uint64)motor->duty * SIM_MOTOR_TRAVEL);
+			motor->runningCycles += moving;
+			motor->stalledCycles += elapsed - moving;
+			if(motor->position != target)
+			{
+				SIM_yield(ctx); /* an end-stop trips or the bolt got stuck */
+			}
+			motor->position = target;
+		}
+		else
+		{
+			motor->runningCycles += elapsed;
+			motor->position += (motor->direction > 0) ? (sint32)step : -(sint32)step;
+		}
+	}
+	motor->lastCycle = ctx->cycles;
+
+	/* what the MCU asks for now */
+	direction = (in1 && !in2) ? 1 : ( (!in1 && in2) ? -1 : 0 );
+	if( (direction != 0) && (motor->direction == 0) )
+	{
+		motor->moves++;
+	}
+	motor->direction = direction;
+	motor->duty = SIM_MOTOR_getDuty(ctx);
+	target = SIM_MOTOR_getTarget(motor);
+
+	motor->nextStop = SIM_FOREVER;
+	if( (motor->direction != 0) && (motor->duty != 0) )
+	{
+		current = (uint16)(((uint32)motor->runCurrent * motor->duty) / 256);
+		if(motor->position == target)
+		{
+			current = (uint16)(current * SIM_MOTOR_STALL_FACTOR);
+		}
+		else
+		{
+			uint64 room = (uint64)((motor->direction > 0) ? (target - motor->position) : (motor->position - target));
+			motor->nextStop = ctx->cycles + 1 + room * 256ULL * travelCycles / ((uint64)motor->duty * SIM_MOTOR_TRAVEL);
+			SIM_schedule(ctx, motor->nextStop);
+		}
+	}
+	ctx->adc.inputs[motor->currentChannel] = (current > 0x3FF) ? 0x3FF : current;
+
+	if(motor->endStops)
+	{
+		if(motor->position >= SIM_MOTOR_TRAVEL)
+			SIM_GPIO_drive(ctx, motor->port, motor->openedPin, LOGIC_LOW);
+		else
+			SIM_GPIO_release(ctx, motor->port, motor->openedPin);
+		if(motor->position <= 0)
+			SIM_GPIO_drive(ctx, motor->port, motor->closedPin, LOGIC_LOW);
+		else
+			SIM_GPIO_release(ctx, motor->port, motor->closedPin);
+	}
+}
+
+boolean SIM_MOTOR_isOpened(const Sim_MotorType *motor)
+{
+	return (motor->position >= SIM_MOTOR_TRAVEL) ? TRUE : FALSE;
+}
+
+boolean SIM_MOTOR_isClosed(const Sim_MotorType *motor)
+{
+	return (motor->position <= 0) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_MOTOR_getDuty
+* Description:			Function to get the duty cycle on OC0, the new OCR0 is taken at once
+* 						where the chip waits for the end of the PWM period
+* Parameters (in):    	Context
+* Parameters (out):   	0 .. 256
+* Return value:      	uint16
+********************************************************************************/
+
+static uint16 SIM_MOTOR_getDuty(Sim_ContextType *ctx)
+{
+	uint8 tccr0 = ctx->io[SIM_TCCR0];
+	boolean fastPwm = ( (tccr0 & (1<<WGM00)) && (tccr0 & (1<<WGM01)) ) ? TRUE : FALSE;
+	uint16 high;
+
+	if((ctx->io[SIM_DDR_ADDRESS(SIM_MOTOR_OC0_PORT)] & (1<<SIM_MOTOR_OC0_PIN)) == 0)
+		return 0; /* the pin doesn't drive the bridge */
+
+	if( fastPwm && (tccr0 & (1<<COM01)) && (tccr0 & ((1<<CS02) | (1<<CS01) | (1<<CS00))) )
+	{
+		high = (uint16)(ctx->io[SIM_OCR0] + 1);
+		return (tccr0 & (1<<COM00)) ? (uint16)(256 - high) : high;
+	}
+	return (ctx->io[SIM_PORT_ADDRESS(SIM_MOTOR_OC0_PORT)] & (1<<SIM_MOTOR_OC0_PIN)) ? 256 : 0;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_MOTOR_getTarget
+* Description:			Function to get where the bolt stops in the way it turns
+* Parameters (in):    	Motor
+* Parameters (out):   	Position of the end or of the jam
+* Return value:      	sint32
+********************************************************************************/
+
+static sint32 SIM_MOTOR_getTarget(const Sim_MotorType *motor)
+{
+	if(motor->direction > 0)
+	{
+		return ( (motor->jamAt != SIM_MOTOR_NO_JAM) && (motor->jamAt >= motor->position) ) ? motor->jamAt : SIM_MOTOR_TRAVEL;
+	}
+	return ( (motor->jamAt != SIM_MOTOR_NO_JAM) && (motor->jamAt <= motor->position) ) ? motor->jamAt : 0;
+}
@@ -0,0 +1,527 @@
+/******************************************************************************
+*  File name:		sim_replay.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Runs MCU2 from the reset with the bytes of a capture of its link (the answer
+ * to MSG_ReadCapture, see LIB/capture.h of MCU2) to reproduce what it did in the
+ * field. Every received byte is put on the wire so that it is over when the field
+ * firmware read it, or earlier when the next one came less than a frame after it,
+ * and every byte MCU2 sends is checked against the capture, value and time. The
+ * times of the capture start when timer 2 starts, found here from the write to
+ * TCCR2, and have the step of timer 2 (32 us with the 8 ms tick).
+ *
+ *   replay [-e eeprom.bin] [-l] [-n] [-q] [-v] capture.bin
+ *
+ *   -e  EEPROM image of the lock at the reset the capture started from, from a
+ *       maintenance backup, blank without it
+ *   -l  list the events of the capture with their time and stop
+ *   -n  run the loops that wait for a peripheral instead of skipping them
+ *   -q  no statistics
+ *   -v  every byte replayed on stdout with its virtual time
+ *
+ * The replay is only exact with the image the capture was taken with, built with
+ * make CAPTURE=TRUE as the probes take time too. The statistics are written to
+ * stderr as key=value lines and the exit status is 1 if MCU2 didn't send what it
+ * sent in the field.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim_board.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define REPLAY_HEADER_SIZE			3			/* events and events lost */
+#define REPLAY_EVENT_SIZE			4			/* CAPTURE_EVENT_SIZE */
+#define REPLAY_TX					0x80		/* CAPTURE_TX */
+#define REPLAY_GAP					0x40		/* CAPTURE_GAP */
+#define REPLAY_FE					(1<<FE)
+#define REPLAY_DOR					(1<<DOR)
+#define REPLAY_TICK_STEPS			250			/* TIMER2_OCR2 + 1, only for -l */
+#define REPLAY_STEP_CYCLES			256			/* TIMER2_FCPU_256, only for -l */
+#define REPLAY_SLICE_MS				1			/* the bytes are put on the wire this much ahead */
+#define REPLAY_TAIL_MS				1000		/* MCU2 runs this long after the last event */
+#define REPLAY_MAX_BOOT_MS			5000		/* timer 2 must start by then */
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Name: Replay_EventType
+* Type: Structure
+* Description: Byte of the capture with its time since timer 2 started, the time is
+* 			   ticks of timer 2 from the silences and steps from the deltas as the
+* 			   steps of a tick are only known once MCU2 starts its timer
+********************************************************************************/
+typedef struct
+{
+	boolean tx;
+	uint8 data;
+	uint8 flags;		/* FE and DOR of a received byte */
+	uint64 ticks;
+	uint64 steps;
+	uint64 cycle;		/* of the replay */
+	uint64 end;			/* cycle a received byte is over on the wire */
+}Replay_EventType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static Sim_BoardType g_replayBoard;
+static Replay_EventType *g_replayEvents;
+static uint16 g_replayNumEvents = 0;
+static uint8 g_replayDropped = 0;
+static boolean g_replayVerbose = FALSE;
+static void (*g_replayBoardAccess)(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value);
+
+/* the clock of the capture in the replay */
+static boolean g_replayStarted = FALSE;
+static uint64 g_replayStart;			/* cycle timer 2 started */
+static uint32 g_replayStepCycles;
+static uint32 g_replayTickSteps;
+
+/* progress */
+static uint16 g_replayNextRx = 0;		/* next received byte to put on the wire */
+static uint16 g_replayNextRead = 0;		/* next received byte the firmware reads */
+static uint16 g_replayNextTx = 0;		/* next byte the firmware must send */
+static uint32 g_replayPlannedBitCycles = 0;
+static uint64 g_replayLastEnd = 0;
+static uint64 g_replayLastCycle = 0;	/* of the last event, once the clock is known */
+
+/* results */
+static boolean g_replayDiverged = FALSE;
+static uint16 g_replayDivergedEvent;
+static uint64 g_replayDivergedCycle;
+static sint16 g_replayDivergedGot;		/* -1 when the firmware read a byte it wasn't given */
+static uint64 g_replayMaxTxError = 0;
+static uint64 g_replayMaxRxLate = 0;	/* a byte read later than in the field */
+static uint32 g_replayAfterCapture = 0;
+static uint32 g_replayFlagged = 0;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static boolean REPLAY_load(const char *path);
+static void REPLAY_list(void);
+static void REPLAY_plan(Sim_ContextType *ctx);
+static void REPLAY_feed(Sim_ContextType *ctx,uint64 until);
+static void REPLAY_access(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value);
+static uint16 REPLAY_skip(uint16 index,boolean tx);
+static void REPLAY_check(Sim_ContextType *ctx,boolean tx,uint8 data);
+static void REPLAY_diverge(Sim_ContextType *ctx,uint16 event,sint16 got);
+static void REPLAY_report(double hz);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(int argc,char **argv)
+{
+	const char *eepromPath = NULL_PTR;
+	boolean list = FALSE;
+	boolean quiet = FALSE;
+	boolean skipLoops = TRUE;
+	Sim_ContextType *ctx = &g_replayBoard.mcu2;
+	int option;
+
+	while((option = getopt(argc, argv, "e:lnqv")) != -1)
+	{
+		switch(option)
+		{
+		case 'e': eepromPath = optarg; break;
+		case 'l': list = TRUE; break;
+		case 'n': skipLoops = FALSE; break;
+		case 'q': quiet = TRUE; break;
+		case 'v': g_replayVerbose = TRUE; break;
+		default:
+			fprintf(stderr, "usage: %s [-e eeprom.bin] [-l] [-n] [-q] [-v] capture.bin\n", argv[0]);
+			return 2;
+		}
+	}
+	if(optind >= argc)
+	{
+		fprintf(stderr, "usage: %s [-e eeprom.bin] [-l] [-n] [-q] [-v] capture.bin\n", argv[0]);
+		return 2;
+	}
+	if(REPLAY_load(argv[optind]) == FALSE)
+	{
+		fprintf(stderr, "%s: %s isn't an answer to MSG_ReadCapture\n", argv[0], argv[optind]);
+		return 1;
+	}
+	if(list)
+	{
+		REPLAY_list();
+		return 0;
+	}
+
+	if(SIM_BOARD_initMcu2(&g_replayBoard) == ERROR)
+	{
+		fprintf(stderr, "%s: no memory for the stack\n", argv[0]);
+		return 1;
+	}
+	if( (eepromPath != NULL_PTR) && (SIM_EEPROM_load(&g_replayBoard.eeprom, eepromPath) == FALSE) )
+	{
+		fprintf(stderr, "%s: can't read %s\n", argv[0], eepromPath);
+		SIM_BOARD_deinit(&g_replayBoard);
+		return 1;
+	}
+	ctx->skipLoops = skipLoops;
+	g_replayBoardAccess = ctx->onAccess;
+	ctx->onAccess = REPLAY_access;
+
+	while(ctx->stopReason == SIM_RUNNING)
+	{
+		uint64 until = ctx->cycles + SIM_MS_TO_CYCLES(REPLAY_SLICE_MS);
+
+		if(g_replayStarted == FALSE)
+		{
+			if(ctx->cycles >= SIM_MS_TO_CYCLES(REPLAY_MAX_BOOT_MS))
+				break;
+		}
+		else if( (g_replayNextRx == g_replayNumEvents) && (ctx->cycles >= g_replayLastCycle + SIM_MS_TO_CYCLES(REPLAY_TAIL_MS)) )
+		{
+			break;
+		}
+		REPLAY_feed(ctx, until);
+		SIM_resume(ctx, until);
+	}
+
+	if(g_replayStarted == FALSE)
+	{
+		fprintf(stderr, "%s: MCU2 didn't start timer 2\n", argv[0]);
+		g_replayDiverged = TRUE;
+	}
+	else if(g_replayDiverged == FALSE)
+	{
+		/* a byte of the capture the firmware never sent or never read */
+		uint16 tx = REPLAY_skip(g_replayNextTx, TRUE);
+		uint16 rx = REPLAY_skip(g_replayNextRead, FALSE);
+		if( (tx != g_replayNumEvents) || (rx != g_replayNumEvents) )
+			REPLAY_diverge(ctx, (tx < rx) ? tx : rx, -1);
+	}
+	if(quiet == FALSE)
+	{
+		REPLAY_report((double)SIM_F_CPU);
+	}
+	SIM_BOARD_deinit(&g_replayBoard);
+	free(g_replayEvents);
+	return g_replayDiverged ? 1 : 0;
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		REPLAY_load
+* Description:			Function to read a capture, the silences are added to the time of the
+* 						byte that follows them
+* Parameters (in):    	Path of the capture
+* Parameters (out):   	FALSE if it can't be read or is cut
+* Return value:      	boolean
+********************************************************************************/
+
+static boolean REPLAY_load(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	uint8 header[REPLAY_HEADER_SIZE];
+	uint16 count;
+	uint64 ticks = 0;
+	uint64 steps = 0;
+
+	if(file == NULL_PTR)
+		return FALSE;
+	if(fread(header, 1, REPLAY_HEADER_SIZE, file) != REPLAY_HEADER_SIZE)
+	{
+		fclose(file);
+		return FALSE;
+	}
+	count = (uint16)(header[0] | (header[1] << 8));
+	g_replayDropped = header[2];
+	g_replayEvents = calloc((count != 0) ? count : 1, sizeof(Replay_EventType));
+	if(g_replayEvents == NULL_PTR)
+	{
+		fclose(file);
+		return FALSE;
+	}
+
+	for(uint16 i = 0 ; i < count ; i++)
+	{
+		uint8 bytes[REPLAY_EVENT_SIZE];
+		uint16 delta;
+		Replay_EventType *event = &g_replayEvents[g_replayNumEvents];
+
+		if(fread(bytes, 1, REPLAY_EVENT_SIZE, file) != REPLAY_EVENT_SIZE)
+		{
+			fclose(file);
+			return FALSE;
+		}
+		delta = (uint16)(bytes[2] | (bytes[3] << 8));
+		if(bytes[0] == REPLAY_GAP)
+		{
+			ticks += (uint32)bytes[1] | ((uint32)delta << 8);
+			continue;
+		}
+		steps += delta;
+		event->tx = (bytes[0] & REPLAY_TX) ? TRUE : FALSE;
+		event->flags = bytes[0] & (REPLAY_FE | REPLAY_DOR);
+		event->data = bytes[1];
+		event->ticks = ticks;
+		event->steps = steps;
+		g_replayFlagged += (event->flags != 0) ? 1 : 0;
+		g_replayNumEvents++;
+	}
+	fclose(file);
+	return TRUE;
+}
+
+/*******************************************************************************
+* Function Name:		REPLAY_list
+* Description:			Function to write the events of the capture on stdout, with the 8 ms tick
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void REPLAY_list(void)
+{
+	for(uint16 i = 0 ; i < g_replayNumEvents ; i++)
+	{
+		const Replay_EventType *event = &g_replayEvents[i];
+		uint64 cycles = (event->ticks * REPLAY_TICK_STEPS + event->steps) * REPLAY_STEP_CYCLES;
+
+		printf("%12.3f ms %s %02x%s%s\n", (double)cycles * 1000.0 / SIM_F_CPU, event->tx ? "tx" : "rx", event->data,
+				(event->flags & REPLAY_FE) ? " FE" : "", (event->flags & REPLAY_DOR) ? " DOR" : "");
+	}
+	printf("events=%u\n", g_replayNumEvents);
+	printf("dropped=%u\n", g_replayDropped);
+}
+
+/*******************************************************************************
+* Function Name:		REPLAY_plan
+* Description:			Function to find the cycle every received byte not on the wire yet must be
+* 						over, from the last one back as a byte read less than a frame before the
+* 						next one was waiting in UDR, again if the baud rate changed
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void REPLAY_plan(Sim_ContextType *ctx)
+{
+	uint64 frame = (uint64)SIM_UART_getFrameBits(ctx) * SIM_UART_getBitCycles(ctx);
+	uint64 next = SIM_FOREVER;
+
+	g_replayPlannedBitCycles = SIM_UART_getBitCycles(ctx);
+	for(sint32 i = (sint32)g_replayNumEvents - 1 ; i >= (sint32)g_replayNextRx ; i--)
+	{
+		Replay_EventType *event = &g_replayEvents[i];
+		if(event->tx)
+			continue;
+		event->end = (next - frame < event->cycle) ? (next - frame) : event->cycle;
+		next = event->end;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		REPLAY_feed
+* Description:			Function to put on the wire the received bytes that start before a cycle,
+* 						once the receiver of MCU2 is on
+* Parameters (in):    	Context and the cycle
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void REPLAY_feed(Sim_ContextType *ctx,uint64 until)
+{
+	uint64 frame;
+
+	if( (g_replayStarted == FALSE) || ((ctx->io[SIM_UCSRB] & (1<<RXEN)) == 0) )
+		return;
+	if(SIM_UART_getBitCycles(ctx) != g_replayPlannedBitCycles)
+	{
+		REPLAY_plan(ctx);
+	}
+	frame = (uint64)SIM_UART_getFrameBits(ctx) * SIM_UART_getBitCycles(ctx);
+
+	while(g_replayNextRx < g_replayNumEvents)
+	{
+		Replay_EventType *event = &g_replayEvents[g_replayNextRx];
+		uint64 start;
+
+		if(event->tx)
+		{
+			g_replayNextRx++;
+			continue;
+		}
+		start = (event->end > frame) ? (event->end - frame) : 0;
+		start = (start < g_replayLastEnd) ? g_replayLastEnd : start;
+		start = (start < ctx->cycles) ? ctx->cycles : start;
+		if(start >= until)
+			break;
+		SIM_UART_receive(ctx, event->data, SIM_UART_getBitCycles(ctx), start);
+		g_replayLastEnd = start + frame;
+		g_replayNextRx++;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		REPLAY_access
+* Description:			Function to find the start of timer 2 and to follow the bytes the firmware
+* 						reads and writes, then to pass the access to the board
+* Parameters (in):    	Context, register address, TRUE for a write and the value
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void REPLAY_access(Sim_ContextType *ctx,uint8 address,boolean write,uint16 value)
+{
+	static const uint16 prescalers[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+
+	if( write && (address == SIM_TCCR2) && (value & 0x07) && (g_replayStarted == FALSE) )
+	{
+		g_replayStarted = TRUE;
+		g_replayStart = ctx->cycles;
+		g_replayStepCycles = prescalers[value & 0x07];
+		g_replayTickSteps = (uint32)ctx->io[SIM_OCR2] + 1; /* CTC, OCR2 is set first */
+		for(uint16 i = 0 ; i < g_replayNumEvents ; i++)
+		{
+			Replay_EventType *event = &g_replayEvents[i];
+			event->cycle = g_replayStart + (event->ticks * g_replayTickSteps + event->steps) * g_replayStepCycles;
+		}
+		g_replayLastCycle = (g_replayNumEvents != 0) ? g_replayEvents[g_replayNumEvents - 1].cycle : g_replayStart;
+	}
+	else if( g_replayStarted && (address == SIM_UDR) )
+	{
+		REPLAY_check(ctx, write, (uint8)value);
+	}
+	g_replayBoardAccess(ctx, address, write, value);
+}
+
+/*******************************************************************************
+* Function Name:		REPLAY_skip
+* Description:			Function to find the next byte of the capture in one direction
+* Parameters (in):    	Index to start from and TRUE for the bytes MCU2 sent
+* Parameters (out):   	Index of the byte, the number of events if there is none
+* Return value:      	uint16
+********************************************************************************/
+
+static uint16 REPLAY_skip(uint16 index,boolean tx)
+{
+	while( (index < g_replayNumEvents) && (g_replayEvents[index].tx != tx) )
+	{
+		index++;
+	}
+	return index;
+}
+
+/*******************************************************************************
+* Function Name:		REPLAY_check
+* Description:			Function to check a byte the firmware read or wrote against the capture
+* Parameters (in):    	Context, TRUE for a written byte and the byte
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void REPLAY_check(Sim_ContextType *ctx,boolean tx,uint8 data)
+{
+	uint16 *next = tx ? &g_replayNextTx : &g_replayNextRead;
+	Replay_EventType *event;
+
+	*next = REPLAY_skip(*next, tx);
+	if(*next == g_replayNumEvents)
+	{
+		if(tx)
+			g_replayAfterCapture++; /* the answer to MSG_ReadCapture, or after the capture was full */
+		else if(g_replayDiverged == FALSE)
+			REPLAY_diverge(ctx, g_replayNumEvents, -1);
+		return;
+	}
+
+	event = &g_replayEvents[*next];
+	if(g_replayVerbose)
+	{
+		printf("%12.3f ms %s %02x, %+.3f ms from the capture\n", (double)ctx->cycles * 1000.0 / SIM_F_CPU,
+				tx ? "tx" : "rx", data, ((double)ctx->cycles - (double)event->cycle) * 1000.0 / SIM_F_CPU);
+	}
+	if( (event->data != data) && (g_replayDiverged == FALSE) )
+	{
+		REPLAY_diverge(ctx, *next, data);
+	}
+	if(tx)
+	{
+		uint64 error = (ctx->cycles > event->cycle) ? (ctx->cycles - event->cycle) : (event->cycle - ctx->cycles);
+		g_replayMaxTxError = (error > g_replayMaxTxError) ? error : g_replayMaxTxError;
+	}
+	else if(ctx->cycles > event->cycle + g_replayStepCycles)
+	{
+		uint64 late = ctx->cycles - event->cycle;
+		g_replayMaxRxLate = (late > g_replayMaxRxLate) ? late : g_replayMaxRxLate;
+	}
+	(*next)++;
+}
+
+/*******************************************************************************
+* Function Name:		REPLAY_diverge
+* Description:			Function to save where the replay first differs from the capture
+* Parameters (in):    	Context, the event and what the firmware sent instead, -1 if nothing
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void REPLAY_diverge(Sim_ContextType *ctx,uint16 event,sint16 got)
+{
+	g_replayDiverged = TRUE;
+	g_replayDivergedEvent = event;
+	g_replayDivergedCycle = ctx->cycles;
+	g_replayDivergedGot = got;
+	if(g_replayVerbose)
+	{
+		printf("%12.3f ms diverged at event %u\n", (double)ctx->cycles * 1000.0 / SIM_F_CPU, event);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		REPLAY_report
+* Description:			Function to write the result of the replay as key=value lines on stderr
+* Parameters (in):    	Clock of MCU2
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void REPLAY_report(double hz)
+{
+	fprintf(stderr, "events=%u\n", g_replayNumEvents);
+	fprintf(stderr, "dropped=%u\n", g_replayDropped);
+	fprintf(stderr, "rx_errors=%u\n", g_replayFlagged);
+	fprintf(stderr, "rx_read=%u\n", g_replayNextRead);
+	fprintf(stderr, "tx_checked=%u\n", g_replayNextTx);
+	fprintf(stderr, "tx_after_capture=%u\n", g_replayAfterCapture);
+	fprintf(stderr, "tx_max_error_us=%.1f\n", (double)g_replayMaxTxError * 1e6 / hz);
+	fprintf(stderr, "rx_max_late_us=%.1f\n", (double)g_replayMaxRxLate * 1e6 / hz);
+	fprintf(stderr, "mcu2_stop=%u\n", g_replayBoard.mcu2.stopReason);
+	fprintf(stderr, "replay=%s\n", g_replayDiverged ? "diverged" : "matched");
+	if(g_replayDiverged)
+	{
+		fprintf(stderr, "diverged_event=%u\n", g_replayDivergedEvent);
+		fprintf(stderr, "diverged_ms=%.3f\n", (double)g_replayDivergedCycle * 1000.0 / hz);
+		if(g_replayDivergedGot >= 0)
+			fprintf(stderr, "diverged_byte=%02x\n", g_replayDivergedGot);
+		if(g_replayDivergedEvent < g_replayNumEvents)
+			fprintf(stderr, "expected_byte=%02x\n", g_replayEvents[g_replayDivergedEvent].data);
+	}
+}
@@ -0,0 +1,231 @@
+/******************************************************************************
+*  File name:		sim_run.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Runs one firmware alone : the bytes on stdin are sent to its UART like the
+ * other MCU would, what it sends goes to stdout. The run ends at the time limit
+ * or once the input is over and the firmware has been quiet for the idle time,
+ * then the statistics are written to stderr as key=value lines.
+ *
+ *   mcu2 [-t seconds] [-i ms] [-x] [-n] [-q] [-v] < input > output
+ *
+ *   -t  virtual time limit, 10 s by default
+ *   -i  quiet time after the end of the input, 1000 ms by default
+ *   -x  write every sent byte as "<virtual ms> <hex>" instead of raw bytes
+ *   -n  run the loops that wait for a peripheral instead of skipping them
+ *   -q  no statistics
+ *   -v  statistics of every register and ISR too
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define RUN_DEFAULT_SECONDS		10
+#define RUN_DEFAULT_IDLE_MS		1000
+#define RUN_SLICE_MS			1		/* the end of the run is checked this often */
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+extern const Sim_FirmwareType SIM_RUN_FIRMWARE; /* SIM_FIRMWARE_MCU1 or SIM_FIRMWARE_MCU2 */
+
+static Sim_ContextType g_runMcu;
+static boolean g_runHex = FALSE;
+static boolean g_runInputDone = FALSE;
+static uint64 g_runLastActivity = 0;	/* cycle of the last byte in or out */
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static sint16 RUN_source(Sim_ContextType *ctx);
+static void RUN_sink(Sim_ContextType *ctx,uint8 byte,uint32 bitCycles);
+static void RUN_report(Sim_ContextType *ctx,double hostSeconds,boolean verbose);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(int argc,char **argv)
+{
+	double seconds = RUN_DEFAULT_SECONDS;
+	uint64 idle;
+	uint64 limit;
+	boolean quiet = FALSE;
+	boolean verbose = FALSE;
+	boolean skipLoops = TRUE;
+	struct timespec start, end;
+	int option;
+
+	idle = SIM_MS_TO_CYCLES(RUN_DEFAULT_IDLE_MS);
+	while((option = getopt(argc, argv, "t:i:xnqv")) != -1)
+	{
+		switch(option)
+		{
+		case 't': seconds = atof(optarg); break;
+		case 'i': idle = SIM_MS_TO_CYCLES(atol(optarg)); break;
+		case 'x': g_runHex = TRUE; break;
+		case 'n': skipLoops = FALSE; break;
+		case 'q': quiet = TRUE; break;
+		case 'v': verbose = TRUE; break;
+		default:
+			fprintf(stderr, "usage: %s [-t seconds] [-i ms] [-x] [-n] [-q] [-v] < input > output\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if(SIM_init(&g_runMcu, &SIM_RUN_FIRMWARE, NULL_PTR) == ERROR)
+	{
+		fprintf(stderr, "%s: no memory for the stack\n", argv[0]);
+		return 1;
+	}
+	g_runMcu.uart.source = RUN_source;
+	g_runMcu.uart.sink = RUN_sink;
+	g_runMcu.skipLoops = skipLoops;
+
+	limit = (uint64)(seconds * SIM_F_CPU);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while(g_runMcu.cycles < limit)
+	{
+		uint64 until = g_runMcu.cycles + SIM_MS_TO_CYCLES(RUN_SLICE_MS);
+		if(SIM_resume(&g_runMcu, (until < limit) ? until : limit) == FALSE)
+			break;
+		if( g_runInputDone && (g_runMcu.cycles >= g_runLastActivity + idle) )
+			break;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	fflush(stdout);
+
+	if(quiet == FALSE)
+	{
+		RUN_report(&g_runMcu, (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9, verbose);
+	}
+	SIM_deinit(&g_runMcu);
+	return 0;
+}
+
+/*******************************************************************************
+* Function Name:		RUN_source
+* Description:			Function to give the UART the next byte of stdin
+* Parameters (in):    	Context
+* Parameters (out):   	Byte or -1 at the end of the input
+* Return value:      	sint16
+********************************************************************************/
+
+static sint16 RUN_source(Sim_ContextType *ctx)
+{
+	uint8 byte;
+
+	g_runLastActivity = ctx->cycles;
+	if(read(STDIN_FILENO, &byte, 1) != 1)
+	{
+		g_runInputDone = TRUE;
+		ctx->uart.source = NULL_PTR;
+		return -1;
+	}
+	return byte;
+}
+
+/*******************************************************************************
+* Function Name:		RUN_sink
+* Description:			Function to write a byte the firmware sent to stdout
+* Parameters (in):    	Context, the byte and its bit time
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void RUN_sink(Sim_ContextType *ctx,uint8 byte,uint32 bitCycles)
+{
+	(void)bitCycles;
+	g_runLastActivity = ctx->cycles;
+	if(g_runHex)
+	{
+		printf("%.3f %02x\n", (double)ctx->cycles * 1000.0 / SIM_F_CPU, byte);
+	}
+	else
+	{
+		putchar(byte);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		RUN_report
+* Description:			Function to write the statistics of the run to stderr
+* Parameters (in):    	Context, host time of the run and TRUE for every register and ISR
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void RUN_report(Sim_ContextType *ctx,double hostSeconds,boolean verbose)
+{
+	static const char *const reasons[] = {"time", "stopped", "returned", "sleep_forever", "bad_interrupt"};
+	double virtualSeconds = (double)ctx->cycles / SIM_F_CPU;
+	uint64 reads = 0;
+	uint64 writes = 0;
+
+	for(uint8 i = 0 ; i < SIM_IO_SIZE ; i++)
+	{
+		reads += ctx->stats.registerReads[i];
+		writes += ctx->stats.registerWrites[i];
+	}
+
+	fprintf(stderr, "firmware=%s\n", ctx->name);
+	fprintf(stderr, "end=%s\n", reasons[ctx->stopReason]);
+	fprintf(stderr, "cycles=%llu\n", (unsigned long long)ctx->cycles);
+	fprintf(stderr, "virtual_ms=%.3f\n", virtualSeconds * 1000.0);
+	fprintf(stderr, "host_ms=%.3f\n", hostSeconds * 1000.0);
+	fprintf(stderr, "speedup=%.1f\n", (hostSeconds > 0) ? (virtualSeconds / hostSeconds) : 0.0);
+	fprintf(stderr, "accesses=%llu\n", (unsigned long long)ctx->stats.accesses);
+	fprintf(stderr, "calls=%llu\n", (unsigned long long)ctx->stats.calls);
+	fprintf(stderr, "register_reads=%llu\n", (unsigned long long)reads);
+	fprintf(stderr, "register_writes=%llu\n", (unsigned long long)writes);
+	fprintf(stderr, "delay_ms=%.3f\n", (double)ctx->stats.delayCycles * 1000.0 / SIM_F_CPU);
+	fprintf(stderr, "sleep_ms=%.3f\n", (double)ctx->stats.sleepCycles * 1000.0 / SIM_F_CPU);
+	fprintf(stderr, "skipped_ms=%.3f\n", (double)ctx->stats.skippedCycles * 1000.0 / SIM_F_CPU);
+	fprintf(stderr, "skips=%llu\n", (unsigned long long)ctx->stats.skips);
+	fprintf(stderr, "uart_tx_bytes=%lu\n", (unsigned long)ctx->uart.txBytes);
+	fprintf(stderr, "uart_rx_bytes=%lu\n", (unsigned long)ctx->uart.rxBytes);
+	fprintf(stderr, "uart_frame_errors=%lu\n", (unsigned long)ctx->uart.frameErrors);
+	fprintf(stderr, "uart_overruns=%lu\n", (unsigned long)ctx->uart.overruns);
+	fprintf(stderr, "twi_starts=%lu\n", (unsigned long)ctx->twi.starts);
+	fprintf(stderr, "twi_bytes=%lu\n", (unsigned long)ctx->twi.bytes);
+	fprintf(stderr, "twi_nacks=%lu\n", (unsigned long)ctx->twi.nacks);
+	fprintf(stderr, "adc_conversions=%lu\n", (unsigned long)ctx->adc.conversions);
+	fprintf(stderr, "int_eeprom_reads=%lu\n", (unsigned long)ctx->intEeprom.reads);
+	fprintf(stderr, "int_eeprom_writes=%lu\n", (unsigned long)ctx->intEeprom.writes);
+
+	for(uint8 i = 1 ; i < SIM_NUM_VECTORS ; i++)
+	{
+		if( (ctx->stats.interrupts[i] != 0) || (verbose && (ctx->firmware->vectors[i] != NULL_PTR)) )
+		{
+			fprintf(stderr, "isr.%s.count=%llu\n", SIM_getVectorName(i), (unsigned long long)ctx->stats.interrupts[i]);
+			fprintf(stderr, "isr.%s.cycles=%llu\n", SIM_getVectorName(i), (unsigned long long)ctx->stats.interruptCycles[i]);
+		}
+	}
+	if(verbose)
+	{
+		for(uint8 i = 0 ; i < SIM_IO_SIZE ; i++)
+		{
+			if( (ctx->stats.registerReads[i] != 0) || (ctx->stats.registerWrites[i] != 0) )
+			{
+				fprintf(stderr, "reg.%s.reads=%llu\n", SIM_getRegisterName(i), (unsigned long long)ctx->stats.registerReads[i]);
+				fprintf(stderr, "reg.%s.writes=%llu\n", SIM_getRegisterName(i), (unsigned long long)ctx->stats.registerWrites[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,290 @@
+/******************************************************************************
+*  File name:		sim_timer.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Timers 0, 1 and 2. A counter is only brought up to date when it is read, when
+ * its settings change and at the events the simulator asked for, the compare
+ * matches and overflows in between are counted in one step. The dual slope PWM
+ * modes count up only at half the clock, which keeps their period and the number
+ * of matches but not the position of the matches inside the period.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+typedef struct
+{
+	uint32 prescaler;		/* CPU cycles per count, 0 if the timer is stopped */
+	uint32 period;			/* counts from BOTTOM back to BOTTOM */
+	uint32 max;				/* 0xFF or 0xFFFF */
+	uint8 numCompare;
+	uint16 compare[2];
+	uint8 compareFlag[2];	/* bits in TIFR */
+	uint8 compareEnable[2];	/* bits in TIMSK */
+	uint8 overflowFlag;
+	uint8 overflowEnable;
+	boolean overflowAtTop;	/* FALSE in CTC where TOV is set at MAX only */
+	boolean toggleA;		/* COMxA = 01 in a non PWM mode */
+}Sim_TimerConfigType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+static const uint16 g_simTimer01Prescalers[8] = {0, 1, 8, 64, 256, 1024, 0, 0}; /* the T0 and T1 pins aren't simulated */
+static const uint16 g_simTimer2Prescalers[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void SIM_TIMER_getConfig(Sim_ContextType *ctx,uint8 timer,Sim_TimerConfigType *config);
+static void SIM_TIMER_count(Sim_ContextType *ctx,uint8 timer,const Sim_TimerConfigType *config,uint64 ticks);
+static uint64 SIM_TIMER_ticksTo(uint32 count,uint32 value,uint32 period);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_TIMER_sync(Sim_ContextType *ctx)
+{
+	for(uint8 i = 0 ; i < SIM_NUM_TIMERS ; i++)
+	{
+		Sim_TimerType *timer = &ctx->timers[i];
+		Sim_TimerConfigType config;
+		uint64 total;
+
+		SIM_TIMER_getConfig(ctx, i, &config);
+		total = timer->prescalerCount + (ctx->cycles - timer->lastCycle);
+		timer->lastCycle = ctx->cycles;
+		if(config.prescaler == 0)
+			continue;
+
+		timer->prescalerCount = (uint32)(total % config.prescaler);
+		SIM_TIMER_count(ctx, i, &config, total / config.prescaler);
+	}
+}
+
+uint64 SIM_TIMER_run(Sim_ContextType *ctx)
+{
+	uint64 next = SIM_FOREVER;
+
+	SIM_TIMER_sync(ctx);
+	for(uint8 i = 0 ; i < SIM_NUM_TIMERS ; i++)
+	{
+		const Sim_TimerType *timer = &ctx->timers[i];
+		Sim_TimerConfigType config;
+		uint64 ticks = SIM_FOREVER;
+		uint64 cycle;
+
+		SIM_TIMER_getConfig(ctx, i, &config);
+		if(config.prescaler == 0)
+			continue;
+
+		/* the events of the enabled interrupts and of the flags the firmware may be waiting for,
+		 * a flag nobody clears is set once and the timer has no events anymore */
+		if(timer->count >= config.period)
+		{
+			ticks = config.max + 1 - timer->count;
+		}
+		else
+		{
+			for(uint8 k = 0 ; k < config.numCompare ; k++)
+			{
+				if( ((ctx->io[SIM_TIMSK] & config.compareEnable[k]) || ((ctx->io[SIM_TIFR] & config.compareFlag[k]) == 0))
+						&& (config.compare[k] < config.period) )
+				{
+					uint64 toMatch = SIM_TIMER_ticksTo(timer->count, config.compare[k], config.period);
+					ticks = (toMatch < ticks) ? toMatch : ticks;
+				}
+			}
+			if( ((ctx->io[SIM_TIMSK] & config.overflowEnable) || ((ctx->io[SIM_TIFR] & config.overflowFlag) == 0))
+					&& config.overflowAtTop )
+			{
+				uint64 toOverflow = config.period - timer->count;
+				ticks = (toOverflow < ticks) ? toOverflow : ticks;
+			}
+		}
+		if(ticks == SIM_FOREVER)
+			continue;
+
+		cycle = ctx->cycles + (ticks - 1) * config.prescaler + (config.prescaler - timer->prescalerCount);
+		next = (cycle < next) ? cycle : next;
+	}
+	return next;
+}
+
+void SIM_TIMER_setCount(Sim_ContextType *ctx,uint8 timer,uint16 count)
+{
+	ctx->timers[timer].count = (timer == 1) ? count : (uint8)count;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_TIMER_getConfig
+* Description:			Function to decode the registers of a timer
+* Parameters (in):    	Context and timer number
+* Parameters (out):   	Settings of the timer
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_TIMER_getConfig(Sim_ContextType *ctx,uint8 timer,Sim_TimerConfigType *config)
+{
+	uint8 mode;
+	boolean dualSlope = FALSE;
+
+	config->overflowAtTop = TRUE;
+	config->toggleA = FALSE;
+	if(timer == 1)
+	{
+		uint8 tccra = ctx->io[SIM_TCCR1A];
+		uint8 tccrb = ctx->io[SIM_TCCR1B];
+		static const uint8 pwmBits[4] = {0, 8, 9, 10};
+
+		mode = (tccra & 0x03) | ((tccrb >> WGM12) & 0x03) << 2;
+		config->prescaler = g_simTimer01Prescalers[tccrb & 0x07];
+		config->max = 0xFFFF;
+		config->numCompare = 2;
+		config->compare[0] = SIM_REG16(ctx, SIM_OCR1AL);
+		config->compare[1] = SIM_REG16(ctx, SIM_OCR1BL);
+		config->compareFlag[0] = (1<<OCF1A);
+		config->compareFlag[1] = (1<<OCF1B);
+		config->compareEnable[0] = (1<<OCIE1A);
+		config->compareEnable[1] = (1<<OCIE1B);
+		config->overflowFlag = (1<<TOV1);
+		config->overflowEnable = (1<<TOIE1);
+
+		switch(mode)
+		{
+		case 0: case 13: /* normal and reserved */
+			config->period = 0x10000;
+			break;
+		case 1: case 2: case 3: /* phase correct 8, 9 and 10 bits */
+		case 5: case 6: case 7: /* fast PWM 8, 9 and 10 bits */
+			config->period = 1UL << pwmBits[mode & 0x03];
+			dualSlope = (mode < 4) ? TRUE : FALSE;
+			break;
+		case 4: /* CTC, TOP = OCR1A */
+		case 9: case 11: case 15: /* PWM with TOP = OCR1A */
+			config->period = (uint32)config->compare[0] + 1;
+			dualSlope = ((mode == 9) || (mode == 11)) ? TRUE : FALSE;
+			break;
+		default: /* 8, 10, 12 and 14 : TOP = ICR1 */
+			config->period = (uint32)SIM_REG16(ctx, SIM_ICR1L) + 1;
+			dualSlope = ((mode == 8) || (mode == 10)) ? TRUE : FALSE;
+			break;
+		}
+		if( (mode == 4) || (mode == 12) )
+		{
+			config->overflowAtTop = (config->period == 0x10000) ? TRUE : FALSE;
+		}
+		config->toggleA = ( (((tccra >> COM1A0) & 0x03) == 1) && ((mode == 0) || (mode == 4) || (mode == 12)) ) ? TRUE : FALSE;
+	}
+	else
+	{
+		uint8 tccr = ctx->io[(timer == 0) ? SIM_TCCR0 : SIM_TCCR2];
+
+		/* same bits in TCCR0 and TCCR2 */
+		mode = ((tccr >> WGM00) & 0x01) | (((tccr >> WGM01) & 0x01) << 1);
+		config->prescaler = (timer == 0) ? g_simTimer01Prescalers[tccr & 0x07] : g_simTimer2Prescalers[tccr & 0x07];
+		config->max = 0xFF;
+		config->numCompare = 1;
+		config->compare[0] = ctx->io[(timer == 0) ? SIM_OCR0 : SIM_OCR2];
+		config->compareFlag[0] = (timer == 0) ? (1<<OCF0) : (1<<OCF2);
+		config->compareEnable[0] = (timer == 0) ? (1<<OCIE0) : (1<<OCIE2);
+		config->overflowFlag = (timer == 0) ? (1<<TOV0) : (1<<TOV2);
+		config->overflowEnable = (timer == 0) ? (1<<TOIE0) : (1<<TOIE2);
+
+		if(mode == 2) /* CTC, TOP = OCRx */
+		{
+			config->period = (uint32)config->compare[0] + 1;
+			config->overflowAtTop = (config->period == 0x100) ? TRUE : FALSE;
+		}
+		else
+		{
+			config->period = 0x100;
+			dualSlope = (mode == 1) ? TRUE : FALSE;
+		}
+		config->toggleA = ( (((tccr >> COM00) & 0x03) == 1) && ((mode == 0) || (mode == 2)) ) ? TRUE : FALSE;
+	}
+
+	if(dualSlope)
+	{
+		config->prescaler *= 2;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_TIMER_count
+* Description:			Function to count some timer clocks at once and set the flags of the
+* 						matches and overflows on the way
+* Parameters (in):    	Context, timer number, its settings and the number of clocks
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_TIMER_count(Sim_ContextType *ctx,uint8 timer,const Sim_TimerConfigType *config,uint64 ticks)
+{
+	Sim_TimerType *state = &ctx->timers[timer];
+	uint64 count = state->count;
+
+	if(ticks == 0)
+		return;
+
+	if(count >= config->period)
+	{
+		/* TOP was moved under the counter, it runs up to MAX and wraps first */
+		uint64 toMax = config->max + 1 - count;
+		if(ticks < toMax)
+		{
+			state->count = (uint16)(count + ticks);
+			return;
+		}
+		ticks -= toMax;
+		count = 0;
+		ctx->io[SIM_TIFR] |= config->overflowFlag;
+	}
+
+	for(uint8 k = 0 ; k < config->numCompare ; k++)
+	{
+		if(config->compare[k] < config->period)
+		{
+			uint64 first = SIM_TIMER_ticksTo((uint32)count, config->compare[k], config->period);
+			if(ticks >= first)
+			{
+				ctx->io[SIM_TIFR] |= config->compareFlag[k];
+				if( (k == 0) && config->toggleA )
+				{
+					state->toggles += (uint32)(1 + (ticks - first) / config->period);
+				}
+			}
+		}
+	}
+	if( ((count + ticks) >= config->period) && config->overflowAtTop )
+	{
+		ctx->io[SIM_TIFR] |= config->overflowFlag;
+	}
+	state->count = (uint16)((count + ticks) % config->period);
+}
+
+/*******************************************************************************
+* Function Name:		SIM_TIMER_ticksTo
+* Description:			Function to get the number of clocks until the counter reaches a value
+* Parameters (in):    	Counter, value and period, the value is inside the period
+* Parameters (out):   	Number of clocks, at least 1
+* Return value:      	uint64
+********************************************************************************/
+
+static uint64 SIM_TIMER_ticksTo(uint32 count,uint32 value,uint32 period)
+{
+	return (value > count) ? (value - count) : (value + period - count);
+}
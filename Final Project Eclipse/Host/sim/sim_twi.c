@@ -0,0 +1,230 @@
+/******************************************************************************
+*  File name:		sim_twi.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * TWI in master mode with the slaves attached by the board model. An operation
+ * started by writing TWINT ends after the bits it puts on the bus at the rate of
+ * TWBR and TWPS, then TWINT and the status are set like on the chip. An address
+ * no device answers to is not acknowledged.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define SIM_TWI_STATUS_BUS_ERROR		0x00
+#define SIM_TWI_STATUS_START			0x08
+#define SIM_TWI_STATUS_REP_START		0x10
+#define SIM_TWI_STATUS_MT_SLA_ACK		0x18
+#define SIM_TWI_STATUS_MT_SLA_NACK		0x20
+#define SIM_TWI_STATUS_MT_DATA_ACK		0x28
+#define SIM_TWI_STATUS_MT_DATA_NACK		0x30
+#define SIM_TWI_STATUS_MR_SLA_ACK		0x40
+#define SIM_TWI_STATUS_MR_SLA_NACK		0x48
+#define SIM_TWI_STATUS_MR_DATA_ACK		0x50
+#define SIM_TWI_STATUS_MR_DATA_NACK		0x58
+#define SIM_TWI_STATUS_NO_INFO			0xF8
+
+#define SIM_TWI_BITS_PER_BYTE	9
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static uint32 SIM_TWI_getBitCycles(Sim_ContextType *ctx);
+static Sim_TwiDeviceType *SIM_TWI_find(Sim_ContextType *ctx,uint8 address);
+static void SIM_TWI_transfer(Sim_ContextType *ctx);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+void SIM_TWI_attach(Sim_ContextType *ctx,Sim_TwiDeviceType *device)
+{
+	if(ctx->twi.numDevices < SIM_TWI_MAX_DEVICES)
+	{
+		ctx->twi.devices[ctx->twi.numDevices++] = device;
+	}
+}
+
+void SIM_TWI_control(Sim_ContextType *ctx,uint8 twcr)
+{
+	Sim_TwiType *twi = &ctx->twi;
+	uint32 bitCycles;
+
+	/* TWINT is cleared by writing 1, TWWC is read only */
+	twi->twcr = (twi->twcr & (1<<TWINT)) | (twcr & ~((1<<TWINT) | (1<<TWWC)));
+	if(twcr & (1<<TWINT))
+	{
+		twi->twcr &= ~(1<<TWINT);
+	}
+
+	if((twcr & (1<<TWEN)) == 0)
+	{
+		/* the module lets the pins go, whatever was going on is dropped */
+		if( (twi->active != NULL_PTR) && (twi->active->stop != NULL_PTR) )
+		{
+			twi->active->stop(twi->active, ctx->cycles);
+		}
+		twi->active = NULL_PTR;
+		twi->state = SIM_TWI_IDLE;
+		twi->busy = FALSE;
+		twi->status = SIM_TWI_STATUS_NO_INFO;
+		return;
+	}
+	if( ((twcr & (1<<TWINT)) == 0) || twi->busy )
+		return; /* nothing new is started */
+
+	bitCycles = SIM_TWI_getBitCycles(ctx);
+	twi->busy = TRUE;
+	twi->ack = (twcr & (1<<TWEA)) ? TRUE : FALSE;
+	if(twcr & (1<<TWSTA))
+	{
+		twi->operation = SIM_TWI_START;
+		twi->end = ctx->cycles + bitCycles;
+	}
+	else if(twcr & (1<<TWSTO))
+	{
+		twi->operation = SIM_TWI_STOP;
+		twi->end = ctx->cycles + bitCycles;
+	}
+	else
+	{
+		twi->operation = SIM_TWI_BYTE;
+		twi->end = ctx->cycles + (uint64)SIM_TWI_BITS_PER_BYTE * bitCycles;
+	}
+}
+
+uint64 SIM_TWI_run(Sim_ContextType *ctx)
+{
+	Sim_TwiType *twi = &ctx->twi;
+
+	if(twi->busy && (twi->end <= ctx->cycles))
+	{
+		twi->busy = FALSE;
+		switch(twi->operation)
+		{
+		case SIM_TWI_START:
+			twi->status = (twi->state == SIM_TWI_IDLE) ? SIM_TWI_STATUS_START : SIM_TWI_STATUS_REP_START;
+			twi->state = SIM_TWI_STARTED;
+			twi->twcr |= (1<<TWINT);
+			twi->starts++;
+			break;
+		case SIM_TWI_STOP:
+			if( (twi->active != NULL_PTR) && (twi->active->stop != NULL_PTR) )
+			{
+				twi->active->stop(twi->active, twi->end);
+			}
+			twi->active = NULL_PTR;
+			twi->state = SIM_TWI_IDLE;
+			twi->status = SIM_TWI_STATUS_NO_INFO;
+			twi->twcr &= ~(1<<TWSTO); /* TWINT isn't set after a STOP */
+			break;
+		case SIM_TWI_BYTE:
+			SIM_TWI_transfer(ctx);
+			twi->twcr |= (1<<TWINT);
+			break;
+		}
+	}
+	return twi->busy ? twi->end : SIM_FOREVER;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_TWI_getBitCycles
+* Description:			Function to get the SCL period in CPU cycles
+* Parameters (in):    	Context
+* Parameters (out):   	16 + 2 * TWBR * 4^TWPS
+* Return value:      	uint32
+********************************************************************************/
+
+static uint32 SIM_TWI_getBitCycles(Sim_ContextType *ctx)
+{
+	return 16 + ((2UL * ctx->io[SIM_TWBR]) << (2 * ctx->twi.prescaler));
+}
+
+/*******************************************************************************
+* Function Name:		SIM_TWI_find
+* Description:			Function to find the device that answers to an address
+* Parameters (in):    	Context and 7 bit address
+* Parameters (out):   	Device or NULL_PTR
+* Return value:      	Sim_TwiDeviceType *
+********************************************************************************/
+
+static Sim_TwiDeviceType *SIM_TWI_find(Sim_ContextType *ctx,uint8 address)
+{
+	for(uint8 i = 0 ; i < ctx->twi.numDevices ; i++)
+	{
+		Sim_TwiDeviceType *device = ctx->twi.devices[i];
+		if( (address & (uint8)~device->mask) == (device->address & (uint8)~device->mask) )
+			return device;
+	}
+	return NULL_PTR;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_TWI_transfer
+* Description:			Function to end a byte on the bus : the address after a START, or data
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_TWI_transfer(Sim_ContextType *ctx)
+{
+	Sim_TwiType *twi = &ctx->twi;
+	boolean acked;
+
+	switch(twi->state)
+	{
+	case SIM_TWI_STARTED:
+	{
+		uint8 sla = twi->data;
+		boolean reading = (sla & 0x01) ? TRUE : FALSE;
+		Sim_TwiDeviceType *device = SIM_TWI_find(ctx, sla >> 1);
+
+		acked = ( (device != NULL_PTR) && device->start(device, sla, twi->end) ) ? TRUE : FALSE;
+		twi->active = acked ? device : NULL_PTR;
+		if(acked)
+		{
+			twi->state = reading ? SIM_TWI_RECEIVER : SIM_TWI_TRANSMITTER;
+			twi->status = reading ? SIM_TWI_STATUS_MR_SLA_ACK : SIM_TWI_STATUS_MT_SLA_ACK;
+		}
+		else
+		{
+			twi->state = SIM_TWI_NOT_ACKED;
+			twi->status = reading ? SIM_TWI_STATUS_MR_SLA_NACK : SIM_TWI_STATUS_MT_SLA_NACK;
+			twi->nacks++;
+		}
+		break;
+	}
+	case SIM_TWI_TRANSMITTER:
+		acked = twi->active->write(twi->active, twi->data, twi->end);
+		twi->status = acked ? SIM_TWI_STATUS_MT_DATA_ACK : SIM_TWI_STATUS_MT_DATA_NACK;
+		twi->bytes++;
+		if(acked == FALSE)
+		{
+			twi->nacks++;
+		}
+		break;
+	case SIM_TWI_RECEIVER:
+		twi->data = twi->active->read(twi->active, twi->ack, twi->end);
+		twi->status = twi->ack ? SIM_TWI_STATUS_MR_DATA_ACK : SIM_TWI_STATUS_MR_DATA_NACK;
+		twi->bytes++;
+		break;
+	case SIM_TWI_NOT_ACKED:
+		twi->status = SIM_TWI_STATUS_MT_DATA_NACK; /* nobody listens */
+		break;
+	default:
+		twi->status = SIM_TWI_STATUS_BUS_ERROR; /* a byte without a START */
+		break;
+	}
+}
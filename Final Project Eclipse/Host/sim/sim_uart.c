@@ -0,0 +1,355 @@
+/******************************************************************************
+*  File name:		sim_uart.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * USART in asynchronous mode. A byte takes the time of its whole frame on the
+ * wire at the baud rate of the sender, the receiver gets a frame error when its
+ * own baud rate is too far off to sample the last bit right. Only the data bits
+ * of the character size of the sender go on the wire, up to 8.
+ * A peer gets every byte when its start bit is sent and has it in UDR a frame
+ * later, so a peer can run ahead of the sender as long as it doesn't look at its
+ * receiver : reading UCSRA or UDR more than a frame ahead waits for the sender
+ * to catch up. A source with sourceAtOnce skips the wire, its next byte is in
+ * UDR as soon as the firmware looks at an empty receiver.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void SIM_UART_startSending(Sim_ContextType *ctx,uint8 byte,uint64 start);
+static void SIM_UART_waitPeer(Sim_ContextType *ctx);
+static void SIM_UART_startReceiving(Sim_ContextType *ctx);
+static void SIM_UART_endReceiving(Sim_ContextType *ctx);
+static void SIM_UART_takeSource(Sim_ContextType *ctx);
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+uint32 SIM_UART_getBitCycles(Sim_ContextType *ctx)
+{
+	uint32 ubrr = ((uint32)ctx->uart.ubrrh << 8) | ctx->io[SIM_UBRRL];
+	return ((ctx->io[SIM_UCSRA] & (1<<U2X)) ? 8 : 16) * (ubrr + 1);
+}
+
+uint8 SIM_UART_getFrameBits(Sim_ContextType *ctx)
+{
+	uint8 ucsrc = ctx->uart.ucsrc;
+	uint8 size = ((ucsrc >> UCSZ0) & 0x03) | ((ctx->io[SIM_UCSRB] & (1<<UCSZ2)) ? 0x04 : 0);
+	uint8 dataBits = (size == 7) ? 9 : (uint8)(5 + (size & 0x03));
+
+	/* start, data, parity and stop bits */
+	return (uint8)(1 + dataBits + ((ucsrc & (1<<UPM1)) ? 1 : 0) + ((ucsrc & (1<<USBS)) ? 2 : 1));
+}
+
+uint64 SIM_UART_getHorizon(Sim_ContextType *ctx)
+{
+	Sim_ContextType *peer = ctx->uart.peer;
+	uint64 frame;
+
+	if( (peer == NULL_PTR) || (peer->stopReason != SIM_RUNNING) )
+		return SIM_FOREVER;
+	/* a byte the peer starts from its clock on is in the receiver a frame later, half a frame
+	 * leaves room for the clock error and the receiver sampling in the middle of the stop bit */
+	frame = (uint64)SIM_UART_getFrameBits(peer) * SIM_UART_getBitCycles(peer);
+	return peer->cycles + frame / 2;
+}
+
+void SIM_UART_transmit(Sim_ContextType *ctx,uint8 byte)
+{
+	Sim_UartType *uart = &ctx->uart;
+
+	if((ctx->io[SIM_UCSRB] & (1<<TXEN)) == 0)
+		return;
+
+	if(uart->txBusy == FALSE)
+	{
+		/* UDR goes to the shift register right away */
+		uart->txBusy = TRUE;
+		SIM_UART_startSending(ctx, byte, ctx->cycles);
+	}
+	else
+	{
+		uart->txBuffer = byte; /* overwrites a byte that waits if UDRE wasn't checked */
+		uart->txBufferFull = TRUE;
+	}
+}
+
+uint8 SIM_UART_readStatus(Sim_ContextType *ctx)
+{
+	Sim_UartType *uart = &ctx->uart;
+	uint8 status = 0;
+
+	SIM_UART_waitPeer(ctx);
+	SIM_UART_takeSource(ctx);
+	if(uart->rxCount != 0)
+	{
+		status |= (1<<RXC) | uart->rxFifoErrors[uart->rxHead];
+	}
+	if(uart->txComplete)
+	{
+		status |= (1<<TXC);
+	}
+	if(uart->txBufferFull == FALSE)
+	{
+		status |= (1<<UDRE);
+	}
+	return status;
+}
+
+uint8 SIM_UART_readData(Sim_ContextType *ctx)
+{
+	Sim_UartType *uart = &ctx->uart;
+	uint8 byte;
+
+	SIM_UART_waitPeer(ctx);
+	SIM_UART_takeSource(ctx);
+	byte = uart->rxFifo[uart->rxHead];
+	if(uart->rxCount != 0)
+	{
+		uart->rxHead = (uint8)((uart->rxHead + 1) % SIM_UART_FIFO_SIZE);
+		uart->rxCount--;
+		SIM_schedule(ctx, ctx->cycles); /* room for the next byte */
+	}
+	return byte;
+}
+
+void SIM_UART_receive(Sim_ContextType *ctx,uint8 byte,uint32 bitCycles,uint64 start)
+{
+	Sim_UartType *uart = &ctx->uart;
+
+	if(uart->lineCount == SIM_UART_LINE_SIZE)
+	{
+		uart->overruns++; /* the other end sends much faster than this one reads */
+		return;
+	}
+	uint16 tail = (uint16)((uart->lineHead + uart->lineCount) % SIM_UART_LINE_SIZE);
+	uart->line[tail] = byte;
+	uart->lineBitCycles[tail] = bitCycles;
+	uart->lineStart[tail] = start;
+	uart->lineCount++;
+	SIM_schedule(ctx, start);
+}
+
+uint64 SIM_UART_run(Sim_ContextType *ctx)
+{
+	Sim_UartType *uart = &ctx->uart;
+	uint64 next = SIM_FOREVER;
+
+	/* transmitter */
+	while(uart->txBusy && (uart->txEnd <= ctx->cycles))
+	{
+		uint8 byte = uart->txShift;
+		uint32 bitCycles = SIM_UART_getBitCycles(ctx);
+
+		if(uart->txBufferFull)
+		{
+			uart->txBufferFull = FALSE;
+			SIM_UART_startSending(ctx, uart->txBuffer, uart->txEnd);
+		}
+		else
+		{
+			uart->txBusy = FALSE;
+			uart->txComplete = TRUE;
+		}
+		uart->txBytes++;
+		if(uart->sink != NULL_PTR)
+		{
+			uart->sink(ctx, byte, bitCycles);
+		}
+	}
+	if(uart->txBusy)
+	{
+		next = uart->txEnd;
+	}
+
+	/* receiver, several bytes may be over after the peer caught up */
+	while(uart->rxBusy && (uart->rxEnd <= ctx->cycles))
+	{
+		SIM_UART_endReceiving(ctx);
+		if( (uart->lineCount != 0) && (uart->lineStart[uart->lineHead] <= ctx->cycles) )
+		{
+			SIM_UART_startReceiving(ctx);
+		}
+	}
+	if(uart->rxBusy == FALSE)
+	{
+		/* the source waits for the receiver to be on and the last byte to be taken like a host reading the answers */
+		if( (uart->lineCount == 0) && (uart->source != NULL_PTR) && (uart->rxCount == 0) && (ctx->cycles >= uart->nextPoll)
+				&& (ctx->io[SIM_UCSRB] & (1<<RXEN)) )
+		{
+			sint16 byte = uart->source(ctx);
+			if(byte >= 0)
+			{
+				SIM_UART_receive(ctx, (uint8)byte, SIM_UART_getBitCycles(ctx), ctx->cycles);
+			}
+			else
+			{
+				uart->nextPoll = ctx->cycles + (uint64)SIM_UART_getFrameBits(ctx) * SIM_UART_getBitCycles(ctx);
+			}
+		}
+		if( (uart->lineCount != 0) && (uart->lineStart[uart->lineHead] <= ctx->cycles) )
+		{
+			SIM_UART_startReceiving(ctx);
+		}
+	}
+	if(uart->rxBusy)
+	{
+		next = (uart->rxEnd < next) ? uart->rxEnd : next;
+	}
+	else if(uart->lineCount != 0)
+	{
+		next = (uart->lineStart[uart->lineHead] < next) ? uart->lineStart[uart->lineHead] : next;
+	}
+	else if( (uart->source != NULL_PTR) && (uart->lineCount == 0) && (uart->rxCount == 0) && (ctx->io[SIM_UCSRB] & (1<<RXEN)) )
+	{
+		next = (uart->nextPoll < next) ? uart->nextPoll : next;
+	}
+	return next;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_UART_startSending
+* Description:			Function to move a byte to the shift register, the peer gets it at once
+* Parameters (in):    	Context, the byte and the cycle its start bit goes out
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_UART_startSending(Sim_ContextType *ctx,uint8 byte,uint64 start)
+{
+	Sim_UartType *uart = &ctx->uart;
+	uint32 bitCycles = SIM_UART_getBitCycles(ctx);
+	uint8 dataBits = (uint8)(SIM_UART_getFrameBits(ctx) - 2 - ((uart->ucsrc & (1<<UPM1)) ? 1 : 0) - ((uart->ucsrc & (1<<USBS)) ? 1 : 0));
+
+	if(dataBits < 8)
+	{
+		byte &= (uint8)((1U << dataBits) - 1); /* the high bits are never sent */
+	}
+	uart->txShift = byte;
+	uart->txEnd = start + (uint64)SIM_UART_getFrameBits(ctx) * bitCycles;
+	if(uart->peer != NULL_PTR)
+	{
+		sint64 error = ((sint64)bitCycles * uart->peerErrorPpm) / 1000000;
+		SIM_UART_receive(uart->peer, byte, (uint32)((sint64)bitCycles + error), start);
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_UART_waitPeer
+* Description:			Function to let the peer catch up before the receiver is looked at, a byte
+* 						it sends from its clock on is only received a frame later
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_UART_waitPeer(Sim_ContextType *ctx)
+{
+	if(ctx->uart.peer == NULL_PTR)
+		return;
+	ctx->uart.peerObserved = TRUE;
+	while(ctx->cycles >= SIM_UART_getHorizon(ctx))
+	{
+		SIM_wait(ctx);
+	}
+	SIM_schedule(ctx, SIM_UART_run(ctx)); /* the bytes the peer sent meanwhile */
+}
+
+/*******************************************************************************
+* Function Name:		SIM_UART_startReceiving
+* Description:			Function to put the next byte of the line on the wire
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_UART_startReceiving(Sim_ContextType *ctx)
+{
+	Sim_UartType *uart = &ctx->uart;
+	uint32 senderBit = uart->lineBitCycles[uart->lineHead];
+	uint32 ownBit = SIM_UART_getBitCycles(ctx);
+	uint8 frameBits = SIM_UART_getFrameBits(ctx);
+	uint32 drift = (senderBit > ownBit) ? (senderBit - ownBit) : (ownBit - senderBit);
+	uint64 start = uart->lineStart[uart->lineHead];
+
+	uart->rxShift = uart->line[uart->lineHead];
+	uart->lineHead = (uint16)((uart->lineHead + 1) % SIM_UART_LINE_SIZE);
+	uart->lineCount--;
+	if((ctx->io[SIM_UCSRB] & (1<<RXEN)) == 0)
+		return; /* nobody listens */
+
+	/* the bits are sampled in their middle, the last one must still be inside its bit time */
+	uart->rxShiftError = ((uint64)drift * (2 * frameBits - 1) > ownBit) ? TRUE : FALSE;
+	uart->rxBusy = TRUE;
+	uart->rxEnd = start + (uint64)frameBits * senderBit;
+}
+
+/*******************************************************************************
+* Function Name:		SIM_UART_endReceiving
+* Description:			Function to move a received byte into UDR, it is lost if both are full
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_UART_endReceiving(Sim_ContextType *ctx)
+{
+	Sim_UartType *uart = &ctx->uart;
+
+	uart->rxBusy = FALSE;
+	if(uart->rxCount == SIM_UART_FIFO_SIZE)
+	{
+		uint8 last = (uint8)((uart->rxHead + SIM_UART_FIFO_SIZE - 1) % SIM_UART_FIFO_SIZE);
+		uart->rxFifoErrors[last] |= (1<<DOR);
+		uart->overruns++;
+		return;
+	}
+
+	uint8 tail = (uint8)((uart->rxHead + uart->rxCount) % SIM_UART_FIFO_SIZE);
+	uart->rxFifo[tail] = uart->rxShiftError ? (uint8)(uart->rxShift ^ 0x80) : uart->rxShift;
+	uart->rxFifoErrors[tail] = uart->rxShiftError ? (1<<FE) : 0;
+	uart->rxCount++;
+	uart->rxBytes++;
+	if(uart->rxShiftError)
+	{
+		uart->frameErrors++;
+	}
+}
+
+/*******************************************************************************
+* Function Name:		SIM_UART_takeSource
+* Description:			Function to put the next byte of a source with sourceAtOnce in an empty UDR
+* Parameters (in):    	Context
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void SIM_UART_takeSource(Sim_ContextType *ctx)
+{
+	Sim_UartType *uart = &ctx->uart;
+	sint16 byte;
+
+	if( (uart->sourceAtOnce == FALSE) || (uart->source == NULL_PTR) || (uart->rxCount != 0) || uart->rxBusy
+			|| (uart->lineCount != 0) || ((ctx->io[SIM_UCSRB] & (1<<RXEN)) == 0) )
+		return;
+
+	byte = uart->source(ctx);
+	if(byte >= 0)
+	{
+		uart->rxFifo[uart->rxHead] = (uint8)byte;
+		uart->rxFifoErrors[uart->rxHead] = 0;
+		uart->rxCount = 1;
+		uart->rxBytes++;
+	}
+}
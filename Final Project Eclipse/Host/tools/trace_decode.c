@@ -0,0 +1,348 @@
+/******************************************************************************
+*  File name:		trace_decode.c
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Turns the answers of MCU2 to MSG_ReadTrace into the time spent in every traced
+ * region. The input is one or more answers one after the other, raw bytes as they
+ * came on the link. An entry is paired with the next exit of the same region, the
+ * events of a region cut by a lost event or by the end of an answer are counted
+ * as unpaired. Every region is written to stdout as key=value lines followed by
+ * a histogram of its times in power of 2 buckets of cycles.
+ *
+ *   trace_decode [-f hz] [-s] [file]
+ *
+ *   -f  clock of MCU2, 8000000 by default, only used for the times in us
+ *   -s  the input is an answer to MSG_ReadStats instead, the statistics of
+ *       every interrupt vector and the CPU load are written as key=value lines
+ *
+ * The PROBE region is two probes back to back : its time is the part of every
+ * other region that comes from the tracing itself.
+ */
+
+/*******************************************************************************
+*                        		Inclusions                                     *
+*******************************************************************************/
+
+#include "../../Final_Project_MCU2/LIB/std_types.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+#define DECODE_DEFAULT_HZ			8000000.0
+#define DECODE_EVENT_SIZE			4			/* TRACE_EVENT_SIZE */
+#define DECODE_EXIT_FLAG			0x80		/* TRACE_EXIT_FLAG */
+#define DECODE_TIME_MASK			0xFFFFFFUL	/* the time stamps have 24 bits */
+#define DECODE_NUM_BUCKETS			24			/* [0, 2) up to [2^23, 2^24) cycles */
+#define DECODE_BAR_WIDTH			40
+#define DECODE_VECTOR_SIZE			8			/* calls, average and longest time of a vector */
+
+/*******************************************************************************
+*                         Types Declaration                                   *
+*******************************************************************************/
+
+typedef struct
+{
+	boolean open;				/* an entry waits for its exit */
+	uint32 entry;
+	uint32 count;
+	uint32 unpaired;
+	uint32 min;
+	uint32 max;
+	uint64 sum;
+	uint32 buckets[DECODE_NUM_BUCKETS];
+}Decode_RegionType;
+
+/*******************************************************************************
+*                           Global Variables                                  *
+*******************************************************************************/
+
+#define TRACE_REGION(name)			#name,
+static const char *const g_decodeNames[] =
+{
+#include "../../Final_Project_MCU2/LIB/trace_regions.h"
+};
+#undef TRACE_REGION
+
+#define TRACE_VECTOR(name)			#name,
+static const char *const g_decodeVectors[] =
+{
+#include "../../Final_Project_MCU2/LIB/trace_vectors.h"
+};
+#undef TRACE_VECTOR
+
+#define DECODE_NUM_REGIONS			(sizeof(g_decodeNames) / sizeof(g_decodeNames[0]))
+
+static Decode_RegionType g_decodeRegions[DECODE_NUM_REGIONS];
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                          *
+*******************************************************************************/
+
+static void DECODE_event(const uint8 *bytes,uint32 *unknown);
+static void DECODE_closeAll(void);
+static void DECODE_report(double hz,uint32 answers,uint32 events,uint32 dropped,uint32 unknown);
+static int DECODE_stats(FILE *input,double hz,const char *name);
+
+/*******************************************************************************
+*           					Main Function                                 *
+*******************************************************************************/
+
+int main(int argc,char **argv)
+{
+	double hz = DECODE_DEFAULT_HZ;
+	FILE *input = stdin;
+	uint32 answers = 0;
+	uint32 events = 0;
+	uint32 dropped = 0;
+	uint32 unknown = 0;
+	boolean stats = FALSE;
+	int option;
+	int count;
+
+	while((option = getopt(argc, argv, "f:s")) != -1)
+	{
+		switch(option)
+		{
+		case 'f': hz = atof(optarg); break;
+		case 's': stats = TRUE; break;
+		default:
+			fprintf(stderr, "usage: %s [-f hz] [-s] [file]\n", argv[0]);
+			return 2;
+		}
+	}
+	if( (optind < argc) && ((input = fopen(argv[optind], "rb")) == NULL) )
+	{
+		perror(argv[optind]);
+		return 1;
+	}
+	if(stats)
+	{
+		return DECODE_stats(input, hz, argv[0]);
+	}
+
+	while((count = fgetc(input)) != EOF)
+	{
+		int lost = fgetc(input);
+		if(lost == EOF)
+		{
+			fprintf(stderr, "%s: the input ends in the middle of an answer\n", argv[0]);
+			return 1;
+		}
+		answers++;
+		dropped += (uint32)lost;
+		for(int i = 0 ; i < count ; i++)
+		{
+			uint8 bytes[DECODE_EVENT_SIZE];
+			if(fread(bytes, 1, DECODE_EVENT_SIZE, input) != DECODE_EVENT_SIZE)
+			{
+				fprintf(stderr, "%s: the input ends in the middle of an answer\n", argv[0]);
+				return 1;
+			}
+			DECODE_event(bytes, &unknown);
+			events++;
+		}
+		DECODE_closeAll(); /* the events between two answers aren't saved */
+	}
+
+	DECODE_report(hz, answers, events, dropped, unknown);
+	return 0;
+}
+
+/*******************************************************************************
+*                      Functions Definitions                                   *
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name:		DECODE_event
+* Description:			Function to add an event to its region, the time of the region is
+* 						counted at its exit
+* Parameters (in):    	The 4 bytes of the event and pointer to the count of unknown ids
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DECODE_event(const uint8 *bytes,uint32 *unknown)
+{
+	uint8 id = bytes[0] & ~DECODE_EXIT_FLAG;
+	uint32 time = (uint32)bytes[1] | ((uint32)bytes[2] << 8) | ((uint32)bytes[3] << 16);
+	Decode_RegionType *region;
+	uint32 cycles;
+	uint8 bucket = 0;
+
+	if(id >= DECODE_NUM_REGIONS)
+	{
+		(*unknown)++; /* a newer firmware, its trace_regions.h has more regions */
+		return;
+	}
+	region = &g_decodeRegions[id];
+
+	if((bytes[0] & DECODE_EXIT_FLAG) == 0)
+	{
+		if(region->open)
+		{
+			region->unpaired++; /* the exit was lost */
+		}
+		region->open = TRUE;
+		region->entry = time;
+		return;
+	}
+	if(region->open == FALSE)
+	{
+		region->unpaired++; /* the entry was overwritten */
+		return;
+	}
+
+	region->open = FALSE;
+	cycles = (time - region->entry) & DECODE_TIME_MASK;
+	if( (region->count == 0) || (cycles < region->min) )
+		region->min = cycles;
+	if(cycles > region->max)
+		region->max = cycles;
+	region->sum += cycles;
+	region->count++;
+	while( (cycles >> (bucket + 1)) != 0 )
+	{
+		bucket++;
+	}
+	region->buckets[bucket]++;
+}
+
+/*******************************************************************************
+* Function Name:		DECODE_closeAll
+* Description:			Function to drop the entries still waiting for their exit at the end of an answer
+* Parameters (in):    	None
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DECODE_closeAll(void)
+{
+	for(uint8 i = 0 ; i < DECODE_NUM_REGIONS ; i++)
+	{
+		if(g_decodeRegions[i].open)
+		{
+			g_decodeRegions[i].open = FALSE;
+			g_decodeRegions[i].unpaired++;
+		}
+	}
+}
+
+/*******************************************************************************
+* Function Name:		DECODE_report
+* Description:			Function to write the totals then every region seen with its histogram
+* Parameters (in):    	Clock of MCU2, number of answers, events, events lost and events of unknown regions
+* Parameters (out):   	None
+* Return value:      	void
+********************************************************************************/
+
+static void DECODE_report(double hz,uint32 answers,uint32 events,uint32 dropped,uint32 unknown)
+{
+	printf("answers=%u\n", answers);
+	printf("events=%u\n", events);
+	printf("dropped=%u\n", dropped);
+	printf("unknown=%u\n", unknown);
+
+	for(uint8 i = 0 ; i < DECODE_NUM_REGIONS ; i++)
+	{
+		const Decode_RegionType *region = &g_decodeRegions[i];
+		uint32 largest = 0;
+		double avg;
+
+		if( (region->count == 0) && (region->unpaired == 0) )
+			continue;
+
+		avg = (region->count != 0) ? ((double)region->sum / region->count) : 0.0;
+		printf("\nregion=%s\n", g_decodeNames[i]);
+		printf("count=%u\n", region->count);
+		printf("unpaired=%u\n", region->unpaired);
+		if(region->count == 0)
+			continue;
+
+		printf("min_cycles=%u\n", region->min);
+		printf("avg_cycles=%.1f\n", avg);
+		printf("max_cycles=%u\n", region->max);
+		printf("min_us=%.1f\n", region->min * 1e6 / hz);
+		printf("avg_us=%.1f\n", avg * 1e6 / hz);
+		printf("max_us=%.1f\n", region->max * 1e6 / hz);
+
+		for(uint8 k = 0 ; k < DECODE_NUM_BUCKETS ; k++)
+		{
+			largest = (region->buckets[k] > largest) ? region->buckets[k] : largest;
+		}
+		for(uint8 k = 0 ; k < DECODE_NUM_BUCKETS ; k++)
+		{
+			uint32 width;
+			if(region->buckets[k] == 0)
+				continue;
+			width = (uint32)(((uint64)region->buckets[k] * DECODE_BAR_WIDTH + largest - 1) / largest);
+			printf("  %8lu - %8lu cycles %6u %.*s\n", (k == 0) ? 0UL : (1UL << k), (2UL << k) - 1, region->buckets[k],
+					(int)width, "########################################");
+		}
+	}
+}
+
+/*******************************************************************************
+* Function Name:		DECODE_stats
+* Description:			Function to write an answer to MSG_ReadStats as key=value lines
+* Parameters (in):    	Input, clock of MCU2 and name of the program for the errors
+* Parameters (out):   	Exit status
+* Return value:      	int
+********************************************************************************/
+
+static int DECODE_stats(FILE *input,double hz,const char *name)
+{
+	uint8 bytes[DECODE_VECTOR_SIZE];
+	int count = fgetc(input);
+
+	if(count == EOF)
+	{
+		fprintf(stderr, "%s: empty input\n", name);
+		return 1;
+	}
+	for(int i = 0 ; i < count ; i++)
+	{
+		uint32 calls;
+		uint16 average;
+		uint16 longest;
+		char unknown[24];
+		const char *vector = unknown;
+
+		if(fread(bytes, 1, DECODE_VECTOR_SIZE, input) != DECODE_VECTOR_SIZE)
+		{
+			fprintf(stderr, "%s: the input ends in the middle of the answer\n", name);
+			return 1;
+		}
+		calls = (uint32)bytes[0] | ((uint32)bytes[1] << 8) | ((uint32)bytes[2] << 16) | ((uint32)bytes[3] << 24);
+		average = (uint16)(bytes[4] | (bytes[5] << 8));
+		longest = (uint16)(bytes[6] | (bytes[7] << 8));
+		if(i < (int)(sizeof(g_decodeVectors) / sizeof(g_decodeVectors[0])))
+		{
+			vector = g_decodeVectors[i];
+		}
+		else
+		{
+			snprintf(unknown, sizeof(unknown), "VECTOR_%d", i); /* a newer firmware */
+		}
+		printf("%s.calls=%u\n", vector, calls);
+		printf("%s.avg_cycles=%u\n", vector, average);
+		printf("%s.max_cycles=%u\n", vector, longest);
+		printf("%s.max_us=%.1f\n", vector, longest * 1e6 / hz);
+	}
+	if(fread(bytes, 1, 4, input) != 4)
+	{
+		fprintf(stderr, "%s: the input ends in the middle of the answer\n", name);
+		return 1;
+	}
+	printf("worst_latency_cycles=%u\n", bytes[0] | (bytes[1] << 8));
+	printf("worst_latency_us=%.1f\n", (bytes[0] | (bytes[1] << 8)) * 1e6 / hz);
+	printf("load_percent=%u\n", bytes[2]);
+	printf("max_load_percent=%u\n", bytes[3]);
+	return 0;
+}
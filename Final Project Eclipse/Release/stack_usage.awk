@@ -0,0 +1,214 @@
+################################################################################
+# Worst case stack of an image from the call graph gcc writes at the link with
+# -fstack-usage -fcallgraph-info=su (the .ci files of every LTO partition).
+# The depth of every entry point, main and each __vector_N, is its frame plus
+# the deepest of its callees, with the path that gives it. The ISRs don't nest
+# so the worst case of the image is main plus the deepest ISR.
+#
+#   awk -v image=mcu2.elf -v stack=bytes -v symbols=mcu2.sym -v callbacks="__vector_4=TIMER2_TICK_ISR __vector_7=" *.ci
+#
+#   stack      bytes of RAM left after .data, .bss and .noinit, 0 to only report
+#   symbols    nm of the image : a function folded into one with the same code
+#              (-fipa-icf) is only an alias in the graph, it gets the frame of
+#              the function at its address
+#   callbacks  what every call through a pointer calls, "caller=callee" separated
+#              by spaces, an empty callee for a callback that is never set
+#   call       bytes added per call for the return address, 2 by default
+#   external   bytes given to a function without a frame in the graph (avr-libc,
+#              libgcc), 16 by default
+#
+# It fails on a recursion, on a frame of unbounded size or on a call through a
+# pointer that callbacks doesn't resolve, the depth couldn't be trusted.
+################################################################################
+
+BEGIN {
+	if(call == "") call = 2
+	if(external == "") external = 16
+	count = split(callbacks, pairs, " ")
+	for(i = 1 ; i <= count ; i++)
+	{
+		split(pairs[i], pair, "=")
+		callback[pair[1]] = pair[2]
+	}
+	if(symbols != "")
+	{
+		while( (getline line < symbols) > 0 )
+		{
+			split(line, word, " ")
+			if(word[2] ~ /^[tTwW]$/)
+			{
+				address[word[3]] = word[1]
+				named[word[1]] = named[word[1]] " " word[3]
+			}
+		}
+		close(symbols)
+	}
+	errors = 0
+}
+
+# node: { title: "file:name" label: "name\nfile:line:column\nN bytes (static)" }
+/^node:/ {
+	name = bare(field($0, "title"))
+	label = field($0, "label")
+	if(match(label, /[0-9]+ bytes \([^)]*\)/))
+	{
+		base = name
+		sub(/\..*$/, "", base)
+		clone[base] = name
+		split(substr(label, RSTART, RLENGTH), frame, " ")
+		frameSize[name] = (name in frameSize && frameSize[name] > frame[1]) ? frameSize[name] : frame[1]
+		if( (frame[3] ~ /dynamic/) && (frame[3] !~ /bounded/) )
+			unbounded[name] = 1
+	}
+	next
+}
+
+# edge: { sourcename: "file:caller" targetname: "file:callee" label: "file:line:column" }
+/^edge:/ {
+	source = bare(field($0, "sourcename"))
+	target = bare(field($0, "targetname"))
+	if(!((source, target) in edge))
+	{
+		edge[source, target] = 1
+		callees[source] = callees[source] " " target
+	}
+	next
+}
+
+END {
+	for(name in frameSize)
+	{
+		if( (name == "main") || (name ~ /^__vector_[0-9]+$/) )
+		{
+			entry[name] = 1
+			depth(name)
+		}
+	}
+	if(!("main" in entry))
+	{
+		print image ": no main in the call graph"
+		exit 1
+	}
+	printf "%s : main %d bytes, %s\n", image, deepest["main"], route["main"]
+	worstIsr = ""
+	for(name in entry)
+	{
+		if(name == "main")
+			continue
+		printf "%s : %s %d bytes, %s\n", image, name, deepest[name], route[name]
+		if( (worstIsr == "") || (deepest[name] > deepest[worstIsr]) )
+			worstIsr = name
+	}
+	for(name in missing)
+		printf "%s : %s has no frame in the graph, counted as %d bytes\n", image, name, external
+	if(errors)
+		exit 1
+
+	worst = deepest["main"] + ((worstIsr == "") ? 0 : deepest[worstIsr])
+	if(stack == 0)
+	{
+		printf "%s : worst case stack %d bytes\n", image, worst
+		exit 0
+	}
+	printf "%s : worst case stack %d / %d bytes (main and %s)\n", image, worst, stack, (worstIsr == "") ? "no ISR" : worstIsr
+	if(worst > stack)
+	{
+		print image " can overflow its stack"
+		exit 1
+	}
+}
+
+# value of key: "..." in a line of the graph
+function field(line, key,    start, rest)
+{
+	start = index(line, key ": \"")
+	rest = substr(line, start + length(key) + 3)
+	return substr(rest, 1, index(rest, "\"") - 1)
+}
+
+# name of a function without its file, the clones made by LTO keep their suffix (.part.0, .isra.0)
+function bare(title)
+{
+	sub(/^.*:/, "", title)
+	return title
+}
+
+function fail(message)
+{
+	print image ": " message
+	errors = 1
+}
+
+# function with a frame at the address of name, "" if there is none
+function folded(name,    list, count, i)
+{
+	if(!(name in address))
+		return ""
+	count = split(named[address[name]], list, " ")
+	for(i = 1 ; i <= count ; i++)
+	{
+		if(list[i] in frameSize)
+			return list[i]
+	}
+	return ""
+}
+
+# deepest stack from the entry of a function, saved in deepest[] with its path in route[]
+function depth(name,    list, count, i, callee, best, bestRoute, below, alias)
+{
+	if(name in deepest)
+		return deepest[name]
+	if(name in visiting)
+	{
+		fail("recursion through " name ", its depth has no bound")
+		return 0
+	}
+	if( !(name in frameSize) && ((alias = folded(name)) != "") )
+	{
+		deepest[name] = depth(alias)
+		route[name] = name "=" route[alias]
+		return deepest[name]
+	}
+	if(!(name in frameSize))
+	{
+		missing[name] = 1
+		deepest[name] = external
+		route[name] = name
+		return external
+	}
+	if(name in unbounded)
+		fail(name " has a frame of unbounded size")
+
+	visiting[name] = 1
+	best = 0
+	bestRoute = ""
+	count = split(callees[name], list, " ")
+	for(i = 1 ; i <= count ; i++)
+	{
+		callee = list[i]
+		if(callee == "__indirect_call")
+		{
+			if(!(name in callback))
+			{
+				fail(name " calls through a pointer, give its callee in callbacks")
+				continue
+			}
+			callee = callback[name]
+			if(callee == "")
+				continue
+			if( !(callee in frameSize) && (callee in clone) )
+				callee = clone[callee] # renamed by LTO, TIMER2_TICK_ISR.lto_priv.0
+		}
+		below = call + depth(callee)
+		if(below > best)
+		{
+			best = below
+			bestRoute = route[callee]
+		}
+	}
+	delete visiting[name]
+
+	deepest[name] = frameSize[name] + best
+	route[name] = (bestRoute == "") ? name : (name " > " bestRoute)
+	return deepest[name]
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+*  File name:		board_mcu1.h
+*  Generated by:	board_pins.awk from board.cfg
+*******************************************************************************/
+
+/*
+ * Pins of MCU1, edit board.cfg instead of this file.
+ * It includes nothing : the IDs are those of gpio.h and the registers those of
+ * avr/io.h, they are only needed where a name is used.
+ */
+
+#ifndef BOARD_MCU1_H_
+#define BOARD_MCU1_H_
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* PB0-3 input, driven low one at a time by the scan */
+#define KEYPAD_ROW_PORT_ID				PORTB_ID
+#define KEYPAD_ROW_PIN_ID				PIN0_ID
+#define KEYPAD_ROW_NUM_PINS				4
+#define KEYPAD_ROW_MASK					0x0F
+#define KEYPAD_ROW_PORT_REG				PORTB
+#define KEYPAD_ROW_DDR_REG				DDRB
+#define KEYPAD_ROW_PIN_REG				PINB
+
+/* PB4-7 pullup, 4 columns, 3 for a 4x3 keypad */
+#define KEYPAD_COL_PORT_ID				PORTB_ID
+#define KEYPAD_COL_PIN_ID				PIN4_ID
+#define KEYPAD_COL_NUM_PINS				4
+#define KEYPAD_COL_MASK					0xF0
+#define KEYPAD_COL_PORT_REG				PORTB
+#define KEYPAD_COL_DDR_REG				DDRB
+#define KEYPAD_COL_PIN_REG				PINB
+
+/* PD6 output */
+#define LCD_RS_PORT_ID					PORTD_ID
+#define LCD_RS_PIN_ID					PIN6_ID
+#define LCD_RS_NUM_PINS					1
+#define LCD_RS_MASK						0x40
+#define LCD_RS_PORT_REG					PORTD
+#define LCD_RS_DDR_REG					DDRD
+#define LCD_RS_PIN_REG					PIND
+
+/* PD7 output */
+#define LCD_E_PORT_ID					PORTD_ID
+#define LCD_E_PIN_ID					PIN7_ID
+#define LCD_E_NUM_PINS					1
+#define LCD_E_MASK						0x80
+#define LCD_E_PORT_REG					PORTD
+#define LCD_E_DDR_REG					DDRD
+#define LCD_E_PIN_REG					PIND
+
+/* PA0-7 output, DB0 to DB7, 4 pins for the 4 bits mode */
+#define LCD_DATA_PORT_ID				PORTA_ID
+#define LCD_DATA_PIN_ID					PIN0_ID
+#define LCD_DATA_NUM_PINS				8
+#define LCD_DATA_MASK					0xFF
+#define LCD_DATA_PORT_REG				PORTA
+#define LCD_DATA_DDR_REG				DDRA
+#define LCD_DATA_PIN_REG				PINA
+
+/* RXD alternate */
+#define UART_RXD_PORT_ID				PORTD_ID
+#define UART_RXD_PIN_ID					PIN0_ID
+#define UART_RXD_NUM_PINS				1
+#define UART_RXD_MASK					0x01
+#define UART_RXD_PORT_REG				PORTD
+#define UART_RXD_DDR_REG				DDRD
+#define UART_RXD_PIN_REG				PIND
+
+/* TXD alternate */
+#define UART_TXD_PORT_ID				PORTD_ID
+#define UART_TXD_PIN_ID					PIN1_ID
+#define UART_TXD_NUM_PINS				1
+#define UART_TXD_MASK					0x02
+#define UART_TXD_PORT_REG				PORTD
+#define UART_TXD_DDR_REG				DDRD
+#define UART_TXD_PIN_REG				PIND
+
+#endif /* BOARD_MCU1_H_ */
@@ -0,0 +1,128 @@
+/******************************************************************************
+*  File name:		board_mcu2.h
+*  Generated by:	board_pins.awk from board.cfg
+*******************************************************************************/
+
+/*
+ * Pins of MCU2, edit board.cfg instead of this file.
+ * It includes nothing : the IDs are those of gpio.h and the registers those of
+ * avr/io.h, they are only needed where a name is used.
+ */
+
+#ifndef BOARD_MCU2_H_
+#define BOARD_MCU2_H_
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+
+/* PA0 output, inputs of the H-bridge */
+#define DCMOTOR_IN1_PORT_ID				PORTA_ID
+#define DCMOTOR_IN1_PIN_ID				PIN0_ID
+#define DCMOTOR_IN1_NUM_PINS			1
+#define DCMOTOR_IN1_MASK				0x01
+#define DCMOTOR_IN1_PORT_REG			PORTA
+#define DCMOTOR_IN1_DDR_REG				DDRA
+#define DCMOTOR_IN1_PIN_REG				PINA
+
+/* PA1 output */
+#define DCMOTOR_IN2_PORT_ID				PORTA_ID
+#define DCMOTOR_IN2_PIN_ID				PIN1_ID
+#define DCMOTOR_IN2_NUM_PINS			1
+#define DCMOTOR_IN2_MASK				0x02
+#define DCMOTOR_IN2_PORT_REG			PORTA
+#define DCMOTOR_IN2_DDR_REG				DDRA
+#define DCMOTOR_IN2_PIN_REG				PINA
+
+/* ADC3 analog, filtered voltage of the current sense resistor, read with DOOR_SENSING */
+#define DCMOTOR_CURRENT_PORT_ID			PORTA_ID
+#define DCMOTOR_CURRENT_PIN_ID			PIN3_ID
+#define DCMOTOR_CURRENT_NUM_PINS		1
+#define DCMOTOR_CURRENT_MASK			0x08
+#define DCMOTOR_CURRENT_PORT_REG		PORTA
+#define DCMOTOR_CURRENT_DDR_REG			DDRA
+#define DCMOTOR_CURRENT_PIN_REG			PINA
+#define DCMOTOR_CURRENT_CHANNEL			3
+
+/* PA4 pullup, end-stop reached by turning CW, active low, read with DOOR_SENSING */
+#define DCMOTOR_OPENED_PORT_ID			PORTA_ID
+#define DCMOTOR_OPENED_PIN_ID			PIN4_ID
+#define DCMOTOR_OPENED_NUM_PINS			1
+#define DCMOTOR_OPENED_MASK				0x10
+#define DCMOTOR_OPENED_PORT_REG			PORTA
+#define DCMOTOR_OPENED_DDR_REG			DDRA
+#define DCMOTOR_OPENED_PIN_REG			PINA
+
+/* PA5 pullup, end-stop reached by turning CCW, active low */
+#define DCMOTOR_CLOSED_PORT_ID			PORTA_ID
+#define DCMOTOR_CLOSED_PIN_ID			PIN5_ID
+#define DCMOTOR_CLOSED_NUM_PINS			1
+#define DCMOTOR_CLOSED_MASK				0x20
+#define DCMOTOR_CLOSED_PORT_REG			PORTA
+#define DCMOTOR_CLOSED_DDR_REG			DDRA
+#define DCMOTOR_CLOSED_PIN_REG			PINA
+
+/* OC0 alternate, enable of the H-bridge, the speed of the motor */
+#define PWM0_OC0_PORT_ID				PORTB_ID
+#define PWM0_OC0_PIN_ID					PIN3_ID
+#define PWM0_OC0_NUM_PINS				1
+#define PWM0_OC0_MASK					0x08
+#define PWM0_OC0_PORT_REG				PORTB
+#define PWM0_OC0_DDR_REG				DDRB
+#define PWM0_OC0_PIN_REG				PINB
+
+/* PB0 output, active buzzer */
+#define BUZZER_PORT_ID					PORTB_ID
+#define BUZZER_PIN_ID					PIN0_ID
+#define BUZZER_NUM_PINS					1
+#define BUZZER_MASK						0x01
+#define BUZZER_PORT_REG					PORTB
+#define BUZZER_DDR_REG					DDRB
+#define BUZZER_PIN_REG					PINB
+
+/* OC1A alternate, passive buzzer, only with BUZZER_USE_TONE */
+#define TIMER1_OC1A_PORT_ID				PORTD_ID
+#define TIMER1_OC1A_PIN_ID				PIN5_ID
+#define TIMER1_OC1A_NUM_PINS			1
+#define TIMER1_OC1A_MASK				0x20
+#define TIMER1_OC1A_PORT_REG			PORTD
+#define TIMER1_OC1A_DDR_REG				DDRD
+#define TIMER1_OC1A_PIN_REG				PIND
+
+/* SCL alternate, 24C16 */
+#define TWI_SCL_PORT_ID					PORTC_ID
+#define TWI_SCL_PIN_ID					PIN0_ID
+#define TWI_SCL_NUM_PINS				1
+#define TWI_SCL_MASK					0x01
+#define TWI_SCL_PORT_REG				PORTC
+#define TWI_SCL_DDR_REG					DDRC
+#define TWI_SCL_PIN_REG					PINC
+
+/* SDA alternate */
+#define TWI_SDA_PORT_ID					PORTC_ID
+#define TWI_SDA_PIN_ID					PIN1_ID
+#define TWI_SDA_NUM_PINS				1
+#define TWI_SDA_MASK					0x02
+#define TWI_SDA_PORT_REG				PORTC
+#define TWI_SDA_DDR_REG					DDRC
+#define TWI_SDA_PIN_REG					PINC
+
+/* RXD alternate */
+#define UART_RXD_PORT_ID				PORTD_ID
+#define UART_RXD_PIN_ID					PIN0_ID
+#define UART_RXD_NUM_PINS				1
+#define UART_RXD_MASK					0x01
+#define UART_RXD_PORT_REG				PORTD
+#define UART_RXD_DDR_REG				DDRD
+#define UART_RXD_PIN_REG				PIND
+
+/* TXD alternate */
+#define UART_TXD_PORT_ID				PORTD_ID
+#define UART_TXD_PIN_ID					PIN1_ID
+#define UART_TXD_NUM_PINS				1
+#define UART_TXD_MASK					0x02
+#define UART_TXD_PORT_REG				PORTD
+#define UART_TXD_DDR_REG				DDRD
+#define UART_TXD_PIN_REG				PIND
+
+#endif /* BOARD_MCU2_H_ */
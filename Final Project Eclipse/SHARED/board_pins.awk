@@ -0,0 +1,192 @@
+################################################################################
+# Pins of one MCU of the board from board.cfg, as a header of constants : for
+# every name its port and first pin as the IDs of gpio.h, its number of pins,
+# its mask and its PORT, DDR and PIN registers, and the channel of an analog
+# input. A driver that uses them (and the GPIO_xxx(name) macros of gpio.h)
+# writes its pins with sbi and cbi, there is no lookup of the port left.
+#
+#   awk -f board_pins.awk -v mcu=mcu1 board.cfg > board_mcu1.h
+#
+# Every line of the file is checked whatever its MCU. It fails on a line it
+# doesn't understand, on a name given twice for one MCU and on a pin used by
+# two names of one MCU, with the line of both, and writes nothing then.
+################################################################################
+
+BEGIN {
+	# the ATmega32 pins of the alternate functions
+	split("ADC0 ADC1 ADC2 ADC3 ADC4 ADC5 ADC6 ADC7", names, " ")
+	for(i = 1 ; i <= 8 ; i++) function_pin[names[i]] = "A" (i - 1)
+	split("T0 T1 INT2 OC0 SS MOSI MISO SCK", names, " ")
+	for(i = 1 ; i <= 8 ; i++) function_pin[names[i]] = "B" (i - 1)
+	split("SCL SDA TCK TMS TDO TDI TOSC1 TOSC2", names, " ")
+	for(i = 1 ; i <= 8 ; i++) function_pin[names[i]] = "C" (i - 1)
+	split("RXD TXD INT0 INT1 OC1B OC1A ICP1 OC2", names, " ")
+	for(i = 1 ; i <= 8 ; i++) function_pin[names[i]] = "D" (i - 1)
+	function_pin["XCK"] = "B0"
+	function_pin["AIN0"] = "B2"
+	function_pin["AIN1"] = "B3"
+
+	uses["output"] = uses["input"] = uses["pullup"] = uses["analog"] = uses["alternate"] = 1
+	errors = 0
+	count = 0
+	if(mcu == "")
+	{
+		error("board_pins.awk : no mcu given")
+		exit 1
+	}
+}
+
+# a comment is kept for the header, it ends the fields
+{
+	comment = ""
+	hash = index($0, "#")
+	line = $0
+	if(hash > 0)
+	{
+		comment = substr($0, hash + 1)
+		sub(/^[ \t]+/, "", comment)
+		sub(/[ \t]+$/, "", comment)
+		line = substr($0, 1, hash - 1)
+	}
+	fields = split(line, field, /[ \t]+/)
+	if( (fields > 0) && (field[1] == "") )
+	{
+		for(i = 1 ; i < fields ; i++) field[i] = field[i + 1]
+		fields--
+	}
+	if( (fields > 0) && (field[fields] == "") ) fields--
+	if(fields == 0) next
+
+	where = FILENAME ":" FNR
+	if( (fields != 4) || (field[1] !~ /^mcu[0-9]+$/) || (field[2] !~ /^[A-Z][A-Z0-9_]*$/) || !(field[4] in uses) )
+	{
+		error(where ": expected mcu, name, pins and one of output, input, pullup, analog, alternate")
+		next
+	}
+	board = field[1]
+	name = field[2]
+	pins = field[3]
+	use = field[4]
+
+	channel = ""
+	if(pins ~ /^P[A-D][0-7](-[0-7])?$/)
+	{
+		if(use == "alternate")
+		{
+			error(where ": " name " is alternate but " pins " isn't a function")
+			next
+		}
+		port = substr(pins, 2, 1)
+		first = substr(pins, 3, 1) + 0
+		last = (length(pins) == 5) ? substr(pins, 5, 1) + 0 : first
+		if(last < first)
+		{
+			error(where ": " pins " of " name " goes down")
+			next
+		}
+	}
+	else if(pins in function_pin)
+	{
+		port = substr(function_pin[pins], 1, 1)
+		first = last = substr(function_pin[pins], 2, 1) + 0
+		if(pins ~ /^ADC/) channel = first
+	}
+	else
+	{
+		error(where ": " pins " of " name " isn't a pin or an ATmega32 function")
+		next
+	}
+	if( (use == "analog") && (channel == "") )
+	{
+		error(where ": " name " is analog but " pins " isn't an ADC input")
+		next
+	}
+
+	if( (board, name) in defined )
+	{
+		error(where ": " name " of " board " is already at " defined[board, name])
+		next
+	}
+	defined[board, name] = where
+
+	for(pin = first ; pin <= last ; pin++)
+	{
+		if( (board, port, pin) in owner )
+		{
+			error(where ": P" port pin " of " name " on " board " is already " owner[board, port, pin])
+			continue
+		}
+		owner[board, port, pin] = name " (" where ")"
+	}
+
+	if(board != mcu) next
+	count++
+	entry_name[count] = name
+	entry_port[count] = port
+	entry_first[count] = first
+	entry_pins[count] = last - first + 1
+	entry_channel[count] = channel
+	entry_comment[count] = pins " " use ((comment == "") ? "" : ", " comment)
+}
+
+function error(message)
+{
+	print message > "/dev/stderr"
+	errors++
+}
+
+# the value one tab stop after column 40 like the hand written headers, 4 columns a tab
+function define(name, value,    column, tabs)
+{
+	column = 8 + length(name)
+	tabs = "\t"
+	for(column = int(column / 4) * 4 + 4 ; column < 40 ; column += 4) tabs = tabs "\t"
+	printf "#define %s%s%s\n", name, tabs, value
+}
+
+END {
+	if(errors > 0) exit 1
+	if(count == 0)
+	{
+		print "board_pins.awk : no pin of " mcu > "/dev/stderr"
+		exit 1
+	}
+
+	header = "board_" mcu ".h"
+	guard = "BOARD_" toupper(mcu) "_H_"
+	print "/******************************************************************************"
+	print "*  File name:\t\t" header
+	print "*  Generated by:\tboard_pins.awk from board.cfg"
+	print "*******************************************************************************/"
+	print ""
+	print "/*"
+	print " * Pins of " toupper(mcu) ", edit board.cfg instead of this file."
+	print " * It includes nothing : the IDs are those of gpio.h and the registers those of"
+	print " * avr/io.h, they are only needed where a name is used."
+	print " */"
+	print ""
+	print "#ifndef " guard
+	print "#define " guard
+	print ""
+	print "/*******************************************************************************"
+	print "*                        		Definitions                                    *"
+	print "*******************************************************************************/"
+	for(i = 1 ; i <= count ; i++)
+	{
+		name = entry_name[i]
+		mask = 0
+		for(pin = entry_first[i] ; pin < entry_first[i] + entry_pins[i] ; pin++) mask += 2 ^ pin
+		print ""
+		print "/* " entry_comment[i] " */"
+		define(name "_PORT_ID", "PORT" entry_port[i] "_ID")
+		define(name "_PIN_ID", "PIN" entry_first[i] "_ID")
+		define(name "_NUM_PINS", entry_pins[i])
+		define(name "_MASK", sprintf("0x%02X", mask))
+		define(name "_PORT_REG", "PORT" entry_port[i])
+		define(name "_DDR_REG", "DDR" entry_port[i])
+		define(name "_PIN_REG", "PIN" entry_port[i])
+		if(entry_channel[i] != "") define(name "_CHANNEL", entry_channel[i])
+	}
+	print ""
+	print "#endif /* " guard " */"
+}
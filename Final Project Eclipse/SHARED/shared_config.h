@@ -0,0 +1,94 @@
+/******************************************************************************
+*  File name:		shared_config.h
+*  Author:			Oct 19, 2026
+*  Author:			agent
+*******************************************************************************/
+
+/*
+ * Configuration shared by MCU1 and MCU2, both projects include this same file so
+ * the two sides of the UART link can never disagree on a message or a size.
+ */
+
+#ifndef SHARED_CONFIG_H_
+#define SHARED_CONFIG_H_
+
+/*******************************************************************************
+*                        		Definitions                                    *
+*******************************************************************************/
+#define PASSWORD_MIN_SIZE			4 		/* min number of digits of a password */
+#define PASSWORD_MAX_SIZE			12 		/* max number of digits of a password, size of every password buffer */
+#define PasswordSET					0xC2 	/* To indicate whether the password is set or not */
+#define PasswordNotSET				0xFF 	/* Sent to MCU1 in case no password is saved */
+#define PASSWORD_COMMIT_TRIES		3 		/* passwords MCU2 waits for after MSG_UpdatePassword before it goes back to its commands */
+
+#if (PASSWORD_MIN_SIZE == 0) || (PASSWORD_MIN_SIZE > PASSWORD_MAX_SIZE)
+
+#error "The min password size should be between 1 and the max password size"
+
+#endif
+
+/*******************************************************************************
+*                        		UATR MESSAGES                                  *
+*******************************************************************************/
+/* A password is always sent as its length followed by the digits */
+#define MC_Ready					0xFC /* Message to indicate if the MCU is ready or not */
+#define MSG_UpdatePassword			0x99 /* Message From MCU1 to MCU2 to inform it that it will send new password and replace the one you have with it */
+#define MSG_TurnOnAlarm				0x88 /* Message From MCU1 to MCU2 to inform it the user entered the password wrong for 3 times, turn on the alarm */
+#define MSG_checkPassword			0x77 /* Message From MCU1 to MCU2 to inform it that it will send password from keypad to get checked */
+#define MSG_Motor					0x20 /* Message From MCU1 to MCU2 to inform it the user entered the password right, open the door */
+#define MSG_Matched					0xF0 /* Message From MCU2 to MCU1 to inform it if the passwords match or not */
+#define MSG_UnMatched				0x0F /* Message From MCU2 to MCU1 to inform it if the passwords match or not, followed by the tries left */
+#define MSG_Committed				0xE1 /* Message From MCU2 to MCU1 to inform it the new password is saved and verified */
+#define MSG_CommitFailed			0x1E /* Message From MCU2 to MCU1 to inform it the new password couldn't be saved and the old one is still active, MCU2 waits for the password again unless it was the last of PASSWORD_COMMIT_TRIES */
+#define MSG_Refused					0xB4 /* Message From MCU2 to MCU1 instead of MSG_CommitFailed when a password change needs an admin password first, MCU2 waits for a new command */
+#define MSG_AddUser					0x66 /* Message From MCU1 to MCU2 followed by role, uses and the password of a new user */
+#define MSG_RevokeUser				0x55 /* Message From MCU1 to MCU2 followed by the slot of the user to remove */
+#define MSG_LockoutStatus			0x44 /* Message From MCU1 to MCU2 to ask for the remaining lockout time */
+#define MSG_LockedOut				0xD2 /* Message From MCU2 to MCU1 instead of MSG_UnMatched when the password checks are locked */
+/* The remaining lockout time is sent as 2 bytes of seconds, little endian, after MSG_LockedOut or MSG_LockoutStatus */
+#define MSG_Maintenance				0x3C /* Message to MCU2 to enter the maintenance mode, answered with MC_Ready or MSG_CommitFailed */
+/* The maintenance mode needs an admin password check first unless no password is set yet, after MC_Ready
+ * the link switches to the maintenance baud rate until the host exits (see maintenance.h of MCU2) */
+#define MSG_ReadAudit				0x33 /* Message to MCU2 to stream out the whole audit log */
+/* MCU2 answers MSG_ReadAudit with the number of records, every record of 8 bytes from the oldest to the newest
+ * (erased records are all 0xFF), then the number of broken links of the hash chain and the number of lost events */
+#define MSG_ReadTrace				0x11 /* Message to MCU2 to send out the trace ring and empty it */
+/* MCU2 answers MSG_ReadTrace with the number of events, the number of events lost since the last read (255 at most),
+ * then every event of 4 bytes from the oldest to the newest (see trace.h of MCU2), 0 and 0 if it was built without the trace */
+#define MSG_ReadStats				0x12 /* Message to MCU2 to send the statistics of its interrupts and its CPU load */
+/* MCU2 answers MSG_ReadStats with the number of vectors then for every vector its calls (4 bytes), its average and
+ * longest time in cycles (2 bytes each), then the worst time the interrupts were disabled in cycles (2 bytes), the
+ * CPU load of the last second and the highest one in %. Every value is little endian and 0 without the statistics */
+#define MSG_ReadStack				0x13 /* Message to MCU2 to send the deepest its stack went since the reset */
+/* MCU2 answers MSG_ReadStack with the bytes of stack used and the bytes of RAM left for the stack, 2 bytes each,
+ * little endian, both 0 on a build without the stack painting */
+#define MSG_ReadCapture				0x14 /* Message to MCU2 to stop the capture of the link and send it */
+/* MCU2 answers MSG_ReadCapture with the number of events as 2 bytes, little endian, the number of events lost because
+ * the capture was full (255 at most), then every event of 4 bytes from the reset on (see capture.h of MCU2), 0, 0 and 0
+ * if it was built without the capture. The capture doesn't start again before the next reset */
+
+#define MSG_DoorMoved				0x2D /* Message From MCU2 to MCU1 at the end of each move of the door, the unlock then the lock */
+/* MSG_DoorMoved is followed by a DOOR_xxx result and the travel time as 2 bytes of ms, little endian. After the
+ * unlock MCU2 waits for MC_Ready from MCU1 to lock the door again */
+
+/*******************************************************************************
+*                        		DOOR RESULTS                                   *
+*******************************************************************************/
+#define DOOR_EndStop				0x00 /* Sent after MSG_DoorMoved, the bolt reached its end-stop */
+#define DOOR_Stalled				0x01 /* Sent after MSG_DoorMoved, the motor stalled before the end-stop, the bolt may be jammed */
+#define DOOR_TimedOut				0x02 /* Sent after MSG_DoorMoved, the move ran for the max time, normal on a lock without sensors */
+
+/*******************************************************************************
+*                        		USER ROLES                                     *
+*******************************************************************************/
+#define ROLE_ADMIN					0x01 /* Sent after MSG_Matched, the user can change the password and manage users */
+#define ROLE_USER					0x02 /* Sent after MSG_Matched, the user can only open the door */
+
+/*******************************************************************************
+*                        	ADD USER ERRORS                                    *
+*******************************************************************************/
+#define ERR_PasswordTaken			0x01 /* Sent after MSG_CommitFailed, the password is used by another user */
+#define ERR_UsersFull				0x02 /* Sent after MSG_CommitFailed, no free slots */
+#define ERR_SavingFailed			0x03 /* Sent after MSG_CommitFailed, the EEPROM couldn't be written */
+
+#endif /* SHARED_CONFIG_H_ */